@@ -347,6 +347,27 @@ elif name == 'json':
     install_tree('.', os.path.join(builddir, 'include'), match=['*.h'])
     install_files('.libs/libjson.a', os.path.join(builddir, 'lib'))
     install_files('.libs/libjson-c.a', os.path.join(builddir, 'lib'))
+elif name == 'opus':
+    download(
+      'https://archive.mozilla.org/pub/opus/opus-%s.tar.gz' % ver,
+        'opus-%s.tar.gz' % ver,
+        logfile,
+        vendordir)
+    extract('opus-%s.tar.gz' % ver,
+            'opus-%s' % ver)
+    os.chdir('opus-%s' % ver)
+    execute('./configure --host=%s %s %s' % (
+        toolchain,
+        makeflags(workdir, toolchain, [], cflags='-fPIC -fvisibility=hidden'),
+        ' '.join([
+            '--enable-static',
+            '--disable-shared',
+            '--disable-extra-programs',
+            '--disable-doc',
+        ])), logfile)
+    execute('make -j', logfile)
+    install_files('include/*.h', os.path.join(builddir, 'include'))
+    install_files('.libs/libopus.a', os.path.join(builddir, 'lib'))
 elif name == 'sndfile':
     download(
       'http://www.mega-nerd.com/libsndfile/files/libsndfile-%s.tar.gz' % ver,
@@ -471,6 +492,28 @@ elif name == 'cpputest':
     execute('make -j', logfile)
     install_tree('include', os.path.join(builddir, 'include'))
     install_files('lib/libCppUTest.a', os.path.join(builddir, 'lib'))
+elif name == 'benchmark':
+    download(
+        'https://github.com/google/benchmark/archive/v%s.tar.gz' % ver,
+        'benchmark_v%s.tar.gz' % ver,
+        logfile,
+        vendordir)
+    extract('benchmark_v%s.tar.gz' % ver,
+            'benchmark-%s' % ver)
+    os.chdir('benchmark-%s' % ver)
+    os.mkdir('build')
+    os.chdir('build')
+    execute('cmake .. ' + ' '.join([
+        '-DCMAKE_CXX_COMPILER=%s' % '-'.join([s for s in [toolchain, 'g++'] if s]),
+        '-DCMAKE_FIND_ROOT_PATH=%s' % getsysroot(toolchain),
+        '-DCMAKE_BUILD_TYPE=Release',
+        '-DBENCHMARK_ENABLE_TESTING=OFF',
+        '-DBENCHMARK_ENABLE_GTEST_TESTS=OFF',
+        ]), logfile)
+    execute('make -j', logfile)
+    os.chdir('..')
+    install_tree('include', os.path.join(builddir, 'include'))
+    install_files('build/src/libbenchmark.a', os.path.join(builddir, 'lib'))
 else:
     print("error: unknown 3rdparty '%s'" % fullname, file=sys.stderr)
     exit(1)
@@ -31,7 +31,13 @@ typedef enum roc_port_type {
      * If FEC is used, this type of port is used to send or receive FEC repair packets
      * containing redundant data for audio plus some FEC headers.
      */
-    ROC_PORT_AUDIO_REPAIR = 2
+    ROC_PORT_AUDIO_REPAIR = 2,
+
+    /** Network port for control packets.
+     * If set, the sender and the receiver exchange RTCP reports through this port,
+     * which allows to measure round-trip time, losses, jitter, and end-to-end latency.
+     */
+    ROC_PORT_CONTROL = 3
 } roc_port_type;
 
 /** Network protocol. */
@@ -50,7 +56,16 @@ typedef enum roc_protocol {
     ROC_PROTO_RTP_LDPC_SOURCE = 4,
 
     /** FEC repair packet + FECFRAME LDPC-Staircase header (RFC 6816). */
-    ROC_PROTO_LDPC_REPAIR = 5
+    ROC_PROTO_LDPC_REPAIR = 5,
+
+    /** RTCP sender and receiver reports (RFC 3550). */
+    ROC_PROTO_RTCP = 6,
+
+    /** RTP source packet (RFC 3550) + FECFRAME RLC footer (RFC 8681) with m=8. */
+    ROC_PROTO_RTP_RLC_SOURCE = 7,
+
+    /** FEC repair packet + FECFRAME RLC header (RFC 8681) with m=8. */
+    ROC_PROTO_RLC_REPAIR = 8
 } roc_protocol;
 
 /** Forward Error Correction code. */
@@ -77,7 +92,15 @@ typedef enum roc_fec_code {
      * Compatible with @c ROC_PROTO_RTP_LDPC_SOURCE and @c ROC_PROTO_LDPC_REPAIR
      * protocols for source and repair ports.
      */
-    ROC_FEC_LDPC_STAIRCASE = 2
+    ROC_FEC_LDPC_STAIRCASE = 2,
+
+    /** Sliding window Random Linear Codes (RFC 8681) with m=8.
+     * Good for low latency, since lost packets may be repaired before the
+     * whole block is received. Block size defines the encoding window size.
+     * Compatible with @c ROC_PROTO_RTP_RLC_SOURCE and @c ROC_PROTO_RLC_REPAIR
+     * protocols for source and repair ports.
+     */
+    ROC_FEC_RLC8M = 3
 } roc_fec_code;
 
 /** Packet encoding. */
@@ -87,7 +110,28 @@ typedef enum roc_packet_encoding {
      * Uncompressed samples coded as interleaved 16-bit signed big-endian
      * integers in two's complement notation.
      */
-    ROC_PACKET_ENCODING_AVP_L16 = 2
+    ROC_PACKET_ENCODING_AVP_L16 = 2,
+
+    /** PCM signed 24-bit.
+     * "L24" encoding (RFC 3190).
+     * Uncompressed samples coded as interleaved 24-bit signed big-endian
+     * integers in two's complement notation.
+     */
+    ROC_PACKET_ENCODING_L24 = 3,
+
+    /** PCM floats.
+     * Uncompressed samples coded as interleaved 32-bit big-endian IEEE 754 floats
+     * in range [-1; 1].
+     */
+    ROC_PACKET_ENCODING_FLOAT32 = 4,
+
+    /** Opus.
+     * Compressed samples coded using Opus codec (RFC 6716, RFC 7587) in
+     * constant bitrate mode. Packet sample rate is always 48000 and packet
+     * length should be 2.5, 5, 10, 20, 40, or 60 ms.
+     * Available only if the library was built with Opus support.
+     */
+    ROC_PACKET_ENCODING_OPUS = 5
 } roc_packet_encoding;
 
 /** Frame encoding. */
@@ -101,6 +145,13 @@ typedef enum roc_frame_encoding {
 
 /** Channel set. */
 typedef enum roc_channel_set {
+    /** Mono.
+     * One channel.
+     * Currently supported only for packet formats registered using
+     * roc_context_register_format().
+     */
+    ROC_CHANNEL_SET_MONO = 1,
+
     /** Stereo.
      * Two channels: left and right.
      */
@@ -124,7 +175,22 @@ typedef enum roc_resampler_profile {
     ROC_RESAMPLER_MEDIUM = 2,
 
     /** Low quality, high speed. */
-    ROC_RESAMPLER_LOW = 3
+    ROC_RESAMPLER_LOW = 3,
+
+    /** Short polyphase sinc filter, lower quality and higher speed than low. */
+    ROC_RESAMPLER_SHORT = 4,
+
+    /** Cubic Hermite interpolation, even lower quality and higher speed.
+     * Intended only for clock drift compensation, when sender and receiver
+     * have the same nominal sample rate.
+     */
+    ROC_RESAMPLER_CUBIC = 5,
+
+    /** Linear interpolation, lowest quality, highest speed.
+     * Intended only for clock drift compensation, when sender and receiver
+     * have the same nominal sample rate.
+     */
+    ROC_RESAMPLER_LINEAR = 6
 } roc_resampler_profile;
 
 /** Context configuration.
@@ -144,6 +210,34 @@ typedef struct roc_context_config {
     unsigned int max_frame_size;
 } roc_context_config;
 
+/** Packet format.
+ * Defines how audio is encoded in the packets with given RTP payload type.
+ * @see roc_context_register_format
+ */
+typedef struct roc_format {
+    /** RTP payload type.
+     * Should be in range [0; 127]. Dynamic payload types are in range [96; 127].
+     */
+    unsigned int payload_type;
+
+    /** The sample encoding in the packets.
+     * Should be set.
+     */
+    roc_packet_encoding encoding;
+
+    /** The rate of the samples in the packets.
+     * Number of samples per channel per second. Any non-zero rate is allowed for
+     * PCM encodings. Opus requires 48000.
+     * Should be set.
+     */
+    unsigned int sample_rate;
+
+    /** The channel set in the packets.
+     * Should be set.
+     */
+    roc_channel_set channels;
+} roc_format;
+
 /** Sender configuration.
  * @see roc_sender
  */
@@ -168,6 +262,8 @@ typedef struct roc_sender_config {
 
     /** The rate of the samples in the packets generated by sender.
      * Number of samples per channel per second.
+     * Supported values are 44100, 48000, and 96000. If it is equal to
+     * @c frame_sample_rate, sender doesn't need to resample.
      * If zero, default value is used.
      */
     unsigned int packet_sample_rate;
@@ -182,6 +278,14 @@ typedef struct roc_sender_config {
      */
     roc_packet_encoding packet_encoding;
 
+    /** The RTP payload type of the packets generated by sender.
+     * If non-zero, the sender uses the format registered in the context for this
+     * payload type using roc_context_register_format(), and @c packet_sample_rate,
+     * @c packet_channels, and @c packet_encoding are ignored.
+     * If zero, payload type is derived from the other packet parameters.
+     */
+    unsigned int packet_payload_type;
+
     /** The length of the packets produced by sender, in nanoseconds.
      * Number of nanoseconds encoded per packet.
      * The samples written to the sender are buffered until the full packet is
@@ -191,12 +295,52 @@ typedef struct roc_sender_config {
      */
     unsigned long long packet_length;
 
+    /** The maximum size of the packets produced by sender, in bytes.
+     * If non-zero, @c packet_length is ignored, and the sender instead uses the
+     * longest packets that fit into this size, including RTP and FEC headers.
+     * Typically set to the path MTU minus IP and UDP headers, e.g. 1472 bytes
+     * for Ethernet and IPv4. Should not exceed @c max_packet_size of the context.
+     * When FEC is enabled, receiver should use the same packet length, which is
+     * reported in the sender log.
+     */
+    unsigned int packet_max_size;
+
     /** Enable packet interleaving.
      * If non-zero, the sender shuffles packets before sending them. This
      * may increase robustness but also increases latency.
      */
     unsigned int packet_interleaving;
 
+    /** Enable discontinuous transmission (DTX).
+     * If non-zero, the sender doesn't send packets containing only zero samples,
+     * and instead sends rare keep-alive packets during silence. This greatly
+     * reduces traffic when the stream is idle most of the time.
+     */
+    unsigned int dtx;
+
+    /** Interval between keep-alive packets during silence, in nanoseconds.
+     * Used if DTX is enabled. Should be less than the receiver no_playback_timeout.
+     * If zero, default value is used.
+     */
+    unsigned long long dtx_keepalive_interval;
+
+    /** Enable packet capture timestamps.
+     * If non-zero, the sender adds an RTP header extension (RFC 8285) with the
+     * wall clock capture time of the first sample to every audio packet. This
+     * increases packet overhead by 16 bytes, but allows the receiver to measure
+     * end-to-end latency per packet instead of using RTCP sender reports.
+     * When FEC is enabled, the receiver should enable @c capture_timestamps too.
+     */
+    unsigned int capture_timestamps;
+
+    /** Number of recent packets kept for retransmission.
+     * If non-zero, the sender remembers this many recent source packets and
+     * sends them again when the receiver requests them using RTCP generic NACKs.
+     * Requires control port to be connected. This is a low-overhead alternative
+     * to FEC on networks with small round-trip time, like LANs.
+     */
+    unsigned int retransmission_buffer;
+
     /** Enable automatic timing.
      * If non-zero, the sender write operation restricts the write rate according
      * to the frame_sample_rate parameter. If zero, no restrictions are applied.
@@ -288,6 +432,26 @@ typedef struct roc_receiver_config {
      */
     unsigned long long max_latency_underrun;
 
+    /** Enable adaptive latency.
+     * If non-zero, the receiver measures network jitter for every session and
+     * adjusts the target latency accordingly, keeping it between
+     * @c min_target_latency and @c max_target_latency. The @c target_latency is
+     * used as the initial value. Requires resampler to be enabled. If
+     * @c max_latency_overrun or @c max_latency_underrun is set, the resulting
+     * latency bounds should contain this range.
+     */
+    unsigned int adaptive_latency;
+
+    /** Minimum target latency, in nanoseconds.
+     * Used if adaptive latency is enabled. If zero, default value is used.
+     */
+    unsigned long long min_target_latency;
+
+    /** Maximum target latency, in nanoseconds.
+     * Used if adaptive latency is enabled. If zero, default value is used.
+     */
+    unsigned long long max_target_latency;
+
     /** Timeout for the lack of playback, in nanoseconds.
      * If there is no playback during this period, the session is terminated.
      * This mechanism allows to detect dead, hanging, or broken clients
@@ -318,6 +482,15 @@ typedef struct roc_receiver_config {
      */
     unsigned long long packet_length;
 
+    /** Enable retransmission requests.
+     * If non-zero, the receiver detects lost packets as soon as newer packets
+     * arrive and requests them from the sender using RTCP generic NACKs.
+     * Requires control port to be bound and the sender to have
+     * @c retransmission_buffer enabled. The target latency should be large
+     * enough to fit a few round-trips.
+     */
+    unsigned int retransmission;
+
     /** FEC code to use.
      * If non-zero, the receiver employs FEC codec to restore dropped packets.
      * This requires both sender and receiver to use two separate source and
@@ -336,6 +509,21 @@ typedef struct roc_receiver_config {
      * Should be set to the same value as on the sender.
      */
     unsigned int fec_block_repair_packets;
+
+    /** Expect packet capture timestamps.
+     * Capture timestamps are used whenever packets carry them. However, when
+     * FEC is enabled, they change the size of FEC symbols, so this should be
+     * set to the same value as on the sender.
+     */
+    unsigned int capture_timestamps;
+
+    /** Maximum number of packets queued in a session.
+     * If non-zero, when a session has more source and repair packets queued,
+     * the receiver drops repair packets first and then the oldest source
+     * packets. Should be large enough to hold packets for the maximum latency.
+     * If zero, there is no limit.
+     */
+    unsigned int max_session_packets;
 } roc_receiver_config;
 
 #ifdef __cplusplus
@@ -71,6 +71,26 @@ ROC_API roc_context* roc_context_open(const roc_context_config* config);
  */
 ROC_API int roc_context_close(roc_context* context);
 
+/** Register packet format.
+ *
+ * Maps an RTP payload type to the encoding, sample rate, and channel set of the
+ * packets. Senders and receivers attached to the context use the registered
+ * formats in addition to the built-in ones. If the payload type is already mapped,
+ * either to a built-in or to a registered format, the mapping is replaced.
+ *
+ * Formats should be registered before any objects are attached to the context.
+ *
+ * @b Parameters
+ *  - @p context should point to an opened context
+ *  - @p format should point to an initialized format
+ *
+ * @b Returns
+ *  - returns zero if the format was successfully registered
+ *  - returns a negative value if the arguments are invalid
+ *  - returns a negative value if there are objects attached to the context
+ */
+ROC_API int roc_context_register_format(roc_context* context, const roc_format* format);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
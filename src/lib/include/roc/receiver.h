@@ -57,6 +57,11 @@ extern "C" {
  * to the employed FEC code. Otherwise, the sender needs to be connected to a single
  * @c ROC_PORT_AUDIO_SOURCE port.
  *
+ * Receiver may be additionally bound to a single @c ROC_PORT_CONTROL port with
+ * @c ROC_PROTO_RTCP protocol. It will receive RTCP sender reports and periodically
+ * send RTCP receiver reports back to every connected sender. Statistics built from
+ * received packets and reports are available via roc_receiver_get_stats().
+ *
  * @b Sessions
  *
  * Receiver creates a session object for every sender connected to it. Sessions can appear
@@ -116,6 +121,59 @@ extern "C" {
  */
 typedef struct roc_receiver roc_receiver;
 
+/** Receiver statistics.
+ *
+ * Aggregated over all active sessions.
+ */
+typedef struct roc_receiver_stats {
+    /** Number of active sessions. */
+    unsigned long num_sessions;
+
+    /** Maximum interarrival jitter among sessions, in nanoseconds. */
+    unsigned long long jitter;
+
+    /** Maximum fraction of packets lost among sessions since the previous receiver
+     * report. In range [0; 1].
+     */
+    float fraction_lost;
+
+    /** Total number of packets lost in all sessions. */
+    long long cumulative_lost;
+
+    /** Maximum end-to-end latency among sessions, in nanoseconds.
+     * Time passed since the sample being currently read was captured at the sender.
+     * Computed using capture timestamps from RTP header extension if the sender
+     * enables them (see roc_sender_config.capture_timestamps), or else using RTCP
+     * sender reports. Requires the sender and receiver clocks to be synchronized,
+     * e.g. using NTP. Zero if the capture time is not known yet.
+     */
+    long long e2e_latency;
+
+    /** Maximum 50th percentile of end-to-end latency among sessions, in nanoseconds.
+     * Percentiles are estimated over the recent end-to-end latency measurements.
+     */
+    long long e2e_latency_p50;
+
+    /** Maximum 95th percentile of end-to-end latency among sessions, in nanoseconds.
+     */
+    long long e2e_latency_p95;
+
+    /** Maximum 99th percentile of end-to-end latency among sessions, in nanoseconds.
+     */
+    long long e2e_latency_p99;
+
+    /** Total number of source packets dropped because the receiver could not keep up
+     * with incoming packets and its queues reached the maximum size.
+     */
+    unsigned long long num_dropped_source;
+
+    /** Total number of repair packets dropped because the receiver could not keep up
+     * with incoming packets and its queues reached the maximum size. Repair packets
+     * are dropped before source packets.
+     */
+    unsigned long long num_dropped_repair;
+} roc_receiver_stats;
+
 /** Open a new receiver.
  *
  * Allocates and initializes a new receiver, and attaches it to the context.
@@ -179,6 +237,18 @@ ROC_API int roc_receiver_bind(roc_receiver* receiver,
  */
 ROC_API int roc_receiver_read(roc_receiver* receiver, roc_frame* frame);
 
+/** Get receiver statistics.
+ *
+ * @b Parameters
+ *  - @p receiver should point to an opened receiver
+ *  - @p stats should point to a statistics struct to be filled
+ *
+ * @b Returns
+ *  - returns zero if the statistics was successfully retrieved
+ *  - returns a negative value if the arguments are invalid
+ */
+ROC_API int roc_receiver_get_stats(roc_receiver* receiver, roc_receiver_stats* stats);
+
 /** Close the receiver.
  *
  * Deinitializes and deallocates the receiver, and detaches it from the context. The user
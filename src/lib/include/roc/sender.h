@@ -64,6 +64,11 @@ extern "C" {
  *    @c ROC_FEC_RS8M is used, the corresponding protocols would be
  *    @c ROC_PROTO_RTP_RSM8_SOURCE and @c ROC_PROTO_RSM8_REPAIR.
  *
+ * In both configurations, a port of type @c ROC_PORT_CONTROL with protocol
+ * @c ROC_PROTO_RTCP may be additionally connected. The sender will periodically send
+ * RTCP sender reports to it and receive RTCP receiver reports on its bound port.
+ * Statistics built from these reports are available via roc_sender_get_stats().
+ *
  * @b Resampling
  *
  * If the sample rate of the user frames and the sample rate of the network packets are
@@ -95,6 +100,30 @@ extern "C" {
  */
 typedef struct roc_sender roc_sender;
 
+/** Sender statistics.
+ *
+ * Built from RTCP receiver reports. All fields are zero until the first report
+ * is received.
+ */
+typedef struct roc_sender_stats {
+    /** Number of receiver reports received. */
+    unsigned long num_reports;
+
+    /** Round-trip time, in nanoseconds. */
+    unsigned long long rtt;
+
+    /** Fraction of packets lost, as reported by the last receiver report.
+     * In range [0; 1].
+     */
+    float fraction_lost;
+
+    /** Cumulative number of packets lost, as reported by the last receiver report. */
+    long cumulative_lost;
+
+    /** Interarrival jitter, in nanoseconds. */
+    unsigned long long jitter;
+} roc_sender_stats;
+
 /** Open a new sender.
  *
  * Allocates and initializes a new sender, and attaches it to the context.
@@ -176,6 +205,22 @@ ROC_API int roc_sender_connect(roc_sender* sender,
  */
 ROC_API int roc_sender_write(roc_sender* sender, const roc_frame* frame);
 
+/** Get sender statistics.
+ *
+ * Fills @p stats with the statistics built from RTCP receiver reports received on
+ * the sender port. Reports are processed during roc_sender_write(). If the control
+ * port is not connected, all statistics fields are zero.
+ *
+ * @b Parameters
+ *  - @p sender should point to an opened sender
+ *  - @p stats should point to a statistics struct to be filled
+ *
+ * @b Returns
+ *  - returns zero if the statistics was successfully retrieved
+ *  - returns a negative value if the arguments are invalid
+ */
+ROC_API int roc_sender_get_stats(roc_sender* sender, roc_sender_stats* stats);
+
 /** Close the sender.
  *
  * Deinitializes and deallocates the sender, and detaches it from the context. The user
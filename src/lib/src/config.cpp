@@ -30,6 +30,185 @@ bool make_context_config(roc_context_config& out, const roc_context_config& in)
     return true;
 }
 
+namespace {
+
+bool make_payload_type(rtp::PayloadType& out,
+                       roc_packet_encoding encoding,
+                       unsigned int sample_rate) {
+    switch ((int)encoding) {
+    case 0:
+    case ROC_PACKET_ENCODING_AVP_L16:
+        switch (sample_rate) {
+        case 0:
+        case 44100:
+            out = rtp::PayloadType_L16_Stereo;
+            return true;
+        case 48000:
+            out = rtp::PayloadType_L16_48k_Stereo;
+            return true;
+        case 96000:
+            out = rtp::PayloadType_L16_96k_Stereo;
+            return true;
+        }
+        break;
+
+    case ROC_PACKET_ENCODING_L24:
+        switch (sample_rate) {
+        case 0:
+        case 44100:
+            out = rtp::PayloadType_L24_Stereo;
+            return true;
+        case 48000:
+            out = rtp::PayloadType_L24_48k_Stereo;
+            return true;
+        case 96000:
+            out = rtp::PayloadType_L24_96k_Stereo;
+            return true;
+        }
+        break;
+
+    case ROC_PACKET_ENCODING_FLOAT32:
+        switch (sample_rate) {
+        case 0:
+        case 44100:
+            out = rtp::PayloadType_Float32_Stereo;
+            return true;
+        case 48000:
+            out = rtp::PayloadType_Float32_48k_Stereo;
+            return true;
+        case 96000:
+            out = rtp::PayloadType_Float32_96k_Stereo;
+            return true;
+        }
+        break;
+
+    case ROC_PACKET_ENCODING_OPUS:
+#ifdef ROC_TARGET_OPUS
+        switch (sample_rate) {
+        case 0:
+        case 48000:
+            out = rtp::PayloadType_Opus_Stereo;
+            return true;
+        }
+        roc_log(LogError,
+                "roc_config: invalid packet_sample_rate, only 48000 is supported by opus");
+        return false;
+#else
+        roc_log(LogError, "roc_config: opus encoding is not supported by this build");
+        return false;
+#endif // ROC_TARGET_OPUS
+
+    default:
+        roc_log(LogError, "roc_config: invalid packet_encoding");
+        return false;
+    }
+
+    roc_log(LogError,
+            "roc_config: invalid packet_sample_rate,"
+            " only 44100, 48000, and 96000 are supported");
+    return false;
+}
+
+bool make_packet_length(core::nanoseconds_t& out,
+                        roc_packet_encoding encoding,
+                        unsigned long long packet_length) {
+    if (encoding != ROC_PACKET_ENCODING_OPUS) {
+        if (packet_length != 0) {
+            out = (core::nanoseconds_t)packet_length;
+        }
+        return true;
+    }
+
+    // Opus frames may be only 2.5, 5, 10, 20, 40, or 60 ms long.
+    switch (packet_length) {
+    case 0:
+        out = 10 * core::Millisecond;
+        return true;
+    case 2500 * core::Microsecond:
+    case 5 * core::Millisecond:
+    case 10 * core::Millisecond:
+    case 20 * core::Millisecond:
+    case 40 * core::Millisecond:
+    case 60 * core::Millisecond:
+        out = (core::nanoseconds_t)packet_length;
+        return true;
+    }
+
+    roc_log(LogError,
+            "roc_config: invalid packet_length,"
+            " only 2.5, 5, 10, 20, 40, and 60 ms are supported by opus");
+    return false;
+}
+
+} // namespace
+
+bool make_format(rtp::Format& out, const roc_format& in) {
+    if (in.payload_type > 127) {
+        roc_log(LogError, "roc_config: invalid payload_type, should be in range [0; 127]");
+        return false;
+    }
+
+    if (in.sample_rate == 0) {
+        roc_log(LogError, "roc_config: invalid sample_rate");
+        return false;
+    }
+
+    bool stereo = false;
+
+    switch ((int)in.channels) {
+    case ROC_CHANNEL_SET_MONO:
+        break;
+    case ROC_CHANNEL_SET_STEREO:
+        stereo = true;
+        break;
+    default:
+        roc_log(LogError, "roc_config: invalid channels");
+        return false;
+    }
+
+    rtp::PayloadType builtin_pt;
+
+    switch ((int)in.encoding) {
+    case ROC_PACKET_ENCODING_AVP_L16:
+        builtin_pt = stereo ? rtp::PayloadType_L16_Stereo : rtp::PayloadType_L16_Mono;
+        break;
+
+    case ROC_PACKET_ENCODING_L24:
+        builtin_pt = stereo ? rtp::PayloadType_L24_Stereo : rtp::PayloadType_L24_Mono;
+        break;
+
+    case ROC_PACKET_ENCODING_FLOAT32:
+        builtin_pt =
+            stereo ? rtp::PayloadType_Float32_Stereo : rtp::PayloadType_Float32_Mono;
+        break;
+
+    case ROC_PACKET_ENCODING_OPUS:
+        if (in.sample_rate != 48000) {
+            roc_log(LogError,
+                    "roc_config: invalid sample_rate, only 48000 is supported by opus");
+            return false;
+        }
+        builtin_pt = stereo ? rtp::PayloadType_Opus_Stereo : rtp::PayloadType_Opus_Mono;
+        break;
+
+    default:
+        roc_log(LogError, "roc_config: invalid encoding");
+        return false;
+    }
+
+    const rtp::Format* builtin_format = rtp::FormatMap::builtin_format(builtin_pt);
+    if (!builtin_format) {
+        roc_log(LogError, "roc_config: encoding is not supported by this build");
+        return false;
+    }
+
+    out = *builtin_format;
+    out.payload_type = (rtp::PayloadType)in.payload_type;
+    out.sample_rate = in.sample_rate;
+
+    return true;
+}
+
 bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config& in) {
     if (in.frame_sample_rate != 0) {
         out.input_sample_rate = in.frame_sample_rate;
@@ -48,28 +227,36 @@ bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config& in
         return false;
     }
 
-    if (in.packet_sample_rate != 0 && in.packet_sample_rate != 44100) {
-        roc_log(
-            LogError,
-            "roc_config: invalid packet_sample_rate, only 44100 is currently supported");
-        return false;
-    }
-
     if (in.packet_channels != 0 && in.packet_channels != ROC_CHANNEL_SET_STEREO) {
         roc_log(LogError, "roc_config: invalid packet_channels");
         return false;
     }
 
-    if (in.packet_encoding != 0 && in.packet_encoding != ROC_PACKET_ENCODING_AVP_L16) {
-        roc_log(LogError, "roc_config: invalid packet_encoding");
+    if (in.packet_payload_type != 0) {
+        if (in.packet_payload_type > 127) {
+            roc_log(LogError, "roc_config: invalid packet_payload_type");
+            return false;
+        }
+        out.payload_type = (rtp::PayloadType)in.packet_payload_type;
+    } else if (!make_payload_type(out.payload_type, in.packet_encoding,
+                                  in.packet_sample_rate)) {
         return false;
     }
 
-    if (in.packet_length != 0) {
-        out.packet_length = (core::nanoseconds_t)in.packet_length;
+    if (!make_packet_length(out.packet_length, in.packet_encoding, in.packet_length)) {
+        return false;
     }
 
+    out.max_packet_size = in.packet_max_size;
+
     out.interleaving = in.packet_interleaving;
+    out.capture_timestamps = in.capture_timestamps;
+    out.retransmission_buffer = in.retransmission_buffer;
+
+    out.dtx = in.dtx;
+    if (in.dtx_keepalive_interval != 0) {
+        out.dtx_keepalive_interval = (core::nanoseconds_t)in.dtx_keepalive_interval;
+    }
     out.timing = in.automatic_timing;
 
     out.resampling = (in.resampler_profile != ROC_RESAMPLER_DISABLE);
@@ -87,6 +274,15 @@ bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config& in
     case ROC_RESAMPLER_HIGH:
         out.resampler = audio::resampler_profile(audio::ResamplerProfile_High);
         break;
+    case ROC_RESAMPLER_SHORT:
+        out.resampler = audio::resampler_profile(audio::ResamplerProfile_Short);
+        break;
+    case ROC_RESAMPLER_CUBIC:
+        out.resampler = audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+    case ROC_RESAMPLER_LINEAR:
+        out.resampler = audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
     default:
         roc_log(LogError, "roc_config: invalid resampler_profile");
         return false;
@@ -103,6 +299,9 @@ bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config& in
     case ROC_FEC_LDPC_STAIRCASE:
         out.fec.codec = fec::LDPCStaircase;
         break;
+    case ROC_FEC_RLC8M:
+        out.fec.codec = fec::RLC8m;
+        break;
     default:
         roc_log(LogError, "roc_config: invalid fec_scheme");
         return false;
@@ -154,6 +353,18 @@ bool make_receiver_config(pipeline::ReceiverConfig& out, const roc_receiver_conf
         out.default_session.resampler =
             audio::resampler_profile(audio::ResamplerProfile_High);
         break;
+    case ROC_RESAMPLER_SHORT:
+        out.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Short);
+        break;
+    case ROC_RESAMPLER_CUBIC:
+        out.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+    case ROC_RESAMPLER_LINEAR:
+        out.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
     default:
         roc_log(LogError, "roc_config: invalid resampler_profile");
         return false;
@@ -182,17 +393,81 @@ bool make_receiver_config(pipeline::ReceiverConfig& out, const roc_receiver_conf
     }
 
     if (in.max_latency_overrun != 0) {
-        out.default_session.latency_monitor.min_latency =
+        out.default_session.latency_monitor.max_latency =
             out.default_session.target_latency
             + (core::nanoseconds_t)in.max_latency_overrun;
     }
 
     if (in.max_latency_underrun != 0) {
-        out.default_session.latency_monitor.max_latency =
+        out.default_session.latency_monitor.min_latency =
             out.default_session.target_latency
             - (core::nanoseconds_t)in.max_latency_underrun;
     }
 
+    if (in.adaptive_latency) {
+        if (!out.output.resampling) {
+            roc_log(LogError, "roc_config: adaptive_latency requires resampler_profile");
+            return false;
+        }
+
+        out.default_session.adaptive_latency = true;
+
+        if (in.min_target_latency != 0) {
+            out.default_session.latency_tuner.min_target_latency =
+                (core::nanoseconds_t)in.min_target_latency;
+        }
+
+        if (in.max_target_latency != 0) {
+            out.default_session.latency_tuner.max_target_latency =
+                (core::nanoseconds_t)in.max_target_latency;
+        }
+
+        const core::nanoseconds_t max_target =
+            out.default_session.latency_tuner.max_target_latency;
+
+        if (out.default_session.latency_tuner.min_target_latency > max_target) {
+            roc_log(LogError, "roc_config: invalid min_target_latency/max_target_latency");
+            return false;
+        }
+
+        // Latency monitor bounds set explicitly are kept as is, but they should
+        // still allow latency tuner to move target latency within its range.
+        if (in.max_latency_underrun == 0
+            && out.default_session.latency_monitor.min_latency
+                > max_target * pipeline::DefaultMinLatencyFactor) {
+            out.default_session.latency_monitor.min_latency =
+                max_target * pipeline::DefaultMinLatencyFactor;
+        }
+
+        if (in.max_latency_overrun == 0
+            && out.default_session.latency_monitor.max_latency
+                < max_target * pipeline::DefaultMaxLatencyFactor) {
+            out.default_session.latency_monitor.max_latency =
+                max_target * pipeline::DefaultMaxLatencyFactor;
+        }
+
+        if (out.default_session.latency_monitor.min_latency
+                > out.default_session.latency_tuner.min_target_latency
+            || out.default_session.latency_monitor.max_latency < max_target) {
+            roc_log(LogError,
+                    "roc_config: max_latency_overrun/max_latency_underrun should allow"
+                    " min_target_latency/max_target_latency");
+            return false;
+        }
+
+        if (out.default_session.watchdog.no_playback_timeout
+            < out.default_session.latency_monitor.max_latency) {
+            out.default_session.watchdog.no_playback_timeout =
+                out.default_session.latency_monitor.max_latency;
+        }
+
+        if (out.default_session.watchdog.broken_playback_timeout
+            < out.default_session.latency_monitor.max_latency) {
+            out.default_session.watchdog.broken_playback_timeout =
+                out.default_session.latency_monitor.max_latency;
+        }
+    }
+
     if (in.no_playback_timeout < 0) {
         out.default_session.watchdog.no_playback_timeout = 0;
     } else if (in.no_playback_timeout > 0) {
@@ -214,6 +489,8 @@ bool make_receiver_config(pipeline::ReceiverConfig& out, const roc_receiver_conf
         out.default_session.packet_length = (core::nanoseconds_t)in.packet_length;
     }
 
+    out.default_session.retransmission = in.retransmission;
+
     switch ((int)in.fec_code) {
     case ROC_FEC_DISABLE:
         out.default_session.fec.codec = fec::NoCodec;
@@ -225,6 +502,9 @@ bool make_receiver_config(pipeline::ReceiverConfig& out, const roc_receiver_conf
     case ROC_FEC_LDPC_STAIRCASE:
         out.default_session.fec.codec = fec::LDPCStaircase;
         break;
+    case ROC_FEC_RLC8M:
+        out.default_session.fec.codec = fec::RLC8m;
+        break;
     default:
         roc_log(LogError, "roc_config: invalid fec_scheme");
         return false;
@@ -235,6 +515,9 @@ bool make_receiver_config(pipeline::ReceiverConfig& out, const roc_receiver_conf
         out.default_session.fec.n_repair_packets = in.fec_block_repair_packets;
     }
 
+    out.default_session.capture_timestamps = in.capture_timestamps;
+    out.default_session.max_session_packets = in.max_session_packets;
+
     return true;
 }
 
@@ -254,6 +537,9 @@ bool make_port_config(pipeline::PortConfig& out,
         case ROC_PROTO_RTP_LDPC_SOURCE:
             out.protocol = pipeline::Proto_RTP_LDPC_Source;
             break;
+        case ROC_PROTO_RTP_RLC_SOURCE:
+            out.protocol = pipeline::Proto_RTP_RLC_Source;
+            break;
         default:
             roc_log(LogError, "roc_config: invalid protocol for audio source port");
             return false;
@@ -268,12 +554,26 @@ bool make_port_config(pipeline::PortConfig& out,
         case ROC_PROTO_LDPC_REPAIR:
             out.protocol = pipeline::Proto_LDPC_Repair;
             break;
+        case ROC_PROTO_RLC_REPAIR:
+            out.protocol = pipeline::Proto_RLC_Repair;
+            break;
         default:
             roc_log(LogError, "roc_config: invalid protocol for audio repair port");
             return false;
         }
         break;
 
+    case ROC_PORT_CONTROL:
+        switch ((int)proto) {
+        case ROC_PROTO_RTCP:
+            out.protocol = pipeline::Proto_RTCP;
+            break;
+        default:
+            roc_log(LogError, "roc_config: invalid protocol for control port");
+            return false;
+        }
+        break;
+
     default:
         roc_log(LogError, "roc_config: invalid port type");
         return false;
@@ -49,6 +49,16 @@ roc_context* roc_context_open(const roc_context_config* config) {
         return NULL;
     }
 
+    if (!context->fec_worker.start()) {
+        roc_log(LogError, "roc_context_start: can't start fec thread");
+
+        context->trx.stop();
+        context->trx.join();
+
+        delete context;
+        return NULL;
+    }
+
     return context;
 }
 
@@ -67,9 +77,48 @@ int roc_context_close(roc_context* context) {
     context->trx.stop();
     context->trx.join();
 
+    context->fec_worker.stop();
+    context->fec_worker.join();
+
     delete context;
 
     roc_log(LogInfo, "roc_context: closed context");
 
     return 0;
 }
+
+int roc_context_register_format(roc_context* context, const roc_format* format) {
+    if (!context) {
+        roc_log(LogError,
+                "roc_context_register_format: invalid arguments: context is null");
+        return -1;
+    }
+
+    if (!format) {
+        roc_log(LogError, "roc_context_register_format: invalid arguments: format is null");
+        return -1;
+    }
+
+    rtp::Format private_format;
+    if (!make_format(private_format, *format)) {
+        roc_log(LogError, "roc_context_register_format: invalid arguments: bad format");
+        return -1;
+    }
+
+    if (context->counter != 0) {
+        roc_log(LogError,
+                "roc_context_register_format: context is already in use: counter=%lu",
+                (unsigned long)context->counter);
+        return -1;
+    }
+
+    if (!context->format_map.add_format(private_format)) {
+        roc_log(LogError, "roc_context_register_format: can't register format");
+        return -1;
+    }
+
+    roc_log(LogInfo, "roc_context: registered format: pt=%u rate=%u ch=%u",
+            format->payload_type, format->sample_rate, (unsigned)format->channels);
+
+    return 0;
+}
@@ -20,8 +20,10 @@
 #include "roc_core/heap_allocator.h"
 #include "roc_core/mutex.h"
 #include "roc_core/unique_ptr.h"
+#include "roc_fec/encoder_worker.h"
 #include "roc_netio/transceiver.h"
 #include "roc_packet/address.h"
+#include "roc_packet/concurrent_queue.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_pool.h"
 #include "roc_pipeline/receiver.h"
@@ -33,6 +35,8 @@ roc::packet::Address& get_address(roc_address* address);
 
 bool make_context_config(roc_context_config& out, const roc_context_config& in);
 
+bool make_format(roc::rtp::Format& out, const roc_format& in);
+
 bool make_sender_config(roc::pipeline::SenderConfig& out, const roc_sender_config& in);
 bool make_receiver_config(roc::pipeline::ReceiverConfig& out,
                           const roc_receiver_config& in);
@@ -53,6 +57,10 @@ struct roc_context {
 
     roc::netio::Transceiver trx;
 
+    roc::fec::EncoderWorker fec_worker;
+
+    roc::rtp::FormatMap format_map;
+
     roc::core::Atomic counter;
 };
 
@@ -61,16 +69,17 @@ struct roc_sender {
 
     roc_context& context;
 
-    roc::rtp::FormatMap format_map;
-
     roc::pipeline::SenderConfig config;
 
     roc::pipeline::PortConfig source_port;
     roc::pipeline::PortConfig repair_port;
+    roc::pipeline::PortConfig control_port;
 
     roc::core::UniquePtr<roc::pipeline::Sender> sender;
     roc::packet::IWriter* writer;
 
+    roc::packet::ConcurrentQueue control_queue;
+
     roc::packet::Address address;
 
     roc::core::Mutex mutex;
@@ -83,7 +92,6 @@ struct roc_receiver {
 
     roc_context& context;
 
-    roc::rtp::FormatMap format_map;
     roc::pipeline::Receiver receiver;
 
     size_t num_channels;
@@ -28,7 +28,7 @@ void receiver_close_port(void* arg, const pipeline::PortConfig& port) {
 roc_receiver::roc_receiver(roc_context& ctx, pipeline::ReceiverConfig& cfg)
     : context(ctx)
     , receiver(cfg,
-               format_map,
+               context.format_map,
                context.packet_pool,
                context.byte_buffer_pool,
                context.sample_buffer_pool,
@@ -94,9 +94,19 @@ int roc_receiver_bind(roc_receiver* receiver,
         return -1;
     }
 
-    if (!receiver->context.trx.add_udp_receiver(addr, receiver->receiver)) {
-        roc_log(LogError, "roc_receiver_bind: bind failed");
-        return -1;
+    packet::IWriter* control_writer = NULL;
+
+    if (type == ROC_PORT_CONTROL) {
+        control_writer = receiver->context.trx.add_udp_sender(addr, receiver->receiver);
+        if (!control_writer) {
+            roc_log(LogError, "roc_receiver_bind: bind failed");
+            return -1;
+        }
+    } else {
+        if (!receiver->context.trx.add_udp_receiver(addr, receiver->receiver)) {
+            roc_log(LogError, "roc_receiver_bind: bind failed");
+            return -1;
+        }
     }
 
     pipeline::PortConfig port_config;
@@ -105,7 +115,11 @@ int roc_receiver_bind(roc_receiver* receiver,
         return -1;
     }
 
-    if (!receiver->receiver.add_port(port_config)) {
+    const bool added = control_writer
+        ? receiver->receiver.add_port(port_config, *control_writer)
+        : receiver->receiver.add_port(port_config);
+
+    if (!added) {
         roc_log(LogError, "roc_receiver_bind: can't add pipeline port");
         return -1;
     }
@@ -153,6 +167,33 @@ int roc_receiver_read(roc_receiver* receiver, roc_frame* frame) {
     return 0;
 }
 
+int roc_receiver_get_stats(roc_receiver* receiver, roc_receiver_stats* stats) {
+    if (!receiver) {
+        roc_log(LogError, "roc_receiver_get_stats: invalid arguments: receiver is null");
+        return -1;
+    }
+
+    if (!stats) {
+        roc_log(LogError, "roc_receiver_get_stats: invalid arguments: stats is null");
+        return -1;
+    }
+
+    const pipeline::ReceiverStats private_stats = receiver->receiver.stats();
+
+    stats->num_sessions = (unsigned long)private_stats.num_sessions;
+    stats->jitter = (unsigned long long)private_stats.jitter;
+    stats->fraction_lost = private_stats.fraction_lost;
+    stats->cumulative_lost = (long long)private_stats.cumulative_lost;
+    stats->e2e_latency = (long long)private_stats.e2e_latency;
+    stats->e2e_latency_p50 = (long long)private_stats.e2e_latency_p50;
+    stats->e2e_latency_p95 = (long long)private_stats.e2e_latency_p95;
+    stats->e2e_latency_p99 = (long long)private_stats.e2e_latency_p99;
+    stats->num_dropped_source = (unsigned long long)private_stats.num_dropped_source;
+    stats->num_dropped_repair = (unsigned long long)private_stats.num_dropped_repair;
+
+    return 0;
+}
+
 int roc_receiver_close(roc_receiver* receiver) {
     if (!receiver) {
         roc_log(LogError, "roc_receiver_close: invalid arguments: receiver is null");
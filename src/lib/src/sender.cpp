@@ -16,13 +16,17 @@ using namespace roc;
 
 namespace {
 
+// Maximum number of received control packets waiting for the next write.
+enum { MaxControlPackets = 32 };
+
 bool sender_init_pipeline(roc_sender* sender) {
     sender->sender.reset(
         new (sender->context.allocator) pipeline::Sender(
             sender->config, sender->source_port, *sender->writer, sender->repair_port,
-            *sender->writer, sender->format_map, sender->context.packet_pool,
-            sender->context.byte_buffer_pool, sender->context.sample_buffer_pool,
-            sender->context.allocator),
+            *sender->writer, sender->control_port, *sender->writer,
+            &sender->context.fec_worker, sender->context.format_map,
+            sender->context.packet_pool, sender->context.byte_buffer_pool,
+            sender->context.sample_buffer_pool, sender->context.allocator),
         sender->context.allocator);
 
     if (!sender->sender) {
@@ -75,6 +79,20 @@ bool sender_set_port(roc_sender* sender,
                 pipeline::proto_to_str(port_config.protocol));
 
         return true;
+
+    case ROC_PORT_CONTROL:
+        if (sender->control_port.protocol != pipeline::Proto_None) {
+            roc_log(LogError, "roc_sender: control port is already set");
+            return false;
+        }
+
+        sender->control_port = port_config;
+
+        roc_log(LogInfo, "roc_sender: set control port to %s %s",
+                packet::address_to_str(port_config.address).c_str(),
+                pipeline::proto_to_str(port_config.protocol));
+
+        return true;
     }
 
     roc_log(LogError, "roc_sender: invalid protocol");
@@ -102,6 +120,7 @@ roc_sender::roc_sender(roc_context& ctx, pipeline::SenderConfig& cfg)
     : context(ctx)
     , config(cfg)
     , writer(NULL)
+    , control_queue(MaxControlPackets, packet::ConcurrentQueue::DropOldest)
     , num_channels(packet::num_channels(cfg.input_channels)) {
 }
 
@@ -124,6 +143,15 @@ roc_sender* roc_sender_open(roc_context* context, const roc_sender_config* confi
         return NULL;
     }
 
+    if (config->packet_payload_type != 0
+        && !context->format_map.format(config->packet_payload_type)) {
+        roc_log(LogError,
+                "roc_sender_open: invalid arguments:"
+                " no format registered for packet_payload_type=%u",
+                config->packet_payload_type);
+        return NULL;
+    }
+
     roc_sender* sender = new (context->allocator) roc_sender(*context, private_config);
     if (!sender) {
         roc_log(LogError, "roc_sender_open: can't allocate roc_sender");
@@ -164,7 +192,7 @@ int roc_sender_bind(roc_sender* sender, roc_address* address) {
         return -1;
     }
 
-    sender->writer = sender->context.trx.add_udp_sender(addr);
+    sender->writer = sender->context.trx.add_udp_sender(addr, sender->control_queue);
     if (!sender->writer) {
         roc_log(LogError, "roc_sender_bind: bind failed");
         return -1;
@@ -272,12 +300,41 @@ int roc_sender_write(roc_sender* sender, const roc_frame* frame) {
         return -1;
     }
 
+    sender->control_queue.drain(*sender->sender, 0);
+
     audio::Frame audio_frame((float*)frame->samples, frame->samples_size / sizeof(float));
     sender->sender->write(audio_frame);
 
     return 0;
 }
 
+int roc_sender_get_stats(roc_sender* sender, roc_sender_stats* stats) {
+    if (!sender) {
+        roc_log(LogError, "roc_sender_get_stats: invalid arguments: sender is null");
+        return -1;
+    }
+
+    if (!stats) {
+        roc_log(LogError, "roc_sender_get_stats: invalid arguments: stats is null");
+        return -1;
+    }
+
+    core::Mutex::Lock lock(sender->mutex);
+
+    rtcp::SenderStats private_stats;
+    if (sender->sender) {
+        private_stats = sender->sender->stats();
+    }
+
+    stats->num_reports = (unsigned long)private_stats.num_reports;
+    stats->rtt = (unsigned long long)private_stats.rtt;
+    stats->fraction_lost = private_stats.fraction_lost;
+    stats->cumulative_lost = (long)private_stats.cumulative_lost;
+    stats->jitter = (unsigned long long)private_stats.jitter;
+
+    return 0;
+}
+
 int roc_sender_close(roc_sender* sender) {
     if (!sender) {
         roc_log(LogError, "roc_sender_close: invalid arguments: sender is null");
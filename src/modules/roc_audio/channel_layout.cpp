@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/channel_layout.h"
+
+namespace roc {
+namespace audio {
+
+const char* channel_layout_to_str(ChannelLayout layout) {
+    switch (layout) {
+    case ChannelLayout_Interleaved:
+        return "interleaved";
+    case ChannelLayout_Planar:
+        return "planar";
+    }
+    return "<invalid>";
+}
+
+void deinterleave_samples(sample_t* out,
+                          size_t plane_size,
+                          const sample_t* in,
+                          size_t n_samples,
+                          size_t n_channels) {
+    if (n_channels == 1) {
+        memcpy(out, in, n_samples * sizeof(sample_t));
+        return;
+    }
+
+    if (n_channels == 2) {
+        sample_t* left = out;
+        sample_t* right = out + plane_size;
+        for (size_t i = 0; i < n_samples; i++) {
+            left[i] = in[i * 2];
+            right[i] = in[i * 2 + 1];
+        }
+        return;
+    }
+
+    for (size_t ch = 0; ch < n_channels; ch++) {
+        sample_t* plane = out + ch * plane_size;
+        for (size_t i = 0; i < n_samples; i++) {
+            plane[i] = in[i * n_channels + ch];
+        }
+    }
+}
+
+void interleave_samples(sample_t* out,
+                        const sample_t* in,
+                        size_t plane_size,
+                        size_t n_samples,
+                        size_t n_channels) {
+    if (n_channels == 1) {
+        memcpy(out, in, n_samples * sizeof(sample_t));
+        return;
+    }
+
+    if (n_channels == 2) {
+        const sample_t* left = in;
+        const sample_t* right = in + plane_size;
+        for (size_t i = 0; i < n_samples; i++) {
+            out[i * 2] = left[i];
+            out[i * 2 + 1] = right[i];
+        }
+        return;
+    }
+
+    for (size_t ch = 0; ch < n_channels; ch++) {
+        const sample_t* plane = in + ch * plane_size;
+        for (size_t i = 0; i < n_samples; i++) {
+            out[i * n_channels + ch] = plane[i];
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/channel_layout.h
+//! @brief Channel layout.
+
+#ifndef ROC_AUDIO_CHANNEL_LAYOUT_H_
+#define ROC_AUDIO_CHANNEL_LAYOUT_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Layout of samples of multiple channels in a frame.
+enum ChannelLayout {
+    //! Samples of all channels for the same time are stored together,
+    //! e.g. L R L R L R.
+    ChannelLayout_Interleaved,
+
+    //! Samples of every channel are stored in a separate contiguous plane,
+    //! e.g. L L L R R R. Frame of size N with C channels consists of C planes
+    //! of N / C samples.
+    ChannelLayout_Planar
+};
+
+//! Get string name of channel layout.
+const char* channel_layout_to_str(ChannelLayout layout);
+
+//! Convert interleaved samples to planar.
+//! @remarks
+//!  Reads @p n_samples samples per channel from @p in and writes them to
+//!  @p out, where samples of channel N start at out + N * @p plane_size.
+void deinterleave_samples(sample_t* out,
+                          size_t plane_size,
+                          const sample_t* in,
+                          size_t n_samples,
+                          size_t n_channels);
+
+//! Convert planar samples to interleaved.
+//! @remarks
+//!  Reads @p n_samples samples per channel from @p in, where samples of
+//!  channel N start at in + N * @p plane_size, and writes them to @p out.
+void interleave_samples(sample_t* out,
+                        const sample_t* in,
+                        size_t plane_size,
+                        size_t n_samples,
+                        size_t n_channels);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_CHANNEL_LAYOUT_H_
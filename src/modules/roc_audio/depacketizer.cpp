@@ -18,10 +18,22 @@ namespace {
 
 const core::nanoseconds_t LogInterval = 20 * core::Second;
 
+// Size of temporary buffer used to produce planar frames, in samples.
+enum { MaxChunkSize = 1024 };
+
 inline void write_zeros(sample_t* buf, size_t bufsz) {
     memset(buf, 0, bufsz * sizeof(sample_t));
 }
 
+inline bool is_silent(const sample_t* buf, size_t bufsz) {
+    for (size_t n = 0; n < bufsz; n++) {
+        if (buf[n] > 0 || buf[n] < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 inline void write_beep(sample_t* buf, size_t bufsz) {
     for (size_t n = 0; n < bufsz; n++) {
         buf[n] = (sample_t)std::sin(2 * M_PI / 44100 * 880 * n);
@@ -33,19 +45,26 @@ inline void write_beep(sample_t* buf, size_t bufsz) {
 Depacketizer::Depacketizer(packet::IReader& reader,
                            IDecoder& decoder,
                            packet::channel_mask_t channels,
+                           ChannelLayout layout,
                            bool beep)
     : reader_(reader)
     , decoder_(decoder)
     , channels_(channels)
     , num_channels_(packet::num_channels(channels))
+    , layout_(layout)
     , packet_pos_(0)
     , timestamp_(0)
+    , capture_rtp_ts_(0)
+    , capture_ts_(0)
     , zero_samples_(0)
     , missing_samples_(0)
+    , silent_samples_(0)
     , packet_samples_(0)
     , rate_limiter_(LogInterval)
     , first_packet_(true)
     , beep_(beep)
+    , packet_silent_(false)
+    , dtx_gap_(false)
     , dropped_packets_(0) {
 }
 
@@ -60,21 +79,37 @@ packet::timestamp_t Depacketizer::timestamp() const {
     return timestamp_;
 }
 
+bool Depacketizer::dtx() const {
+    return !packet_ && dtx_gap_;
+}
+
+bool Depacketizer::capture_timestamp(packet::timestamp_t& rtp_ts,
+                                     core::nanoseconds_t& capture_ts) const {
+    if (capture_ts_ == 0) {
+        return false;
+    }
+    rtp_ts = capture_rtp_ts_;
+    capture_ts = capture_ts_;
+    return true;
+}
+
 void Depacketizer::read(Frame& frame) {
     const size_t prev_dropped_packets = dropped_packets_;
     const packet::timestamp_t prev_packet_samples = packet_samples_;
+    const packet::timestamp_t prev_silent_samples = silent_samples_;
 
     read_frame_(frame);
 
-    set_frame_flags_(frame, prev_dropped_packets, prev_packet_samples);
+    set_frame_flags_(frame, prev_dropped_packets, prev_packet_samples,
+                     prev_silent_samples);
 
     if (rate_limiter_.allow()) {
         const size_t total_samples = missing_samples_ + packet_samples_;
         const double loss_ratio =
             total_samples != 0 ? (double)missing_samples_ / total_samples : 0.;
 
-        roc_log(LogDebug, "depacketizer: ts=%lu loss_ratio=%.5lf",
-                (unsigned long)timestamp_, loss_ratio);
+        roc_log(LogDebug, "depacketizer: ts=%lu loss_ratio=%.5lf silent_samples=%lu",
+                (unsigned long)timestamp_, loss_ratio, (unsigned long)silent_samples_);
     }
 }
 
@@ -83,9 +118,37 @@ void Depacketizer::read_frame_(Frame& frame) {
         roc_panic("depacketizer: unexpected frame size");
     }
 
-    sample_t* buff_ptr = frame.data();
-    sample_t* buff_end = frame.data() + frame.size();
+    if (layout_ == ChannelLayout_Planar) {
+        read_planar_frame_(frame);
+    } else {
+        read_interleaved_(frame.data(), frame.data() + frame.size());
+    }
+}
+
+// Decoders produce interleaved samples. To produce planar frame, we decode samples
+// into a small buffer which stays in cache, and then spread them over frame planes.
+void Depacketizer::read_planar_frame_(Frame& frame) {
+    if (num_channels_ > MaxChunkSize) {
+        roc_panic("depacketizer: too many channels");
+    }
+
+    sample_t buff[MaxChunkSize];
 
+    const size_t plane_size = frame.size() / num_channels_;
+    const size_t chunk_size = MaxChunkSize / num_channels_;
+
+    for (size_t pos = 0; pos < plane_size;) {
+        const size_t n_samples = std::min(plane_size - pos, chunk_size);
+
+        read_interleaved_(buff, buff + n_samples * num_channels_);
+        deinterleave_samples(frame.data() + pos, plane_size, buff, n_samples,
+                             num_channels_);
+
+        pos += n_samples;
+    }
+}
+
+void Depacketizer::read_interleaved_(sample_t* buff_ptr, sample_t* buff_end) {
     while (buff_ptr < buff_end) {
         buff_ptr = read_samples_(buff_ptr, buff_end);
     }
@@ -127,6 +190,10 @@ sample_t* Depacketizer::read_packet_samples_(sample_t* buff_ptr, sample_t* buff_
     const size_t num_samples =
         decoder_.read_samples(*packet_, packet_pos_, buff_ptr, max_samples, channels_);
 
+    if (packet_silent_) {
+        packet_silent_ = is_silent(buff_ptr, num_samples * num_channels_);
+    }
+
     timestamp_ += packet::timestamp_t(num_samples);
     packet_pos_ += packet::timestamp_t(num_samples);
     packet_samples_ += num_samples;
@@ -141,16 +208,22 @@ sample_t* Depacketizer::read_packet_samples_(sample_t* buff_ptr, sample_t* buff_
 sample_t* Depacketizer::read_missing_samples_(sample_t* buff_ptr, sample_t* buff_end) {
     const size_t num_samples = (size_t)(buff_end - buff_ptr) / num_channels_;
 
-    if (beep_) {
+    if (dtx_gap_) {
+        write_zeros(buff_ptr, num_samples * num_channels_);
+    } else if (beep_) {
         write_beep(buff_ptr, num_samples * num_channels_);
-    } else {
+    } else if (first_packet_) {
         write_zeros(buff_ptr, num_samples * num_channels_);
+    } else {
+        decoder_.conceal_samples(buff_ptr, num_samples, channels_);
     }
 
     timestamp_ += packet::timestamp_t(num_samples);
 
     if (first_packet_) {
         zero_samples_ += num_samples;
+    } else if (dtx_gap_) {
+        silent_samples_ += num_samples;
     } else {
         missing_samples_ += num_samples;
     }
@@ -192,10 +265,17 @@ void Depacketizer::update_packet_() {
         dropped_packets_ += n_dropped;
     }
 
+    // Gap after a silent packet is intentional silence, either until the next
+    // packet, or until the end of the stream. During silence, DTX sender sends
+    // only the first silent packet and rare keep-alives.
+    dtx_gap_ = packet_silent_;
+
     if (!packet_) {
         return;
     }
 
+    packet_silent_ = true;
+
     if (first_packet_) {
         roc_log(LogDebug, "depacketizer: got first packet: zero_samples=%lu",
                 (unsigned long)zero_samples_);
@@ -204,6 +284,11 @@ void Depacketizer::update_packet_() {
         first_packet_ = false;
     }
 
+    if (packet_->rtp()->capture_timestamp != 0) {
+        capture_rtp_ts_ = pkt_timestamp;
+        capture_ts_ = packet_->rtp()->capture_timestamp;
+    }
+
     if (packet::timestamp_lt(pkt_timestamp, timestamp_)) {
         packet_pos_ =
             (packet::timestamp_t)packet::timestamp_diff(timestamp_, pkt_timestamp);
@@ -227,13 +312,19 @@ packet::PacketPtr Depacketizer::read_packet_() {
 
 void Depacketizer::set_frame_flags_(Frame& frame,
                                     const size_t prev_dropped_packets,
-                                    const packet::timestamp_t prev_packet_samples) {
+                                    const packet::timestamp_t prev_packet_samples,
+                                    const packet::timestamp_t prev_silent_samples) {
     const size_t packet_samples = num_channels_
         * (size_t)packet::timestamp_diff(packet_samples_, prev_packet_samples);
 
+    const size_t silent_samples = num_channels_
+        * (size_t)packet::timestamp_diff(silent_samples_, prev_silent_samples);
+
     unsigned flags = 0;
 
-    if (packet_samples != frame.size()) {
+    // Intentional silence in DTX gap is not missing data, otherwise watchdog
+    // would consider playback broken during long silence.
+    if (packet_samples + silent_samples != frame.size()) {
         flags |= Frame::FlagIncomplete;
     }
 
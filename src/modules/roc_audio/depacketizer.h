@@ -12,11 +12,13 @@
 #ifndef ROC_AUDIO_DEPACKETIZER_H_
 #define ROC_AUDIO_DEPACKETIZER_H_
 
+#include "roc_audio/channel_layout.h"
 #include "roc_audio/idecoder.h"
 #include "roc_audio/ireader.h"
 #include "roc_audio/units.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/rate_limiter.h"
+#include "roc_core/time.h"
 #include "roc_packet/ireader.h"
 
 namespace roc {
@@ -34,10 +36,12 @@ public:
     //!  - @p reader is used to read packets
     //!  - @p decoder is used to extract samples from packets
     //!  - @p channels defines a set of channels in the output frames
+    //!  - @p layout defines layout of channels in the output frames
     //!  - @p beep enables weird beeps instead of silence on packet loss
     Depacketizer(packet::IReader& reader,
                  IDecoder& decoder,
                  packet::channel_mask_t channels,
+                 ChannelLayout layout,
                  bool beep);
 
     //! Read audio frame.
@@ -51,8 +55,29 @@ public:
     //!  started() should return true
     packet::timestamp_t timestamp() const;
 
+    //! Is depacketizer in discontinuous transmission (DTX) gap?
+    //! @remarks
+    //!  Returns true if there are no more packets and the last packet read
+    //!  from the reader contained only zero samples, which means that the
+    //!  sender probably stopped sending packets because of silence. Samples
+    //!  missing after such packet are filled with zeros and are not considered
+    //!  lost.
+    bool dtx() const;
+
+    //! Get capture timestamp of the last packet that had one.
+    //! @remarks
+    //!  Sets @p capture_ts to the Unix time in nanoseconds when the first
+    //!  sample of the packet was captured at the sender, and @p rtp_ts to
+    //!  the RTP timestamp of that sample.
+    //! @returns
+    //!  false if there were no packets with capture timestamps.
+    bool capture_timestamp(packet::timestamp_t& rtp_ts,
+                           core::nanoseconds_t& capture_ts) const;
+
 private:
     void read_frame_(Frame& frame);
+    void read_planar_frame_(Frame& frame);
+    void read_interleaved_(sample_t* buff_ptr, sample_t* buff_end);
 
     sample_t* read_samples_(sample_t* buff_ptr, sample_t* buff_end);
 
@@ -61,7 +86,8 @@ private:
 
     void set_frame_flags_(Frame& frame,
                           size_t prev_dropped_packets,
-                          packet::timestamp_t prev_packet_samples);
+                          packet::timestamp_t prev_packet_samples,
+                          packet::timestamp_t prev_silent_samples);
 
     void update_packet_();
     packet::PacketPtr read_packet_();
@@ -71,14 +97,19 @@ private:
 
     const packet::channel_mask_t channels_;
     const size_t num_channels_;
+    const ChannelLayout layout_;
 
     packet::PacketPtr packet_;
     packet::timestamp_t packet_pos_;
 
     packet::timestamp_t timestamp_;
 
+    packet::timestamp_t capture_rtp_ts_;
+    core::nanoseconds_t capture_ts_;
+
     packet::timestamp_t zero_samples_;
     packet::timestamp_t missing_samples_;
+    packet::timestamp_t silent_samples_;
     packet::timestamp_t packet_samples_;
 
     core::RateLimiter rate_limiter_;
@@ -86,6 +117,9 @@ private:
     bool first_packet_;
     bool beep_;
 
+    bool packet_silent_;
+    bool dtx_gap_;
+
     size_t dropped_packets_;
 };
 
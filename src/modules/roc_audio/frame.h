@@ -32,6 +32,7 @@ public:
         FlagBlank = (1 << 0),
 
         //! Set if the frame is partially filled with zeros instead of data from packets.
+        //! Zeros of intentional silence (DTX gap) are not counted.
         FlagIncomplete = (1 << 1),
 
         //! Set if some late packets were dropped while the frame was being built.
@@ -35,11 +35,16 @@ public:
     //! Compute new value of frequency coefficient.
     void update(packet::timestamp_t current_latency);
 
+    //! Change target latency.
+    //! @remarks
+    //!  Subsequent updates will drive the latency to the new target.
+    void set_target_latency(packet::timestamp_t target_latency);
+
 private:
     bool run_decimators_(packet::timestamp_t current, float& filtered);
     float run_controller_(float current);
 
-    const float target_; // Target latency.
+    float target_; // Target latency.
 
     float dec1_casc_buff_[fe_decim_len];
     size_t dec1_ind_;
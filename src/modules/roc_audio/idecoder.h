@@ -48,6 +48,20 @@ public:
                                 sample_t* samples,
                                 size_t n_samples,
                                 packet::channel_mask_t channels) = 0;
+
+    //! Generate samples for lost packets.
+    //!
+    //! @b Parameters
+    //!  - @p samples - output buffer
+    //!  - @p n_samples - number of samples in output buffer
+    //!  - @p channels - output buffer channel mask
+    //!
+    //! Called instead of read_samples() when packets for a part of the stream are
+    //! missing. Decoders with packet loss concealment extrapolate previously
+    //! decoded samples, other decoders write zeros.
+    virtual void conceal_samples(sample_t* samples,
+                                 size_t n_samples,
+                                 packet::channel_mask_t channels) = 0;
 };
 
 } // namespace audio
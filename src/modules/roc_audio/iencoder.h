@@ -28,6 +28,12 @@ public:
     //! Get packet payload size for given number of samples.
     virtual size_t payload_size(size_t num_samples) const = 0;
 
+    //! Get maximum number of samples per channel that fit into payload.
+    //! @remarks
+    //!  Returns the largest number of samples for which payload_size() doesn't
+    //!  exceed @p payload_size, or zero if no samples fit.
+    virtual size_t payload_samples(size_t payload_size) const = 0;
+
     //! Write samples to packet.
     //!
     //! @b Parameters
@@ -52,6 +58,19 @@ public:
                                  const sample_t* samples,
                                  size_t n_samples,
                                  packet::channel_mask_t channels) = 0;
+
+    //! Finish writing samples to packet.
+    //!
+    //! @b Parameters
+    //!  - @p packet - packet to finish
+    //!  - @p n_samples - total number of samples written to @p packet
+    //!
+    //! Called after the last write_samples() call for @p packet, when its payload
+    //! is already truncated to payload_size(n_samples). Encoders that compress
+    //! the whole packet at once, perform actual encoding here.
+    //!
+    //! @returns false if the packet can't be encoded and should be dropped.
+    virtual bool finish(packet::Packet& packet, size_t n_samples) = 0;
 };
 
 } // namespace audio
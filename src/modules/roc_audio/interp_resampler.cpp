@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/interp_resampler.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// One in terms of Q0.32 fraction.
+const double FracOne = 4294967296.0;
+
+// Number of input samples before the current one used by interpolation.
+const size_t LeftReach = 1;
+
+// Maximum supported resampling factor.
+const float MaxScaling = 65536;
+
+// Converts Q0.32 fraction to float.
+inline sample_t frac_to_sample(uint32_t frac) {
+    return (sample_t)frac * (1.0f / 4294967296.0f);
+}
+
+} // namespace
+
+InterpResampler::InterpResampler(core::IAllocator& allocator,
+                                 const ResamplerConfig& config,
+                                 packet::channel_mask_t channels,
+                                 ChannelLayout layout,
+                                 size_t frame_size)
+    : backend_(config.backend)
+    , channels_num_(packet::num_channels(channels))
+    , layout_(layout)
+    , frame_size_(frame_size)
+    , frame_size_ch_(channels_num_ ? frame_size / channels_num_ : 0)
+    , right_reach_(config.backend == ResamplerBackend_Cubic ? 2 : 1)
+    , history_(allocator, channels_num_, layout)
+    , out_frame_pos_(0)
+    , scaling_(1.0f)
+    , index_(LeftReach)
+    , frac_(0)
+    , step_index_(1)
+    , step_frac_(0)
+    , valid_(false) {
+    if (backend_ != ResamplerBackend_Linear && backend_ != ResamplerBackend_Cubic) {
+        roc_log(LogError, "interp resampler: unsupported backend: backend=%s",
+                resampler_backend_to_str(backend_));
+        return;
+    }
+
+    if (channels_num_ < 1) {
+        roc_log(LogError, "interp resampler: invalid num_channels: num_channels=%lu",
+                (unsigned long)channels_num_);
+        return;
+    }
+
+    if (frame_size_ != frame_size_ch_ * channels_num_) {
+        roc_log(LogError,
+                "interp resampler: frame_size is not multiple of num_channels:"
+                " frame_size=%lu num_channels=%lu",
+                (unsigned long)frame_size_, (unsigned long)channels_num_);
+        return;
+    }
+
+    if (!history_.reserve(LeftReach + right_reach_ + frame_size_ch_)) {
+        return;
+    }
+
+    // first output sample corresponds to the first input sample, and there
+    // is nothing before it
+    history_.prepend_zeros(LeftReach);
+
+    roc_log(LogDebug,
+            "interp resampler: initializing: "
+            "backend=%s frame_size=%lu channels_num=%lu layout=%s",
+            resampler_backend_to_str(backend_), (unsigned long)frame_size_,
+            (unsigned long)channels_num_, channel_layout_to_str(layout_));
+
+    valid_ = true;
+}
+
+bool InterpResampler::valid() const {
+    return valid_;
+}
+
+bool InterpResampler::set_scaling(float new_scaling) {
+    if (!(new_scaling > 0) || new_scaling >= MaxScaling) {
+        roc_log(LogError, "interp resampler: scaling is out of range: scaling=%.5f",
+                (double)new_scaling);
+        return false;
+    }
+
+    const double step = (double)new_scaling;
+    const double step_frac = (step - (double)(size_t)step) * FracOne + 0.5;
+
+    step_index_ = (size_t)step;
+    step_frac_ = step_frac < FracOne ? (uint32_t)step_frac : (uint32_t)-1;
+
+    scaling_ = new_scaling;
+
+    return true;
+}
+
+bool InterpResampler::resample_buff(Frame& out) {
+    roc_panic_if_not(valid());
+
+    const size_t out_stride = output_stride_(out);
+
+    for (; out_frame_pos_ < out.size(); out_frame_pos_ += channels_num_) {
+        if (index_ + right_reach_ >= history_.size()) {
+            return false;
+        }
+
+        sample_t* out_data = out.data() + output_offset_(out_frame_pos_);
+
+        if (backend_ == ResamplerBackend_Linear) {
+            resample_linear_(out_data, out_stride);
+        } else {
+            resample_cubic_(out_data, out_stride);
+        }
+
+        frac_ += step_frac_;
+        index_ += step_index_ + (frac_ < step_frac_ ? 1 : 0);
+    }
+    out_frame_pos_ = 0;
+    return true;
+}
+
+void InterpResampler::push_input(const Frame& in) {
+    roc_panic_if_not(valid());
+
+    roc_panic_if(in.size() > frame_size_);
+
+    // drop samples which are before the interpolation window
+    if (index_ > LeftReach) {
+        const size_t n_remove = std::min(index_ - LeftReach, history_.size());
+
+        history_.remove(n_remove);
+        index_ -= n_remove;
+    }
+
+    history_.append(in.data(), in.size());
+}
+
+// Linear interpolation between x0 and x1.
+void InterpResampler::resample_linear_(sample_t* out, size_t out_stride) {
+    const sample_t* x0 = history_.data(index_);
+    const sample_t* x1 = history_.data(index_ + 1);
+
+    const sample_t f = frac_to_sample(frac_);
+
+    for (size_t ch = 0; ch < channels_num_; ch++) {
+        const size_t off = ch * history_.channel_stride();
+
+        out[ch * out_stride] = x0[off] + f * (x1[off] - x0[off]);
+    }
+}
+
+// Catmull-Rom spline between x0 and x1, i.e. cubic Hermite spline with
+// tangents estimated from xm1 and x2.
+void InterpResampler::resample_cubic_(sample_t* out, size_t out_stride) {
+    const sample_t* xm1 = history_.data(index_ - 1);
+    const sample_t* x0 = history_.data(index_);
+    const sample_t* x1 = history_.data(index_ + 1);
+    const sample_t* x2 = history_.data(index_ + 2);
+
+    const sample_t f = frac_to_sample(frac_);
+
+    for (size_t ch = 0; ch < channels_num_; ch++) {
+        const size_t off = ch * history_.channel_stride();
+
+        const sample_t c1 = 0.5f * (x1[off] - xm1[off]);
+        const sample_t c2 =
+            xm1[off] - 2.5f * x0[off] + 2.0f * x1[off] - 0.5f * x2[off];
+        const sample_t c3 = 0.5f * (x2[off] - xm1[off]) + 1.5f * (x0[off] - x1[off]);
+
+        out[ch * out_stride] = ((c3 * f + c2) * f + c1) * f + x0[off];
+    }
+}
+
+// Returns distance between samples of adjacent channels in output frame.
+size_t InterpResampler::output_stride_(const Frame& out) const {
+    return layout_ == ChannelLayout_Planar ? out.size() / channels_num_ : 1;
+}
+
+// Returns offset of the first channel sample in output frame, given offset of
+// this sample in interleaved frame.
+size_t InterpResampler::output_offset_(size_t pos) const {
+    return layout_ == ChannelLayout_Planar ? pos / channels_num_ : pos;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/interp_resampler.h
+//! @brief Interpolating resampler.
+
+#ifndef ROC_AUDIO_INTERP_RESAMPLER_H_
+#define ROC_AUDIO_INTERP_RESAMPLER_H_
+
+#include "roc_audio/channel_layout.h"
+#include "roc_audio/frame.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_config.h"
+#include "roc_audio/resampler_history.h"
+#include "roc_audio/units.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Resamples audio stream using polynomial interpolation.
+//! @remarks
+//!  Implements ResamplerBackend_Linear and ResamplerBackend_Cubic. Computes
+//!  every output sample from two or four nearest input samples of the same
+//!  channel, without low-pass filtering. Much cheaper than SincResampler,
+//!  but introduces aliasing and attenuates high frequencies, so it's intended
+//!  for resampling factors close to 1.
+class InterpResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Input and output frames should have the given channels and layout.
+    //!  Input frames should have at most @p frame_size samples.
+    InterpResampler(core::IAllocator& allocator,
+                    const ResamplerConfig& config,
+                    packet::channel_mask_t channels,
+                    ChannelLayout layout,
+                    size_t frame_size);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Set new resample factor.
+    virtual bool set_scaling(float);
+
+    //! Resamples the whole output frame.
+    virtual bool resample_buff(Frame& out);
+
+    //! Push input samples.
+    virtual void push_input(const Frame& in);
+
+private:
+    void resample_linear_(sample_t* out, size_t out_stride);
+    void resample_cubic_(sample_t* out, size_t out_stride);
+
+    size_t output_stride_(const Frame& out) const;
+    size_t output_offset_(size_t pos) const;
+
+    const ResamplerBackend backend_;
+
+    const size_t channels_num_;
+    const ChannelLayout layout_;
+
+    const size_t frame_size_;
+    const size_t frame_size_ch_;
+
+    // number of input samples after the current one used by interpolation
+    const size_t right_reach_;
+
+    // recent input samples
+    ResamplerHistory history_;
+
+    size_t out_frame_pos_;
+
+    float scaling_;
+
+    // time position of output sample: index of input sample in history_
+    // and fraction between it and the next one in Q0.32
+    size_t index_;
+    uint32_t frac_;
+
+    // time distance between two output samples
+    size_t step_index_;
+    uint32_t step_frac_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_INTERP_RESAMPLER_H_
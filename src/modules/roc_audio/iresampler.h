@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/iresampler.h
+//! @brief Resampler interface.
+
+#ifndef ROC_AUDIO_IRESAMPLER_H_
+#define ROC_AUDIO_IRESAMPLER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Resampler interface.
+//! @remarks
+//!  Resampler consumes input samples pushed by push_input() and produces
+//!  output samples by resample_buff(). It keeps only as many recent input
+//!  samples as needed by its filter, so input may be pushed in chunks of
+//!  any size, and output is produced as soon as enough input is available.
+//!  Input and output samples should have the channels and layout which
+//!  were passed to the resampler.
+class IResampler {
+public:
+    virtual ~IResampler();
+
+    //! Set new resample factor.
+    //! @returns
+    //!  false if the factor is not supported.
+    virtual bool set_scaling(float scaling) = 0;
+
+    //! Resamples the whole output frame.
+    //! @returns
+    //!  false if more input is needed; in this case push_input() should be
+    //!  called and then resample_buff() should be called again with the same
+    //!  frame to fill its remaining part.
+    virtual bool resample_buff(Frame& out) = 0;
+
+    //! Push input samples.
+    //! @pre
+    //!  Frame size should not exceed the maximum input size passed to the
+    //!  resampler. Should be called only after resample_buff() returned false,
+    //!  or before the first resample_buff() call.
+    virtual void push_input(const Frame& in) = 0;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_IRESAMPLER_H_
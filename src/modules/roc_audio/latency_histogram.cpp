@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/latency_histogram.h"
+#include "roc_core/panic.h"
+
+#include <math.h>
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Lower bound of the second bucket.
+const double MinLatency = 100 * core::Microsecond;
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+    : size_(0) {
+    memset(buckets_, 0, sizeof(buckets_));
+}
+
+void LatencyHistogram::add(core::nanoseconds_t latency) {
+    size_t index = 0;
+
+    if (latency > MinLatency) {
+        const double pos = log((double)latency / MinLatency) / log(2.0) * BucketsPerOctave;
+
+        index = pos < NumBuckets - 1 ? (size_t)pos + 1 : NumBuckets - 1;
+    }
+
+    buckets_[index]++;
+    size_++;
+
+    if (size_ >= MaxMeasurements) {
+        size_ = 0;
+        for (size_t n = 0; n < NumBuckets; n++) {
+            buckets_[n] /= 2;
+            size_ += buckets_[n];
+        }
+    }
+}
+
+size_t LatencyHistogram::size() const {
+    return size_;
+}
+
+core::nanoseconds_t LatencyHistogram::percentile(double p) const {
+    roc_panic_if(p < 0 || p > 1);
+
+    if (size_ == 0) {
+        return 0;
+    }
+
+    size_t rank = (size_t)ceil(p * size_);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    size_t index = 0;
+    size_t count = 0;
+
+    for (; index < NumBuckets - 1; index++) {
+        count += buckets_[index];
+        if (count >= rank) {
+            break;
+        }
+    }
+
+    if (index == 0) {
+        return (core::nanoseconds_t)MinLatency;
+    }
+
+    // Geometric middle of the bucket.
+    return (core::nanoseconds_t)(MinLatency
+                                 * pow(2.0, (index - 0.5) / BucketsPerOctave));
+}
+
+} // namespace audio
+} // namespace roc
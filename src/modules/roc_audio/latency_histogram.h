@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/latency_histogram.h
+//! @brief Latency histogram.
+
+#ifndef ROC_AUDIO_LATENCY_HISTOGRAM_H_
+#define ROC_AUDIO_LATENCY_HISTOGRAM_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace audio {
+
+//! Latency histogram.
+//! @remarks
+//!  Collects latency measurements into logarithmic buckets and estimates
+//!  percentiles. Every octave is split into eight buckets, so the relative
+//!  error of a percentile is below 5%. Buckets cover the range from 100us
+//!  to about 6s; values outside of the range go to the first or the last
+//!  bucket. To follow latency changes, old measurements are gradually
+//!  forgotten: when the number of measurements reaches a limit, all
+//!  counters are halved.
+class LatencyHistogram : public core::NonCopyable<> {
+public:
+    //! Initialize empty histogram.
+    LatencyHistogram();
+
+    //! Add measurement.
+    void add(core::nanoseconds_t latency);
+
+    //! Get number of measurements.
+    size_t size() const;
+
+    //! Get percentile.
+    //! @remarks
+    //!  @p p should be in range [0; 1], e.g. 0.5 for median.
+    //! @returns
+    //!  estimated latency, or zero if the histogram is empty.
+    core::nanoseconds_t percentile(double p) const;
+
+private:
+    enum {
+        BucketsPerOctave = 8,
+        NumBuckets = 128,
+        MaxMeasurements = 8192
+    };
+
+    size_t buckets_[NumBuckets];
+    size_t size_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_LATENCY_HISTOGRAM_H_
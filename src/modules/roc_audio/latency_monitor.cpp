@@ -22,6 +22,7 @@ const core::nanoseconds_t LogInterval = 5 * core::Second;
 LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
                                const Depacketizer& depacketizer,
                                ResamplerReader* resampler,
+                               const LatencyTuner* tuner,
                                const LatencyMonitorConfig& config,
                                core::nanoseconds_t target_latency,
                                size_t input_sample_rate,
@@ -29,6 +30,7 @@ LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
     : queue_(queue)
     , depacketizer_(depacketizer)
     , resampler_(resampler)
+    , tuner_(tuner)
     , fe_((packet::timestamp_t)packet::timestamp_from_ns(target_latency,
                                                          input_sample_rate))
     , rate_limiter_(LogInterval)
@@ -38,6 +40,7 @@ LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
     , has_update_pos_(false)
     , target_latency_((packet::timestamp_t)packet::timestamp_from_ns(target_latency,
                                                                      input_sample_rate))
+    , max_target_step_(0)
     , min_latency_(packet::timestamp_from_ns(config.min_latency, input_sample_rate))
     , max_latency_(packet::timestamp_from_ns(config.max_latency, input_sample_rate))
     , max_scaling_delta_(config.max_scaling_delta)
@@ -63,6 +66,12 @@ LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
         return;
     }
 
+    if (tuner_ && !resampler_) {
+        roc_log(LogError,
+                "latency monitor: latency tuning requires resampling to be enabled");
+        return;
+    }
+
     if (resampler_) {
         if (!init_resampler_(input_sample_rate, output_sample_rate)) {
             return;
@@ -77,6 +86,14 @@ LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
         }
     }
 
+    if (tuner_) {
+        max_target_step_ =
+            (packet::timestamp_t)(update_interval_ * max_scaling_delta_ / 2);
+        if (max_target_step_ == 0) {
+            max_target_step_ = 1;
+        }
+    }
+
     valid_ = true;
 }
 
@@ -114,6 +131,12 @@ bool LatencyMonitor::get_latency_(packet::timestamp_diff_t& latency) const {
         return false;
     }
 
+    // Sender doesn't send packets during silence, so the queue doesn't
+    // reflect the actual latency.
+    if (depacketizer_.dtx()) {
+        return false;
+    }
+
     const packet::timestamp_t head = depacketizer_.timestamp();
 
     packet::PacketPtr latest = queue_.latest();
@@ -185,6 +208,9 @@ bool LatencyMonitor::update_resampler_(packet::timestamp_t pos,
     }
 
     while (pos >= update_pos_) {
+        if (tuner_) {
+            update_target_();
+        }
         fe_.update(latency);
         update_pos_ += update_interval_;
     }
@@ -194,11 +220,22 @@ bool LatencyMonitor::update_resampler_(packet::timestamp_t pos,
     const float adjusted_coeff = sample_rate_coeff_ * trimmed_coeff;
 
     if (rate_limiter_.allow()) {
-        roc_log(
-            LogDebug,
-            "latency monitor: latency=%lu target=%lu fe=%.5f trim_fe=%.5f adj_fe=%.5f",
-            (unsigned long)latency, (unsigned long)target_latency_, (double)freq_coeff,
-            (double)trimmed_coeff, (double)adjusted_coeff);
+        if (tuner_) {
+            roc_log(LogDebug,
+                    "latency monitor: latency=%lu target=%lu tuner_target=%lu"
+                    " jitter=%.1f peak_delay=%lu loss_ratio=%.3f"
+                    " fe=%.5f trim_fe=%.5f adj_fe=%.5f",
+                    (unsigned long)latency, (unsigned long)target_latency_,
+                    (unsigned long)tuner_->target_latency(), (double)tuner_->jitter(),
+                    (unsigned long)tuner_->peak_delay(), (double)tuner_->loss_ratio(),
+                    (double)freq_coeff, (double)trimmed_coeff, (double)adjusted_coeff);
+        } else {
+            roc_log(LogDebug,
+                    "latency monitor: latency=%lu target=%lu"
+                    " fe=%.5f trim_fe=%.5f adj_fe=%.5f",
+                    (unsigned long)latency, (unsigned long)target_latency_,
+                    (double)freq_coeff, (double)trimmed_coeff, (double)adjusted_coeff);
+        }
     }
 
     if (!resampler_->set_scaling(adjusted_coeff)) {
@@ -211,6 +248,30 @@ bool LatencyMonitor::update_resampler_(packet::timestamp_t pos,
     return true;
 }
 
+void LatencyMonitor::update_target_() {
+    const packet::timestamp_t new_target = tuner_->target_latency();
+
+    // Move the target gradually, not faster than the resampler is able to
+    // compensate, so that the playback is smoothly sped up or slowed down.
+    if (new_target > target_latency_) {
+        if (new_target - target_latency_ > max_target_step_) {
+            target_latency_ += max_target_step_;
+        } else {
+            target_latency_ = new_target;
+        }
+    } else if (new_target < target_latency_) {
+        if (target_latency_ - new_target > max_target_step_) {
+            target_latency_ -= max_target_step_;
+        } else {
+            target_latency_ = new_target;
+        }
+    } else {
+        return;
+    }
+
+    fe_.set_target_latency(target_latency_);
+}
+
 void LatencyMonitor::report_latency_(packet::timestamp_t latency) {
     if (rate_limiter_.allow()) {
         roc_log(LogDebug, "latency monitor: latency=%lu target=%lu",
@@ -14,6 +14,7 @@
 
 #include "roc_audio/depacketizer.h"
 #include "roc_audio/freq_estimator.h"
+#include "roc_audio/latency_tuner.h"
 #include "roc_audio/resampler_reader.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/rate_limiter.h"
@@ -56,6 +57,7 @@ struct LatencyMonitorConfig {
 //!  - calculates session scaling factor
 //!  - trims scaling factor to the allowed range
 //!  - updates resampler scaling
+//!  - moves target latency towards the one suggested by latency tuner
 //!  - shutdowns session if the latency goes out of bounds
 class LatencyMonitor : public core::NonCopyable<> {
 public:
@@ -64,6 +66,8 @@ public:
     //! @b Parameters
     //!  - @p queue and @p depacketizer are used to calculate the latency
     //!  - @p resampler is used to set the scaling factor, may be null
+    //!  - @p tuner is used to adjust the target latency, may be null; requires
+    //!    @p resampler to be non-null
     //!  - @p config defines various miscellaneous parameters
     //!  - @p target_latency defines FreqEstimator target latency, in samples
     //!  - @p input_sample_rate is the sample rate of the input packets
@@ -71,6 +75,7 @@ public:
     LatencyMonitor(const packet::SortedQueue& queue,
                    const Depacketizer& depacketizer,
                    ResamplerReader* resampler,
+                   const LatencyTuner* tuner,
                    const LatencyMonitorConfig& config,
                    core::nanoseconds_t target_latency,
                    size_t input_sample_rate,
@@ -92,12 +97,14 @@ private:
 
     bool init_resampler_(size_t input_sample_rate, size_t output_sample_rate);
     bool update_resampler_(packet::timestamp_t time, packet::timestamp_t latency);
+    void update_target_();
 
     void report_latency_(packet::timestamp_t latency);
 
     const packet::SortedQueue& queue_;
     const Depacketizer& depacketizer_;
     ResamplerReader* resampler_;
+    const LatencyTuner* tuner_;
     FreqEstimator fe_;
 
     core::RateLimiter rate_limiter_;
@@ -106,7 +113,8 @@ private:
     packet::timestamp_t update_pos_;
     bool has_update_pos_;
 
-    const packet::timestamp_t target_latency_;
+    packet::timestamp_t target_latency_;
+    packet::timestamp_t max_target_step_;
     const packet::timestamp_diff_t min_latency_;
     const packet::timestamp_diff_t max_latency_;
 
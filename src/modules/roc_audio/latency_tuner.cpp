@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/latency_tuner.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Jitter estimator gain, see RFC 3550, section 6.4.1.
+const double JitterGain = 1.0 / 16;
+
+} // namespace
+
+LatencyTuner::LatencyTuner(const LatencyTunerConfig& config,
+                           core::nanoseconds_t initial_latency,
+                           size_t sample_rate)
+    : sample_rate_(sample_rate)
+    , window_((double)packet::timestamp_from_ns(config.window, sample_rate))
+    , jitter_factor_(config.jitter_factor)
+    , delay_factor_(config.delay_factor)
+    , min_target_((packet::timestamp_t)packet::timestamp_from_ns(
+          config.min_target_latency, sample_rate))
+    , max_target_((packet::timestamp_t)packet::timestamp_from_ns(
+          config.max_target_latency, sample_rate))
+    , initial_target_(0)
+    , started_(false)
+    , ready_(false)
+    , first_ts_(0)
+    , window_start_(0)
+    , last_rtp_ts_(0)
+    , last_rtp_ext_ts_(0)
+    , last_transit_(0)
+    , jitter_(0)
+    , cur_min_transit_(0)
+    , prev_min_transit_(0)
+    , cur_peak_delay_(0)
+    , prev_peak_delay_(0)
+    , last_seqnum_(0)
+    , last_seqnum_ext_(0)
+    , window_first_seqnum_(0)
+    , window_received_(0)
+    , loss_ratio_(0)
+    , valid_(false) {
+    roc_log(LogDebug,
+            "latency tuner: initializing:"
+            " min_target=%lu max_target=%lu window=%lu rate=%lu",
+            (unsigned long)min_target_, (unsigned long)max_target_,
+            (unsigned long)window_, (unsigned long)sample_rate);
+
+    if (sample_rate == 0 || config.window <= 0 || config.min_target_latency <= 0
+        || config.max_target_latency < config.min_target_latency) {
+        roc_log(LogError,
+                "latency tuner: invalid config:"
+                " min_target_latency=%ld max_target_latency=%ld window=%ld rate=%lu",
+                (long)config.min_target_latency, (long)config.max_target_latency,
+                (long)config.window, (unsigned long)sample_rate);
+        return;
+    }
+
+    if (jitter_factor_ < 0 || delay_factor_ < 0) {
+        roc_log(LogError,
+                "latency tuner: invalid config: jitter_factor=%.3f delay_factor=%.3f",
+                (double)jitter_factor_, (double)delay_factor_);
+        return;
+    }
+
+    initial_target_ =
+        clamp_((double)packet::timestamp_from_ns(initial_latency, sample_rate));
+
+    valid_ = true;
+}
+
+bool LatencyTuner::valid() const {
+    return valid_;
+}
+
+void LatencyTuner::add_packet(const packet::Packet& packet) {
+    roc_panic_if(!valid());
+
+    const packet::UDP* udp = packet.udp();
+    const packet::RTP* rtp = packet.rtp();
+
+    if (!udp || !rtp || udp->receive_timestamp == 0) {
+        return;
+    }
+
+    if (!started_) {
+        first_ts_ = udp->receive_timestamp;
+        last_rtp_ts_ = rtp->timestamp;
+        last_seqnum_ = rtp->seqnum;
+    }
+
+    const double arrival = (double)(udp->receive_timestamp - first_ts_)
+        * sample_rate_ / core::Second;
+
+    const packet::timestamp_diff_t ts_diff =
+        packet::timestamp_diff(rtp->timestamp, last_rtp_ts_);
+
+    const int64_t rtp_ext_ts = last_rtp_ext_ts_ + ts_diff;
+    if (ts_diff > 0) {
+        last_rtp_ts_ = rtp->timestamp;
+        last_rtp_ext_ts_ = rtp_ext_ts;
+    }
+
+    const double transit = arrival - (double)rtp_ext_ts;
+
+    if (started_ && arrival - window_start_ >= window_) {
+        window_start_ = arrival;
+        rotate_window_();
+        cur_min_transit_ = transit;
+    }
+
+    update_jitter_(transit);
+    update_delay_(transit);
+    update_losses_(rtp->seqnum);
+
+    started_ = true;
+}
+
+packet::timestamp_t LatencyTuner::target_latency() const {
+    roc_panic_if(!valid());
+
+    if (!ready_) {
+        return initial_target_;
+    }
+
+    double latency = jitter_ * (double)jitter_factor_;
+
+    const double delay = (double)peak_delay() * (double)delay_factor_;
+    if (latency < delay) {
+        latency = delay;
+    }
+
+    return clamp_(latency);
+}
+
+float LatencyTuner::jitter() const {
+    return (float)jitter_;
+}
+
+packet::timestamp_t LatencyTuner::peak_delay() const {
+    const double delay =
+        cur_peak_delay_ > prev_peak_delay_ ? cur_peak_delay_ : prev_peak_delay_;
+    return (packet::timestamp_t)delay;
+}
+
+float LatencyTuner::loss_ratio() const {
+    return loss_ratio_;
+}
+
+void LatencyTuner::update_jitter_(double transit) {
+    if (started_) {
+        double d = transit - last_transit_;
+        if (d < 0) {
+            d = -d;
+        }
+        jitter_ += (d - jitter_) * JitterGain;
+    }
+
+    last_transit_ = transit;
+}
+
+void LatencyTuner::update_delay_(double transit) {
+    if (!started_) {
+        cur_min_transit_ = prev_min_transit_ = transit;
+    }
+
+    if (transit < cur_min_transit_) {
+        cur_min_transit_ = transit;
+    }
+
+    const double base_transit =
+        cur_min_transit_ < prev_min_transit_ ? cur_min_transit_ : prev_min_transit_;
+
+    const double delay = transit - base_transit;
+    if (delay > cur_peak_delay_) {
+        cur_peak_delay_ = delay;
+    }
+}
+
+void LatencyTuner::update_losses_(packet::seqnum_t seqnum) {
+    const packet::seqnum_diff_t sn_diff = packet::seqnum_diff(seqnum, last_seqnum_);
+    if (sn_diff > 0) {
+        last_seqnum_ = seqnum;
+        last_seqnum_ext_ += sn_diff;
+    }
+
+    window_received_++;
+}
+
+void LatencyTuner::rotate_window_() {
+    const int64_t expected = last_seqnum_ext_ - window_first_seqnum_ + 1;
+
+    if (expected > 0 && (int64_t)window_received_ < expected) {
+        loss_ratio_ = 1.0f - (float)window_received_ / expected;
+    } else {
+        loss_ratio_ = 0;
+    }
+
+    window_first_seqnum_ = last_seqnum_ext_ + 1;
+    window_received_ = 0;
+
+    prev_min_transit_ = cur_min_transit_;
+    prev_peak_delay_ = cur_peak_delay_;
+    cur_peak_delay_ = 0;
+
+    ready_ = true;
+
+    roc_log(LogDebug,
+            "latency tuner: jitter=%.1f peak_delay=%lu loss_ratio=%.3f target=%lu",
+            jitter_, (unsigned long)peak_delay(), (double)loss_ratio_,
+            (unsigned long)target_latency());
+}
+
+packet::timestamp_t LatencyTuner::clamp_(double latency) const {
+    if (latency < min_target_) {
+        return min_target_;
+    }
+    if (latency > max_target_) {
+        return max_target_;
+    }
+    return (packet::timestamp_t)latency;
+}
+
+} // namespace audio
+} // namespace roc
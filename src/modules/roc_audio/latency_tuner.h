@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/latency_tuner.h
+//! @brief Latency tuner.
+
+#ifndef ROC_AUDIO_LATENCY_TUNER_H_
+#define ROC_AUDIO_LATENCY_TUNER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Latency tuner parameters.
+struct LatencyTunerConfig {
+    //! Minimum allowed target latency, nanoseconds.
+    core::nanoseconds_t min_target_latency;
+
+    //! Maximum allowed target latency, nanoseconds.
+    core::nanoseconds_t max_target_latency;
+
+    //! Statistics window, nanoseconds.
+    //! @remarks
+    //!  Delay peaks and loss ratio are remembered for one to two windows.
+    //!  No target is suggested until the first window is complete.
+    core::nanoseconds_t window;
+
+    //! Target latency to jitter ratio.
+    //! @remarks
+    //!  Target latency is at least jitter multiplied by this factor.
+    float jitter_factor;
+
+    //! Target latency to peak delay ratio.
+    //! @remarks
+    //!  Target latency is at least peak delay multiplied by this factor.
+    float delay_factor;
+
+    LatencyTunerConfig()
+        : min_target_latency(20 * core::Millisecond)
+        , max_target_latency(1 * core::Second)
+        , window(5 * core::Second)
+        , jitter_factor(4.0f)
+        , delay_factor(1.25f) {
+    }
+};
+
+//! Latency tuner.
+//! @remarks
+//!  Collects network statistics for a session and suggests a target latency:
+//!   - estimates interarrival jitter as described in RFC 3550, section 6.4.1
+//!   - tracks the peak of the packet delay relative to the fastest packet,
+//!     which covers both jitter spikes and reordered packets
+//!   - tracks the ratio of lost packets, for reporting
+class LatencyTuner : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p config defines tuner parameters
+    //!  - @p initial_latency defines target latency until enough statistics is
+    //!    collected, nanoseconds
+    //!  - @p sample_rate is the sample rate of the packets
+    LatencyTuner(const LatencyTunerConfig& config,
+                 core::nanoseconds_t initial_latency,
+                 size_t sample_rate);
+
+    //! Check if the object was initialized successfully.
+    bool valid() const;
+
+    //! Update statistics with a packet received from network.
+    //! @remarks
+    //!  Packets without RTP header or receive timestamp are ignored.
+    void add_packet(const packet::Packet& packet);
+
+    //! Get suggested target latency, in samples.
+    packet::timestamp_t target_latency() const;
+
+    //! Get current interarrival jitter, in samples.
+    float jitter() const;
+
+    //! Get peak packet delay during last windows, in samples.
+    packet::timestamp_t peak_delay() const;
+
+    //! Get ratio of lost packets during last complete window.
+    float loss_ratio() const;
+
+private:
+    void update_jitter_(double transit);
+    void update_delay_(double transit);
+    void update_losses_(packet::seqnum_t seqnum);
+
+    void rotate_window_();
+
+    packet::timestamp_t clamp_(double latency) const;
+
+    const size_t sample_rate_;
+    const double window_;
+    const float jitter_factor_;
+    const float delay_factor_;
+
+    const packet::timestamp_t min_target_;
+    const packet::timestamp_t max_target_;
+    packet::timestamp_t initial_target_;
+
+    bool started_;
+    bool ready_;
+
+    core::nanoseconds_t first_ts_;
+    double window_start_;
+
+    packet::timestamp_t last_rtp_ts_;
+    int64_t last_rtp_ext_ts_;
+
+    double last_transit_;
+    double jitter_;
+
+    double cur_min_transit_;
+    double prev_min_transit_;
+    double cur_peak_delay_;
+    double prev_peak_delay_;
+
+    packet::seqnum_t last_seqnum_;
+    int64_t last_seqnum_ext_;
+    int64_t window_first_seqnum_;
+    size_t window_received_;
+    float loss_ratio_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_LATENCY_TUNER_H_
@@ -14,6 +14,19 @@
 namespace roc {
 namespace audio {
 
+namespace {
+
+bool is_silent(const sample_t* samples, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        if (samples[n] > 0 || samples[n] < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 Packetizer::Packetizer(packet::IWriter& writer,
                        packet::IComposer& composer,
                        IEncoder& encoder,
@@ -32,13 +45,35 @@ Packetizer::Packetizer(packet::IWriter& writer,
     , num_channels_(packet::num_channels(channels))
     , samples_per_packet_(
           (packet::timestamp_t)packet::timestamp_from_ns(packet_length, sample_rate))
+    , sample_rate_(sample_rate)
     , payload_type_(payload_type)
     , packet_pos_(0)
+    , packet_silent_(false)
+    , capture_timestamps_(false)
+    , dtx_(false)
+    , dtx_silence_(false)
+    , dtx_keepalive_interval_(0)
+    , dtx_silence_samples_(0)
     , source_((packet::source_t)core::random(packet::source_t(-1)))
     , seqnum_((packet::seqnum_t)core::random(packet::seqnum_t(-1)))
     , timestamp_((packet::timestamp_t)core::random(packet::timestamp_t(-1))) {
 }
 
+void Packetizer::enable_dtx(core::nanoseconds_t keepalive_interval) {
+    if (keepalive_interval <= 0) {
+        roc_panic("packetizer: expected positive dtx keepalive interval, got %ld",
+                  (long)keepalive_interval);
+    }
+
+    dtx_ = true;
+    dtx_keepalive_interval_ = (packet::timestamp_t)packet::timestamp_from_ns(
+        keepalive_interval, sample_rate_);
+}
+
+void Packetizer::enable_capture_timestamps() {
+    capture_timestamps_ = true;
+}
+
 void Packetizer::write(Frame& frame) {
     if (frame.size() % num_channels_ != 0) {
         roc_panic("packetizer: unexpected frame size");
@@ -57,6 +92,10 @@ void Packetizer::write(Frame& frame) {
         size_t ns = encoder_.write_samples(*packet_, packet_pos_, buffer_ptr,
                                            buffer_samples, channels_);
 
+        if (dtx_ && packet_silent_) {
+            packet_silent_ = is_silent(buffer_ptr, ns * num_channels_);
+        }
+
         packet_pos_ += ns;
         buffer_samples -= ns;
         buffer_ptr += ns * num_channels_;
@@ -72,6 +111,15 @@ void Packetizer::flush() {
         return;
     }
 
+    if (skip_packet_()) {
+        timestamp_ += (packet::timestamp_t)packet_pos_;
+
+        packet_pos_ = 0;
+        packet_ = NULL;
+
+        return;
+    }
+
     if (finish_packet_()) {
         writer_.write(packet_);
     }
@@ -111,17 +159,61 @@ packet::PacketPtr Packetizer::start_packet_() {
     rtp.seqnum = seqnum_;
     rtp.timestamp = timestamp_;
     rtp.payload_type = payload_type_;
+    if (capture_timestamps_) {
+        rtp.capture_timestamp = core::unix_timestamp();
+    }
+
+    packet_silent_ = true;
 
     return packet;
 }
 
-bool Packetizer::finish_packet_() {
-    if (packet_pos_ == samples_per_packet_) {
+bool Packetizer::skip_packet_() {
+    if (!dtx_) {
+        return false;
+    }
+
+    if (!packet_silent_) {
+        if (dtx_silence_) {
+            roc_log(LogDebug, "packetizer: dtx: silence ended: silence_samples=%lu",
+                    (unsigned long)dtx_silence_samples_);
+
+            // First packet after silence starts a talkspurt and has the marker
+            // bit set, as recommended by RFC 3551.
+            packet_->rtp()->marker = true;
+        }
+        dtx_silence_ = false;
+        return false;
+    }
+
+    if (dtx_silence_ && dtx_silence_samples_ < dtx_keepalive_interval_) {
+        dtx_silence_samples_ += (packet::timestamp_t)packet_pos_;
         return true;
     }
 
-    if (!composer_.truncate(*packet_, encoder_.payload_size(packet_pos_))) {
-        roc_log(LogError, "packetizer: can't truncate packet");
+    if (!dtx_silence_) {
+        roc_log(LogDebug, "packetizer: dtx: silence started: ts=%lu",
+                (unsigned long)timestamp_);
+    }
+
+    // Send first silent packet and keep-alives, so that the receiver knows
+    // that the sender is alive and that the following gap is silence.
+    dtx_silence_ = true;
+    dtx_silence_samples_ = (packet::timestamp_t)packet_pos_;
+
+    return false;
+}
+
+bool Packetizer::finish_packet_() {
+    if (packet_pos_ != samples_per_packet_) {
+        if (!composer_.truncate(*packet_, encoder_.payload_size(packet_pos_))) {
+            roc_log(LogError, "packetizer: can't truncate packet");
+            return false;
+        }
+    }
+
+    if (!encoder_.finish(*packet_, packet_pos_)) {
+        roc_log(LogError, "packetizer: can't encode packet");
         return false;
     }
 
@@ -54,6 +54,22 @@ public:
                size_t sample_rate,
                unsigned int payload_type);
 
+    //! Enable discontinuous transmission (DTX).
+    //! @remarks
+    //!  When enabled, packets that contain only zero samples are not sent,
+    //!  except keep-alive packets sent at least every @p keepalive_interval
+    //!  nanoseconds. The first packet after silence has the marker bit set,
+    //!  as the first packet of a talkspurt in RFC 3551. RTP timestamps remain
+    //!  continuous, while sequence numbers are incremented only for sent
+    //!  packets.
+    void enable_dtx(core::nanoseconds_t keepalive_interval);
+
+    //! Enable capture timestamps.
+    //! @remarks
+    //!  When enabled, every packet gets the current unix time as its capture
+    //!  timestamp. The composer should be configured to write it to the packet.
+    void enable_capture_timestamps();
+
     //! Write audio frame.
     virtual void write(Frame& frame);
 
@@ -65,6 +81,7 @@ public:
 private:
     packet::PacketPtr start_packet_();
     bool finish_packet_();
+    bool skip_packet_();
 
     packet::IWriter& writer_;
     packet::IComposer& composer_;
@@ -75,10 +92,19 @@ private:
     const packet::channel_mask_t channels_;
     const size_t num_channels_;
     const size_t samples_per_packet_;
+    const size_t sample_rate_;
     const unsigned int payload_type_;
 
     packet::PacketPtr packet_;
     size_t packet_pos_;
+    bool packet_silent_;
+
+    bool capture_timestamps_;
+
+    bool dtx_;
+    bool dtx_silence_;
+    packet::timestamp_t dtx_keepalive_interval_;
+    packet::timestamp_t dtx_silence_samples_;
 
     const packet::source_t source_;
     packet::seqnum_t seqnum_;
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_config.h"
+
+namespace roc {
+namespace audio {
+
+const char* resampler_backend_to_str(ResamplerBackend backend) {
+    switch (backend) {
+    case ResamplerBackend_Sinc:
+        return "sinc";
+    case ResamplerBackend_Linear:
+        return "linear";
+    case ResamplerBackend_Cubic:
+        return "cubic";
+    }
+    return "<invalid>";
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_config.h
+//! @brief Resampler config.
+
+#ifndef ROC_AUDIO_RESAMPLER_CONFIG_H_
+#define ROC_AUDIO_RESAMPLER_CONFIG_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Resampler backend.
+enum ResamplerBackend {
+    //! Windowed sinc filter.
+    //! @remarks
+    //!  Uses window_interp, window_size, and polyphase parameters.
+    ResamplerBackend_Sinc,
+
+    //! Linear interpolation between two nearest input samples.
+    //! @remarks
+    //!  No anti-aliasing filter. Suitable only for clock drift compensation,
+    //!  i.e. when resampling factor is very close to 1.
+    ResamplerBackend_Linear,
+
+    //! Cubic Hermite (Catmull-Rom) interpolation over four nearest input samples.
+    //! @remarks
+    //!  No anti-aliasing filter. Suitable only for clock drift compensation,
+    //!  i.e. when resampling factor is very close to 1.
+    ResamplerBackend_Cubic
+};
+
+//! Resampler parameters.
+struct ResamplerConfig {
+    //! Resampler backend.
+    ResamplerBackend backend;
+
+    //! Sinc table precision.
+    //! @remarks
+    //!  Affects sync table size.
+    //!  Lower values give lower quality but rarer cache misses.
+    size_t window_interp;
+
+    //! Resampler internal window length.
+    //! @remarks
+    //!  Affects sync table size and number of CPU cycles.
+    //!  Lower values give lower quality but higher speed and also rarer cache misses.
+    size_t window_size;
+
+    //! Use precomputed polyphase filter bank.
+    //! @remarks
+    //!  Instead of interpolating sinc table for every tap of every output sample,
+    //!  precompute filter coefficients for a fixed set of fractional positions
+    //!  (phases), so that every output sample becomes a single dot product.
+    //!  If resampling factor is a ratio of two small integers, e.g. 48000/44100,
+    //!  phases are chosen so that output samples fall exactly on them. Small
+    //!  changes of the factor, e.g. for clock drift compensation, are applied
+    //!  on top of the bank without recomputing it, and output samples that fall
+    //!  between phases are computed by interpolating coefficients of adjacent
+    //!  phases. Uses more memory.
+    bool polyphase;
+
+    ResamplerConfig()
+        : backend(ResamplerBackend_Sinc)
+        , window_interp(128)
+        , window_size(32)
+        , polyphase(false) {
+    }
+};
+
+//! Get string name of resampler backend.
+const char* resampler_backend_to_str(ResamplerBackend backend);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_CONFIG_H_
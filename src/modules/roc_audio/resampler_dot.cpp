@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_dot.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROC_AUDIO_RESAMPLER_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ROC_AUDIO_RESAMPLER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+void dot_scalar(sample_t* acc,
+                const sample_t* in,
+                const sample_t* coeffs,
+                size_t n_taps,
+                size_t n_channels) {
+    for (size_t ch = 0; ch < n_channels; ch++) {
+        sample_t sum = 0;
+        for (size_t i = 0; i < n_taps; i++) {
+            sum += in[i * n_channels + ch] * coeffs[i];
+        }
+        acc[ch] += sum;
+    }
+}
+
+#ifdef ROC_AUDIO_RESAMPLER_X86
+
+__attribute__((target("sse2"))) size_t
+dot_sse2(sample_t* acc, const sample_t* in, const sample_t* coeffs, size_t n_taps,
+         size_t n_channels) {
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+
+    size_t i = 0;
+
+    if (n_channels == 1) {
+        for (; i + 4 <= n_taps; i += 4) {
+            sum0 = _mm_add_ps(
+                sum0, _mm_mul_ps(_mm_loadu_ps(in + i), _mm_loadu_ps(coeffs + i)));
+        }
+    } else {
+        // duplicate every coefficient to match L R L R layout
+        for (; i + 4 <= n_taps; i += 4) {
+            const __m128 c = _mm_loadu_ps(coeffs + i);
+            sum0 = _mm_add_ps(
+                sum0, _mm_mul_ps(_mm_loadu_ps(in + i * 2), _mm_unpacklo_ps(c, c)));
+            sum1 = _mm_add_ps(
+                sum1, _mm_mul_ps(_mm_loadu_ps(in + i * 2 + 4), _mm_unpackhi_ps(c, c)));
+        }
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(sum0, sum1));
+
+    if (n_channels == 1) {
+        acc[0] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    } else {
+        acc[0] += lanes[0] + lanes[2];
+        acc[1] += lanes[1] + lanes[3];
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t
+dot_avx2(sample_t* acc, const sample_t* in, const sample_t* coeffs, size_t n_taps,
+         size_t n_channels) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+
+    size_t i = 0;
+
+    if (n_channels == 1) {
+        for (; i + 8 <= n_taps; i += 8) {
+            sum0 = _mm256_add_ps(sum0,
+                                 _mm256_mul_ps(_mm256_loadu_ps(in + i),
+                                               _mm256_loadu_ps(coeffs + i)));
+        }
+    } else {
+        // c0 c0 c1 c1 c2 c2 c3 c3 and c4 c4 c5 c5 c6 c6 c7 c7
+        const __m256i dup_lo = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+        const __m256i dup_hi = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+
+        for (; i + 8 <= n_taps; i += 8) {
+            const __m256 c = _mm256_loadu_ps(coeffs + i);
+            sum0 = _mm256_add_ps(sum0,
+                                 _mm256_mul_ps(_mm256_loadu_ps(in + i * 2),
+                                               _mm256_permutevar8x32_ps(c, dup_lo)));
+            sum1 = _mm256_add_ps(sum1,
+                                 _mm256_mul_ps(_mm256_loadu_ps(in + i * 2 + 8),
+                                               _mm256_permutevar8x32_ps(c, dup_hi)));
+        }
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(sum0, sum1));
+
+    if (n_channels == 1) {
+        acc[0] += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]))
+            + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    } else {
+        acc[0] += (lanes[0] + lanes[2]) + (lanes[4] + lanes[6]);
+        acc[1] += (lanes[1] + lanes[3]) + (lanes[5] + lanes[7]);
+    }
+
+    return i;
+}
+
+bool has_avx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+bool has_sse2() {
+    return __builtin_cpu_supports("sse2");
+}
+
+#endif // ROC_AUDIO_RESAMPLER_X86
+
+#ifdef ROC_AUDIO_RESAMPLER_NEON
+
+size_t dot_neon(sample_t* acc,
+                const sample_t* in,
+                const sample_t* coeffs,
+                size_t n_taps,
+                size_t n_channels) {
+    float32x4_t sum0 = vdupq_n_f32(0);
+    float32x4_t sum1 = vdupq_n_f32(0);
+
+    size_t i = 0;
+
+    if (n_channels == 1) {
+        for (; i + 4 <= n_taps; i += 4) {
+            sum0 = vaddq_f32(sum0, vmulq_f32(vld1q_f32(in + i), vld1q_f32(coeffs + i)));
+        }
+    } else {
+        // vld2q deinterleaves L R L R into separate L and R vectors
+        for (; i + 4 <= n_taps; i += 4) {
+            const float32x4x2_t x = vld2q_f32(in + i * 2);
+            const float32x4_t c = vld1q_f32(coeffs + i);
+            sum0 = vaddq_f32(sum0, vmulq_f32(x.val[0], c));
+            sum1 = vaddq_f32(sum1, vmulq_f32(x.val[1], c));
+        }
+    }
+
+    float lanes0[4];
+    float lanes1[4];
+    vst1q_f32(lanes0, sum0);
+    vst1q_f32(lanes1, sum1);
+
+    acc[0] += (lanes0[0] + lanes0[1]) + (lanes0[2] + lanes0[3]);
+    if (n_channels == 2) {
+        acc[1] += (lanes1[0] + lanes1[1]) + (lanes1[2] + lanes1[3]);
+    }
+
+    return i;
+}
+
+#endif // ROC_AUDIO_RESAMPLER_NEON
+
+// Processes the longest prefix of the taps that the best available
+// vector implementation can handle, and returns its size.
+size_t dot_simd(sample_t* acc,
+                const sample_t* in,
+                const sample_t* coeffs,
+                size_t n_taps,
+                size_t n_channels) {
+    if (n_channels != 1 && n_channels != 2) {
+        return 0;
+    }
+#if defined(ROC_AUDIO_RESAMPLER_X86)
+    if (has_avx2()) {
+        return dot_avx2(acc, in, coeffs, n_taps, n_channels);
+    }
+    if (has_sse2()) {
+        return dot_sse2(acc, in, coeffs, n_taps, n_channels);
+    }
+#elif defined(ROC_AUDIO_RESAMPLER_NEON)
+    return dot_neon(acc, in, coeffs, n_taps, n_channels);
+#else
+    (void)acc;
+    (void)in;
+    (void)coeffs;
+    (void)n_taps;
+#endif
+    return 0;
+}
+
+} // namespace
+
+void resampler_dot(sample_t* acc,
+                   const sample_t* in,
+                   const sample_t* coeffs,
+                   size_t n_taps,
+                   size_t n_channels) {
+    const size_t done = dot_simd(acc, in, coeffs, n_taps, n_channels);
+    dot_scalar(acc, in + done * n_channels, coeffs + done, n_taps - done, n_channels);
+}
+
+const char* resampler_dot_isa() {
+#if defined(ROC_AUDIO_RESAMPLER_X86)
+    if (has_avx2()) {
+        return "avx2";
+    }
+    if (has_sse2()) {
+        return "sse2";
+    }
+#elif defined(ROC_AUDIO_RESAMPLER_NEON)
+    return "neon";
+#endif
+    return "scalar";
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_dot.h
+//! @brief Resampler filter kernel.
+
+#ifndef ROC_AUDIO_RESAMPLER_DOT_H_
+#define ROC_AUDIO_RESAMPLER_DOT_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Apply filter to interleaved samples.
+//! @remarks
+//!  @p in contains @p n_taps interleaved frames of @p n_channels samples.
+//!  For every channel, computes the dot product of its samples and @p coeffs
+//!  and adds it to acc[channel]. Uses vector instructions for mono and
+//!  stereo streams if the CPU supports them. Since the vector code sums
+//!  products in a different order, the result may differ from the scalar
+//!  code in the last bits of the mantissa.
+void resampler_dot(sample_t* acc,
+                   const sample_t* in,
+                   const sample_t* coeffs,
+                   size_t n_taps,
+                   size_t n_channels);
+
+//! Get name of the instruction set used by resampler_dot().
+//! @remarks
+//!  Returns "avx2", "sse2", or "neon" if the CPU supports corresponding
+//!  extensions, or "scalar" otherwise.
+const char* resampler_dot_isa();
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_DOT_H_
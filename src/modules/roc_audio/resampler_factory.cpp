@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_factory.h"
+#include "roc_audio/interp_resampler.h"
+#include "roc_audio/sinc_resampler.h"
+#include "roc_core/log.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+template <class T> T* check_valid(T* resampler, core::IAllocator& allocator) {
+    if (!resampler) {
+        return NULL;
+    }
+
+    if (!resampler->valid()) {
+        allocator.destroy(*resampler);
+        return NULL;
+    }
+
+    return resampler;
+}
+
+} // namespace
+
+IResampler* new_resampler(core::IAllocator& allocator,
+                          const ResamplerConfig& config,
+                          packet::channel_mask_t channels,
+                          ChannelLayout layout,
+                          size_t frame_size) {
+    switch (config.backend) {
+    case ResamplerBackend_Sinc:
+        return check_valid(new (allocator) SincResampler(allocator, config, channels,
+                                                         layout, frame_size),
+                           allocator);
+
+    case ResamplerBackend_Linear:
+    case ResamplerBackend_Cubic:
+        return check_valid(new (allocator) InterpResampler(allocator, config, channels,
+                                                           layout, frame_size),
+                           allocator);
+    }
+
+    roc_log(LogError, "resampler factory: invalid backend");
+    return NULL;
+}
+
+} // namespace audio
+} // namespace roc
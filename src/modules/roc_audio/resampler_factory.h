@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_factory.h
+//! @brief Resampler factory.
+
+#ifndef ROC_AUDIO_RESAMPLER_FACTORY_H_
+#define ROC_AUDIO_RESAMPLER_FACTORY_H_
+
+#include "roc_audio/channel_layout.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_config.h"
+#include "roc_core/iallocator.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Create resampler.
+//! @remarks
+//!  Selects implementation according to @p config backend.
+//!  Input and output frames should have the given channels and layout.
+//!  Input frames should have @p frame_size samples.
+//! @returns
+//!  NULL if the resampler can't be initialized.
+IResampler* new_resampler(core::IAllocator& allocator,
+                          const ResamplerConfig& config,
+                          packet::channel_mask_t channels,
+                          ChannelLayout layout,
+                          size_t frame_size);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_FACTORY_H_
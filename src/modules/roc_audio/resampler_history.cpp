@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_history.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+ResamplerHistory::ResamplerHistory(core::IAllocator& allocator,
+                                   size_t num_channels,
+                                   ChannelLayout layout)
+    : storage_(allocator)
+    , data_(NULL)
+    , num_channels_(num_channels)
+    , layout_(layout)
+    , size_(0)
+    , capacity_(0)
+    , channel_stride_(layout == ChannelLayout_Planar ? 0 : 1)
+    , sample_stride_(layout == ChannelLayout_Planar ? 1 : num_channels) {
+}
+
+bool ResamplerHistory::reserve(size_t capacity) {
+    if (capacity <= capacity_) {
+        return true;
+    }
+
+    if (!storage_.resize(capacity * num_channels_)) {
+        roc_log(LogError, "resampler history: can't allocate buffer: capacity=%lu",
+                (unsigned long)capacity);
+        return false;
+    }
+
+    data_ = &storage_[0];
+
+    if (layout_ == ChannelLayout_Planar) {
+        // planes are moved from the last one, so that they don't overlap with
+        // planes that are not moved yet
+        for (size_t ch = num_channels_; ch > 1; ch--) {
+            memmove(data_ + (ch - 1) * capacity, data_ + (ch - 1) * capacity_,
+                    size_ * sizeof(sample_t));
+        }
+        channel_stride_ = capacity;
+    }
+
+    capacity_ = capacity;
+
+    return true;
+}
+
+void ResamplerHistory::append(const sample_t* samples, size_t n_samples) {
+    const size_t n_samples_ch = n_samples / num_channels_;
+
+    roc_panic_if_not(n_samples_ch * num_channels_ == n_samples);
+
+    if (size_ + n_samples_ch > capacity_) {
+        roc_panic("resampler history: not enough capacity: size=%lu capacity=%lu"
+                  " n_samples=%lu",
+                  (unsigned long)size_, (unsigned long)capacity_,
+                  (unsigned long)n_samples_ch);
+    }
+
+    if (layout_ == ChannelLayout_Planar) {
+        for (size_t ch = 0; ch < num_channels_; ch++) {
+            memcpy(data_ + ch * channel_stride_ + size_, samples + ch * n_samples_ch,
+                   n_samples_ch * sizeof(sample_t));
+        }
+    } else {
+        memcpy(data_ + size_ * num_channels_, samples, n_samples * sizeof(sample_t));
+    }
+
+    size_ += n_samples_ch;
+}
+
+void ResamplerHistory::prepend_zeros(size_t n_samples_ch) {
+    if (size_ + n_samples_ch > capacity_) {
+        roc_panic("resampler history: not enough capacity: size=%lu capacity=%lu"
+                  " n_samples=%lu",
+                  (unsigned long)size_, (unsigned long)capacity_,
+                  (unsigned long)n_samples_ch);
+    }
+
+    move_(n_samples_ch, 0, size_);
+
+    if (layout_ == ChannelLayout_Planar) {
+        for (size_t ch = 0; ch < num_channels_; ch++) {
+            memset(data_ + ch * channel_stride_, 0, n_samples_ch * sizeof(sample_t));
+        }
+    } else {
+        memset(data_, 0, n_samples_ch * num_channels_ * sizeof(sample_t));
+    }
+
+    size_ += n_samples_ch;
+}
+
+void ResamplerHistory::remove(size_t n_samples_ch) {
+    roc_panic_if_not(n_samples_ch <= size_);
+
+    if (n_samples_ch == 0) {
+        return;
+    }
+
+    size_ -= n_samples_ch;
+
+    move_(0, n_samples_ch, size_);
+}
+
+void ResamplerHistory::move_(size_t to, size_t from, size_t n_samples_ch) {
+    if (n_samples_ch == 0) {
+        return;
+    }
+
+    if (layout_ == ChannelLayout_Planar) {
+        for (size_t ch = 0; ch < num_channels_; ch++) {
+            sample_t* plane = data_ + ch * channel_stride_;
+            memmove(plane + to, plane + from, n_samples_ch * sizeof(sample_t));
+        }
+    } else {
+        memmove(data_ + to * num_channels_, data_ + from * num_channels_,
+                n_samples_ch * num_channels_ * sizeof(sample_t));
+    }
+}
+
+} // namespace audio
+} // namespace roc
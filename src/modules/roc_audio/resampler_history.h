@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_history.h
+//! @brief Resampler input history.
+
+#ifndef ROC_AUDIO_RESAMPLER_HISTORY_H_
+#define ROC_AUDIO_RESAMPLER_HISTORY_H_
+
+#include "roc_audio/channel_layout.h"
+#include "roc_audio/units.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Resampler input history.
+//! @remarks
+//!  Holds the most recent input samples of every channel, in the given
+//!  layout. New samples are appended to the end, and samples that are no
+//!  longer needed are removed from the beginning by moving the remaining
+//!  ones to the front. Since only the filter window and the last input
+//!  chunk are kept, moving is cheap, and every filter window is a
+//!  contiguous range of samples.
+class ResamplerHistory : public core::NonCopyable<> {
+public:
+    //! Initialize empty history.
+    ResamplerHistory(core::IAllocator& allocator,
+                     size_t num_channels,
+                     ChannelLayout layout);
+
+    //! Get number of samples per channel.
+    size_t size() const {
+        return size_;
+    }
+
+    //! Get maximum number of samples per channel.
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    //! Get sample of the first channel at given position.
+    //! @remarks
+    //!  Sample of channel N is at data(pos) + N * channel_stride(), and the
+    //!  next sample of the same channel is at data(pos) + sample_stride().
+    const sample_t* data(size_t pos) const {
+        return data_ + pos * sample_stride_;
+    }
+
+    //! Get distance between samples of adjacent channels.
+    size_t channel_stride() const {
+        return channel_stride_;
+    }
+
+    //! Get distance between adjacent samples of the same channel.
+    size_t sample_stride() const {
+        return sample_stride_;
+    }
+
+    //! Increase maximum number of samples per channel.
+    //! @returns
+    //!  false if the allocation failed.
+    bool reserve(size_t capacity);
+
+    //! Append samples.
+    //! @remarks
+    //!  @p n_samples is the total number of samples of all channels in
+    //!  @p samples, which have the layout passed to constructor.
+    //! @pre
+    //!  There should be enough capacity.
+    void append(const sample_t* samples, size_t n_samples);
+
+    //! Insert zero samples at the beginning.
+    //! @pre
+    //!  There should be enough capacity.
+    void prepend_zeros(size_t n_samples_ch);
+
+    //! Remove samples from the beginning.
+    void remove(size_t n_samples_ch);
+
+private:
+    void move_(size_t to, size_t from, size_t n_samples_ch);
+
+    core::Array<sample_t> storage_;
+    sample_t* data_;
+
+    const size_t num_channels_;
+    const ChannelLayout layout_;
+
+    size_t size_;
+    size_t capacity_;
+
+    size_t channel_stride_;
+    const size_t sample_stride_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_HISTORY_H_
@@ -13,6 +13,7 @@ namespace audio {
 
 ResamplerConfig resampler_profile(ResamplerProfile profile) {
     ResamplerConfig config;
+    config.polyphase = true;
 
     switch (profile) {
     case ResamplerProfile_Low:
@@ -29,6 +30,20 @@ ResamplerConfig resampler_profile(ResamplerProfile profile) {
         config.window_interp = 512;
         config.window_size = 64;
         break;
+
+    case ResamplerProfile_Short:
+        // 8 taps per output sample
+        config.window_interp = 64;
+        config.window_size = 3;
+        break;
+
+    case ResamplerProfile_Cubic:
+        config.backend = ResamplerBackend_Cubic;
+        break;
+
+    case ResamplerProfile_Linear:
+        config.backend = ResamplerBackend_Linear;
+        break;
     }
 
     return config;
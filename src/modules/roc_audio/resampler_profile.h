@@ -12,7 +12,7 @@
 #ifndef ROC_AUDIO_RESAMPLER_PROFILE_H_
 #define ROC_AUDIO_RESAMPLER_PROFILE_H_
 
-#include "roc_audio/resampler.h"
+#include "roc_audio/resampler_config.h"
 
 namespace roc {
 namespace audio {
@@ -26,7 +26,16 @@ enum ResamplerProfile {
     ResamplerProfile_Medium,
 
     //! Hight quality, low speed.
-    ResamplerProfile_High
+    ResamplerProfile_High,
+
+    //! Short polyphase sinc filter, lower quality and higher speed than low.
+    ResamplerProfile_Short,
+
+    //! Cubic Hermite interpolation, for clock drift compensation only.
+    ResamplerProfile_Cubic,
+
+    //! Linear interpolation, for clock drift compensation only.
+    ResamplerProfile_Linear
 };
 
 //! Get parameters for given resampler profile.
@@ -7,7 +7,7 @@
  */
 
 #include "roc_audio/resampler_reader.h"
-#include "roc_core/helpers.h"
+#include "roc_audio/resampler_factory.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
@@ -20,18 +20,24 @@ ResamplerReader::ResamplerReader(IReader& reader,
                                  core::IAllocator& allocator,
                                  const ResamplerConfig& config,
                                  packet::channel_mask_t channels,
+                                 ChannelLayout layout,
                                  size_t frame_size)
-    : resampler_(allocator, config, channels, frame_size)
+    : resampler_(new_resampler(allocator, config, channels, layout, frame_size),
+                 allocator)
     , reader_(reader)
     , frame_size_(frame_size)
-    , frames_empty_(true)
     , valid_(false) {
-    if (!resampler_.valid()) {
+    if (!resampler_) {
         return;
     }
-    if (!init_frames_(buffer_pool)) {
+
+    input_ = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
+    if (!input_) {
+        roc_log(LogError, "resampler reader: can't allocate buffer");
         return;
     }
+    input_.resize(frame_size_);
+
     valid_ = true;
 }
 
@@ -42,57 +48,21 @@ bool ResamplerReader::valid() const {
 bool ResamplerReader::set_scaling(float scaling) {
     roc_panic_if_not(valid());
 
-    return resampler_.set_scaling(scaling);
+    return resampler_->set_scaling(scaling);
 }
 
 void ResamplerReader::read(Frame& frame) {
     roc_panic_if_not(valid());
 
-    if (frames_empty_) {
-        renew_frames_();
-    }
+    // Read no more input than the output frame needs at scaling close to 1,
+    // so that only the resampler window is buffered in addition.
+    while (!resampler_->resample_buff(frame)) {
+        Frame input(input_.data(), std::min(frame.size(), frame_size_));
+        reader_.read(input);
 
-    while (!resampler_.resample_buff(frame)) {
-        renew_frames_();
+        resampler_->push_input(input);
     }
 }
 
-bool ResamplerReader::init_frames_(core::BufferPool<sample_t>& buffer_pool) {
-    roc_log(LogDebug, "resampler reader: initializing window");
-
-    for (size_t n = 0; n < ROC_ARRAY_SIZE(frames_); n++) {
-        frames_[n] = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
-
-        if (!frames_[n]) {
-            roc_log(LogError, "resampler reader: can't allocate buffer");
-            return false;
-        }
-
-        frames_[n].resize(frame_size_);
-    }
-
-    return true;
-}
-
-void ResamplerReader::renew_frames_() {
-    if (frames_empty_) {
-        for (size_t n = 0; n < ROC_ARRAY_SIZE(frames_); ++n) {
-            Frame frame(frames_[n].data(), frames_[n].size());
-            reader_.read(frame);
-        }
-        frames_empty_ = false;
-    } else {
-        core::Slice<sample_t> temp = frames_[0];
-        frames_[0] = frames_[1];
-        frames_[1] = frames_[2];
-        frames_[2] = temp;
-
-        Frame frame(frames_[2].data(), frames_[2].size());
-        reader_.read(frame);
-    }
-
-    resampler_.renew_buffers(frames_[0], frames_[1], frames_[2]);
-}
-
 } // namespace audio
 } // namespace roc
@@ -12,14 +12,17 @@
 #ifndef ROC_AUDIO_RESAMPLER_READER_H_
 #define ROC_AUDIO_RESAMPLER_READER_H_
 
+#include "roc_audio/channel_layout.h"
 #include "roc_audio/frame.h"
 #include "roc_audio/ireader.h"
-#include "roc_audio/resampler.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_config.h"
 #include "roc_audio/units.h"
 #include "roc_core/array.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/unique_ptr.h"
 #include "roc_packet/units.h"
 
 namespace roc {
@@ -35,13 +38,15 @@ public:
     //! @b Parameters
     //!  - @p reader specifies input audio stream used in read()
     //!  - @p buffer_pool is used to allocate temporary buffers
-    //!  - @p frame_size is number of samples per resampler frame per audio channel
+    //!  - @p frame_size is maximum number of samples read from @p reader at once
     //!  - @p channels is the bitmask of audio channels
+    //!  - @p layout is the layout of channels in input and output frames
     ResamplerReader(IReader& reader,
                     core::BufferPool<sample_t>& buffer_pool,
                     core::IAllocator& allocator,
                     const ResamplerConfig& config,
                     packet::channel_mask_t channels,
+                    ChannelLayout layout,
                     size_t frame_size);
 
     //! Check if object is successfully constructed.
@@ -56,21 +61,16 @@ public:
     //! @remarks
     //!  Resampling algorithm needs some window of input samples. The length of the window
     //!  (length of sinc impulse response) is a compromise between SNR and speed. It
-    //!  depends on current resampling factor. So we choose length of input buffers to let
-    //!  it handle maximum length of input. If new scaling factor breaks equation this
+    //!  depends on current resampling factor. If the window becomes too long, this
     //!  function returns false.
     bool set_scaling(float);
 
 private:
-    bool init_frames_(core::BufferPool<sample_t>&);
-    void renew_frames_();
-
-    Resampler resampler_;
+    core::UniquePtr<IResampler> resampler_;
     IReader& reader_;
 
-    core::Slice<sample_t> frames_[3];
+    core::Slice<sample_t> input_;
     const size_t frame_size_;
-    bool frames_empty_;
 
     bool valid_;
 };
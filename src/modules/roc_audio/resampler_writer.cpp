@@ -7,7 +7,7 @@
  */
 
 #include "roc_audio/resampler_writer.h"
-#include "roc_core/helpers.h"
+#include "roc_audio/resampler_factory.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
@@ -15,23 +15,42 @@
 namespace roc {
 namespace audio {
 
+namespace {
+
+const core::nanoseconds_t ProfilingInterval = 5 * core::Second;
+
+} // namespace
+
 ResamplerWriter::ResamplerWriter(IWriter& writer,
                                  core::BufferPool<sample_t>& buffer_pool,
                                  core::IAllocator& allocator,
                                  const ResamplerConfig& config,
                                  packet::channel_mask_t channels,
                                  size_t frame_size)
-    : resampler_(allocator, config, channels, frame_size)
+    : resampler_(new_resampler(allocator,
+                               config,
+                               channels,
+                               ChannelLayout_Interleaved,
+                               frame_size),
+                 allocator)
     , writer_(writer)
-    , frame_pos_(0)
+    , num_channels_(packet::num_channels(channels))
+    , profiling_rate_(0)
+    , profiling_time_(0)
+    , profiling_samples_(0)
     , frame_size_(frame_size)
     , valid_(false) {
-    if (!resampler_.valid()) {
+    if (!resampler_) {
         return;
     }
-    if (!init_(buffer_pool)) {
+
+    output_ = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
+    if (!output_) {
+        roc_log(LogError, "resampler writer: can't allocate buffer");
         return;
     }
+    output_.resize(frame_size_);
+
     valid_ = true;
 }
 
@@ -42,77 +61,68 @@ bool ResamplerWriter::valid() const {
 bool ResamplerWriter::set_scaling(float scaling) {
     roc_panic_if_not(valid());
 
-    return resampler_.set_scaling(scaling);
+    return resampler_->set_scaling(scaling);
 }
 
-void ResamplerWriter::write(Frame& input) {
+void ResamplerWriter::enable_profiling(size_t sample_rate) {
     roc_panic_if_not(valid());
 
-    const sample_t* input_data = input.data();
-    const size_t input_size = input.size();
-    size_t input_pos = 0;
-
-    sample_t* frame0_data = frames_[0].data();
-    for (; frame_pos_ < frame_size_ && input_pos < input_size;
-         ++frame_pos_, ++input_pos) {
-        frame0_data[frame_pos_] = input_data[input_pos];
-    }
-
-    sample_t* frame1_data = frames_[1].data();
-    for (; frame_pos_ < frame_size_ * 2 && input_pos < input_size;
-         ++frame_pos_, ++input_pos) {
-        frame1_data[frame_pos_ - frame_size_] = input_data[input_pos];
+    if (sample_rate == 0) {
+        roc_panic("resampler writer: sample_rate is zero");
     }
 
-    while (input_pos < input_size) {
-        sample_t* frame2_data = frames_[2].data();
-        for (; frame_pos_ < frame_size_ * 3 && input_pos < input_size;
-             ++frame_pos_, ++input_pos) {
-            frame2_data[frame_pos_ - frame_size_ * 2] = input_data[input_pos];
-        }
+    profiling_rate_ = sample_rate;
+}
 
-        // All three slices are full, resampling frame_size_ samples.
-        if (frame_pos_ >= frame_size_ * 3) {
-            resampler_.renew_buffers(frames_[0], frames_[1], frames_[2]);
+void ResamplerWriter::write(Frame& input) {
+    roc_panic_if_not(valid());
 
-            Frame out_frame(output_.data(), output_.size());
-            while (resampler_.resample_buff(out_frame)) {
-                writer_.write(out_frame);
-            }
+    Frame out_frame(output_.data(), output_.size());
 
-            frame_pos_ -= frames_[0].size();
-            core::Slice<sample_t> temp = frames_[0];
-            frames_[0] = frames_[1];
-            frames_[1] = frames_[2];
-            frames_[2] = temp;
-        }
-    }
-}
+    for (size_t input_pos = 0; input_pos < input.size();) {
+        const size_t chunk_size = std::min(input.size() - input_pos, frame_size_);
+        Frame chunk(input.data() + input_pos, chunk_size);
 
-bool ResamplerWriter::init_(core::BufferPool<sample_t>& buffer_pool) {
-    roc_log(LogDebug, "resampler writer: initializing window");
+        core::nanoseconds_t start = profiling_rate_ ? core::timestamp() : 0;
+        resampler_->push_input(chunk);
 
-    for (size_t n = 0; n < ROC_ARRAY_SIZE(frames_); n++) {
-        frames_[n] = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
+        // Write every output frame as soon as it's ready.
+        for (;;) {
+            const bool has_frame = resampler_->resample_buff(out_frame);
+            if (profiling_rate_) {
+                profiling_time_ += core::timestamp() - start;
+            }
+            if (!has_frame) {
+                break;
+            }
+            writer_.write(out_frame);
+            if (profiling_rate_) {
+                start = core::timestamp();
+            }
+        }
 
-        if (!frames_[n]) {
-            roc_log(LogError, "resampler writer: can't allocate buffer");
-            return false;
+        if (profiling_rate_) {
+            profiling_samples_ += chunk_size / num_channels_;
+            report_profile_();
         }
 
-        frames_[n].resize(frame_size_);
+        input_pos += chunk_size;
     }
+}
 
-    output_ = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
-
-    if (!output_) {
-        roc_log(LogError, "resampler writer: can't allocate buffer");
-        return false;
+void ResamplerWriter::report_profile_() {
+    const double stream_time =
+        (double)profiling_samples_ / profiling_rate_ * core::Second;
+    if (stream_time < (double)ProfilingInterval) {
+        return;
     }
 
-    output_.resize(frame_size_);
+    roc_log(LogDebug, "resampler writer: cpu usage per stream: %.3f%% (%.2f ms per sec)",
+            (double)profiling_time_ / stream_time * 100,
+            (double)profiling_time_ / stream_time * 1000);
 
-    return true;
+    profiling_time_ = 0;
+    profiling_samples_ = 0;
 }
 
 } // namespace audio
@@ -13,13 +13,16 @@
 #define ROC_AUDIO_RESAMPLER_WRITER_H_
 
 #include "roc_audio/frame.h"
+#include "roc_audio/iresampler.h"
 #include "roc_audio/iwriter.h"
-#include "roc_audio/resampler.h"
+#include "roc_audio/resampler_config.h"
 #include "roc_audio/units.h"
 #include "roc_core/array.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_core/unique_ptr.h"
 #include "roc_packet/units.h"
 
 namespace roc {
@@ -28,6 +31,7 @@ namespace audio {
 //! Resamples audio stream with non-integer dynamically changing factor.
 //! @remarks
 //!  Typicaly being used with factor close to 1 ( 0.9 < factor < 1.1 ).
+//!  Input and output frames are interleaved.
 class ResamplerWriter : public IWriter, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -35,7 +39,7 @@ public:
     //! @b Parameters
     //!  - @p writer specifies output audio stream used in write()
     //!  - @p buffer_pool is used to allocate temporary buffers
-    //!  - @p frame_size is number of samples per resampler frame per audio channel
+    //!  - @p frame_size is maximum number of samples written to @p writer at once
     //!  - @p channels is the bitmask of audio channels
     ResamplerWriter(IWriter& writer,
                     core::BufferPool<sample_t>& buffer_pool,
@@ -56,21 +60,30 @@ public:
     //! @remarks
     //!  Resampling algorithm needs some window of input samples. The length of the window
     //!  (length of sinc impulse response) is a compromise between SNR and speed. It
-    //!  depends on current resampling factor. So we choose length of input buffers to let
-    //!  it handle maximum length of input. If new scaling factor breaks equation this
+    //!  depends on current resampling factor. If the window becomes too long, this
     //!  function returns false.
     bool set_scaling(float);
 
+    //! Enable profiling.
+    //! @remarks
+    //!  Logs CPU time spent on resampling, as a fraction of the stream
+    //!  duration, every few seconds of the stream. Time spent in the output
+    //!  writer is not counted. @p sample_rate is the input sample rate.
+    void enable_profiling(size_t sample_rate);
+
 private:
-    bool init_(core::BufferPool<sample_t>&);
+    void report_profile_();
 
-    Resampler resampler_;
+    core::UniquePtr<IResampler> resampler_;
     IWriter& writer_;
 
-    core::Slice<sample_t> output_;
+    const size_t num_channels_;
 
-    core::Slice<sample_t> frames_[3];
-    size_t frame_pos_;
+    size_t profiling_rate_;
+    core::nanoseconds_t profiling_time_;
+    size_t profiling_samples_;
+
+    core::Slice<sample_t> output_;
     const size_t frame_size_;
 
     bool valid_;
@@ -0,0 +1,676 @@
+/*
+ * Copyright (c) 2015 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/sinc_resampler.h"
+#include "roc_audio/resampler_dot.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+//! Fixed point type Q8.24 for realizing computations of window position in fixed point
+//! arithmetic. Sometimes this computations requires ceil(...) and floor(...) and
+//! it is very CPU-time hungry in floating point variant on x86.
+typedef uint32_t fixedpoint_t;
+
+// Signed version of fixedpoint_t.
+typedef int32_t signed_fixedpoint_t;
+
+const uint32_t INTEGER_PART_MASK = 0xFFF00000;
+const uint32_t FRACT_PART_MASK = 0x000FFFFF;
+const uint32_t FRACT_BIT_COUNT = 20;
+
+// One in terms of Q8.24.
+const fixedpoint_t qt_one = 1 << FRACT_BIT_COUNT;
+
+// Convert float to fixed-point.
+inline fixedpoint_t float_to_fixedpoint(const float t) {
+    return (fixedpoint_t)(t * (float)qt_one);
+}
+
+inline size_t fixedpoint_to_size(const fixedpoint_t t) {
+    return t >> FRACT_BIT_COUNT;
+}
+
+// Rounds x (Q8.24) upward.
+inline fixedpoint_t qceil(const fixedpoint_t x) {
+    if ((x & FRACT_PART_MASK) == 0) {
+        return x & INTEGER_PART_MASK;
+    } else {
+        return (x & INTEGER_PART_MASK) + qt_one;
+    }
+}
+
+// Rounds x (Q8.24) downward.
+inline fixedpoint_t qfloor(const fixedpoint_t x) {
+    // Just remove fractional part.
+    return x & INTEGER_PART_MASK;
+}
+
+// Returns fractional part of x in f32.
+inline float fractional(const fixedpoint_t x) {
+    return (float)(x & FRACT_PART_MASK) * ((float)1. / (float)qt_one);
+}
+
+// Maximum half window length in input samples. Window position is computed in
+// fixed-point, relative to the beginning of the window, so the whole window
+// should fit into the integer part.
+const double MaxHalfWindow = 2048;
+
+// Returns half window length in input samples for given resampling factor.
+double half_window_len(size_t window_size, float cutoff_freq, float scaling) {
+    const double sinc_step =
+        (double)cutoff_freq / (scaling > 1.0f ? (double)scaling : 1.0);
+    return (double)window_size / sinc_step;
+}
+
+// Maximum number of phases in polyphase filter bank used to represent exact
+// resampling ratio.
+const size_t MaxPhases = 1024;
+
+// Maximum relative difference between resampling factor and factor for which
+// polyphase filter bank was computed, when bank is not recomputed.
+const double MaxBankDrift = 0.01;
+
+// Approximates x with num/den, where den <= max_den.
+// Returns false if there is no approximation with relative error below 1e-6.
+bool rational_approx(double x, size_t max_den, size_t& num, size_t& den) {
+    // continued fraction convergents
+    double p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+    double r = x;
+
+    for (;;) {
+        const double a = (double)(size_t)r;
+
+        const double p2 = a * p1 + p0;
+        const double q2 = a * q1 + q0;
+        if (q2 > (double)max_den) {
+            return false;
+        }
+
+        p0 = p1;
+        q0 = q1;
+        p1 = p2;
+        q1 = q2;
+
+        const double err = p1 / q1 - x;
+        if (err < x * 1e-6 && -err < x * 1e-6) {
+            num = (size_t)p1;
+            den = (size_t)q1;
+            return true;
+        }
+
+        if (r - a < 1e-9) {
+            return false;
+        }
+        r = 1 / (r - a);
+    }
+}
+
+// Returns log2(n) assuming that n is a power of two.
+inline size_t calc_bits(size_t n) {
+    size_t c = 0;
+    while ((n & 1) == 0 && c != sizeof(n) * 8) {
+        n >>= 1;
+        c++;
+    }
+    return c;
+}
+
+} // namespace
+
+SincResampler::SincResampler(core::IAllocator& allocator,
+                             const ResamplerConfig& config,
+                             packet::channel_mask_t channels,
+                             ChannelLayout layout,
+                             size_t frame_size)
+    : channel_mask_(channels)
+    , channels_num_(packet::num_channels(channel_mask_))
+    , layout_(layout)
+    , history_(allocator, channels_num_, layout)
+    , index_(0)
+    , left_reach_(0)
+    , right_reach_(0)
+    , keep_(0)
+    , out_frame_pos_(0)
+    , scaling_(1.0)
+    , frame_size_(frame_size)
+    , frame_size_ch_(channels_num_ ? frame_size / channels_num_ : 0)
+    , window_size_(config.window_size)
+    , qt_half_sinc_window_size_(float_to_fixedpoint(window_size_))
+    , window_interp_(config.window_interp)
+    , window_interp_bits_(calc_bits(config.window_interp))
+    , sinc_table_(allocator)
+    , sinc_table_ptr_(NULL)
+    , coeffs_(allocator)
+    , accum_(allocator)
+    , qt_half_window_size_(0)
+    , qt_epsilon_(float_to_fixedpoint(5e-8f))
+    , qt_frac_(0)
+    , qt_dt_(0)
+    , qt_sinc_step_(0)
+    , cutoff_freq_(0.9f)
+    , polyphase_(config.polyphase)
+    , bank_(allocator)
+    , n_phases_(0)
+    , n_taps_(0)
+    , bank_scaling_(0)
+    , bank_exact_(false)
+    , bank_step_(0)
+    , ph_phase_(0)
+    , ph_frac_(0)
+    , ph_step_index_(0)
+    , ph_step_phase_(0)
+    , ph_step_frac_(0)
+    , valid_(false) {
+    if (!check_config_()) {
+        return;
+    }
+    if (!fill_sinc_()) {
+        return;
+    }
+    if (!accum_.resize(channels_num_)) {
+        roc_log(LogError, "resampler: can't allocate filter buffer");
+        return;
+    }
+    // computes window and allocates history for initial scaling
+    if (!set_scaling(scaling_)) {
+        return;
+    }
+
+    roc_log(LogDebug,
+            "resampler: initializing: "
+            "window_interp=%lu window_size=%lu frame_size=%lu channels_num=%lu "
+            "layout=%s polyphase=%d isa=%s",
+            (unsigned long)window_interp_, (unsigned long)window_size_,
+            (unsigned long)frame_size_, (unsigned long)channels_num_,
+            channel_layout_to_str(layout_), (int)polyphase_, resampler_dot_isa());
+
+    valid_ = true;
+}
+
+bool SincResampler::valid() const {
+    return valid_;
+}
+
+bool SincResampler::set_scaling(float new_scaling) {
+    // Window's size changes according to scaling. If new window size
+    // doesn't fit to fixed-point representation -- deny changes.
+    if (!(new_scaling > 0)
+        || half_window_len(window_size_, cutoff_freq_, new_scaling) + 2
+            >= MaxHalfWindow) {
+        roc_log(LogError,
+                "resampler: scaling does not fit window size:"
+                " window_size=%lu scaling=%.5f",
+                (unsigned long)window_size_, (double)new_scaling);
+        return false;
+    }
+
+    // In case of upscaling one should properly shift the edge frequency
+    // of the digital filter. In both cases it's sensible to decrease the
+    // edge frequency to leave some.
+    fixedpoint_t new_qt_sinc_step, new_qt_half_window_size;
+    if (new_scaling > 1.0f) {
+        new_qt_sinc_step = float_to_fixedpoint(cutoff_freq_ / new_scaling);
+        new_qt_half_window_size =
+            float_to_fixedpoint((float)window_size_ / cutoff_freq_ * new_scaling);
+    } else {
+        new_qt_sinc_step = float_to_fixedpoint(cutoff_freq_);
+        new_qt_half_window_size =
+            float_to_fixedpoint((float)window_size_ / cutoff_freq_);
+    }
+
+    // Small changes are applied on top of the bank, see update_phase_step_().
+    bool new_bank = false;
+    if (polyphase_) {
+        const double drift = n_phases_ != 0
+            ? (double)new_scaling / (double)bank_scaling_ - 1
+            : MaxBankDrift * 2;
+        new_bank = drift > MaxBankDrift || drift < -MaxBankDrift;
+    }
+
+    // Number of input samples before and after the current one covered by
+    // the window.
+    size_t new_left_reach, new_right_reach;
+    if (polyphase_) {
+        const size_t half_taps = new_bank
+            ? (size_t)half_window_len(window_size_, cutoff_freq_, new_scaling) + 1
+            : n_taps_ / 2;
+        new_left_reach = half_taps - 1;
+        new_right_reach = half_taps;
+    } else {
+        new_left_reach = fixedpoint_to_size(qceil(new_qt_half_window_size));
+        new_right_reach = fixedpoint_to_size(qfloor(new_qt_half_window_size)) + 1;
+    }
+
+    // Keep a bit more history than needed, so that window can grow a bit
+    // when scaling grows without losing input samples.
+    const size_t new_keep = new_left_reach + new_left_reach / 8 + 1;
+
+    if (!history_.reserve(new_keep + new_right_reach + frame_size_ch_)) {
+        return false;
+    }
+
+    if (!polyphase_ && !coeffs_.resize(new_left_reach + new_right_reach + 2)) {
+        roc_log(LogError, "resampler: can't allocate filter buffer");
+        return false;
+    }
+
+    if (new_bank && !build_bank_(new_scaling)) {
+        return false;
+    }
+
+    qt_sinc_step_ = new_qt_sinc_step;
+    qt_half_window_size_ = new_qt_half_window_size;
+
+    left_reach_ = new_left_reach;
+    right_reach_ = new_right_reach;
+    keep_ = new_keep;
+
+    scaling_ = new_scaling;
+
+    qt_dt_ = float_to_fixedpoint(scaling_);
+    if (polyphase_) {
+        update_phase_step_();
+    }
+
+    // Window grew beyond the kept history. This happens initially and after
+    // big scaling jumps; missing input samples are replaced with zeros.
+    if (index_ < left_reach_) {
+        const size_t n_zeros = keep_ - index_;
+
+        if (!history_.reserve(history_.size() + n_zeros)) {
+            return false;
+        }
+
+        history_.prepend_zeros(n_zeros);
+        index_ += n_zeros;
+    }
+
+    return true;
+}
+
+bool SincResampler::resample_buff(Frame& out) {
+    if (polyphase_) {
+        return resample_buff_polyphase_(out);
+    }
+
+    const size_t out_stride = output_stride_(out);
+
+    for (; out_frame_pos_ < out.size(); out_frame_pos_ += channels_num_) {
+        if (qt_frac_ < qt_epsilon_) {
+            qt_frac_ = 0;
+        } else if ((qt_one - qt_frac_) < qt_epsilon_) {
+            qt_frac_ = 0;
+            index_++;
+        }
+
+        if (index_ + right_reach_ >= history_.size()) {
+            return false;
+        }
+
+        resample_(out.data() + output_offset_(out_frame_pos_), out_stride);
+
+        qt_frac_ += qt_dt_;
+        index_ += fixedpoint_to_size(qt_frac_);
+        qt_frac_ &= FRACT_PART_MASK;
+    }
+    out_frame_pos_ = 0;
+    return true;
+}
+
+void SincResampler::push_input(const Frame& in) {
+    roc_panic_if(in.size() > frame_size_);
+
+    // drop samples which are before the window and the kept margin
+    if (index_ > keep_) {
+        const size_t n_remove = std::min(index_ - keep_, history_.size());
+
+        history_.remove(n_remove);
+        index_ -= n_remove;
+    }
+
+    history_.append(in.data(), in.size());
+}
+
+bool SincResampler::check_config_() const {
+    if (channels_num_ < 1) {
+        roc_log(LogError, "resampler: invalid num_channels: num_channels=%lu",
+                (unsigned long)channels_num_);
+        return false;
+    }
+
+    if (frame_size_ != frame_size_ch_ * channels_num_) {
+        roc_log(LogError,
+                "resampler: frame_size is not multiple of num_channels:"
+                " frame_size=%lu num_channels=%lu",
+                (unsigned long)frame_size_, (unsigned long)channels_num_);
+        return false;
+    }
+
+    if ((size_t)1 << window_interp_bits_ != window_interp_) {
+        roc_log(LogError,
+                "resampler: window_interp is not power of two: window_interp=%lu",
+                (unsigned long)window_interp_);
+        return false;
+    }
+
+    return true;
+}
+
+bool SincResampler::fill_sinc_() {
+    if (!sinc_table_.resize(window_size_ * window_interp_ + 2)) {
+        roc_log(LogError, "resampler: can't allocate sinc table");
+        return false;
+    }
+
+    const double sinc_step = 1.0 / (double)window_interp_;
+    double sinc_t = sinc_step;
+
+    sinc_table_[0] = 1.0f;
+    for (size_t i = 1; i < sinc_table_.size(); ++i) {
+        const double window = 0.54
+            - 0.46
+                * std::cos(2 * M_PI
+                           * ((double)(i - 1) / 2.0 / (double)sinc_table_.size() + 0.5));
+        sinc_table_[i] = (float)(std::sin(M_PI * sinc_t) / M_PI / sinc_t * window);
+        sinc_t += sinc_step;
+    }
+    sinc_table_[sinc_table_.size() - 2] = 0;
+    sinc_table_[sinc_table_.size() - 1] = 0;
+
+    sinc_table_ptr_ = &sinc_table_[0];
+
+    return true;
+}
+
+// Computes sinc value in x position using linear interpolation between
+// table values from sinc_table.h
+//
+// During going through input signal window only integer part of argument changes,
+// that's why there are two arguments in this function: integer part and fractional
+// part of time coordinate.
+//
+// When upscaling, the result should be divided by scaling; this is done once
+// for the whole sum in resample_().
+sample_t SincResampler::sinc_(const fixedpoint_t x, const float fract_x) {
+    const size_t index = (x >> (FRACT_BIT_COUNT - window_interp_bits_));
+
+    const sample_t hl = sinc_table_ptr_[index];     // table index smaller than x
+    const sample_t hh = sinc_table_ptr_[index + 1]; // table index next to x
+
+    return hl + fract_x * (hh - hl);
+}
+
+void SincResampler::resample_(sample_t* out, size_t out_stride) {
+    // Time position of output sample, counted from the first input sample that
+    // may be covered by the window.
+    const size_t base = index_ - left_reach_;
+    const fixedpoint_t qt_sample =
+        (fixedpoint_t)(left_reach_ << FRACT_BIT_COUNT) + qt_frac_;
+
+    // Window covers input samples [ind_begin; ind_end].
+    const size_t ind_begin =
+        base + fixedpoint_to_size(qceil(qt_sample - qt_half_window_size_));
+    const size_t ind_end =
+        base + fixedpoint_to_size(qfloor(qt_sample + qt_half_window_size_));
+    roc_panic_if(ind_end >= history_.size());
+
+    // Counter inside window.
+    // t_sinc = (t_sample - ceil( t_sample - window_len/cutoff*scale )) * sinc_step
+    const long_fixedpoint_t qt_cur_ =
+        qt_sample - qceil(qt_sample - qt_half_window_size_);
+    fixedpoint_t qt_sinc_cur =
+        (fixedpoint_t)((qt_cur_ * (long_fixedpoint_t)qt_sinc_step_) >> FRACT_BIT_COUNT);
+
+    // sinc_table defined in positive half-plane, so at the begining of the window
+    // qt_sinc_cur starts decreasing and after we cross 0 it will be increasing
+    // till the end of the window.
+    fixedpoint_t qt_sinc_inc = qt_sinc_step_;
+
+    // Compute fractional part of time position at the begining. It wont change during
+    // the run.
+    float f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
+
+    sample_t* coeffs = &coeffs_[0];
+    size_t n_coeffs = 0;
+
+    // Run through the left windows side. qt_sinc_cur is decreasing.
+    size_t i = ind_begin;
+
+    coeffs[n_coeffs++] = sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    while (qt_sinc_cur >= qt_sinc_step_) {
+        i++;
+        qt_sinc_cur -= qt_sinc_inc;
+        coeffs[n_coeffs++] = sinc_(qt_sinc_cur, f_sinc_cur_fract);
+    }
+
+    i++;
+
+    roc_panic_if(i > ind_end + 1);
+
+    // Crossing zero -- we just need to switch qt_sinc_cur.
+    // -1 ------------ 0 ------------- +1
+    //      ^                  ^
+    //      |                  |
+    //   -qt_sinc_cur  ->  +qt_sinc_cur     <=> qt_sinc_cur = 1 - qt_sinc_cur
+    qt_sinc_cur = qt_sinc_step_ - qt_sinc_cur; // qt_sinc_cur = -qt_sinc_cur + 1;
+    f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
+
+    // Run through right side of the window, increasing qt_sinc_cur.
+    for (; i <= ind_end; i++) {
+        coeffs[n_coeffs++] = sinc_(qt_sinc_cur, f_sinc_cur_fract);
+        qt_sinc_cur += qt_sinc_inc;
+    }
+
+    // Apply filter to all channels at once.
+    sample_t* accum = &accum_[0];
+    for (size_t ch = 0; ch < channels_num_; ch++) {
+        accum[ch] = 0;
+    }
+
+    apply_filter_(ind_begin, coeffs, n_coeffs);
+
+    for (size_t ch = 0; ch < channels_num_; ch++) {
+        out[ch * out_stride] = scaling_ > 1.0f ? accum[ch] / scaling_ : accum[ch];
+    }
+}
+
+bool SincResampler::resample_buff_polyphase_(Frame& out) {
+    const size_t out_stride = output_stride_(out);
+
+    for (; out_frame_pos_ < out.size(); out_frame_pos_ += channels_num_) {
+        if (index_ + right_reach_ >= history_.size()) {
+            return false;
+        }
+
+        resample_polyphase_(out.data() + output_offset_(out_frame_pos_), out_stride);
+
+        ph_frac_ += ph_step_frac_;
+        ph_phase_ += ph_step_phase_ + (ph_frac_ < ph_step_frac_ ? 1 : 0);
+        if (ph_phase_ >= n_phases_) {
+            ph_phase_ -= n_phases_;
+            index_++;
+        }
+        index_ += ph_step_index_;
+    }
+    out_frame_pos_ = 0;
+    return true;
+}
+
+// Coefficients of every phase are already scaled, so we just need to compute
+// the dot product of the window of n_taps_ input samples around the output
+// sample.
+void SincResampler::resample_polyphase_(sample_t* out, size_t out_stride) {
+    const size_t half_taps = n_taps_ / 2;
+
+    const sample_t* coeffs = &bank_[0] + ph_phase_ * n_taps_;
+
+    // Output sample is between two phases, e.g. because of the clock drift.
+    // Interpolate coefficients of these phases, like the sinc table is
+    // interpolated in resample_(), so that there is no rounding error.
+    if (ph_frac_ != 0) {
+        const sample_t fract = (sample_t)((double)ph_frac_ / 4294967296.0);
+
+        const sample_t* next_coeffs = coeffs + n_taps_;
+        sample_t* interp_coeffs = &coeffs_[0];
+
+        for (size_t tap = 0; tap < n_taps_; tap++) {
+            interp_coeffs[tap] = coeffs[tap] + fract * (next_coeffs[tap] - coeffs[tap]);
+        }
+
+        coeffs = interp_coeffs;
+    }
+
+    sample_t* accum = &accum_[0];
+    for (size_t ch = 0; ch < channels_num_; ch++) {
+        accum[ch] = 0;
+    }
+
+    // Window covers input samples [index - half_taps + 1; index + half_taps].
+    apply_filter_(index_ + 1 - half_taps, coeffs, n_taps_);
+
+    for (size_t ch = 0; ch < channels_num_; ch++) {
+        out[ch * out_stride] = accum[ch];
+    }
+}
+
+// Adds dot product of coefficients and n_taps input samples of every channel,
+// starting from given position in history, to accumulators.
+void SincResampler::apply_filter_(size_t begin, const sample_t* coeffs, size_t n_taps) {
+    sample_t* accum = &accum_[0];
+
+    const sample_t* in = history_.data(begin);
+
+    if (layout_ == ChannelLayout_Planar) {
+        for (size_t ch = 0; ch < channels_num_; ch++) {
+            resampler_dot(accum + ch, in + ch * history_.channel_stride(), coeffs,
+                          n_taps, 1);
+        }
+    } else {
+        resampler_dot(accum, in, coeffs, n_taps, channels_num_);
+    }
+}
+
+// Returns distance between samples of adjacent channels in output frame.
+size_t SincResampler::output_stride_(const Frame& out) const {
+    return layout_ == ChannelLayout_Planar ? out.size() / channels_num_ : 1;
+}
+
+// Returns offset of the first channel sample in output frame, given offset of
+// this sample in interleaved frame.
+size_t SincResampler::output_offset_(size_t pos) const {
+    return layout_ == ChannelLayout_Planar ? pos / channels_num_ : pos;
+}
+
+bool SincResampler::build_bank_(float scaling) {
+    const double sinc_step =
+        (double)cutoff_freq_ / (scaling > 1.0f ? (double)scaling : 1.0);
+    const double half_window = half_window_len(window_size_, cutoff_freq_, scaling);
+
+    const size_t half_taps = (size_t)half_window + 1;
+
+    // If scaling is num/den, output positions are multiples of 1/den, so
+    // we use a multiple of den phases and step over them exactly.
+    size_t num = 0, den = 0;
+    const bool exact = rational_approx((double)scaling, MaxPhases, num, den);
+
+    const size_t n_phases =
+        exact ? den * ((window_interp_ + den - 1) / den) : window_interp_;
+    const size_t n_taps = half_taps * 2;
+
+    // One more phase, equal to the first phase shifted by one input sample,
+    // is used to interpolate between the last phase and the next input sample.
+    if (!bank_.resize((n_phases + 1) * n_taps)) {
+        roc_log(LogError, "resampler: can't allocate polyphase filter bank");
+        return false;
+    }
+
+    if (!coeffs_.resize(n_taps)) {
+        roc_log(LogError, "resampler: can't allocate filter buffer");
+        return false;
+    }
+
+    for (size_t phase = 0; phase <= n_phases; phase++) {
+        sample_t* coeffs = &bank_[0] + phase * n_taps;
+
+        for (size_t tap = 0; tap < n_taps; tap++) {
+            // distance from output sample to input sample
+            double dist = (double)(half_taps - 1) - (double)tap
+                + (double)phase / (double)n_phases;
+            if (dist < 0) {
+                dist = -dist;
+            }
+
+            if (dist >= half_window) {
+                coeffs[tap] = 0;
+                continue;
+            }
+
+            const double x = dist * sinc_step * (double)window_interp_;
+            const size_t index = (size_t)x;
+            const sample_t fract = (sample_t)(x - (double)index);
+
+            const sample_t hl = sinc_table_ptr_[index];
+            const sample_t hh = sinc_table_ptr_[index + 1];
+
+            coeffs[tap] = hl + fract * (hh - hl);
+            if (scaling > 1.0f) {
+                coeffs[tap] /= scaling;
+            }
+        }
+    }
+
+    if (n_phases_ != 0) {
+        ph_phase_ = ph_phase_ * n_phases / n_phases_;
+    }
+
+    roc_log(LogDebug,
+            "resampler: computed polyphase filter bank:"
+            " scaling=%.5f exact=%d n_phases=%lu n_taps=%lu",
+            (double)scaling, (int)exact, (unsigned long)n_phases, (unsigned long)n_taps);
+
+    n_phases_ = n_phases;
+    n_taps_ = n_taps;
+
+    bank_scaling_ = scaling;
+    bank_exact_ = exact;
+    bank_step_ = exact ? num * (n_phases / den) : 0;
+
+    return true;
+}
+
+void SincResampler::update_phase_step_() {
+    size_t step = 0;
+    uint32_t step_frac = 0;
+
+    const double drift = (double)scaling_ / (double)bank_scaling_ - 1;
+
+    if (bank_exact_ && drift < 1e-9 && drift > -1e-9) {
+        step = bank_step_;
+    } else {
+        // Scaling differs from the exact one, e.g. because of the clock drift.
+        // Accumulate the difference in fraction of phase and move to the next
+        // phase when it overflows. Fraction of phase is used to interpolate
+        // between adjacent phases.
+        const double phase_step = (double)scaling_ * (double)n_phases_;
+        step = (size_t)phase_step;
+        step_frac = (uint32_t)((phase_step - (double)step) * 4294967296.0);
+    }
+
+    ph_step_index_ = step / n_phases_;
+    ph_step_phase_ = step % n_phases_;
+    ph_step_frac_ = step_frac;
+}
+
+} // namespace audio
+} // namespace roc
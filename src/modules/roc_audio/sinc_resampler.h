@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2015 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/sinc_resampler.h
+//! @brief Sinc resampler.
+
+#ifndef ROC_AUDIO_SINC_RESAMPLER_H_
+#define ROC_AUDIO_SINC_RESAMPLER_H_
+
+#include "roc_audio/channel_layout.h"
+#include "roc_audio/frame.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_config.h"
+#include "roc_audio/resampler_history.h"
+#include "roc_audio/units.h"
+#include "roc_core/array.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Resamples audio stream with non-integer dynamically changing factor.
+//! @remarks
+//!  Uses windowed sinc filter, see ResamplerBackend_Sinc.
+class SincResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Input and output frames should have the given channels and layout.
+    //!  Input frames should have at most @p frame_size samples.
+    SincResampler(core::IAllocator& allocator,
+                  const ResamplerConfig& config,
+                  packet::channel_mask_t channels,
+                  ChannelLayout layout,
+                  size_t frame_size);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Set new resample factor.
+    //! @remarks
+    //!  Resampling algorithm needs some window of input samples. The length of the window
+    //!  (length of sinc impulse response) is a compromise between SNR and speed. It
+    //!  depends on current resampling factor. If the window becomes too long, this
+    //!  function returns false.
+    virtual bool set_scaling(float);
+
+    //! Resamples the whole output frame.
+    virtual bool resample_buff(Frame& out);
+
+    //! Push input samples.
+    virtual void push_input(const Frame& in);
+
+private:
+    typedef uint32_t fixedpoint_t;
+    typedef uint64_t long_fixedpoint_t;
+    typedef int32_t signed_fixedpoint_t;
+    typedef int64_t signed_long_fixedpoint_t;
+
+    const packet::channel_mask_t channel_mask_;
+    const size_t channels_num_;
+    const ChannelLayout layout_;
+
+    //! Computes single sample of every audio channel.
+    //!
+    //! @remarks
+    //!  Filter coefficients depend only on the time position of the output
+    //!  sample, so they are computed once and then applied to every channel.
+    //!  Sample of channel N is written to out[N * out_stride].
+    void resample_(sample_t* out, size_t out_stride);
+
+    bool check_config_() const;
+
+    bool fill_sinc_();
+    sample_t sinc_(fixedpoint_t x, float fract_x);
+
+    bool resample_buff_polyphase_(Frame& out);
+    void resample_polyphase_(sample_t* out, size_t out_stride);
+
+    void apply_filter_(size_t begin, const sample_t* coeffs, size_t n_taps);
+
+    size_t output_stride_(const Frame& out) const;
+    size_t output_offset_(size_t pos) const;
+
+    bool build_bank_(float scaling);
+    void update_phase_step_();
+
+    // recent input samples
+    ResamplerHistory history_;
+
+    // position in history_ of the input sample at or before the time
+    // position of the next output sample
+    size_t index_;
+
+    // number of input samples before and after index_ used by the filter
+    size_t left_reach_;
+    size_t right_reach_;
+
+    // number of input samples before index_ kept in history_
+    size_t keep_;
+
+    size_t out_frame_pos_;
+
+    float scaling_;
+
+    const size_t frame_size_;
+    const size_t frame_size_ch_;
+
+    const size_t window_size_;
+    const fixedpoint_t qt_half_sinc_window_size_;
+
+    const size_t window_interp_;
+    const size_t window_interp_bits_;
+
+    core::Array<sample_t> sinc_table_;
+    const sample_t* sinc_table_ptr_;
+
+    // filter coefficients for current output sample
+    core::Array<sample_t> coeffs_;
+
+    // per-channel accumulators for current output sample
+    core::Array<sample_t> accum_;
+
+    // half window len in Q8.24 in terms of input signal
+    fixedpoint_t qt_half_window_size_;
+    const fixedpoint_t qt_epsilon_;
+
+    // fractional part of time position of output sample
+    fixedpoint_t qt_frac_;
+
+    // time distance between two output samples, equals to resampling factor
+    fixedpoint_t qt_dt_;
+
+    // the step with which we iterate over the sinc_table_
+    fixedpoint_t qt_sinc_step_;
+
+    const sample_t cutoff_freq_;
+
+    const bool polyphase_;
+
+    // polyphase filter bank, n_taps_ coefficients per phase
+    core::Array<sample_t> bank_;
+    size_t n_phases_;
+    size_t n_taps_;
+
+    // scaling used to compute the bank and step in phase units if it's exact
+    float bank_scaling_;
+    bool bank_exact_;
+    size_t bank_step_;
+
+    // fractional part of time position of output sample: phase and fraction
+    // of phase
+    size_t ph_phase_;
+    uint32_t ph_frac_;
+
+    // time distance between two output samples
+    size_t ph_step_index_;
+    size_t ph_step_phase_;
+    uint32_t ph_step_frac_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_SINC_RESAMPLER_H_
@@ -28,7 +28,8 @@ struct WatchdogConfig {
     //! @remarks
     //!  Maximum allowed period during which every frame is blank. After this period,
     //!  the session is terminated. This mechanism allows to detect dead, hanging, or
-    //!  broken clients. Set to zero to disable.
+    //!  broken clients. Set to zero to disable. If the sender uses DTX, its
+    //!  keep-alive interval should be less than this timeout.
     core::nanoseconds_t no_playback_timeout;
 
     //! Timeout for frequent breakages, nanoseconds.
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/hash.h
+//! @brief Hash functions.
+
+#ifndef ROC_CORE_HASH_H_
+#define ROC_CORE_HASH_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Hash value.
+typedef uint32_t hash_t;
+
+//! Compute FNV-1a hash of a memory region.
+//! @remarks
+//!  If @p seed is given, it should be a hash of the preceding data, which
+//!  allows to hash several regions as a single one.
+inline hash_t hash_bytes(const void* data, size_t size, hash_t seed = 2166136261u) {
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    hash_t h = seed;
+    for (size_t n = 0; n < size; n++) {
+        h ^= bytes[n];
+        h *= 16777619u;
+    }
+
+    return h;
+}
+
+//! Mix bits of a hash value.
+//! @remarks
+//!  Makes the low bits depend on all input bits, so that the result can
+//!  be reduced to a power of two range using a bit mask.
+inline hash_t hash_mix(hash_t h) {
+    h ^= h >> 16;
+    h *= 0x45d9f3bu;
+    h ^= h >> 16;
+    return h;
+}
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_HASH_H_
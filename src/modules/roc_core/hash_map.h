@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/hash_map.h
+//! @brief Open addressing hash map.
+
+#ifndef ROC_CORE_HASH_MAP_H_
+#define ROC_CORE_HASH_MAP_H_
+
+#include "roc_core/hash.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/log.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Open addressing hash map.
+//!
+//! @tparam K defines key type. It should be copyable and provide
+//!  hash() method returning core::hash_t and operator==.
+//! @tparam V defines value type. It should be copyable and default
+//!  constructible.
+//!
+//! Uses linear probing and backward shift deletion, so lookups never
+//! have to skip over deleted entries. The table is kept at most half full
+//! and grows twice when this limit is reached. Memory is allocated only
+//! when the table grows.
+template <class K, class V> class HashMap : public NonCopyable<> {
+public:
+    //! Initialize empty map.
+    explicit HashMap(IAllocator& allocator)
+        : slots_(NULL)
+        , size_(0)
+        , capacity_(0)
+        , allocator_(allocator) {
+    }
+
+    ~HashMap() {
+        release_(slots_, capacity_);
+    }
+
+    //! Get number of elements.
+    size_t size() const {
+        return size_;
+    }
+
+    //! Find element by key.
+    //! @returns
+    //!  pointer to the value associated with @p key or NULL if there is
+    //!  no such key. The pointer is invalidated by insert() and remove().
+    V* find(const K& key) const {
+        if (size_ == 0) {
+            return NULL;
+        }
+
+        const size_t mask = capacity_ - 1;
+
+        for (size_t pos = home_(key, mask);; pos = (pos + 1) & mask) {
+            Slot& slot = slots_[pos];
+            if (!slot.used) {
+                return NULL;
+            }
+            if (slot.key == key) {
+                return &slot.value;
+            }
+        }
+    }
+
+    //! Insert element.
+    //! @remarks
+    //!  If there is already an element with the same key, its value is
+    //!  replaced with @p value.
+    //! @returns
+    //!  false if the allocation failed.
+    bool insert(const K& key, const V& value) {
+        if (V* existing = find(key)) {
+            *existing = value;
+            return true;
+        }
+
+        if ((size_ + 1) * 2 > capacity_) {
+            if (!grow_(capacity_ == 0 ? (size_t)MinCapacity : capacity_ * 2)) {
+                return false;
+            }
+        }
+
+        put_(key, value);
+        size_++;
+
+        return true;
+    }
+
+    //! Remove element.
+    //! @returns
+    //!  false if there is no element with given key.
+    bool remove(const K& key) {
+        if (size_ == 0) {
+            return false;
+        }
+
+        const size_t mask = capacity_ - 1;
+
+        size_t pos = home_(key, mask);
+        for (;; pos = (pos + 1) & mask) {
+            if (!slots_[pos].used) {
+                return false;
+            }
+            if (slots_[pos].key == key) {
+                break;
+            }
+        }
+
+        // Move following elements of the same probe sequence back, so that
+        // every element stays reachable from its home position.
+        for (size_t next = (pos + 1) & mask;; next = (next + 1) & mask) {
+            Slot& slot = slots_[next];
+            if (!slot.used) {
+                break;
+            }
+
+            const size_t home = home_(slot.key, mask);
+            if (((next - home) & mask) < ((next - pos) & mask)) {
+                continue;
+            }
+
+            slots_[pos] = slot;
+            pos = next;
+        }
+
+        slots_[pos] = Slot();
+        size_--;
+
+        return true;
+    }
+
+private:
+    enum { MinCapacity = 16 };
+
+    struct Slot {
+        K key;
+        V value;
+        bool used;
+
+        Slot()
+            : key()
+            , value()
+            , used(false) {
+        }
+    };
+
+    static size_t home_(const K& key, size_t mask) {
+        return size_t(hash_mix(key.hash())) & mask;
+    }
+
+    bool grow_(size_t new_capacity) {
+        Slot* new_slots = (Slot*)allocator_.allocate(new_capacity * sizeof(Slot));
+        if (!new_slots) {
+            roc_log(LogError,
+                    "hash map: can't allocate memory: old_capacity=%lu new_capacity=%lu",
+                    (unsigned long)capacity_, (unsigned long)new_capacity);
+            return false;
+        }
+
+        for (size_t n = 0; n < new_capacity; n++) {
+            new (new_slots + n) Slot();
+        }
+
+        Slot* old_slots = slots_;
+        const size_t old_capacity = capacity_;
+
+        slots_ = new_slots;
+        capacity_ = new_capacity;
+
+        for (size_t n = 0; n < old_capacity; n++) {
+            if (old_slots[n].used) {
+                put_(old_slots[n].key, old_slots[n].value);
+            }
+        }
+
+        release_(old_slots, old_capacity);
+
+        return true;
+    }
+
+    void put_(const K& key, const V& value) {
+        const size_t mask = capacity_ - 1;
+
+        size_t pos = home_(key, mask);
+        while (slots_[pos].used) {
+            pos = (pos + 1) & mask;
+        }
+
+        slots_[pos].key = key;
+        slots_[pos].value = value;
+        slots_[pos].used = true;
+    }
+
+    void release_(Slot* slots, size_t capacity) {
+        if (!slots) {
+            return;
+        }
+        for (size_t n = capacity; n > 0; n--) {
+            slots[n - 1].~Slot();
+        }
+        allocator_.deallocate(slots);
+    }
+
+    Slot* slots_;
+    size_t size_;
+    size_t capacity_;
+
+    IAllocator& allocator_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_HASH_MAP_H_
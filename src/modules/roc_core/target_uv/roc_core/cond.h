@@ -17,6 +17,7 @@
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/panic.h"
+#include "roc_core/time.h"
 
 namespace roc {
 namespace core {
@@ -42,6 +43,33 @@ public:
         uv_cond_wait(&cond_, &mutex_);
     }
 
+    //! Wait until the specified absolute time point.
+    //! @remarks
+    //!  @p deadline specifies absolute time point in nanoseconds, as
+    //!  returned by core::timestamp().
+    //! @returns
+    //!  false if the deadline has expired.
+    bool timed_wait(nanoseconds_t deadline) const {
+        const nanoseconds_t now = timestamp();
+        if (deadline <= now) {
+            return false;
+        }
+        const int err = uv_cond_timedwait(&cond_, &mutex_, uint64_t(deadline - now));
+        if (err == UV_ETIMEDOUT) {
+            return false;
+        }
+        if (err != 0) {
+            roc_panic("cond: uv_cond_timedwait(): [%s] %s", uv_err_name(err),
+                      uv_strerror(err));
+        }
+        return true;
+    }
+
+    //! Wake up one pending wait.
+    void signal() const {
+        uv_cond_signal(&cond_);
+    }
+
     //! Wake up all pending waits.
     void broadcast() const {
         uv_cond_broadcast(&cond_);
@@ -41,6 +41,12 @@ const nanoseconds_t Hour = 60 * Minute;
 //! Get current timestamp in nanoseconds.
 nanoseconds_t timestamp();
 
+//! Get current wall clock time in nanoseconds since Unix epoch.
+//! @remarks
+//!  Unlike timestamp(), may jump forward or backward if system time is adjusted.
+//!  Should be used only when time should be comparable between hosts.
+nanoseconds_t unix_timestamp();
+
 //! Sleep until the specified absolute time point has been reached.
 //! @remarks
 //!  @p timestamp specifies absolute time point in nanoseconds.
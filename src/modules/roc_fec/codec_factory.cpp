@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/codec_factory.h"
+#include "roc_core/log.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+
+#ifdef ROC_TARGET_OPENFEC
+#include "roc_fec/of_decoder.h"
+#include "roc_fec/of_encoder.h"
+#endif
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+bool use_builtin(const Config& config) {
+    switch (config.backend) {
+    case BuiltinBackend:
+        return true;
+
+    case OpenFECBackend:
+        return false;
+
+    case DefaultBackend:
+        break;
+    }
+
+    return config.codec == ReedSolomon8m && config.rs_m == 8;
+}
+
+bool is_block_codec(const Config& config) {
+    if (config.codec == RLC8m) {
+        roc_log(LogError, "fec codec factory: rlc is not a block codec");
+        return false;
+    }
+    return true;
+}
+
+bool is_rlc_supported(const Config& config) {
+    if (config.backend == OpenFECBackend) {
+        roc_log(LogError, "fec codec factory: rlc is not supported by OpenFEC");
+        return false;
+    }
+    return true;
+}
+
+template <class T> T* check_valid(T* codec, core::IAllocator& allocator) {
+    if (!codec) {
+        return NULL;
+    }
+
+    if (!codec->valid()) {
+        allocator.destroy(*codec);
+        return NULL;
+    }
+
+    return codec;
+}
+
+} // namespace
+
+IEncoder* new_encoder(const Config& config,
+                      size_t payload_size,
+                      core::IAllocator& allocator) {
+    if (!is_block_codec(config)) {
+        return NULL;
+    }
+
+    if (use_builtin(config)) {
+        return check_valid(new (allocator) RS8MEncoder(config, payload_size, allocator),
+                           allocator);
+    }
+
+#ifdef ROC_TARGET_OPENFEC
+    return check_valid(new (allocator) OFEncoder(config, payload_size, allocator),
+                       allocator);
+#else
+    roc_log(LogError, "fec codec factory: codec is not supported without OpenFEC");
+    return NULL;
+#endif
+}
+
+IDecoder* new_decoder(const Config& config,
+                      size_t payload_size,
+                      core::BufferPool<uint8_t>& buffer_pool,
+                      core::IAllocator& allocator) {
+    if (!is_block_codec(config)) {
+        return NULL;
+    }
+
+    if (use_builtin(config)) {
+        return check_valid(new (allocator) RS8MDecoder(config, payload_size,
+                                                       buffer_pool, allocator),
+                           allocator);
+    }
+
+#ifdef ROC_TARGET_OPENFEC
+    return check_valid(
+        new (allocator) OFDecoder(config, payload_size, buffer_pool, allocator),
+        allocator);
+#else
+    roc_log(LogError, "fec codec factory: codec is not supported without OpenFEC");
+    return NULL;
+#endif
+}
+
+RLCEncoder* new_rlc_encoder(const Config& config,
+                            size_t payload_size,
+                            core::IAllocator& allocator) {
+    if (!is_rlc_supported(config)) {
+        return NULL;
+    }
+
+    return check_valid(new (allocator) RLCEncoder(config, payload_size, allocator),
+                       allocator);
+}
+
+RLCDecoder* new_rlc_decoder(const Config& config,
+                            size_t payload_size,
+                            core::BufferPool<uint8_t>& buffer_pool,
+                            core::IAllocator& allocator) {
+    if (!is_rlc_supported(config)) {
+        return NULL;
+    }
+
+    return check_valid(
+        new (allocator) RLCDecoder(config, payload_size, buffer_pool, allocator),
+        allocator);
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/codec_factory.h
+//! @brief FEC encoder and decoder factory.
+
+#ifndef ROC_FEC_CODEC_FACTORY_H_
+#define ROC_FEC_CODEC_FACTORY_H_
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_fec/config.h"
+#include "roc_fec/idecoder.h"
+#include "roc_fec/iencoder.h"
+#include "roc_fec/rlc_decoder.h"
+#include "roc_fec/rlc_encoder.h"
+
+namespace roc {
+namespace fec {
+
+//! Create FEC block encoder.
+//! @remarks
+//!  Selects implementation according to @p config codec and backend.
+//!  Sliding window codecs are created by new_rlc_encoder().
+//! @returns
+//!  NULL if the codec is not supported by the selected backend or
+//!  the encoder can't be initialized.
+IEncoder* new_encoder(const Config& config,
+                      size_t payload_size,
+                      core::IAllocator& allocator);
+
+//! Create FEC block decoder.
+//! @remarks
+//!  Selects implementation according to @p config codec and backend.
+//!  Sliding window codecs are created by new_rlc_decoder().
+//! @returns
+//!  NULL if the codec is not supported by the selected backend or
+//!  the decoder can't be initialized.
+IDecoder* new_decoder(const Config& config,
+                      size_t payload_size,
+                      core::BufferPool<uint8_t>& buffer_pool,
+                      core::IAllocator& allocator);
+
+//! Create sliding window RLC encoder.
+//! @returns
+//!  NULL if RLC is not supported by the selected backend or the encoder
+//!  can't be initialized.
+RLCEncoder* new_rlc_encoder(const Config& config,
+                            size_t payload_size,
+                            core::IAllocator& allocator);
+
+//! Create sliding window RLC decoder.
+//! @returns
+//!  NULL if RLC is not supported by the selected backend or the decoder
+//!  can't be initialized.
+RLCDecoder* new_rlc_decoder(const Config& config,
+                            size_t payload_size,
+                            core::BufferPool<uint8_t>& buffer_pool,
+                            core::IAllocator& allocator);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_CODEC_FACTORY_H_
@@ -33,6 +33,15 @@ public:
         : inner_composer_(inner_composer) {
     }
 
+    //! Get packet overhead.
+    virtual size_t overhead() const {
+        size_t size = sizeof(PayloadID);
+        if (inner_composer_) {
+            size += inner_composer_->overhead();
+        }
+        return size;
+    }
+
     //! Adjust buffer to align payload.
     virtual bool
     align(core::Slice<uint8_t>& buffer, size_t header_size, size_t payload_alignment) {
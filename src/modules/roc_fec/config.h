@@ -22,25 +22,47 @@ enum CodecType {
     //! FEC is disabled.
     NoCodec,
 
-    //! OpenFEC Reed-Solomon.
+    //! Reed-Solomon (m=8).
     ReedSolomon8m,
 
-    //! OpenFEC LDPC-Staircase.
+    //! LDPC-Staircase.
     LDPCStaircase,
 
+    //! Sliding window random linear codes (m=8).
+    RLC8m,
+
     //! Maximum for iterating through the enum.
     CodecTypeMax
 };
 
+//! FEC codec implementation.
+enum CodecBackend {
+    //! Built-in implementation if it supports the codec, OpenFEC otherwise.
+    DefaultBackend,
+
+    //! OpenFEC library.
+    OpenFECBackend,
+
+    //! Built-in implementation, supports only Reed-Solomon (m=8) and RLC (m=8).
+    BuiltinBackend
+};
+
 //! FEC configuration.
 struct Config {
     //! FEC codec.
     CodecType codec;
 
+    //! FEC codec implementation.
+    CodecBackend backend;
+
     //! Number of data packets in block.
+    //! @remarks
+    //!  For RLC, maximum number of data packets in encoding window.
     size_t n_source_packets;
 
     //! Number of FEC packets in block.
+    //! @remarks
+    //!  For RLC, number of FEC packets per n_source_packets data packets.
     size_t n_repair_packets;
 
     //! Seed for LDPC scheme.
@@ -54,6 +76,7 @@ struct Config {
 
     Config()
         : codec(NoCodec)
+        , backend(DefaultBackend)
         , n_source_packets(20)
         , n_repair_packets(10)
         , ldpc_prng_seed(1297501556)
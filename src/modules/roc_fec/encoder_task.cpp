@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/encoder_task.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+EncoderTask::EncoderTask(IEncoder& encoder,
+                         packet::IWriter& writer,
+                         size_t n_source_packets,
+                         size_t n_repair_packets,
+                         core::IAllocator& allocator)
+    : encoder_(encoder)
+    , writer_(&writer)
+    , n_source_packets_(n_source_packets)
+    , buffers_(allocator)
+    , repair_packets_(allocator)
+    , pending_(false)
+    , valid_(false) {
+    if (!buffers_.resize(n_source_packets + n_repair_packets)) {
+        return;
+    }
+    if (!repair_packets_.resize(n_repair_packets)) {
+        return;
+    }
+    valid_ = true;
+}
+
+bool EncoderTask::valid() const {
+    return valid_;
+}
+
+void EncoderTask::set_writer(packet::IWriter& writer) {
+    writer_ = &writer;
+}
+
+void EncoderTask::set_source(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= n_source_packets_) {
+        roc_panic("encoder task: source index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)n_source_packets_);
+    }
+
+    buffers_[index] = buffer;
+}
+
+void EncoderTask::set_repair(size_t index, const packet::PacketPtr& packet) {
+    roc_panic_if_not(valid());
+
+    if (index >= repair_packets_.size()) {
+        roc_panic("encoder task: repair index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)repair_packets_.size());
+    }
+
+    repair_packets_[index] = packet;
+    buffers_[n_source_packets_ + index] = packet->fec()->payload;
+}
+
+void EncoderTask::encode() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        if (buffers_[i]) {
+            encoder_.set(i, buffers_[i]);
+        }
+    }
+
+    encoder_.commit();
+    encoder_.reset();
+
+    for (size_t i = 0; i < repair_packets_.size(); ++i) {
+        if (repair_packets_[i]) {
+            writer_->write(repair_packets_[i]);
+            repair_packets_[i] = NULL;
+        }
+    }
+
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        buffers_[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace fec
+} // namespace roc
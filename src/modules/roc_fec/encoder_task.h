@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/encoder_task.h
+//! @brief FEC block encoding task.
+
+#ifndef ROC_FEC_ENCODER_TASK_H_
+#define ROC_FEC_ENCODER_TASK_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/list_node.h"
+#include "roc_core/slice.h"
+#include "roc_fec/iencoder.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace fec {
+
+class EncoderWorker;
+
+//! FEC block encoding task.
+//! @remarks
+//!  Holds source buffers and repair packets of a single block until the
+//!  block is encoded. May be encoded in place or passed to EncoderWorker.
+class EncoderTask : public core::ListNode {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Repair packets are written to @p writer after encoding.
+    EncoderTask(IEncoder& encoder,
+                packet::IWriter& writer,
+                size_t n_source_packets,
+                size_t n_repair_packets,
+                core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Set writer for repair packets.
+    void set_writer(packet::IWriter& writer);
+
+    //! Store source packet buffer.
+    void set_source(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Store repair packet.
+    //! @remarks
+    //!  Packet payload is filled when the block is encoded.
+    void set_repair(size_t index, const packet::PacketPtr& packet);
+
+    //! Encode block.
+    //! @remarks
+    //!  Passes stored buffers to the encoder, fills repair packets, writes
+    //!  them to the writer, and releases stored buffers and packets.
+    void encode();
+
+private:
+    friend class EncoderWorker;
+
+    IEncoder& encoder_;
+    packet::IWriter* writer_;
+
+    const size_t n_source_packets_;
+
+    core::Array<core::Slice<uint8_t> > buffers_;
+    core::Array<packet::PacketPtr> repair_packets_;
+
+    // protected by EncoderWorker mutex
+    bool pending_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_ENCODER_TASK_H_
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/encoder_worker.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+EncoderWorker::EncoderWorker()
+    : stopped_(false)
+    , cond_(mutex_) {
+}
+
+EncoderWorker::~EncoderWorker() {
+    if (joinable()) {
+        roc_panic("encoder worker: thread is not joined before calling destructor");
+    }
+
+    if (tasks_.size() != 0) {
+        roc_panic(
+            "encoder worker: %lu task(s) were not encoded before calling destructor",
+            (unsigned long)tasks_.size());
+    }
+}
+
+bool EncoderWorker::start() {
+    core::Mutex::Lock lock(mutex_);
+
+    if (stopped_) {
+        roc_log(LogError, "encoder worker: can't start stopped worker");
+        return false;
+    }
+
+    return Thread::start();
+}
+
+void EncoderWorker::stop() {
+    core::Mutex::Lock lock(mutex_);
+
+    stopped_ = true;
+    cond_.broadcast();
+}
+
+void EncoderWorker::join() {
+    Thread::join();
+}
+
+void EncoderWorker::schedule(EncoderTask& task) {
+    core::Mutex::Lock lock(mutex_);
+
+    if (task.pending_) {
+        roc_panic("encoder worker: task is already scheduled");
+    }
+
+    if (!joinable() || stopped_) {
+        // There is no background thread, encode task in place.
+        task.encode();
+        return;
+    }
+
+    task.pending_ = true;
+    tasks_.push_back(task);
+
+    cond_.broadcast();
+}
+
+bool EncoderWorker::pending(const EncoderTask& task) const {
+    core::Mutex::Lock lock(mutex_);
+
+    return task.pending_;
+}
+
+void EncoderWorker::wait(const EncoderTask& task) const {
+    core::Mutex::Lock lock(mutex_);
+
+    while (task.pending_) {
+        cond_.wait();
+    }
+}
+
+void EncoderWorker::run() {
+    roc_log(LogDebug, "encoder worker: starting thread");
+
+    while (EncoderTask* task = next_task_()) {
+        task->encode();
+        finish_task_(*task);
+    }
+
+    roc_log(LogDebug, "encoder worker: finishing thread");
+}
+
+EncoderTask* EncoderWorker::next_task_() {
+    core::Mutex::Lock lock(mutex_);
+
+    while (tasks_.size() == 0) {
+        if (stopped_) {
+            return NULL;
+        }
+        cond_.wait();
+    }
+
+    EncoderTask* task = tasks_.front();
+    tasks_.remove(*task);
+
+    return task;
+}
+
+void EncoderWorker::finish_task_(EncoderTask& task) {
+    core::Mutex::Lock lock(mutex_);
+
+    task.pending_ = false;
+    cond_.broadcast();
+}
+
+} // namespace fec
+} // namespace roc
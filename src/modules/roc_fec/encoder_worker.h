@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/encoder_worker.h
+//! @brief Background FEC encoding thread.
+
+#ifndef ROC_FEC_ENCODER_WORKER_H_
+#define ROC_FEC_ENCODER_WORKER_H_
+
+#include "roc_core/cond.h"
+#include "roc_core/list.h"
+#include "roc_core/mutex.h"
+#include "roc_core/thread.h"
+#include "roc_fec/encoder_task.h"
+
+namespace roc {
+namespace fec {
+
+//! Background FEC encoding thread.
+//! @remarks
+//!  Encodes FEC blocks scheduled by one or several writers, so that
+//!  building repair packets doesn't block the thread writing audio.
+class EncoderWorker : private core::Thread {
+public:
+    //! Initialize.
+    EncoderWorker();
+
+    virtual ~EncoderWorker();
+
+    //! Start background thread.
+    //! @remarks
+    //!  Should be called once.
+    bool start();
+
+    //! Asynchronous stop.
+    //! @remarks
+    //!  Background thread encodes all scheduled tasks and exits. May be
+    //!  called from any thread. Use join() to wait until it finishes.
+    void stop();
+
+    //! Wait until background thread finishes.
+    void join();
+
+    //! Schedule task.
+    //! @remarks
+    //!  If the background thread is not running, encodes the task in place.
+    void schedule(EncoderTask& task);
+
+    //! Check if task was scheduled and is not encoded yet.
+    bool pending(const EncoderTask& task) const;
+
+    //! Wait until task is encoded.
+    void wait(const EncoderTask& task) const;
+
+private:
+    virtual void run();
+
+    EncoderTask* next_task_();
+    void finish_task_(EncoderTask& task);
+
+    core::List<EncoderTask, core::NoOwnership> tasks_;
+
+    bool stopped_;
+
+    core::Mutex mutex_;
+    core::Cond cond_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_ENCODER_WORKER_H_
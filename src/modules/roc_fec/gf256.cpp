@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/gf256.h"
+#include "roc_core/panic.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROC_FEC_GF256_X86
+#include <immintrin.h>
+#endif
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// gf_exp[n] = a^n, where a is the primitive element; duplicated to avoid
+// reducing the sum of two logarithms modulo 255.
+const uint8_t gf_exp[510] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1d, 0x3a, 0x74, 0xe8,
+    0xcd, 0x87, 0x13, 0x26, 0x4c, 0x98, 0x2d, 0x5a, 0xb4, 0x75, 0xea, 0xc9,
+    0x8f, 0x03, 0x06, 0x0c, 0x18, 0x30, 0x60, 0xc0, 0x9d, 0x27, 0x4e, 0x9c,
+    0x25, 0x4a, 0x94, 0x35, 0x6a, 0xd4, 0xb5, 0x77, 0xee, 0xc1, 0x9f, 0x23,
+    0x46, 0x8c, 0x05, 0x0a, 0x14, 0x28, 0x50, 0xa0, 0x5d, 0xba, 0x69, 0xd2,
+    0xb9, 0x6f, 0xde, 0xa1, 0x5f, 0xbe, 0x61, 0xc2, 0x99, 0x2f, 0x5e, 0xbc,
+    0x65, 0xca, 0x89, 0x0f, 0x1e, 0x3c, 0x78, 0xf0, 0xfd, 0xe7, 0xd3, 0xbb,
+    0x6b, 0xd6, 0xb1, 0x7f, 0xfe, 0xe1, 0xdf, 0xa3, 0x5b, 0xb6, 0x71, 0xe2,
+    0xd9, 0xaf, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0d, 0x1a, 0x34, 0x68,
+    0xd0, 0xbd, 0x67, 0xce, 0x81, 0x1f, 0x3e, 0x7c, 0xf8, 0xed, 0xc7, 0x93,
+    0x3b, 0x76, 0xec, 0xc5, 0x97, 0x33, 0x66, 0xcc, 0x85, 0x17, 0x2e, 0x5c,
+    0xb8, 0x6d, 0xda, 0xa9, 0x4f, 0x9e, 0x21, 0x42, 0x84, 0x15, 0x2a, 0x54,
+    0xa8, 0x4d, 0x9a, 0x29, 0x52, 0xa4, 0x55, 0xaa, 0x49, 0x92, 0x39, 0x72,
+    0xe4, 0xd5, 0xb7, 0x73, 0xe6, 0xd1, 0xbf, 0x63, 0xc6, 0x91, 0x3f, 0x7e,
+    0xfc, 0xe5, 0xd7, 0xb3, 0x7b, 0xf6, 0xf1, 0xff, 0xe3, 0xdb, 0xab, 0x4b,
+    0x96, 0x31, 0x62, 0xc4, 0x95, 0x37, 0x6e, 0xdc, 0xa5, 0x57, 0xae, 0x41,
+    0x82, 0x19, 0x32, 0x64, 0xc8, 0x8d, 0x07, 0x0e, 0x1c, 0x38, 0x70, 0xe0,
+    0xdd, 0xa7, 0x53, 0xa6, 0x51, 0xa2, 0x59, 0xb2, 0x79, 0xf2, 0xf9, 0xef,
+    0xc3, 0x9b, 0x2b, 0x56, 0xac, 0x45, 0x8a, 0x09, 0x12, 0x24, 0x48, 0x90,
+    0x3d, 0x7a, 0xf4, 0xf5, 0xf7, 0xf3, 0xfb, 0xeb, 0xcb, 0x8b, 0x0b, 0x16,
+    0x2c, 0x58, 0xb0, 0x7d, 0xfa, 0xe9, 0xcf, 0x83, 0x1b, 0x36, 0x6c, 0xd8,
+    0xad, 0x47, 0x8e, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1d,
+    0x3a, 0x74, 0xe8, 0xcd, 0x87, 0x13, 0x26, 0x4c, 0x98, 0x2d, 0x5a, 0xb4,
+    0x75, 0xea, 0xc9, 0x8f, 0x03, 0x06, 0x0c, 0x18, 0x30, 0x60, 0xc0, 0x9d,
+    0x27, 0x4e, 0x9c, 0x25, 0x4a, 0x94, 0x35, 0x6a, 0xd4, 0xb5, 0x77, 0xee,
+    0xc1, 0x9f, 0x23, 0x46, 0x8c, 0x05, 0x0a, 0x14, 0x28, 0x50, 0xa0, 0x5d,
+    0xba, 0x69, 0xd2, 0xb9, 0x6f, 0xde, 0xa1, 0x5f, 0xbe, 0x61, 0xc2, 0x99,
+    0x2f, 0x5e, 0xbc, 0x65, 0xca, 0x89, 0x0f, 0x1e, 0x3c, 0x78, 0xf0, 0xfd,
+    0xe7, 0xd3, 0xbb, 0x6b, 0xd6, 0xb1, 0x7f, 0xfe, 0xe1, 0xdf, 0xa3, 0x5b,
+    0xb6, 0x71, 0xe2, 0xd9, 0xaf, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0d,
+    0x1a, 0x34, 0x68, 0xd0, 0xbd, 0x67, 0xce, 0x81, 0x1f, 0x3e, 0x7c, 0xf8,
+    0xed, 0xc7, 0x93, 0x3b, 0x76, 0xec, 0xc5, 0x97, 0x33, 0x66, 0xcc, 0x85,
+    0x17, 0x2e, 0x5c, 0xb8, 0x6d, 0xda, 0xa9, 0x4f, 0x9e, 0x21, 0x42, 0x84,
+    0x15, 0x2a, 0x54, 0xa8, 0x4d, 0x9a, 0x29, 0x52, 0xa4, 0x55, 0xaa, 0x49,
+    0x92, 0x39, 0x72, 0xe4, 0xd5, 0xb7, 0x73, 0xe6, 0xd1, 0xbf, 0x63, 0xc6,
+    0x91, 0x3f, 0x7e, 0xfc, 0xe5, 0xd7, 0xb3, 0x7b, 0xf6, 0xf1, 0xff, 0xe3,
+    0xdb, 0xab, 0x4b, 0x96, 0x31, 0x62, 0xc4, 0x95, 0x37, 0x6e, 0xdc, 0xa5,
+    0x57, 0xae, 0x41, 0x82, 0x19, 0x32, 0x64, 0xc8, 0x8d, 0x07, 0x0e, 0x1c,
+    0x38, 0x70, 0xe0, 0xdd, 0xa7, 0x53, 0xa6, 0x51, 0xa2, 0x59, 0xb2, 0x79,
+    0xf2, 0xf9, 0xef, 0xc3, 0x9b, 0x2b, 0x56, 0xac, 0x45, 0x8a, 0x09, 0x12,
+    0x24, 0x48, 0x90, 0x3d, 0x7a, 0xf4, 0xf5, 0xf7, 0xf3, 0xfb, 0xeb, 0xcb,
+    0x8b, 0x0b, 0x16, 0x2c, 0x58, 0xb0, 0x7d, 0xfa, 0xe9, 0xcf, 0x83, 0x1b,
+    0x36, 0x6c, 0xd8, 0xad, 0x47, 0x8e
+};
+
+// gf_log[gf_exp[n]] = n; gf_log[0] is undefined.
+const uint8_t gf_log[256] = {
+    0x00, 0x00, 0x01, 0x19, 0x02, 0x32, 0x1a, 0xc6, 0x03, 0xdf, 0x33, 0xee,
+    0x1b, 0x68, 0xc7, 0x4b, 0x04, 0x64, 0xe0, 0x0e, 0x34, 0x8d, 0xef, 0x81,
+    0x1c, 0xc1, 0x69, 0xf8, 0xc8, 0x08, 0x4c, 0x71, 0x05, 0x8a, 0x65, 0x2f,
+    0xe1, 0x24, 0x0f, 0x21, 0x35, 0x93, 0x8e, 0xda, 0xf0, 0x12, 0x82, 0x45,
+    0x1d, 0xb5, 0xc2, 0x7d, 0x6a, 0x27, 0xf9, 0xb9, 0xc9, 0x9a, 0x09, 0x78,
+    0x4d, 0xe4, 0x72, 0xa6, 0x06, 0xbf, 0x8b, 0x62, 0x66, 0xdd, 0x30, 0xfd,
+    0xe2, 0x98, 0x25, 0xb3, 0x10, 0x91, 0x22, 0x88, 0x36, 0xd0, 0x94, 0xce,
+    0x8f, 0x96, 0xdb, 0xbd, 0xf1, 0xd2, 0x13, 0x5c, 0x83, 0x38, 0x46, 0x40,
+    0x1e, 0x42, 0xb6, 0xa3, 0xc3, 0x48, 0x7e, 0x6e, 0x6b, 0x3a, 0x28, 0x54,
+    0xfa, 0x85, 0xba, 0x3d, 0xca, 0x5e, 0x9b, 0x9f, 0x0a, 0x15, 0x79, 0x2b,
+    0x4e, 0xd4, 0xe5, 0xac, 0x73, 0xf3, 0xa7, 0x57, 0x07, 0x70, 0xc0, 0xf7,
+    0x8c, 0x80, 0x63, 0x0d, 0x67, 0x4a, 0xde, 0xed, 0x31, 0xc5, 0xfe, 0x18,
+    0xe3, 0xa5, 0x99, 0x77, 0x26, 0xb8, 0xb4, 0x7c, 0x11, 0x44, 0x92, 0xd9,
+    0x23, 0x20, 0x89, 0x2e, 0x37, 0x3f, 0xd1, 0x5b, 0x95, 0xbc, 0xcf, 0xcd,
+    0x90, 0x87, 0x97, 0xb2, 0xdc, 0xfc, 0xbe, 0x61, 0xf2, 0x56, 0xd3, 0xab,
+    0x14, 0x2a, 0x5d, 0x9e, 0x84, 0x3c, 0x39, 0x53, 0x47, 0x6d, 0x41, 0xa2,
+    0x1f, 0x2d, 0x43, 0xd8, 0xb7, 0x7b, 0xa4, 0x76, 0xc4, 0x17, 0x49, 0xec,
+    0x7f, 0x0c, 0x6f, 0xf6, 0x6c, 0xa1, 0x3b, 0x52, 0x29, 0x9d, 0x55, 0xaa,
+    0xfb, 0x60, 0x86, 0xb1, 0xbb, 0xcc, 0x3e, 0x5a, 0xcb, 0x59, 0x5f, 0xb0,
+    0x9c, 0xa9, 0xa0, 0x51, 0x0b, 0xf5, 0x16, 0xeb, 0x7a, 0x75, 0x2c, 0xd7,
+    0x4f, 0xae, 0xd5, 0xe9, 0xe6, 0xe7, 0xad, 0xe8, 0x74, 0xd6, 0xf4, 0xea,
+    0xa8, 0x50, 0x58, 0xaf
+};
+
+// Products of c and every possible low and high nibble. Since multiplication
+// distributes over addition (xor), c * x = lo[x & 0xf] + hi[x >> 4].
+struct NibbleTables {
+    uint8_t lo[16];
+    uint8_t hi[16];
+};
+
+// Multiply by the primitive element, i.e. by x.
+inline uint8_t mul2(uint8_t a) {
+    return uint8_t((a << 1) ^ ((a & 0x80) ? 0x1d : 0));
+}
+
+// Built from c * 2^n using linearity, which is cheaper than 32 multiplications.
+void make_nibble_tables(NibbleTables& t, uint8_t c) {
+    t.lo[0] = 0;
+    t.lo[1] = c;
+    t.lo[2] = mul2(t.lo[1]);
+    t.lo[4] = mul2(t.lo[2]);
+    t.lo[8] = mul2(t.lo[4]);
+
+    t.hi[0] = 0;
+    t.hi[1] = mul2(t.lo[8]);
+    t.hi[2] = mul2(t.hi[1]);
+    t.hi[4] = mul2(t.hi[2]);
+    t.hi[8] = mul2(t.hi[4]);
+
+    for (size_t x = 3; x < 16; x++) {
+        if ((x & (x - 1)) == 0) {
+            continue;
+        }
+        const size_t low_bit = x & (~x + 1);
+        t.lo[x] = t.lo[low_bit] ^ t.lo[x ^ low_bit];
+        t.hi[x] = t.hi[low_bit] ^ t.hi[x ^ low_bit];
+    }
+}
+
+void mul_region_scalar(uint8_t* dst,
+                       const uint8_t* src,
+                       const NibbleTables& t,
+                       size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        dst[i] = t.lo[src[i] & 0xf] ^ t.hi[src[i] >> 4];
+    }
+}
+
+void mul_add_region_scalar(uint8_t* dst,
+                           const uint8_t* src,
+                           const NibbleTables& t,
+                           size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        dst[i] ^= t.lo[src[i] & 0xf] ^ t.hi[src[i] >> 4];
+    }
+}
+
+#ifdef ROC_FEC_GF256_X86
+
+// pshufb performs 16 parallel lookups in a 16-byte table, so every nibble
+// table fits into a single register.
+
+__attribute__((target("ssse3"))) size_t mul_region_ssse3(uint8_t* dst,
+                                                         const uint8_t* src,
+                                                         const NibbleTables& t,
+                                                         size_t size,
+                                                         bool add) {
+    const __m128i lo = _mm_loadu_si128((const __m128i*)t.lo);
+    const __m128i hi = _mm_loadu_si128((const __m128i*)t.hi);
+    const __m128i mask = _mm_set1_epi8(0xf);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+
+        __m128i p = _mm_xor_si128(
+            _mm_shuffle_epi8(lo, _mm_and_si128(x, mask)),
+            _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(x, 4), mask)));
+
+        if (add) {
+            p = _mm_xor_si128(p, _mm_loadu_si128((const __m128i*)(dst + i)));
+        }
+
+        _mm_storeu_si128((__m128i*)(dst + i), p);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t mul_region_avx2(uint8_t* dst,
+                                                       const uint8_t* src,
+                                                       const NibbleTables& t,
+                                                       size_t size,
+                                                       bool add) {
+    const __m256i lo =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)t.lo));
+    const __m256i hi =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)t.hi));
+    const __m256i mask = _mm256_set1_epi8(0xf);
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(src + i));
+
+        __m256i p = _mm256_xor_si256(
+            _mm256_shuffle_epi8(lo, _mm256_and_si256(x, mask)),
+            _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi64(x, 4), mask)));
+
+        if (add) {
+            p = _mm256_xor_si256(p, _mm256_loadu_si256((const __m256i*)(dst + i)));
+        }
+
+        _mm256_storeu_si256((__m256i*)(dst + i), p);
+    }
+
+    return i;
+}
+
+bool has_avx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+bool has_ssse3() {
+    return __builtin_cpu_supports("ssse3");
+}
+
+#endif // ROC_FEC_GF256_X86
+
+// Processes the longest prefix of the region that the best available
+// vector implementation can handle, and returns its size.
+size_t mul_region_simd(
+    uint8_t* dst, const uint8_t* src, const NibbleTables& t, size_t size, bool add) {
+#ifdef ROC_FEC_GF256_X86
+    if (has_avx2()) {
+        return mul_region_avx2(dst, src, t, size, add);
+    }
+    if (has_ssse3()) {
+        return mul_region_ssse3(dst, src, t, size, add);
+    }
+#else
+    (void)dst;
+    (void)src;
+    (void)t;
+    (void)size;
+    (void)add;
+#endif
+    return 0;
+}
+
+void swap_rows(uint8_t* matrix, size_t a, size_t b, size_t size) {
+    for (size_t col = 0; col < size; col++) {
+        const uint8_t tmp = matrix[a * size + col];
+        matrix[a * size + col] = matrix[b * size + col];
+        matrix[b * size + col] = tmp;
+    }
+}
+
+// Rows of matrices are short, so scalar code is faster than region
+// operations, which have to build nibble tables on every call.
+void scale_row(uint8_t* row, uint8_t c, size_t size) {
+    const size_t log_c = gf_log[c];
+    for (size_t col = 0; col < size; col++) {
+        if (row[col] != 0) {
+            row[col] = gf_exp[log_c + gf_log[row[col]]];
+        }
+    }
+}
+
+void add_scaled_row(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size) {
+    const size_t log_c = gf_log[c];
+    for (size_t col = 0; col < size; col++) {
+        if (src[col] != 0) {
+            dst[col] ^= gf_exp[log_c + gf_log[src[col]]];
+        }
+    }
+}
+
+} // namespace
+
+uint8_t gf256_exp(size_t n) {
+    return gf_exp[n % 255];
+}
+
+uint8_t gf256_mul(uint8_t a, uint8_t b) {
+    if (a == 0 || b == 0) {
+        return 0;
+    }
+    return gf_exp[gf_log[a] + gf_log[b]];
+}
+
+uint8_t gf256_inv(uint8_t a) {
+    if (a == 0) {
+        roc_panic("gf256: can't invert zero");
+    }
+    return gf_exp[255 - gf_log[a]];
+}
+
+bool gf256_invert_matrix(uint8_t* matrix, uint8_t* temp, size_t size) {
+    // Gauss-Jordan elimination; temp starts as identity matrix and
+    // undergoes the same row operations as the input matrix.
+    for (size_t row = 0; row < size; row++) {
+        for (size_t col = 0; col < size; col++) {
+            temp[row * size + col] = (row == col ? 1 : 0);
+        }
+    }
+
+    for (size_t col = 0; col < size; col++) {
+        size_t pivot = col;
+        while (pivot < size && matrix[pivot * size + col] == 0) {
+            pivot++;
+        }
+        if (pivot == size) {
+            return false;
+        }
+
+        if (pivot != col) {
+            swap_rows(matrix, pivot, col, size);
+            swap_rows(temp, pivot, col, size);
+        }
+
+        const uint8_t scale = gf256_inv(matrix[col * size + col]);
+
+        scale_row(matrix + col * size, scale, size);
+        scale_row(temp + col * size, scale, size);
+
+        for (size_t row = 0; row < size; row++) {
+            const uint8_t factor = matrix[row * size + col];
+            if (row == col || factor == 0) {
+                continue;
+            }
+            add_scaled_row(matrix + row * size, matrix + col * size, factor, size);
+            add_scaled_row(temp + row * size, temp + col * size, factor, size);
+        }
+    }
+
+    for (size_t n = 0; n < size * size; n++) {
+        matrix[n] = temp[n];
+    }
+
+    return true;
+}
+
+void gf256_mul_region(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size) {
+    NibbleTables t;
+    make_nibble_tables(t, c);
+
+    const size_t done = mul_region_simd(dst, src, t, size, false);
+    mul_region_scalar(dst + done, src + done, t, size - done);
+}
+
+void gf256_mul_add_region(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size) {
+    if (c == 0) {
+        return;
+    }
+
+    NibbleTables t;
+    make_nibble_tables(t, c);
+
+    const size_t done = mul_region_simd(dst, src, t, size, true);
+    mul_add_region_scalar(dst + done, src + done, t, size - done);
+}
+
+const char* gf256_region_isa() {
+#ifdef ROC_FEC_GF256_X86
+    if (has_avx2()) {
+        return "avx2";
+    }
+    if (has_ssse3()) {
+        return "ssse3";
+    }
+#endif
+    return "scalar";
+}
+
+} // namespace fec
+} // namespace roc
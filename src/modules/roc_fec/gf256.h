@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf256.h
+//! @brief GF(2^8) arithmetic.
+
+#ifndef ROC_FEC_GF256_H_
+#define ROC_FEC_GF256_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Get n-th power of the primitive element of GF(2^8).
+//! @remarks
+//!  The field is generated by the x^8 + x^4 + x^3 + x^2 + 1 polynomial,
+//!  as required by RFC 6865 for m = 8.
+uint8_t gf256_exp(size_t n);
+
+//! Multiply two GF(2^8) elements.
+uint8_t gf256_mul(uint8_t a, uint8_t b);
+
+//! Get multiplicative inverse of non-zero GF(2^8) element.
+uint8_t gf256_inv(uint8_t a);
+
+//! Invert square matrix over GF(2^8).
+//! @remarks
+//!  @p matrix is a row-major @p size x @p size matrix. It is replaced with its
+//!  inverse. @p temp should have room for @p size x @p size elements.
+//! @returns
+//!  false if the matrix is singular.
+bool gf256_invert_matrix(uint8_t* matrix, uint8_t* temp, size_t size);
+
+//! Multiply region by constant.
+//! @remarks
+//!  Computes dst[i] = c * src[i] for every i < @p size.
+void gf256_mul_region(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size);
+
+//! Multiply region by constant and add it to another region.
+//! @remarks
+//!  Computes dst[i] = dst[i] + c * src[i] for every i < @p size.
+void gf256_mul_add_region(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size);
+
+//! Get name of the instruction set used for region operations.
+//! @remarks
+//!  Returns "avx2" or "ssse3" if the CPU supports corresponding extensions,
+//!  or "scalar" otherwise.
+const char* gf256_region_isa();
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_H_
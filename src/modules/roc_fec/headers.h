@@ -244,6 +244,158 @@ public:
     }
 };
 
+//! RLC Source FEC Payload ID (for m=8).
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                   Encoding Symbol ID (ESI)                    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+//!
+//! @remarks
+//!  Defined in RFC 8681. There are no blocks in sliding window codes, so
+//!  ESI of the source symbol is stored in packet::FEC::source_block_number.
+class ROC_ATTR_PACKED RLC_Source_PayloadID {
+private:
+    //! Encoding symbol ID.
+    uint32_t esi_;
+
+public:
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    //! Get encoding symbol ID of the source symbol.
+    uint32_t sbn() const {
+        return core::ntoh32(esi_);
+    }
+
+    //! Set encoding symbol ID of the source symbol.
+    void set_sbn(uint32_t val) {
+        esi_ = core::hton32(val);
+    }
+
+    //! Get encoding symbol ID within block.
+    uint16_t esi() const {
+        return 0;
+    }
+
+    //! Set encoding symbol ID within block.
+    void set_esi(uint16_t) {
+    }
+
+    //! Get source block length.
+    uint16_t k() const {
+        return 0;
+    }
+
+    //! Set source block length.
+    void set_k(uint16_t) {
+    }
+
+    //! Get number encoding symbols.
+    uint16_t n() const {
+        return 0;
+    }
+
+    //! Set number encoding symbols.
+    void set_n(uint16_t) {
+    }
+};
+
+//! RLC Repair FEC Payload ID (for m=8).
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |       Repair_Key              |  DT   |NSS (# src symb in ew.) |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                            FSS_ESI                            |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+//!
+//! @remarks
+//!  Defined in RFC 8681. ESI of the first source symbol of the encoding
+//!  window (FSS_ESI) is stored in packet::FEC::source_block_number, number
+//!  of source symbols in the window (NSS) in packet::FEC::source_block_length,
+//!  and the repair key in packet::FEC::encoding_symbol_id.
+class ROC_ATTR_PACKED RLC_Repair_PayloadID {
+private:
+    //! Repair key.
+    uint16_t repair_key_;
+
+    //! Density threshold and number of source symbols in encoding window.
+    uint16_t dt_nss_;
+
+    //! Encoding symbol ID of first source symbol in encoding window.
+    uint32_t fss_esi_;
+
+public:
+    //! Clear header.
+    //! @remarks
+    //!  Density threshold is set to 15, which means that all coding
+    //!  coefficients are non-zero.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+        set_dt(15);
+    }
+
+    //! Get encoding symbol ID of first source symbol in encoding window.
+    uint32_t sbn() const {
+        return core::ntoh32(fss_esi_);
+    }
+
+    //! Set encoding symbol ID of first source symbol in encoding window.
+    void set_sbn(uint32_t val) {
+        fss_esi_ = core::hton32(val);
+    }
+
+    //! Get repair key.
+    uint16_t esi() const {
+        return core::ntoh16(repair_key_);
+    }
+
+    //! Set repair key.
+    void set_esi(uint16_t val) {
+        repair_key_ = core::hton16(val);
+    }
+
+    //! Get number of source symbols in encoding window.
+    uint16_t k() const {
+        return core::ntoh16(dt_nss_) & 0xfff;
+    }
+
+    //! Set number of source symbols in encoding window.
+    void set_k(uint16_t val) {
+        roc_panic_if((val >> 12) != 0);
+        dt_nss_ = core::hton16(uint16_t((core::ntoh16(dt_nss_) & 0xf000) | val));
+    }
+
+    //! Get density threshold.
+    uint8_t dt() const {
+        return uint8_t(core::ntoh16(dt_nss_) >> 12);
+    }
+
+    //! Set density threshold.
+    void set_dt(uint8_t val) {
+        roc_panic_if((val >> 4) != 0);
+        dt_nss_ = core::hton16(uint16_t((core::ntoh16(dt_nss_) & 0xfff) | (val << 12)));
+    }
+
+    //! Get number encoding symbols.
+    uint16_t n() const {
+        return 0;
+    }
+
+    //! Set number encoding symbols.
+    void set_n(uint16_t) {
+    }
+};
+
 } // namespace fec
 } // namespace roc
 
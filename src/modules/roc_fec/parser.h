@@ -21,14 +21,20 @@ namespace roc {
 namespace fec {
 
 //! FECFRAME packet parser.
-template <class PayloadID, PayloadID_Type Type, PayloadID_Pos Pos>
+//! @tparam InnerParser defines type of inner parser. If it's a concrete parser
+//!  type instead of packet::IParser, the inner parser is called directly and
+//!  the call is bound statically.
+template <class PayloadID,
+          PayloadID_Type Type,
+          PayloadID_Pos Pos,
+          class InnerParser = packet::IParser>
 class Parser : public packet::IParser, public core::NonCopyable<> {
 public:
     //! Initialization.
     //! @remarks
     //!  Parses FECFRAME header or footer and passes the rest to @p inner_parser
     //!  if it's not null.
-    Parser(packet::IParser* inner_parser)
+    Parser(InnerParser* inner_parser)
         : inner_parser_(inner_parser) {
     }
 
@@ -61,20 +67,36 @@ public:
         fec.encoding_symbol_id = payload_id->esi();
 
         if (Pos == Header) {
+            fec.payload_id = buffer.range(0, sizeof(PayloadID));
             fec.payload = buffer.range(sizeof(PayloadID), buffer.size());
         } else {
+            fec.payload_id =
+                buffer.range(buffer.size() - sizeof(PayloadID), buffer.size());
             fec.payload = buffer.range(0, buffer.size() - sizeof(PayloadID));
         }
 
         if (inner_parser_) {
-            return inner_parser_->parse(packet, fec.payload);
+            return parse_inner_(*inner_parser_, packet, fec.payload);
         }
 
         return true;
     }
 
 private:
-    packet::IParser* inner_parser_;
+    template <class P>
+    static bool parse_inner_(P& parser,
+                             packet::Packet& packet,
+                             const core::Slice<uint8_t>& buffer) {
+        return parser.P::parse(packet, buffer);
+    }
+
+    static bool parse_inner_(packet::IParser& parser,
+                             packet::Packet& packet,
+                             const core::Slice<uint8_t>& buffer) {
+        return parser.parse(packet, buffer);
+    }
+
+    InnerParser* inner_parser_;
 };
 
 } // namespace fec
@@ -29,6 +29,9 @@ Reader::Reader(const Config& config,
     , repair_queue_(0)
     , source_block_(allocator)
     , repair_block_(allocator)
+    , source_repaired_(allocator)
+    , n_block_source_(0)
+    , n_block_packets_(0)
     , valid_(false)
     , alive_(true)
     , started_(false)
@@ -44,6 +47,12 @@ Reader::Reader(const Config& config,
     if (!repair_block_.resize(config.n_repair_packets)) {
         return;
     }
+    if (!source_repaired_.resize(config.n_source_packets)) {
+        return;
+    }
+    for (size_t n = 0; n < source_repaired_.size(); n++) {
+        source_repaired_[n] = false;
+    }
     valid_ = true;
 }
 
@@ -105,6 +114,14 @@ packet::PacketPtr Reader::read_() {
 packet::PacketPtr Reader::get_next_packet_() {
     update_packets_();
 
+    // Repair lost packets as soon as there are enough packets in the block,
+    // without waiting until we reach a lost packet. This is not done in
+    // next_block_(), so that switching to a new block and decoding it are
+    // performed by different read() calls.
+    if (can_repair_block_()) {
+        try_repair_();
+    }
+
     packet::PacketPtr pp = source_block_[next_packet_];
 
     do {
@@ -144,15 +161,21 @@ void Reader::next_block_() {
 
     for (size_t n = 0; n < source_block_.size(); n++) {
         source_block_[n] = NULL;
+        source_repaired_[n] = false;
     }
 
     for (size_t n = 0; n < repair_block_.size(); n++) {
         repair_block_[n] = NULL;
     }
 
+    decoder_.reset();
+
     cur_sbn_++;
     next_packet_ = 0;
 
+    n_block_source_ = 0;
+    n_block_packets_ = 0;
+
     can_repair_ = false;
     update_packets_();
 }
@@ -163,21 +186,7 @@ void Reader::try_repair_() {
     }
 
     for (size_t n = 0; n < source_block_.size(); n++) {
-        if (!source_block_[n]) {
-            continue;
-        }
-        decoder_.set(n, source_block_[n]->fec()->payload);
-    }
-
-    for (size_t n = 0; n < repair_block_.size(); n++) {
-        if (!repair_block_[n]) {
-            continue;
-        }
-        decoder_.set(source_block_.size() + n, repair_block_[n]->fec()->payload);
-    }
-
-    for (size_t n = 0; n < source_block_.size(); n++) {
-        if (source_block_[n]) {
+        if (source_block_[n] || source_repaired_[n]) {
             continue;
         }
 
@@ -186,6 +195,8 @@ void Reader::try_repair_() {
             continue;
         }
 
+        source_repaired_[n] = true;
+
         packet::PacketPtr pp = new (packet_pool_) packet::Packet(packet_pool_);
         if (!pp) {
             roc_log(LogError, "fec reader: can't allocate packet");
@@ -205,12 +216,19 @@ void Reader::try_repair_() {
         }
 
         source_block_[n] = pp;
+        n_block_source_++;
     }
 
-    decoder_.reset();
     can_repair_ = false;
 }
 
+// returns true if there are lost packets in the current block and enough
+// packets were received to try to repair them
+bool Reader::can_repair_block_() const {
+    return can_repair_ && n_block_source_ < source_block_.size()
+        && n_block_packets_ >= source_block_.size();
+}
+
 bool Reader::check_packet_(const packet::PacketPtr& pp) {
     roc_panic_if_not(has_source_);
 
@@ -301,9 +319,15 @@ void Reader::update_source_packets_() {
         const size_t p_num = fec->encoding_symbol_id;
 
         if (!source_block_[p_num]) {
-            can_repair_ = true;
             source_block_[p_num] = pp;
+            n_block_source_++;
             n_added++;
+
+            if (!source_repaired_[p_num]) {
+                decoder_.set(p_num, fec->payload);
+                n_block_packets_++;
+                can_repair_ = true;
+            }
         }
     }
 
@@ -348,9 +372,12 @@ void Reader::update_repair_packets_() {
         roc_panic_if(p_num >= repair_block_.size());
 
         if (!repair_block_[p_num]) {
-            can_repair_ = true;
             repair_block_[p_num] = pp;
             n_added++;
+
+            decoder_.set(source_block_.size() + p_num, fec->payload);
+            n_block_packets_++;
+            can_repair_ = true;
         }
     }
 
@@ -58,7 +58,10 @@ public:
 
     //! Read packet.
     //! @remarks
-    //!  When a packet loss is detected, try to restore it from repair packets.
+    //!  Packets of the current block are passed to the decoder as soon as
+    //!  they are fetched. When there are enough packets to repair losses in
+    //!  the block, they are repaired right away, before the lost packets
+    //!  are requested.
     virtual packet::PacketPtr read();
 
 private:
@@ -75,6 +78,8 @@ private:
     void update_source_packets_();
     void update_repair_packets_();
 
+    bool can_repair_block_() const;
+
     void drop_repair_packets_from_prev_blocks_();
 
     IDecoder& decoder_;
@@ -90,6 +95,14 @@ private:
     core::Array<packet::PacketPtr> source_block_;
     core::Array<packet::PacketPtr> repair_block_;
 
+    // true if the decoder has returned buffer for source packet
+    core::Array<bool> source_repaired_;
+
+    // number of source packets in block, including repaired ones
+    size_t n_block_source_;
+    // number of source and repair packets passed to the decoder
+    size_t n_block_packets_;
+
     bool valid_;
 
     bool alive_;
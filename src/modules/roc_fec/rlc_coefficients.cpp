@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_coefficients.h"
+#include "roc_core/panic.h"
+#include "roc_fec/tinymt32.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+uint8_t rand_nonzero(TinyMT32& prng) {
+    uint8_t c;
+    do {
+        c = uint8_t(prng.next() & 0xff);
+    } while (c == 0);
+    return c;
+}
+
+} // namespace
+
+void rlc_coefficients(uint16_t repair_key, uint8_t dt, uint8_t* coefs, size_t n_coefs) {
+    if (dt > RLCDenseThreshold) {
+        roc_panic("rlc coefficients: bad density threshold: dt=%u", (unsigned)dt);
+    }
+
+    TinyMT32 prng(repair_key);
+
+    if (dt == RLCDenseThreshold) {
+        for (size_t i = 0; i < n_coefs; i++) {
+            coefs[i] = rand_nonzero(prng);
+        }
+    } else {
+        for (size_t i = 0; i < n_coefs; i++) {
+            if ((prng.next() & 0xf) <= dt) {
+                coefs[i] = rand_nonzero(prng);
+            } else {
+                coefs[i] = 0;
+            }
+        }
+    }
+}
+
+} // namespace fec
+} // namespace roc
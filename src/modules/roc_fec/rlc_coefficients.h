@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_coefficients.h
+//! @brief RLC coding coefficients.
+
+#ifndef ROC_FEC_RLC_COEFFICIENTS_H_
+#define ROC_FEC_RLC_COEFFICIENTS_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Maximum number of source symbols in RLC encoding window.
+//! @remarks
+//!  Limited by the size of NSS field of repair FEC payload ID.
+const size_t RLCMaxWindow = 4095;
+
+//! RLC density threshold for dense codes, when all coefficients are non-zero.
+const uint8_t RLCDenseThreshold = 15;
+
+//! Generate RLC coding coefficients.
+//! @remarks
+//!  Implements generate_coding_coefficients() from RFC 8681 for m = 8.
+//!  Fills @p n_coefs coefficients of the repair symbol with given
+//!  @p repair_key. Every coefficient is non-zero with probability
+//!  (@p dt + 1) / 16. Coefficient i applies to i-th source symbol of the
+//!  encoding window.
+void rlc_coefficients(uint16_t repair_key, uint8_t dt, uint8_t* coefs, size_t n_coefs);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_COEFFICIENTS_H_
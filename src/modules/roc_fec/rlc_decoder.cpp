@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/rlc_coefficients.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t NoColumn = (size_t)-1;
+
+} // namespace
+
+RLCDecoder::RLCDecoder(const Config& config,
+                       size_t payload_size,
+                       core::BufferPool<uint8_t>& buffer_pool,
+                       core::IAllocator& allocator)
+    : max_window_(config.n_source_packets)
+    , payload_size_(payload_size)
+    , buffer_pool_(buffer_pool)
+    , symbols_(allocator)
+    , begin_esi_(0)
+    , begin_pos_(0)
+    , repairs_(allocator)
+    , n_repairs_(0)
+    , has_position_(false)
+    , has_new_symbols_(false)
+    , matrix_(allocator)
+    , rhs_(allocator)
+    , row_index_(allocator)
+    , n_rows_(0)
+    , row_pivot_(allocator)
+    , col_symbol_(allocator)
+    , symbol_col_(allocator)
+    , n_cols_(0)
+    , coefs_(allocator)
+    , valid_(false) {
+    if (config.codec != RLC8m) {
+        roc_log(LogError, "rlc decoder: unsupported codec");
+        return;
+    }
+
+    if (max_window_ == 0 || max_window_ > RLCMaxWindow) {
+        roc_log(LogError, "rlc decoder: invalid window size: n_source=%lu max=%lu",
+                (unsigned long)max_window_, (unsigned long)RLCMaxWindow);
+        return;
+    }
+
+    const size_t n_symbols = max_window_ * 2;
+    const size_t n_repairs = config.n_repair_packets * 2 + 2;
+
+    if (!symbols_.resize(n_symbols)) {
+        return;
+    }
+    if (!repairs_.resize(n_repairs)) {
+        return;
+    }
+    if (!matrix_.resize(n_repairs * n_symbols)) {
+        return;
+    }
+    if (!rhs_.resize(n_repairs * payload_size_)) {
+        return;
+    }
+    if (!row_index_.resize(n_repairs)) {
+        return;
+    }
+    if (!row_pivot_.resize(n_repairs)) {
+        return;
+    }
+    if (!col_symbol_.resize(n_symbols)) {
+        return;
+    }
+    if (!symbol_col_.resize(n_symbols)) {
+        return;
+    }
+    if (!coefs_.resize(max_window_)) {
+        return;
+    }
+
+    roc_log(LogDebug, "rlc decoder: initializing: max_window=%lu max_repair=%lu isa=%s",
+            (unsigned long)max_window_, (unsigned long)n_repairs, gf256_region_isa());
+
+    valid_ = true;
+}
+
+bool RLCDecoder::valid() const {
+    return valid_;
+}
+
+size_t RLCDecoder::max_window() const {
+    roc_panic_if_not(valid());
+
+    return max_window_;
+}
+
+void RLCDecoder::advance(packet::blknum_t esi) {
+    roc_panic_if_not(valid());
+
+    const packet::blknum_t begin_esi = packet::blknum_t(esi - max_window_);
+
+    if (!has_position_) {
+        begin_esi_ = begin_esi;
+        begin_pos_ = 0;
+        has_position_ = true;
+        return;
+    }
+
+    const packet::blknum_diff_t dist = packet::blknum_diff(begin_esi, begin_esi_);
+    if (dist <= 0) {
+        return;
+    }
+
+    const size_t n_forget =
+        (size_t)dist < symbols_.size() ? (size_t)dist : symbols_.size();
+
+    for (size_t n = 0; n < n_forget; n++) {
+        symbols_[(begin_pos_ + n) % symbols_.size()] = core::Slice<uint8_t>();
+    }
+
+    begin_esi_ = begin_esi;
+    begin_pos_ = (begin_pos_ + (size_t)dist) % symbols_.size();
+
+    forget_repairs_();
+}
+
+void RLCDecoder::set_source(packet::blknum_t esi, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (!buffer) {
+        roc_panic("rlc decoder: null buffer");
+    }
+
+    size_t pos = 0;
+    if (!symbol_pos_(esi, pos)) {
+        return;
+    }
+
+    if (symbols_[pos]) {
+        return;
+    }
+
+    symbols_[pos] = buffer;
+    has_new_symbols_ = true;
+}
+
+void RLCDecoder::set_repair(packet::blknum_t first_esi,
+                            size_t n_source,
+                            uint16_t repair_key,
+                            uint8_t dt,
+                            const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (!buffer) {
+        roc_panic("rlc decoder: null buffer");
+    }
+
+    if (n_source == 0 || n_source > max_window_ || dt > RLCDenseThreshold) {
+        roc_log(LogDebug,
+                "rlc decoder: ignoring repair packet with invalid parameters:"
+                " n_source=%lu max_window=%lu dt=%u",
+                (unsigned long)n_source, (unsigned long)max_window_, (unsigned)dt);
+        return;
+    }
+
+    if (buffer.size() != payload_size_) {
+        roc_log(LogDebug,
+                "rlc decoder: ignoring repair packet with invalid payload size:"
+                " size=%lu expected=%lu",
+                (unsigned long)buffer.size(), (unsigned long)payload_size_);
+        return;
+    }
+
+    if (!has_position_) {
+        return;
+    }
+
+    const packet::blknum_diff_t dist = packet::blknum_diff(first_esi, begin_esi_);
+
+    // encoding window should be in tracked range and should end after
+    // the current position
+    if (dist < 0 || (size_t)dist + n_source > symbols_.size()
+        || (size_t)dist + n_source <= max_window_) {
+        return;
+    }
+
+    size_t index = n_repairs_;
+
+    if (index == repairs_.size()) {
+        // replace repair symbol whose encoding window ends first
+        index = 0;
+        for (size_t n = 1; n < n_repairs_; n++) {
+            if (packet::blknum_lt(
+                    packet::blknum_t(repairs_[n].first_esi + repairs_[n].n_source),
+                    packet::blknum_t(repairs_[index].first_esi
+                                     + repairs_[index].n_source))) {
+                index = n;
+            }
+        }
+    } else {
+        n_repairs_++;
+    }
+
+    RepairSymbol& repair = repairs_[index];
+
+    repair.buffer = buffer;
+    repair.first_esi = first_esi;
+    repair.n_source = n_source;
+    repair.repair_key = repair_key;
+    repair.dt = dt;
+
+    has_new_symbols_ = true;
+}
+
+core::Slice<uint8_t> RLCDecoder::repair(packet::blknum_t esi) {
+    roc_panic_if_not(valid());
+
+    size_t pos = 0;
+    if (!symbol_pos_(esi, pos)) {
+        return core::Slice<uint8_t>();
+    }
+
+    if (!symbols_[pos] && has_new_symbols_) {
+        decode_();
+        has_new_symbols_ = false;
+    }
+
+    return symbols_[pos];
+}
+
+bool RLCDecoder::symbol_pos_(packet::blknum_t esi, size_t& pos) const {
+    if (!has_position_) {
+        return false;
+    }
+
+    const packet::blknum_diff_t dist = packet::blknum_diff(esi, begin_esi_);
+    if (dist < 0 || (size_t)dist >= symbols_.size()) {
+        return false;
+    }
+
+    pos = (begin_pos_ + (size_t)dist) % symbols_.size();
+    return true;
+}
+
+// removes repair symbols which don't fit into tracked range anymore or
+// don't cover any symbol starting from the current position
+void RLCDecoder::forget_repairs_() {
+    size_t n = 0;
+
+    while (n < n_repairs_) {
+        const RepairSymbol& repair = repairs_[n];
+
+        const packet::blknum_diff_t dist =
+            packet::blknum_diff(repair.first_esi, begin_esi_);
+
+        if (dist >= 0 && (size_t)dist + repair.n_source > max_window_) {
+            n++;
+            continue;
+        }
+
+        n_repairs_--;
+        repairs_[n] = repairs_[n_repairs_];
+        repairs_[n_repairs_].buffer = core::Slice<uint8_t>();
+    }
+}
+
+void RLCDecoder::decode_() {
+    n_rows_ = 0;
+    n_cols_ = 0;
+
+    for (size_t n = 0; n < symbol_col_.size(); n++) {
+        symbol_col_[n] = NoColumn;
+    }
+
+    for (size_t n = 0; n < n_repairs_; n++) {
+        add_row_(repairs_[n]);
+    }
+
+    if (n_cols_ == 0) {
+        return;
+    }
+
+    eliminate_();
+    restore_symbols_();
+}
+
+// Every repair symbol is a linear combination of the source symbols of its
+// encoding window. After subtracting contribution of the known symbols, it
+// becomes an equation for the unknown ones. Columns are assigned to unknown
+// symbols in the order they appear.
+void RLCDecoder::add_row_(const RepairSymbol& repair) {
+    size_t first_pos = 0;
+    if (!symbol_pos_(repair.first_esi, first_pos)) {
+        return;
+    }
+
+    rlc_coefficients(repair.repair_key, repair.dt, &coefs_[0], repair.n_source);
+
+    bool has_unknown = false;
+    for (size_t i = 0; i < repair.n_source; i++) {
+        if (coefs_[i] != 0 && !symbols_[(first_pos + i) % symbols_.size()]) {
+            has_unknown = true;
+            break;
+        }
+    }
+
+    if (!has_unknown) {
+        return;
+    }
+
+    const size_t row = n_rows_++;
+    row_index_[row] = row;
+
+    uint8_t* coefs = &matrix_[row * symbols_.size()];
+    uint8_t* rhs = &rhs_[row * payload_size_];
+
+    memset(coefs, 0, symbols_.size());
+    memcpy(rhs, repair.buffer.data(), payload_size_);
+
+    for (size_t i = 0; i < repair.n_source; i++) {
+        if (coefs_[i] == 0) {
+            continue;
+        }
+
+        const size_t pos = (first_pos + i) % symbols_.size();
+        const core::Slice<uint8_t>& symbol = symbols_[pos];
+
+        if (symbol) {
+            const size_t size =
+                symbol.size() < payload_size_ ? symbol.size() : payload_size_;
+            gf256_mul_add_region(rhs, symbol.data(), coefs_[i], size);
+        } else {
+            if (symbol_col_[pos] == NoColumn) {
+                col_symbol_[n_cols_] = pos;
+                symbol_col_[pos] = n_cols_++;
+            }
+            coefs[symbol_col_[pos]] = coefs_[i];
+        }
+    }
+}
+
+// Reduces the system to reduced row echelon form. Rows are reordered
+// using row_index_ instead of moving the right-hand side symbols.
+void RLCDecoder::eliminate_() {
+    const size_t stride = symbols_.size();
+
+    size_t rank = 0;
+
+    for (size_t col = 0; col < n_cols_ && rank < n_rows_; col++) {
+        size_t pivot = rank;
+        while (pivot < n_rows_ && matrix_[row_index_[pivot] * stride + col] == 0) {
+            pivot++;
+        }
+
+        if (pivot == n_rows_) {
+            continue;
+        }
+
+        const size_t tmp = row_index_[pivot];
+        row_index_[pivot] = row_index_[rank];
+        row_index_[rank] = tmp;
+
+        uint8_t* pivot_coefs = &matrix_[row_index_[rank] * stride];
+        uint8_t* pivot_rhs = &rhs_[row_index_[rank] * payload_size_];
+
+        const uint8_t inv = gf256_inv(pivot_coefs[col]);
+        if (inv != 1) {
+            for (size_t j = col; j < n_cols_; j++) {
+                pivot_coefs[j] = gf256_mul(pivot_coefs[j], inv);
+            }
+            gf256_mul_region(pivot_rhs, pivot_rhs, inv, payload_size_);
+        }
+
+        for (size_t row = 0; row < n_rows_; row++) {
+            if (row == rank) {
+                continue;
+            }
+
+            uint8_t* coefs = &matrix_[row_index_[row] * stride];
+
+            const uint8_t factor = coefs[col];
+            if (factor == 0) {
+                continue;
+            }
+
+            for (size_t j = col; j < n_cols_; j++) {
+                coefs[j] ^= gf256_mul(factor, pivot_coefs[j]);
+            }
+            gf256_mul_add_region(&rhs_[row_index_[row] * payload_size_], pivot_rhs,
+                                 factor, payload_size_);
+        }
+
+        row_pivot_[rank] = col;
+        rank++;
+    }
+
+    n_rows_ = rank;
+}
+
+// A symbol is restored if the row with its pivot has no other non-zero
+// coefficients, i.e. it doesn't depend on other unknown symbols.
+void RLCDecoder::restore_symbols_() {
+    const size_t stride = symbols_.size();
+
+    size_t n_restored = 0;
+
+    for (size_t row = 0; row < n_rows_; row++) {
+        const uint8_t* coefs = &matrix_[row_index_[row] * stride];
+        const size_t col = row_pivot_[row];
+
+        bool solved = true;
+        for (size_t j = col + 1; j < n_cols_; j++) {
+            if (coefs[j] != 0) {
+                solved = false;
+                break;
+            }
+        }
+
+        if (!solved) {
+            continue;
+        }
+
+        core::Slice<uint8_t> buffer;
+        if (!make_buffer_(buffer)) {
+            continue;
+        }
+
+        memcpy(buffer.data(), &rhs_[row_index_[row] * payload_size_], payload_size_);
+
+        symbols_[col_symbol_[col]] = buffer;
+        n_restored++;
+    }
+
+    roc_log(LogDebug, "rlc decoder: repaired %lu/%lu symbols using %lu repair symbols",
+            (unsigned long)n_restored, (unsigned long)n_cols_,
+            (unsigned long)n_repairs_);
+}
+
+bool RLCDecoder::make_buffer_(core::Slice<uint8_t>& buffer) {
+    buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+
+    if (!buffer) {
+        roc_log(LogError, "rlc decoder: can't allocate buffer");
+        return false;
+    }
+
+    if (buffer.capacity() < payload_size_) {
+        roc_log(LogError, "rlc decoder: packet size too large: size=%lu max=%lu",
+                (unsigned long)payload_size_, (unsigned long)buffer.capacity());
+        buffer = core::Slice<uint8_t>();
+        return false;
+    }
+
+    buffer.resize(payload_size_);
+
+    return true;
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_decoder.h
+//! @brief RLC (m=8) decoder.
+
+#ifndef ROC_FEC_RLC_DECODER_H_
+#define ROC_FEC_RLC_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/config.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace fec {
+
+//! Sliding window RLC (m=8) decoder.
+//! @remarks
+//!  Implements the decoding part of RFC 8681 scheme over GF(2^8).
+//!
+//!  The decoder keeps source symbols in range [pos - W; pos + W), where
+//!  pos is the position set by advance() and W is the maximum encoding
+//!  window size, and repair symbols whose encoding windows lie in this
+//!  range and end after pos. Lost source symbols are restored by solving
+//!  the linear system formed by repair symbols using Gaussian elimination.
+//!
+//!  The only memory allocated after construction is the buffers for
+//!  repaired packets, which are taken from the buffer pool.
+class RLCDecoder : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Encoding window holds up to config.n_source_packets symbols, and
+    //!  up to 2 * config.n_repair_packets + 2 repair symbols are kept.
+    RLCDecoder(const Config& config,
+               size_t payload_size,
+               core::BufferPool<uint8_t>& buffer_pool,
+               core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get maximum number of source symbols in encoding window.
+    size_t max_window() const;
+
+    //! Set ESI of the next source symbol that will be requested.
+    //! @remarks
+    //!  Forgets source and repair symbols which can't be used to repair
+    //!  symbols starting from @p esi. The position can't move backwards.
+    //!  Should be called before passing any symbols to decoder.
+    void advance(packet::blknum_t esi);
+
+    //! Store source symbol.
+    //! @remarks
+    //!  Ignored if the symbol is out of range or is already known.
+    void set_source(packet::blknum_t esi, const core::Slice<uint8_t>& buffer);
+
+    //! Store repair symbol.
+    //! @remarks
+    //!  @p first_esi and @p n_source define the encoding window, and
+    //!  @p repair_key and @p dt define the coding coefficients. Ignored if
+    //!  the encoding window is out of range or parameters are invalid.
+    void set_repair(packet::blknum_t first_esi,
+                    size_t n_source,
+                    uint16_t repair_key,
+                    uint8_t dt,
+                    const core::Slice<uint8_t>& buffer);
+
+    //! Get source symbol, repairing it if necessary.
+    //! @returns
+    //!  received or repaired symbol, or null slice if the symbol is lost
+    //!  and can't be repaired with the symbols passed so far.
+    core::Slice<uint8_t> repair(packet::blknum_t esi);
+
+private:
+    struct RepairSymbol {
+        core::Slice<uint8_t> buffer;
+        packet::blknum_t first_esi;
+        size_t n_source;
+        uint16_t repair_key;
+        uint8_t dt;
+    };
+
+    bool symbol_pos_(packet::blknum_t esi, size_t& pos) const;
+
+    void forget_repairs_();
+    void add_row_(const RepairSymbol& repair);
+    void decode_();
+    void eliminate_();
+    void restore_symbols_();
+
+    bool make_buffer_(core::Slice<uint8_t>& buffer);
+
+    const size_t max_window_;
+    const size_t payload_size_;
+
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    // ring buffer with source symbols; symbols_[begin_pos_] corresponds
+    // to ESI begin_esi_
+    core::Array<core::Slice<uint8_t> > symbols_;
+    packet::blknum_t begin_esi_;
+    size_t begin_pos_;
+
+    core::Array<RepairSymbol> repairs_;
+    size_t n_repairs_;
+
+    bool has_position_;
+    bool has_new_symbols_;
+
+    // linear system: rows_ x cols_ coefficient matrix with row stride
+    // symbols_.size(), right-hand side symbols, and indices of rows
+    core::Array<uint8_t> matrix_;
+    core::Array<uint8_t> rhs_;
+    core::Array<size_t> row_index_;
+    size_t n_rows_;
+
+    // pivot column of every row of the reduced matrix, or -1
+    core::Array<size_t> row_pivot_;
+
+    // maps columns to symbol positions and vice versa
+    core::Array<size_t> col_symbol_;
+    core::Array<size_t> symbol_col_;
+    size_t n_cols_;
+
+    core::Array<uint8_t> coefs_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_DECODER_H_
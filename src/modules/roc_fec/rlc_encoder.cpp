@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/rlc_coefficients.h"
+
+namespace roc {
+namespace fec {
+
+RLCEncoder::RLCEncoder(const Config& config,
+                       size_t payload_size,
+                       core::IAllocator& allocator)
+    : payload_size_(payload_size)
+    , window_(allocator)
+    , window_begin_(0)
+    , window_size_(0)
+    , coefs_(allocator)
+    , valid_(false) {
+    if (config.codec != RLC8m) {
+        roc_log(LogError, "rlc encoder: unsupported codec");
+        return;
+    }
+
+    if (config.n_source_packets == 0 || config.n_source_packets > RLCMaxWindow) {
+        roc_log(LogError, "rlc encoder: invalid window size: n_source=%lu max=%lu",
+                (unsigned long)config.n_source_packets, (unsigned long)RLCMaxWindow);
+        return;
+    }
+
+    if (!window_.resize(config.n_source_packets)) {
+        return;
+    }
+
+    if (!coefs_.resize(config.n_source_packets)) {
+        return;
+    }
+
+    roc_log(LogDebug, "rlc encoder: initializing: max_window=%lu isa=%s",
+            (unsigned long)config.n_source_packets, gf256_region_isa());
+
+    valid_ = true;
+}
+
+bool RLCEncoder::valid() const {
+    return valid_;
+}
+
+size_t RLCEncoder::alignment() const {
+    return Alignment;
+}
+
+size_t RLCEncoder::max_window() const {
+    roc_panic_if_not(valid());
+
+    return window_.size();
+}
+
+size_t RLCEncoder::window() const {
+    roc_panic_if_not(valid());
+
+    return window_size_;
+}
+
+void RLCEncoder::add(const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (!buffer) {
+        roc_panic("rlc encoder: null buffer");
+    }
+
+    if (window_size_ == window_.size()) {
+        window_[window_begin_] = buffer;
+        window_begin_ = (window_begin_ + 1) % window_.size();
+    } else {
+        window_[(window_begin_ + window_size_) % window_.size()] = buffer;
+        window_size_++;
+    }
+}
+
+void RLCEncoder::encode(uint16_t repair_key, uint8_t dt, core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (!buffer) {
+        roc_panic("rlc encoder: null buffer");
+    }
+
+    if (buffer.size() != payload_size_) {
+        roc_panic("rlc encoder: invalid repair buffer size: size=%lu, expected=%lu",
+                  (unsigned long)buffer.size(), (unsigned long)payload_size_);
+    }
+
+    rlc_coefficients(repair_key, dt, &coefs_[0], window_size_);
+
+    uint8_t* repair = buffer.data();
+
+    memset(repair, 0, payload_size_);
+
+    for (size_t i = 0; i < window_size_; i++) {
+        if (coefs_[i] == 0) {
+            continue;
+        }
+
+        const core::Slice<uint8_t>& source =
+            window_[(window_begin_ + i) % window_.size()];
+
+        const size_t size =
+            source.size() < payload_size_ ? source.size() : payload_size_;
+
+        gf256_mul_add_region(repair, source.data(), coefs_[i], size);
+    }
+}
+
+void RLCEncoder::reset() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < window_.size(); i++) {
+        window_[i] = core::Slice<uint8_t>();
+    }
+
+    window_begin_ = 0;
+    window_size_ = 0;
+}
+
+} // namespace fec
+} // namespace roc
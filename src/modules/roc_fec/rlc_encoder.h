@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_encoder.h
+//! @brief RLC (m=8) encoder.
+
+#ifndef ROC_FEC_RLC_ENCODER_H_
+#define ROC_FEC_RLC_ENCODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/config.h"
+
+namespace roc {
+namespace fec {
+
+//! Sliding window RLC (m=8) encoder.
+//! @remarks
+//!  Implements the encoding part of RFC 8681 scheme over GF(2^8). Keeps
+//!  the last source symbols in the encoding window, and computes repair
+//!  symbols as linear combinations of them. Doesn't allocate memory after
+//!  construction.
+class RLCEncoder : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Encoding window holds up to config.n_source_packets symbols.
+    RLCEncoder(const Config& config, size_t payload_size, core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get buffer alignment requirement.
+    size_t alignment() const;
+
+    //! Get maximum number of source symbols in encoding window.
+    size_t max_window() const;
+
+    //! Get current number of source symbols in encoding window.
+    size_t window() const;
+
+    //! Add source symbol to encoding window.
+    //! @remarks
+    //!  If the window is full, the oldest symbol is removed from it.
+    //!  Buffers shorter than payload size are padded with zeros.
+    void add(const core::Slice<uint8_t>& buffer);
+
+    //! Compute repair symbol.
+    //! @remarks
+    //!  Fills @p buffer with a linear combination of all symbols in the
+    //!  encoding window, with coefficients derived from @p repair_key and
+    //!  @p dt. @p buffer size should be equal to payload size.
+    void encode(uint16_t repair_key, uint8_t dt, core::Slice<uint8_t>& buffer);
+
+    //! Remove all symbols from encoding window.
+    void reset();
+
+private:
+    enum { Alignment = 16 };
+
+    const size_t payload_size_;
+
+    // ring buffer with source symbols of the encoding window
+    core::Array<core::Slice<uint8_t> > window_;
+    size_t window_begin_;
+    size_t window_size_;
+
+    core::Array<uint8_t> coefs_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_ENCODER_H_
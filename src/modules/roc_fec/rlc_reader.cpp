@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_reader.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/rlc_coefficients.h"
+
+namespace roc {
+namespace fec {
+
+RLCReader::RLCReader(const Config& config,
+                     RLCDecoder& decoder,
+                     packet::IReader& source_reader,
+                     packet::IReader& repair_reader,
+                     packet::IParser& parser,
+                     packet::PacketPool& packet_pool,
+                     core::IAllocator& allocator)
+    : n_source_packets_(config.n_source_packets)
+    , n_repair_packets_(config.n_repair_packets)
+    , decoder_(decoder)
+    , source_reader_(source_reader)
+    , repair_reader_(repair_reader)
+    , parser_(parser)
+    , packet_pool_(packet_pool)
+    , source_queue_(0)
+    , repair_queue_(0)
+    , window_(allocator)
+    , window_pos_(0)
+    , n_window_packets_(0)
+    , valid_(false)
+    , alive_(true)
+    , started_(false)
+    , next_esi_(0)
+    , has_source_(false)
+    , source_(0)
+    , n_packets_(0) {
+    if (n_source_packets_ != decoder_.max_window()) {
+        roc_log(LogError, "rlc reader: window size mismatch: reader=%lu decoder=%lu",
+                (unsigned long)n_source_packets_, (unsigned long)decoder_.max_window());
+        return;
+    }
+    if (!window_.resize(n_source_packets_)) {
+        return;
+    }
+    valid_ = true;
+}
+
+bool RLCReader::valid() const {
+    return valid_;
+}
+
+bool RLCReader::started() const {
+    return started_;
+}
+
+bool RLCReader::alive() const {
+    return alive_;
+}
+
+packet::PacketPtr RLCReader::read() {
+    roc_panic_if_not(valid());
+    if (!alive_) {
+        return NULL;
+    }
+    packet::PacketPtr pp = read_();
+    if (pp) {
+        n_packets_++;
+    }
+    // Check if alive_ have changed.
+    return (alive_ ? pp : NULL);
+}
+
+packet::PacketPtr RLCReader::read_() {
+    fetch_packets_();
+
+    if (!started_) {
+        packet::PacketPtr pp = source_queue_.head();
+        if (!pp) {
+            return NULL;
+        }
+
+        if (!has_source_) {
+            source_ = pp->rtp()->source;
+            has_source_ = true;
+        }
+
+        next_esi_ = pp->fec()->source_block_number;
+        decoder_.advance(next_esi_);
+
+        roc_log(LogDebug, "rlc reader: got first packet, start decoding:"
+                          " sn=%lu esi=%lu",
+                (unsigned long)pp->rtp()->seqnum, (unsigned long)next_esi_);
+
+        started_ = true;
+    }
+
+    return get_next_packet_();
+}
+
+packet::PacketPtr RLCReader::get_next_packet_() {
+    for (;;) {
+        update_packets_();
+
+        packet::PacketPtr pp = window_[window_pos_];
+        if (!pp) {
+            pp = repair_packet_();
+        }
+
+        if (pp) {
+            next_packet_();
+            return pp;
+        }
+
+        if (n_window_packets_ == 0) {
+            // next packets are not in the window yet, so we can't repair
+            // anything until we reach them
+            packet::PacketPtr head = source_queue_.head();
+            if (!head) {
+                return NULL;
+            }
+
+            roc_log(LogDebug, "rlc reader: jumping over lost packets: esi=%lu->%lu",
+                    (unsigned long)next_esi_,
+                    (unsigned long)head->fec()->source_block_number);
+
+            next_esi_ = head->fec()->source_block_number;
+            decoder_.advance(next_esi_);
+            continue;
+        }
+
+        // packet is lost and can't be repaired, skip it
+        next_packet_();
+    }
+}
+
+packet::PacketPtr RLCReader::repair_packet_() {
+    core::Slice<uint8_t> buffer = decoder_.repair(next_esi_);
+    if (!buffer) {
+        return NULL;
+    }
+
+    packet::PacketPtr pp = new (packet_pool_) packet::Packet(packet_pool_);
+    if (!pp) {
+        roc_log(LogError, "rlc reader: can't allocate packet");
+        return NULL;
+    }
+
+    if (!parser_.parse(*pp, buffer)) {
+        roc_log(LogDebug, "rlc reader: can't parse repaired packet");
+        return NULL;
+    }
+
+    pp->set_data(buffer);
+
+    if (!check_packet_(pp)) {
+        roc_log(LogDebug, "rlc reader: dropping unexpected repaired packet");
+        return NULL;
+    }
+
+    return pp;
+}
+
+void RLCReader::next_packet_() {
+    if (window_[window_pos_]) {
+        window_[window_pos_] = NULL;
+        n_window_packets_--;
+    }
+
+    window_pos_ = (window_pos_ + 1) % window_.size();
+    next_esi_++;
+
+    decoder_.advance(next_esi_);
+}
+
+bool RLCReader::check_packet_(const packet::PacketPtr& pp) {
+    roc_panic_if_not(has_source_);
+
+    if (!pp->rtp()) {
+        roc_log(LogDebug, "rlc reader: repaired unexpected non-rtp packet");
+        return false;
+    }
+
+    if (pp->rtp()->source != source_) {
+        roc_log(LogDebug,
+                "rlc reader: repaired packet has bad source id, shutting down:"
+                " got=%lu expected=%lu",
+                (unsigned long)pp->rtp()->source, (unsigned long)source_);
+        return (alive_ = false);
+    }
+
+    return true;
+}
+
+void RLCReader::fetch_packets_() {
+    while (source_queue_.size() <= n_source_packets_ * 2) {
+        if (packet::PacketPtr pp = source_reader_.read()) {
+            if (!pp->rtp()) {
+                roc_panic("rlc reader: unexpected non-rtp source packet");
+            }
+            if (!pp->fec()) {
+                roc_panic("rlc reader: unexpected non-fec source packet");
+            }
+            source_queue_.write(pp);
+        } else {
+            break;
+        }
+    }
+
+    while (repair_queue_.size() <= (n_source_packets_ + n_repair_packets_) * 2) {
+        if (packet::PacketPtr pp = repair_reader_.read()) {
+            if (!pp->fec()) {
+                roc_panic("rlc reader: unexpected non-fec repair packet");
+            }
+            repair_queue_.write(pp);
+        } else {
+            break;
+        }
+    }
+}
+
+void RLCReader::update_packets_() {
+    update_source_packets_();
+    update_repair_packets_();
+}
+
+void RLCReader::update_source_packets_() {
+    unsigned n_fetched = 0, n_added = 0, n_dropped = 0;
+
+    for (;;) {
+        packet::PacketPtr pp = source_queue_.head();
+        if (!pp) {
+            break;
+        }
+
+        const packet::FEC* fec = pp->fec();
+
+        const packet::blknum_diff_t dist =
+            packet::blknum_diff(fec->source_block_number, next_esi_);
+
+        if (dist >= 0 && (size_t)dist >= window_.size()) {
+            break;
+        }
+
+        source_queue_.read();
+        n_fetched++;
+
+        if (dist < 0) {
+            roc_log(LogTrace, "rlc reader: dropping late source packet:"
+                              " next_esi=%lu pkt_esi=%lu pkt_sn=%lu",
+                    (unsigned long)next_esi_, (unsigned long)fec->source_block_number,
+                    (unsigned long)pp->rtp()->seqnum);
+            n_dropped++;
+            continue;
+        }
+
+        const size_t pos = (window_pos_ + (size_t)dist) % window_.size();
+
+        if (!window_[pos]) {
+            window_[pos] = pp;
+            n_window_packets_++;
+            n_added++;
+
+            decoder_.set_source(fec->source_block_number, fec->payload);
+        }
+    }
+
+    if (n_dropped != 0 || n_fetched != n_added) {
+        roc_log(LogDebug, "rlc reader: source queue: fetched=%u added=%u dropped=%u",
+                n_fetched, n_added, n_dropped);
+    }
+}
+
+void RLCReader::update_repair_packets_() {
+    unsigned n_fetched = 0, n_added = 0, n_dropped = 0;
+
+    for (;;) {
+        packet::PacketPtr pp = repair_queue_.head();
+        if (!pp) {
+            break;
+        }
+
+        const packet::FEC* fec = pp->fec();
+        if (!fec) {
+            roc_panic("rlc reader: unexpected non-fec repair packet");
+        }
+
+        const bool bad_window =
+            fec->source_block_length == 0 || fec->source_block_length > window_.size();
+
+        // distance from the next packet to the end of encoding window
+        const packet::blknum_diff_t dist = packet::blknum_diff(
+            packet::blknum_t(fec->source_block_number + fec->source_block_length),
+            next_esi_);
+
+        if (!bad_window && dist > 0 && (size_t)dist > window_.size()) {
+            break;
+        }
+
+        repair_queue_.read();
+        n_fetched++;
+
+        if (bad_window || dist <= 0) {
+            roc_log(LogTrace, "rlc reader: dropping repair packet:"
+                              " next_esi=%lu pkt_esi=%lu pkt_nss=%lu",
+                    (unsigned long)next_esi_, (unsigned long)fec->source_block_number,
+                    (unsigned long)fec->source_block_length);
+            n_dropped++;
+            continue;
+        }
+
+        uint8_t dt = RLCDenseThreshold;
+        if (fec->payload_id.size() == sizeof(RLC_Repair_PayloadID)) {
+            dt = ((const RLC_Repair_PayloadID*)fec->payload_id.data())->dt();
+        }
+
+        decoder_.set_repair(fec->source_block_number, fec->source_block_length,
+                            (uint16_t)fec->encoding_symbol_id, dt, fec->payload);
+        n_added++;
+    }
+
+    if (n_dropped != 0 || n_fetched != n_added) {
+        roc_log(LogDebug, "rlc reader: repair queue: fetched=%u added=%u dropped=%u",
+                n_fetched, n_added, n_dropped);
+    }
+}
+
+} // namespace fec
+} // namespace roc
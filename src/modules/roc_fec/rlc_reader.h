@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_reader.h
+//! @brief Sliding window FEC reader.
+
+#ifndef ROC_FEC_RLC_READER_H_
+#define ROC_FEC_RLC_READER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_fec/config.h"
+#include "roc_fec/rlc_decoder.h"
+#include "roc_packet/iparser.h"
+#include "roc_packet/ireader.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/sorted_queue.h"
+
+namespace roc {
+namespace fec {
+
+//! Sliding window FEC reader.
+//! @remarks
+//!  Returns source packets in order of their ESI. Unlike Reader, doesn't
+//!  wait for the beginning of a block, and a lost packet can be repaired
+//!  as soon as a repair packet covering it and the other lost packets
+//!  arrives.
+class RLCReader : public packet::IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p config contains FEC scheme parameters
+    //!  - @p decoder specifies FEC codec implementation;
+    //!  - @p source_reader specifies input queue with data packets;
+    //!  - @p repair_reader specifies input queue with FEC packets;
+    //!  - @p parser specifies packet parser for restored packets.
+    //!  - @p allocator is used to initialize a packet array
+    RLCReader(const Config& config,
+              RLCDecoder& decoder,
+              packet::IReader& source_reader,
+              packet::IReader& repair_reader,
+              packet::IParser& parser,
+              packet::PacketPool& packet_pool,
+              core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Did reader get the first packet?
+    bool started() const;
+
+    //! Is reader alive?
+    bool alive() const;
+
+    //! Read packet.
+    //! @remarks
+    //!  When a packet loss is detected, try to restore it from repair packets.
+    virtual packet::PacketPtr read();
+
+private:
+    packet::PacketPtr read_();
+    packet::PacketPtr get_next_packet_();
+    packet::PacketPtr repair_packet_();
+
+    void next_packet_();
+    bool has_later_packets_() const;
+
+    void fetch_packets_();
+    void update_packets_();
+    void update_source_packets_();
+    void update_repair_packets_();
+
+    bool check_packet_(const packet::PacketPtr& pp);
+
+    const size_t n_source_packets_;
+    const size_t n_repair_packets_;
+
+    RLCDecoder& decoder_;
+
+    packet::IReader& source_reader_;
+    packet::IReader& repair_reader_;
+    packet::IParser& parser_;
+
+    packet::PacketPool& packet_pool_;
+
+    packet::SortedQueue source_queue_;
+    packet::SortedQueue repair_queue_;
+
+    // ring buffer with source packets starting from next_esi_;
+    // window_[window_pos_] corresponds to next_esi_
+    core::Array<packet::PacketPtr> window_;
+    size_t window_pos_;
+    size_t n_window_packets_;
+
+    bool valid_;
+
+    bool alive_;
+    bool started_;
+
+    packet::blknum_t next_esi_;
+
+    bool has_source_;
+    packet::source_t source_;
+
+    unsigned n_packets_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_READER_H_
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_writer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/random.h"
+#include "roc_fec/rlc_coefficients.h"
+
+namespace roc {
+namespace fec {
+
+RLCWriter::RLCWriter(const Config& config,
+                     size_t payload_size,
+                     RLCEncoder& encoder,
+                     packet::IWriter& writer,
+                     packet::IComposer& source_composer,
+                     packet::IComposer& repair_composer,
+                     packet::PacketPool& packet_pool,
+                     core::BufferPool<uint8_t>& buffer_pool)
+    : n_source_packets_(config.n_source_packets)
+    , n_repair_packets_(config.n_repair_packets)
+    , payload_size_(payload_size)
+    , encoder_(encoder)
+    , writer_(writer)
+    , source_composer_(source_composer)
+    , repair_composer_(repair_composer)
+    , packet_pool_(packet_pool)
+    , buffer_pool_(buffer_pool)
+    , cur_esi_((packet::blknum_t)core::random(packet::blknum_t(-1)))
+    , cur_repair_key_((uint16_t)core::random(uint16_t(-1)))
+    , repair_credit_(0)
+    , valid_(false) {
+    if (n_source_packets_ == 0) {
+        roc_log(LogError, "rlc writer: invalid window size: n_source=%lu",
+                (unsigned long)n_source_packets_);
+        return;
+    }
+    valid_ = true;
+}
+
+bool RLCWriter::valid() const {
+    return valid_;
+}
+
+void RLCWriter::write(const packet::PacketPtr& pp) {
+    roc_panic_if_not(valid());
+    roc_panic_if_not(pp);
+
+    if (!pp->rtp()) {
+        roc_panic("rlc writer: unexpected non-rtp packet");
+    }
+
+    if (!pp->fec()) {
+        roc_panic("rlc writer: unexpected non-fec packet");
+    }
+
+    packet::FEC& fec = *pp->fec();
+
+    fec.encoding_symbol_id = 0;
+    fec.source_block_number = cur_esi_;
+    fec.source_block_length = 0;
+    fec.block_length = 0;
+
+    pp->add_flags(packet::Packet::FlagComposed);
+
+    if (!source_composer_.compose(*pp)) {
+        roc_panic("rlc writer: can't compose packet");
+    }
+    writer_.write(pp);
+
+    encoder_.add(fec.payload);
+    cur_esi_++;
+
+    repair_credit_ += n_repair_packets_;
+
+    while (repair_credit_ >= n_source_packets_) {
+        repair_credit_ -= n_source_packets_;
+        write_repair_packet_();
+    }
+}
+
+void RLCWriter::write_repair_packet_() {
+    packet::PacketPtr rp = make_repair_packet_();
+    if (!rp) {
+        roc_log(LogDebug, "rlc writer: can't create repair packet");
+        return;
+    }
+
+    packet::FEC& fec = *rp->fec();
+
+    const size_t window = encoder_.window();
+
+    fec.encoding_symbol_id = cur_repair_key_;
+    fec.source_block_number = packet::blknum_t(cur_esi_ - window);
+    fec.source_block_length = window;
+    fec.block_length = 0;
+
+    encoder_.encode(cur_repair_key_, RLCDenseThreshold, fec.payload);
+    cur_repair_key_++;
+
+    writer_.write(rp);
+}
+
+packet::PacketPtr RLCWriter::make_repair_packet_() {
+    packet::PacketPtr packet = new (packet_pool_) packet::Packet(packet_pool_);
+    if (!packet) {
+        roc_log(LogError, "rlc writer: can't allocate packet");
+        return NULL;
+    }
+
+    core::Slice<uint8_t> data = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+    if (!data) {
+        roc_log(LogError, "rlc writer: can't allocate buffer");
+        return NULL;
+    }
+
+    if (!repair_composer_.align(data, 0, encoder_.alignment())) {
+        roc_log(LogError, "rlc writer: can't align packet buffer");
+        return NULL;
+    }
+
+    if (!repair_composer_.prepare(*packet, data, payload_size_)) {
+        roc_log(LogError, "rlc writer: can't prepare packet");
+        return NULL;
+    }
+
+    if (!packet->fec()) {
+        roc_panic("rlc writer: unexpected non-fec composer");
+    }
+
+    packet->set_data(data);
+
+    return packet;
+}
+
+} // namespace fec
+} // namespace roc
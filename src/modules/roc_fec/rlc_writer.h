@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_writer.h
+//! @brief Sliding window FEC writer.
+
+#ifndef ROC_FEC_RLC_WRITER_H_
+#define ROC_FEC_RLC_WRITER_H_
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/noncopyable.h"
+#include "roc_fec/config.h"
+#include "roc_fec/rlc_encoder.h"
+#include "roc_packet/icomposer.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_pool.h"
+
+namespace roc {
+namespace fec {
+
+//! Sliding window FEC writer.
+//! @remarks
+//!  Unlike Writer, doesn't split packets into blocks. Every source packet
+//!  is added to the encoding window, and repair packets are generated from
+//!  the whole window at a constant rate: config.n_repair_packets repair
+//!  packets per config.n_source_packets source packets, spread evenly.
+//!  Hence a lost packet can be repaired as soon as the next repair packet
+//!  arrives.
+class RLCWriter : public packet::IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p config contains FEC scheme parameters
+    //!  - @p encoder is used to encode repair packets
+    //!  - @p writer is used to write source and repair packets
+    //!  - @p source_composer is used to format source packets
+    //!  - @p repair_composer is used to format repair packets
+    //!  - @p packet_pool is used to allocate repair packets
+    //!  - @p buffer_pool is used to allocate buffers for repair packets
+    RLCWriter(const Config& config,
+              size_t payload_size,
+              RLCEncoder& encoder,
+              packet::IWriter& writer,
+              packet::IComposer& source_composer,
+              packet::IComposer& repair_composer,
+              packet::PacketPool& packet_pool,
+              core::BufferPool<uint8_t>& buffer_pool);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Write packet.
+    //! @remarks
+    //!  - writes the given source packet to the output writer
+    //!  - generates repair packets when it's time and also writes them to
+    //!    the output writer
+    virtual void write(const packet::PacketPtr&);
+
+private:
+    void write_repair_packet_();
+    packet::PacketPtr make_repair_packet_();
+
+    const size_t n_source_packets_;
+    const size_t n_repair_packets_;
+    const size_t payload_size_;
+
+    RLCEncoder& encoder_;
+    packet::IWriter& writer_;
+
+    packet::IComposer& source_composer_;
+    packet::IComposer& repair_composer_;
+
+    packet::PacketPool& packet_pool_;
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    packet::blknum_t cur_esi_;
+    uint16_t cur_repair_key_;
+
+    // incremented by n_repair_packets_ for every source packet; a repair
+    // packet is generated every time it reaches n_source_packets_
+    size_t repair_credit_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_WRITER_H_
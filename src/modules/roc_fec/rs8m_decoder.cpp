@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+RS8MDecoder::RS8MDecoder(const Config& config,
+                         size_t payload_size,
+                         core::BufferPool<uint8_t>& buffer_pool,
+                         core::IAllocator& allocator)
+    : blk_source_packets_(config.n_source_packets)
+    , blk_repair_packets_(config.n_repair_packets)
+    , payload_size_(payload_size)
+    , matrix_(config.n_source_packets, config.n_repair_packets, allocator)
+    , buffer_pool_(buffer_pool)
+    , buff_tab_(allocator)
+    , recv_tab_(allocator)
+    , lost_index_(allocator)
+    , repair_index_(allocator)
+    , decode_matrix_(allocator)
+    , decode_temp_(allocator)
+    , decode_symbols_(allocator)
+    , status_(allocator)
+    , has_new_packets_(false)
+    , valid_(false) {
+    if (config.codec != ReedSolomon8m || config.rs_m != 8) {
+        roc_log(LogError, "rs8m decoder: unsupported codec");
+        return;
+    }
+
+    if (!matrix_.valid()) {
+        return;
+    }
+
+    if (!buff_tab_.resize(blk_source_packets_ + blk_repair_packets_)) {
+        return;
+    }
+    if (!recv_tab_.resize(blk_source_packets_ + blk_repair_packets_)) {
+        return;
+    }
+    if (!lost_index_.resize(blk_repair_packets_)) {
+        return;
+    }
+    if (!repair_index_.resize(blk_repair_packets_)) {
+        return;
+    }
+    if (!decode_matrix_.resize(blk_repair_packets_ * blk_repair_packets_)) {
+        return;
+    }
+    if (!decode_temp_.resize(blk_repair_packets_ * blk_repair_packets_)) {
+        return;
+    }
+    if (!decode_symbols_.resize(blk_repair_packets_ * payload_size_)) {
+        return;
+    }
+    if (!status_.resize(blk_source_packets_ + blk_repair_packets_ + 2)) {
+        return;
+    }
+
+    roc_log(LogDebug, "rs8m decoder: initializing: n_source=%lu n_repair=%lu isa=%s",
+            (unsigned long)blk_source_packets_, (unsigned long)blk_repair_packets_,
+            gf256_region_isa());
+
+    valid_ = true;
+}
+
+bool RS8MDecoder::valid() const {
+    return valid_;
+}
+
+void RS8MDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m decoder: null buffer");
+    }
+
+    if (buff_tab_[index]) {
+        roc_panic("rs8m decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    if (buffer.size() != payload_size_) {
+        roc_log(LogDebug,
+                "rs8m decoder: ignoring packet with invalid payload size:"
+                " index=%lu size=%lu expected=%lu",
+                (unsigned long)index, (unsigned long)buffer.size(),
+                (unsigned long)payload_size_);
+        return;
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    has_new_packets_ = true;
+}
+
+core::Slice<uint8_t> RS8MDecoder::repair(size_t index) {
+    roc_panic_if_not(valid());
+
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (!buff_tab_[index] && has_new_packets_) {
+        decode_();
+        has_new_packets_ = false;
+    }
+
+    return buff_tab_[index];
+}
+
+void RS8MDecoder::reset() {
+    roc_panic_if_not(valid());
+
+    report_();
+
+    has_new_packets_ = false;
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+}
+
+// Every repair symbol R is a linear combination of the source symbols. After
+// subtracting contribution of the available source symbols, it becomes
+// a combination of the lost ones only. Given as many repair symbols as there
+// are lost source symbols L, this gives R' = B * L, where B is a square matrix
+// made of the corresponding generator coefficients, and hence L = inv(B) * R'.
+void RS8MDecoder::decode_() {
+    const size_t k = blk_source_packets_;
+
+    size_t n_lost = 0;
+    for (size_t i = 0; i < k; ++i) {
+        if (buff_tab_[i]) {
+            continue;
+        }
+        if (n_lost == blk_repair_packets_) {
+            return;
+        }
+        lost_index_[n_lost++] = i;
+    }
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    size_t n_avail = 0;
+    for (size_t i = k; i < buff_tab_.size() && n_avail < n_lost; ++i) {
+        if (buff_tab_[i]) {
+            repair_index_[n_avail++] = i;
+        }
+    }
+
+    if (n_avail < n_lost) {
+        return;
+    }
+
+    for (size_t row = 0; row < n_lost; ++row) {
+        const uint8_t* coeffs = matrix_.row(repair_index_[row]);
+
+        for (size_t col = 0; col < n_lost; ++col) {
+            decode_matrix_[row * n_lost + col] = coeffs[lost_index_[col]];
+        }
+
+        uint8_t* symbol = &decode_symbols_[row * payload_size_];
+
+        memcpy(symbol, buff_tab_[repair_index_[row]].data(), payload_size_);
+
+        for (size_t i = 0; i < k; ++i) {
+            if (buff_tab_[i]) {
+                gf256_mul_add_region(symbol, buff_tab_[i].data(), coeffs[i],
+                                     payload_size_);
+            }
+        }
+    }
+
+    if (!gf256_invert_matrix(&decode_matrix_[0], &decode_temp_[0], n_lost)) {
+        roc_log(LogError, "rs8m decoder: can't invert decoding matrix");
+        return;
+    }
+
+    for (size_t row = 0; row < n_lost; ++row) {
+        const size_t index = lost_index_[row];
+
+        if (!make_buffer_(index)) {
+            continue;
+        }
+
+        uint8_t* data = buff_tab_[index].data();
+        const uint8_t* coeffs = &decode_matrix_[row * n_lost];
+
+        gf256_mul_region(data, &decode_symbols_[0], coeffs[0], payload_size_);
+
+        for (size_t col = 1; col < n_lost; ++col) {
+            gf256_mul_add_region(data, &decode_symbols_[col * payload_size_],
+                                 coeffs[col], payload_size_);
+        }
+    }
+}
+
+bool RS8MDecoder::make_buffer_(size_t index) {
+    core::Slice<uint8_t> buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+
+    if (!buffer) {
+        roc_log(LogError, "rs8m decoder: can't allocate buffer");
+        return false;
+    }
+
+    if (buffer.capacity() < payload_size_) {
+        roc_log(LogError, "rs8m decoder: packet size too large: size=%lu max=%lu",
+                (unsigned long)payload_size_, (unsigned long)buffer.capacity());
+        return false;
+    }
+
+    buffer.resize(payload_size_);
+    buff_tab_[index] = buffer;
+
+    return true;
+}
+
+void RS8MDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    status_[blk_source_packets_] = ' ';
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        char* status = (i < blk_source_packets_ ? &status_[i] : &status_[i + 1]);
+
+        if (buff_tab_[i]) {
+            if (recv_tab_[i]) {
+                *status = '.';
+            } else {
+                *status = 'r';
+                n_repaired++;
+                n_lost++;
+            }
+        } else {
+            if (i < blk_source_packets_) {
+                *status = 'X';
+            } else {
+                *status = 'x';
+            }
+            n_lost++;
+        }
+    }
+
+    status_[status_.size() - 1] = '\0';
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "rs8m decoder: repaired %u/%u/%u %s", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)buff_tab_.size(), &status_[0]);
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_decoder.h
+//! @brief Built-in Reed-Solomon (m=8) decoder.
+
+#ifndef ROC_FEC_RS8M_DECODER_H_
+#define ROC_FEC_RS8M_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/config.h"
+#include "roc_fec/idecoder.h"
+#include "roc_fec/rs8m_matrix.h"
+
+namespace roc {
+namespace fec {
+
+//! Built-in Reed-Solomon (m=8) decoder.
+//! @remarks
+//!  Decodes repair symbols produced by RS8MEncoder or OpenFEC Reed-Solomon
+//!  codec with m=8. The only memory allocated after construction is the
+//!  buffers for repaired packets, which are taken from the buffer pool.
+class RS8MDecoder : public IDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit RS8MDecoder(const Config& config,
+                         size_t payload_size,
+                         core::BufferPool<uint8_t>& buffer_pool,
+                         core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair(size_t index);
+
+    //! Reset current block.
+    virtual void reset();
+
+private:
+    void decode_();
+
+    bool make_buffer_(size_t index);
+
+    void report_();
+
+    const size_t blk_source_packets_;
+    const size_t blk_repair_packets_;
+    const size_t payload_size_;
+
+    RS8MMatrix matrix_;
+
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    // received and repaired source and repair packets
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    // true if packet is received, false if it's is lost or repaired
+    core::Array<bool> recv_tab_;
+
+    // indices of lost source packets and repair packets used to restore them
+    core::Array<size_t> lost_index_;
+    core::Array<size_t> repair_index_;
+
+    // decoding matrix and its inversion workspace
+    core::Array<uint8_t> decode_matrix_;
+    core::Array<uint8_t> decode_temp_;
+
+    // repair symbols with contribution of available source symbols removed
+    core::Array<uint8_t> decode_symbols_;
+
+    // for debug logging
+    core::Array<char> status_;
+
+    bool has_new_packets_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_DECODER_H_
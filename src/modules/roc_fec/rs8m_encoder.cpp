@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+RS8MEncoder::RS8MEncoder(const Config& config,
+                         size_t payload_size,
+                         core::IAllocator& allocator)
+    : blk_source_packets_(config.n_source_packets)
+    , blk_repair_packets_(config.n_repair_packets)
+    , payload_size_(payload_size)
+    , matrix_(config.n_source_packets, config.n_repair_packets, allocator)
+    , buff_tab_(allocator)
+    , valid_(false) {
+    if (config.codec != ReedSolomon8m || config.rs_m != 8) {
+        roc_log(LogError, "rs8m encoder: unsupported codec");
+        return;
+    }
+
+    if (!matrix_.valid()) {
+        return;
+    }
+
+    if (!buff_tab_.resize(blk_source_packets_ + blk_repair_packets_)) {
+        return;
+    }
+
+    roc_log(LogDebug, "rs8m encoder: initializing: n_source=%lu n_repair=%lu isa=%s",
+            (unsigned long)blk_source_packets_, (unsigned long)blk_repair_packets_,
+            gf256_region_isa());
+
+    valid_ = true;
+}
+
+bool RS8MEncoder::valid() const {
+    return valid_;
+}
+
+size_t RS8MEncoder::alignment() const {
+    return Alignment;
+}
+
+void RS8MEncoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= blk_source_packets_ + blk_repair_packets_) {
+        roc_panic("rs8m encoder: index out of bounds: index=%lu, size=%lu",
+                  (unsigned long)index,
+                  (unsigned long)(blk_source_packets_ + blk_repair_packets_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m encoder: null buffer");
+    }
+
+    if (index >= blk_source_packets_ && buffer.size() != payload_size_) {
+        roc_panic("rs8m encoder: invalid repair buffer size: size=%lu, expected=%lu",
+                  (unsigned long)buffer.size(), (unsigned long)payload_size_);
+    }
+
+    buff_tab_[index] = buffer;
+}
+
+void RS8MEncoder::commit() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = blk_source_packets_; i < blk_source_packets_ + blk_repair_packets_;
+         ++i) {
+        if (!buff_tab_[i]) {
+            continue;
+        }
+
+        uint8_t* repair = buff_tab_[i].data();
+        const uint8_t* coeffs = matrix_.row(i);
+
+        bool first = true;
+
+        for (size_t j = 0; j < blk_source_packets_; ++j) {
+            const core::Slice<uint8_t>& source = buff_tab_[j];
+
+            if (!source) {
+                roc_panic("rs8m encoder: missing source buffer: index=%lu",
+                          (unsigned long)j);
+            }
+
+            // Like OpenFEC, use only the first payload_size_ bytes of source
+            // buffers; shorter buffers are padded with zeros.
+            const size_t size =
+                source.size() < payload_size_ ? source.size() : payload_size_;
+
+            if (first && size == payload_size_) {
+                gf256_mul_region(repair, source.data(), coeffs[j], size);
+            } else {
+                if (first) {
+                    memset(repair, 0, payload_size_);
+                }
+                gf256_mul_add_region(repair, source.data(), coeffs[j], size);
+            }
+
+            first = false;
+        }
+    }
+}
+
+void RS8MEncoder::reset() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace fec
+} // namespace roc
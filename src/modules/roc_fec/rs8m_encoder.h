@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_encoder.h
+//! @brief Built-in Reed-Solomon (m=8) encoder.
+
+#ifndef ROC_FEC_RS8M_ENCODER_H_
+#define ROC_FEC_RS8M_ENCODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/config.h"
+#include "roc_fec/iencoder.h"
+#include "roc_fec/rs8m_matrix.h"
+
+namespace roc {
+namespace fec {
+
+//! Built-in Reed-Solomon (m=8) encoder.
+//! @remarks
+//!  Produces the same repair symbols as OpenFEC Reed-Solomon codec with m=8.
+//!  Doesn't allocate memory after construction.
+class RS8MEncoder : public IEncoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit RS8MEncoder(const Config& config,
+                         size_t payload_size,
+                         core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get buffer alignment requirement.
+    virtual size_t alignment() const;
+
+    //! Store packet data for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Fill repair packets.
+    virtual void commit();
+
+    //! Reset current block.
+    virtual void reset();
+
+private:
+    enum { Alignment = 16 };
+
+    const size_t blk_source_packets_;
+    const size_t blk_repair_packets_;
+    const size_t payload_size_;
+
+    RS8MMatrix matrix_;
+
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_ENCODER_H_
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_matrix.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+RS8MMatrix::RS8MMatrix(size_t n_source, size_t n_repair, core::IAllocator& allocator)
+    : n_source_(n_source)
+    , n_total_(n_source + n_repair)
+    , matrix_(allocator)
+    , valid_(false) {
+    if (n_source_ == 0 || n_total_ > MaxSymbols) {
+        roc_log(LogError,
+                "rs8m matrix: invalid block size: n_source=%lu n_repair=%lu max=%lu",
+                (unsigned long)n_source, (unsigned long)n_repair,
+                (unsigned long)MaxSymbols);
+        return;
+    }
+
+    if (!matrix_.resize(n_total_ * n_source_)) {
+        roc_log(LogError, "rs8m matrix: can't allocate matrix");
+        return;
+    }
+
+    if (!build_(allocator)) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool RS8MMatrix::valid() const {
+    return valid_;
+}
+
+size_t RS8MMatrix::n_source() const {
+    return n_source_;
+}
+
+size_t RS8MMatrix::n_total() const {
+    return n_total_;
+}
+
+const uint8_t* RS8MMatrix::row(size_t index) const {
+    roc_panic_if_not(valid());
+
+    if (index >= n_total_) {
+        roc_panic("rs8m matrix: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)n_total_);
+    }
+
+    return &matrix_[index * n_source_];
+}
+
+bool RS8MMatrix::build_(core::IAllocator& allocator) {
+    const size_t k = n_source_;
+    const size_t n = n_total_;
+
+    // Vandermonde matrix with rows evaluated at 0, a^0, a^1, ..., a^(n-2),
+    // where a is the primitive element. Any k rows are linearly independent.
+    core::Array<uint8_t> vdm(allocator);
+    core::Array<uint8_t> temp(allocator);
+
+    if (!vdm.resize(n * k) || !temp.resize(k * k)) {
+        roc_log(LogError, "rs8m matrix: can't allocate temporary matrix");
+        return false;
+    }
+
+    for (size_t col = 0; col < k; col++) {
+        vdm[col] = (col == 0 ? 1 : 0);
+    }
+    for (size_t row = 1; row < n; row++) {
+        for (size_t col = 0; col < k; col++) {
+            vdm[row * k + col] = gf256_exp((row - 1) * col);
+        }
+    }
+
+    // Make the code systematic: multiply the matrix by the inverse of its top
+    // k x k square, so that the top square becomes identity.
+    if (!gf256_invert_matrix(&vdm[0], &temp[0], k)) {
+        roc_log(LogError, "rs8m matrix: can't invert vandermonde matrix");
+        return false;
+    }
+
+    for (size_t row = 0; row < k; row++) {
+        for (size_t col = 0; col < k; col++) {
+            matrix_[row * k + col] = (row == col ? 1 : 0);
+        }
+    }
+
+    for (size_t row = k; row < n; row++) {
+        for (size_t col = 0; col < k; col++) {
+            uint8_t sum = 0;
+            for (size_t i = 0; i < k; i++) {
+                sum ^= gf256_mul(vdm[row * k + i], vdm[i * k + col]);
+            }
+            matrix_[row * k + col] = sum;
+        }
+    }
+
+    return true;
+}
+
+} // namespace fec
+} // namespace roc
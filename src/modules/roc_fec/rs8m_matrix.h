@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_matrix.h
+//! @brief Reed-Solomon (m=8) generator matrix.
+
+#ifndef ROC_FEC_RS8M_MATRIX_H_
+#define ROC_FEC_RS8M_MATRIX_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Reed-Solomon (m=8) generator matrix.
+//! @remarks
+//!  Systematic generator matrix of the Reed-Solomon code over GF(2^8) defined
+//!  in RFC 5510 and RFC 6865. It is derived from a Vandermonde matrix in the
+//!  same way as in the reference implementation by L. Rizzo, which is also
+//!  used by OpenFEC, so the repair symbols are bit-exact with OpenFEC.
+class RS8MMatrix : public core::NonCopyable<> {
+public:
+    //! Maximum number of encoding symbols in block.
+    static const size_t MaxSymbols = 255;
+
+    //! Initialize.
+    RS8MMatrix(size_t n_source, size_t n_repair, core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get number of source symbols in block.
+    size_t n_source() const;
+
+    //! Get total number of source and repair symbols in block.
+    size_t n_total() const;
+
+    //! Get coefficients of encoding symbol.
+    //! @remarks
+    //!  Returns n_source() coefficients. Encoding symbol with given @p index
+    //!  is a linear combination of the source symbols with these coefficients.
+    //!  For source symbols, it's a unit vector.
+    const uint8_t* row(size_t index) const;
+
+private:
+    bool build_(core::IAllocator& allocator);
+
+    const size_t n_source_;
+    const size_t n_total_;
+
+    core::Array<uint8_t> matrix_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_MATRIX_H_
@@ -35,6 +35,7 @@ OFDecoder::OFDecoder(const Config& config,
     , status_(allocator)
     , has_new_packets_(false)
     , decoding_finished_(false)
+    , session_used_(false)
     , valid_(false) {
     if (!buff_tab_.resize(blk_source_packets_ + blk_repair_packets_)) {
         return;
@@ -73,6 +74,8 @@ OFDecoder::OFDecoder(const Config& config,
     of_sess_params_->encoding_symbol_length = (uint32_t)payload_size_;
     of_verbosity = 0;
 
+    reset_session_();
+
     OFDecoder::reset(); // non-virtual call from ctor
 
     valid_ = true;
@@ -116,6 +119,12 @@ void OFDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
     data_tab_[index] = buffer.data();
     recv_tab_[index] = true;
 
+    // packets are passed to the session only when a repair is requested,
+    // so that blocks without losses don't need a new session
+    if (!session_used_) {
+        return;
+    }
+
     // register new packet and try to repair more packets
     if (of_decode_with_new_symbol(of_sess_, data_tab_[index], (unsigned int)index)
         != OF_STATUS_OK) {
@@ -135,13 +144,13 @@ core::Slice<uint8_t> OFDecoder::repair(size_t index) {
 }
 
 void OFDecoder::reset() {
-    if (of_sess_ != NULL) {
+    if (session_used_) {
         report_();
         destroy_session_();
+        reset_session_();
     }
 
-    reset_session_();
-
+    session_used_ = false;
     has_new_packets_ = false;
     decoding_finished_ = false;
 
@@ -159,6 +168,7 @@ void OFDecoder::update_() {
         return;
     }
 
+    use_session_();
     decode_();
 
     of_get_source_symbols_tab(of_sess_, &data_tab_[0]);
@@ -190,6 +200,18 @@ void OFDecoder::decode_() {
     }
 }
 
+void OFDecoder::use_session_() {
+    if (session_used_) {
+        return;
+    }
+
+    if (of_set_available_symbols(of_sess_, &data_tab_[0]) != OF_STATUS_OK) {
+        roc_panic("of decoder: can't add packets to OF session");
+    }
+
+    session_used_ = true;
+}
+
 // note: we have to calculate this every time because OpenFEC
 // doesn't always report to us when it repairs a packet
 bool OFDecoder::has_n_packets_(size_t n_packets) const {
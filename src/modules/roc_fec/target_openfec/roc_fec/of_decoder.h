@@ -63,6 +63,8 @@ private:
     void update_();
     void decode_();
 
+    void use_session_();
+
     bool has_n_packets_(size_t n_packets) const;
     bool is_optimal_() const;
 
@@ -87,7 +89,8 @@ private:
         of_ldpc_parameters ldpc_params_;
     } codec_params_;
 
-    // session is recreated for every new block
+    // session is created in advance and is recreated only after a block
+    // that actually used it, since OpenFEC can't reset a decoding session
     of_session_t* of_sess_;
     of_parameters_t* of_sess_params_;
 
@@ -109,6 +112,9 @@ private:
     bool has_new_packets_;
     bool decoding_finished_;
 
+    // true if packets of current block were passed to the session
+    bool session_used_;
+
     bool valid_;
 };
 
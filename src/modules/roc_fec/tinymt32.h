@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/tinymt32.h
+//! @brief TinyMT32 PRNG.
+
+#ifndef ROC_FEC_TINYMT32_H_
+#define ROC_FEC_TINYMT32_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! TinyMT32 pseudorandom number generator.
+//! @remarks
+//!  Implements the generator with the parameters specified by RFC 8682.
+//!  It is used by the RLC scheme (RFC 8681) to derive coding coefficients
+//!  from the repair key, so the output must be exactly the same on both
+//!  sides.
+class TinyMT32 {
+public:
+    //! Initialize generator with given seed.
+    explicit TinyMT32(uint32_t seed);
+
+    //! Get next 32-bit number.
+    uint32_t next();
+
+private:
+    void next_state_();
+    uint32_t temper_() const;
+
+    uint32_t status_[4];
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_TINYMT32_H_
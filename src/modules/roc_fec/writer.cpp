@@ -32,23 +32,44 @@ Writer::Writer(const Config& config,
     , repair_composer_(repair_composer)
     , packet_pool_(packet_pool)
     , buffer_pool_(buffer_pool)
-    , repair_packets_(allocator)
+    , worker_(NULL)
+    , first_task_(
+          encoder, writer, config.n_source_packets, config.n_repair_packets, allocator)
+    , second_task_(
+          encoder, writer, config.n_source_packets, config.n_repair_packets, allocator)
+    , cur_task_(&first_task_)
     , source_(0)
     , first_packet_(true)
     , cur_sbn_((packet::blknum_t)core::random(packet::blknum_t(-1)))
     , cur_block_repair_sn_((packet::seqnum_t)core::random(packet::seqnum_t(-1)))
     , cur_packet_(0)
     , valid_(false) {
-    if (!repair_packets_.resize(config.n_repair_packets)) {
+    if (!first_task_.valid() || !second_task_.valid()) {
         return;
     }
     valid_ = true;
 }
 
+Writer::~Writer() {
+    if (worker_) {
+        worker_->wait(first_task_);
+        worker_->wait(second_task_);
+    }
+}
+
 bool Writer::valid() const {
     return valid_;
 }
 
+void Writer::enable_async(EncoderWorker& worker, packet::IWriter& repair_writer) {
+    roc_panic_if_not(valid());
+
+    worker_ = &worker;
+
+    first_task_.set_writer(repair_writer);
+    second_task_.set_writer(repair_writer);
+}
+
 void Writer::write(const packet::PacketPtr& pp) {
     roc_panic_if_not(valid());
     roc_panic_if_not(pp);
@@ -68,6 +89,14 @@ void Writer::write(const packet::PacketPtr& pp) {
         } while (source_ == pp->rtp()->source);
     }
 
+    if (worker_ && cur_packet_ == 0) {
+        // Repair packets of the previous block should be written before the
+        // first source packet of the next block, and the encoder should be
+        // free when the next block is finished. Usually the previous block
+        // was encoded long ago and this doesn't block.
+        worker_->wait(cur_task_ == &first_task_ ? second_task_ : first_task_);
+    }
+
     pp->add_flags(packet::Packet::FlagComposed);
     fill_packet_fec_fields_(pp, (packet::seqnum_t)cur_packet_);
 
@@ -76,7 +105,7 @@ void Writer::write(const packet::PacketPtr& pp) {
     }
     writer_.write(pp);
 
-    encoder_.set(cur_packet_, pp->fec()->payload);
+    cur_task_->set_source(cur_packet_, pp->fec()->payload);
     cur_packet_++;
 
     if (cur_packet_ == n_source_packets_) {
@@ -98,21 +127,16 @@ void Writer::handle_next_block_() {
             roc_log(LogDebug, "fec writer: can't create repair packet");
             continue;
         }
-        repair_packets_[i] = rp;
-        encoder_.set(n_source_packets_ + i, rp->fec()->payload);
+        cur_task_->set_repair(i, rp);
     }
 
-    encoder_.commit();
-
-    for (packet::seqnum_t i = 0; i < n_repair_packets_; i++) {
-        packet::PacketPtr rp = repair_packets_[i];
-        if (rp) {
-            writer_.write(repair_packets_[i]);
-            repair_packets_[i] = NULL;
-        }
+    if (worker_) {
+        worker_->schedule(*cur_task_);
+    } else {
+        cur_task_->encode();
     }
 
-    encoder_.reset();
+    cur_task_ = (cur_task_ == &first_task_ ? &second_task_ : &first_task_);
 }
 
 packet::PacketPtr Writer::make_repair_packet_(packet::seqnum_t pack_n) {
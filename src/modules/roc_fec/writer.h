@@ -18,6 +18,8 @@
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
 #include "roc_fec/config.h"
+#include "roc_fec/encoder_task.h"
+#include "roc_fec/encoder_worker.h"
 #include "roc_fec/iencoder.h"
 #include "roc_packet/icomposer.h"
 #include "roc_packet/iwriter.h"
@@ -51,9 +53,23 @@ public:
            core::BufferPool<uint8_t>& buffer_pool,
            core::IAllocator& allocator);
 
+    ~Writer();
+
     //! Check if object is successfully constructed.
     bool valid() const;
 
+    //! Encode blocks using background thread.
+    //! @remarks
+    //!  By default, repair packets are generated and written to the output
+    //!  writer in write() when the last source packet of a block arrives.
+    //!  After this call, blocks are passed to @p worker instead, and repair
+    //!  packets are written to @p repair_writer from the worker thread as
+    //!  soon as they're ready. If a block is not encoded yet when the first
+    //!  source packet of the next block arrives, write() waits for it.
+    //!  @p repair_writer should be thread-safe. Should be called before
+    //!  first write().
+    void enable_async(EncoderWorker& worker, packet::IWriter& repair_writer);
+
     //! Write packet.
     //! @remarks
     //!  - writes the given source packet to the output writer
@@ -80,7 +96,13 @@ private:
     packet::PacketPool& packet_pool_;
     core::BufferPool<uint8_t>& buffer_pool_;
 
-    core::Array<packet::PacketPtr> repair_packets_;
+    EncoderWorker* worker_;
+
+    // blocks are filled and encoded in turn, so that the next block
+    // may be filled while the previous one is being encoded
+    EncoderTask first_task_;
+    EncoderTask second_task_;
+    EncoderTask* cur_task_;
 
     packet::source_t source_;
     bool first_packet_;
@@ -170,6 +170,26 @@ packet::IWriter* Transceiver::add_udp_sender(packet::Address& bind_address) {
     return task.writer;
 }
 
+packet::IWriter* Transceiver::add_udp_sender(packet::Address& bind_address,
+                                             packet::IWriter& inbound_writer) {
+    if (!valid()) {
+        roc_panic("transceiver: can't use invalid transceiver");
+    }
+
+    Task task;
+    task.fn = &Transceiver::add_udp_sender_;
+    task.address = &bind_address;
+    task.writer = &inbound_writer;
+
+    run_task_(task);
+
+    if (!task.result) {
+        return NULL;
+    }
+
+    return task.writer;
+}
+
 void Transceiver::remove_port(packet::Address bind_address) {
     if (!valid()) {
         roc_panic("transceiver: can't use invalid transceiver");
@@ -349,7 +369,8 @@ bool Transceiver::add_udp_sender_(Task& task) {
         return false;
     }
 
-    core::SharedPtr<UDPSender> sp = new (allocator_) UDPSender(loop_, allocator_);
+    core::SharedPtr<UDPSender> sp = new (allocator_)
+        UDPSender(loop_, task.writer, packet_pool_, buffer_pool_, allocator_);
 
     if (!sp) {
         roc_log(LogError, "transceiver: can't add port %s: can't allocate sender",
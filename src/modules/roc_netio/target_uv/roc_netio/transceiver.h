@@ -90,6 +90,17 @@ public:
     //!  a new packet writer on success or null if error occured
     packet::IWriter* add_udp_sender(packet::Address& bind_address);
 
+    //! Add UDP datagram sender port that also receives packets.
+    //!
+    //! Same as add_udp_sender(), but additionally passes packets received on
+    //! this port to @p inbound_writer. Writer will be called from the network
+    //! thread. It should not block.
+    //!
+    //! @returns
+    //!  a new packet writer on success or null if error occured
+    packet::IWriter* add_udp_sender(packet::Address& bind_address,
+                                    packet::IWriter& inbound_writer);
+
     //! Remove sender or receiver port.
     void remove_port(packet::Address bind_address);
 
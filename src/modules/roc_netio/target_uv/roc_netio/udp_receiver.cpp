@@ -10,6 +10,7 @@
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/shared_ptr.h"
+#include "roc_core/time.h"
 #include "roc_packet/address_to_str.h"
 
 namespace roc {
@@ -249,6 +250,7 @@ void UDPReceiver::recv_cb_(uv_udp_t* handle,
 
     pp->udp()->src_addr = src_addr;
     pp->udp()->dst_addr = self.address_;
+    pp->udp()->receive_timestamp = core::timestamp();
 
     pp->set_data(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
 
@@ -10,16 +10,26 @@
 #include "roc_core/helpers.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_core/time.h"
 #include "roc_packet/address_to_str.h"
 
 namespace roc {
 namespace netio {
 
-UDPSender::UDPSender(uv_loop_t& event_loop, core::IAllocator& allocator)
+UDPSender::UDPSender(uv_loop_t& event_loop,
+                     packet::IWriter* inbound_writer,
+                     packet::PacketPool& packet_pool,
+                     core::BufferPool<uint8_t>& buffer_pool,
+                     core::IAllocator& allocator)
     : allocator_(allocator)
     , loop_(event_loop)
     , write_sem_initialized_(false)
     , handle_initialized_(false)
+    , inbound_writer_(inbound_writer)
+    , packet_pool_(packet_pool)
+    , buffer_pool_(buffer_pool)
+    , receiving_(false)
     , pending_(0)
     , stopped_(true)
     , container_(NULL)
@@ -80,6 +90,15 @@ bool UDPSender::start(packet::Address& bind_address) {
         return false;
     }
 
+    if (inbound_writer_) {
+        if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+            roc_log(LogError, "udp sender: uv_udp_recv_start(): [%s] %s",
+                    uv_err_name(err), uv_strerror(err));
+            return false;
+        }
+        receiving_ = true;
+    }
+
     roc_log(LogInfo, "udp sender: opened port %s",
             packet::address_to_str(bind_address).c_str());
 
@@ -93,6 +112,14 @@ void UDPSender::stop() {
 
     stopped_ = true;
 
+    if (receiving_) {
+        if (int err = uv_udp_recv_stop(&handle_)) {
+            roc_log(LogError, "udp sender: uv_udp_recv_stop(): [%s] %s",
+                    uv_err_name(err), uv_strerror(err));
+        }
+        receiving_ = false;
+    }
+
     if (pending_ == 0) {
         close_();
     }
@@ -229,6 +256,99 @@ void UDPSender::send_cb_(uv_udp_send_t* req, int status) {
     }
 }
 
+void UDPSender::alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf) {
+    roc_panic_if_not(handle);
+    roc_panic_if_not(buf);
+
+    UDPSender& self = *(UDPSender*)handle->data;
+
+    core::SharedPtr<core::Buffer<uint8_t> > bp =
+        new (self.buffer_pool_) core::Buffer<uint8_t>(self.buffer_pool_);
+
+    if (!bp) {
+        roc_log(LogError, "udp sender: can't allocate buffer");
+
+        buf->base = NULL;
+        buf->len = 0;
+
+        return;
+    }
+
+    if (size > bp->size()) {
+        size = bp->size();
+    }
+
+    bp->incref(); // will be decremented in recv_cb_()
+
+    buf->base = (char*)bp->data();
+    buf->len = size;
+}
+
+void UDPSender::recv_cb_(uv_udp_t* handle,
+                         ssize_t nread,
+                         const uv_buf_t* buf,
+                         const sockaddr* sockaddr,
+                         unsigned flags) {
+    roc_panic_if_not(handle);
+    roc_panic_if_not(buf);
+
+    UDPSender& self = *(UDPSender*)handle->data;
+
+    if (!buf->base) {
+        return;
+    }
+
+    core::SharedPtr<core::Buffer<uint8_t> > bp =
+        core::Buffer<uint8_t>::container_of(buf->base);
+
+    // decrement reference counter incremented in alloc_cb_()
+    bp->decref();
+
+    if (nread < 0) {
+        roc_log(LogError, "udp sender: network error: dst=%s nread=%ld",
+                packet::address_to_str(self.address_).c_str(), (long)nread);
+        return;
+    }
+
+    if (nread == 0 || !sockaddr) {
+        return;
+    }
+
+    if (flags & UV_UDP_PARTIAL) {
+        roc_log(LogDebug, "udp sender: ignoring partial read: dst=%s nread=%ld",
+                packet::address_to_str(self.address_).c_str(), (long)nread);
+        return;
+    }
+
+    packet::Address src_addr;
+    if (!src_addr.set_saddr(sockaddr)) {
+        roc_log(LogError, "udp sender: can't determine source address: dst=%s",
+                packet::address_to_str(self.address_).c_str());
+        return;
+    }
+
+    if ((size_t)nread > bp->size()) {
+        roc_panic("udp sender: unexpected buffer size: got %ld, max %ld", (long)nread,
+                  (long)bp->size());
+    }
+
+    packet::PacketPtr pp = new (self.packet_pool_) packet::Packet(self.packet_pool_);
+    if (!pp) {
+        roc_log(LogError, "udp sender: can't allocate packet");
+        return;
+    }
+
+    pp->add_flags(packet::Packet::FlagUDP);
+
+    pp->udp()->src_addr = src_addr;
+    pp->udp()->dst_addr = self.address_;
+    pp->udp()->receive_timestamp = core::timestamp();
+
+    pp->set_data(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
+
+    self.inbound_writer_->write(pp);
+}
+
 packet::PacketPtr UDPSender::read_() {
     core::Mutex::Lock lock(mutex_);
 
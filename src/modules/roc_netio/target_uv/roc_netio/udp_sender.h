@@ -14,6 +14,7 @@
 
 #include <uv.h>
 
+#include "roc_core/buffer_pool.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/list_node.h"
@@ -21,6 +22,7 @@
 #include "roc_core/refcnt.h"
 #include "roc_packet/address.h"
 #include "roc_packet/iwriter.h"
+#include "roc_packet/packet_pool.h"
 
 namespace roc {
 namespace netio {
@@ -31,7 +33,14 @@ class UDPSender : public core::RefCnt<UDPSender>,
                   public packet::IWriter {
 public:
     //! Initialize.
-    UDPSender(uv_loop_t& event_loop, core::IAllocator& allocator);
+    //! @remarks
+    //!  If @p inbound_writer is not null, packets received on the sender port
+    //!  are passed to it.
+    UDPSender(uv_loop_t& event_loop,
+              packet::IWriter* inbound_writer,
+              packet::PacketPool& packet_pool,
+              core::BufferPool<uint8_t>& buffer_pool,
+              core::IAllocator& allocator);
 
     //! Destroy.
     ~UDPSender();
@@ -63,6 +72,12 @@ private:
     static void close_cb_(uv_handle_t* handle);
     static void write_sem_cb_(uv_async_t* handle);
     static void send_cb_(uv_udp_send_t* req, int status);
+    static void alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf);
+    static void recv_cb_(uv_udp_t* handle,
+                         ssize_t nread,
+                         const uv_buf_t* buf,
+                         const sockaddr* addr,
+                         unsigned flags);
 
     friend class core::RefCnt<UDPSender>;
 
@@ -83,6 +98,11 @@ private:
 
     packet::Address address_;
 
+    packet::IWriter* inbound_writer_;
+    packet::PacketPool& packet_pool_;
+    core::BufferPool<uint8_t>& buffer_pool_;
+    bool receiving_;
+
     core::List<packet::Packet> list_;
     core::Mutex mutex_;
 
@@ -12,21 +12,71 @@
 namespace roc {
 namespace packet {
 
-ConcurrentQueue::ConcurrentQueue()
-    : cond_(mutex_) {
+ConcurrentQueue::ConcurrentQueue(size_t max_size, OverflowPolicy policy)
+    : cond_(mutex_)
+    , max_size_(max_size)
+    , policy_(policy)
+    , num_waiters_(0)
+    , num_dropped_(0) {
 }
 
 PacketPtr ConcurrentQueue::read() {
     core::Mutex::Lock lock(mutex_);
 
-    PacketPtr packet;
-    while (!(packet = list_.front())) {
+    while (list_.size() == 0) {
+        num_waiters_++;
         cond_.wait();
+        num_waiters_--;
     }
 
-    list_.remove(*packet);
+    return pop_();
+}
 
-    return packet;
+PacketPtr ConcurrentQueue::try_read() {
+    core::Mutex::Lock lock(mutex_);
+
+    return pop_();
+}
+
+PacketPtr ConcurrentQueue::read_until(core::nanoseconds_t deadline) {
+    core::Mutex::Lock lock(mutex_);
+
+    while (list_.size() == 0) {
+        num_waiters_++;
+        const bool ok = cond_.timed_wait(deadline);
+        num_waiters_--;
+
+        if (!ok) {
+            break;
+        }
+    }
+
+    return pop_();
+}
+
+size_t ConcurrentQueue::drain(IWriter& writer, size_t max_packets) {
+    core::List<Packet> batch;
+
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        while (max_packets == 0 || batch.size() < max_packets) {
+            PacketPtr packet = pop_();
+            if (!packet) {
+                break;
+            }
+            batch.push_back(*packet);
+        }
+    }
+
+    const size_t n_packets = batch.size();
+
+    while (PacketPtr packet = batch.front()) {
+        batch.remove(*packet);
+        writer.write(packet);
+    }
+
+    return n_packets;
 }
 
 void ConcurrentQueue::write(const PacketPtr& packet) {
@@ -36,8 +86,43 @@ void ConcurrentQueue::write(const PacketPtr& packet) {
 
     core::Mutex::Lock lock(mutex_);
 
+    if (max_size_ != 0 && list_.size() >= max_size_) {
+        num_dropped_++;
+
+        if (policy_ == DropNewest) {
+            return;
+        }
+
+        list_.remove(*list_.front());
+    }
+
     list_.push_back(*packet);
-    cond_.broadcast();
+
+    // Every write adds exactly one packet, so waking up more than one reader
+    // would only make the rest of them go back to sleep.
+    if (num_waiters_ != 0) {
+        cond_.signal();
+    }
+}
+
+size_t ConcurrentQueue::size() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return list_.size();
+}
+
+size_t ConcurrentQueue::num_dropped() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return num_dropped_;
+}
+
+PacketPtr ConcurrentQueue::pop_() {
+    PacketPtr packet = list_.front();
+    if (packet) {
+        list_.remove(*packet);
+    }
+    return packet;
 }
 
 } // namespace packet
@@ -16,6 +16,7 @@
 #include "roc_core/list.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet.h"
@@ -26,7 +27,22 @@ namespace packet {
 //! Concurrent blocking packet queue.
 class ConcurrentQueue : public IReader, public IWriter, public core::NonCopyable<> {
 public:
-    ConcurrentQueue();
+    //! What to do when a packet is added to a full queue.
+    enum OverflowPolicy {
+        //! Drop the packet being added.
+        DropNewest,
+
+        //! Drop the first packet in the queue to free space for a new one.
+        DropOldest
+    };
+
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - if @p max_size is non-zero, it specifies maximum number of
+    //!    packets in queue
+    //!  - @p policy defines which packet is dropped when the queue is full
+    explicit ConcurrentQueue(size_t max_size = 0, OverflowPolicy policy = DropNewest);
 
     //! Read next packet.
     //! @remarks
@@ -34,15 +50,53 @@ public:
     //!  packet from the queue.
     virtual PacketPtr read();
 
+    //! Read next packet without blocking.
+    //! @returns
+    //!  the first packet from the queue or null if the queue is empty.
+    PacketPtr try_read();
+
+    //! Read next packet, blocking no longer than until the given deadline.
+    //! @remarks
+    //!  @p deadline is an absolute time point, as returned by core::timestamp().
+    //! @returns
+    //!  the first packet from the queue or null if the queue is still empty
+    //!  when the deadline expires.
+    PacketPtr read_until(core::nanoseconds_t deadline);
+
+    //! Move packets from the queue to a writer without blocking.
+    //! @remarks
+    //!  Removes up to @p max_packets packets from the queue under a single
+    //!  lock and then writes them to @p writer with the lock released. If
+    //!  @p max_packets is zero, the whole queue is drained.
+    //! @returns
+    //!  number of packets written to @p writer.
+    size_t drain(IWriter& writer, size_t max_packets);
+
     //! Add packet to the queue.
     //! @remarks
-    //!  Adds packet to the end of the queue.
+    //!  Adds packet to the end of the queue and wakes up one blocked reader.
+    //!  If the queue is full, either the new or the oldest packet is dropped,
+    //!  depending on the overflow policy.
     virtual void write(const PacketPtr& packet);
 
+    //! Get number of packets in queue.
+    size_t size() const;
+
+    //! Get number of packets dropped because of the queue overflow.
+    size_t num_dropped() const;
+
 private:
+    PacketPtr pop_();
+
     core::Mutex mutex_;
     core::Cond cond_;
     core::List<Packet> list_;
+
+    const size_t max_size_;
+    const OverflowPolicy policy_;
+
+    size_t num_waiters_;
+    size_t num_dropped_;
 };
 
 } // namespace packet
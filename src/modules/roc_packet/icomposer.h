@@ -23,6 +23,13 @@ class IComposer {
 public:
     virtual ~IComposer();
 
+    //! Get packet overhead.
+    //! @remarks
+    //!  Returns the total size of all headers and footers added by this composer
+    //!  and its inner composers, i.e. the difference between the size of the
+    //!  composed packet and the size of the payload of the most inner packet.
+    virtual size_t overhead() const = 0;
+
     //! Adjust buffer to align payload.
     //! @remarks
     //!  Adjusts the given @p buffer so that the payload of the most inner composer
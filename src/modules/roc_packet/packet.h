@@ -19,6 +19,7 @@
 #include "roc_core/shared_ptr.h"
 #include "roc_packet/fec.h"
 #include "roc_packet/print.h"
+#include "roc_packet/rtcp.h"
 #include "roc_packet/rtp.h"
 #include "roc_packet/udp.h"
 
@@ -39,12 +40,13 @@ public:
 
     //! Packet flags.
     enum {
-        FlagUDP = (1 << 0),     //!< Packet contains UDP header.
-        FlagRTP = (1 << 1),     //!< Packet contains RTP header.
-        FlagFEC = (1 << 2),     //!< Packet contains FEC header.
-        FlagAudio = (1 << 3),   //!< Packet contains audio samples.
-        FlagRepair = (1 << 4),  //!< Packet contains repair FEC symbols.
-        FlagComposed = (1 << 5) //!< Packet is already composed.
+        FlagUDP = (1 << 0),      //!< Packet contains UDP header.
+        FlagRTP = (1 << 1),      //!< Packet contains RTP header.
+        FlagFEC = (1 << 2),      //!< Packet contains FEC header.
+        FlagAudio = (1 << 3),    //!< Packet contains audio samples.
+        FlagRepair = (1 << 4),   //!< Packet contains repair FEC symbols.
+        FlagComposed = (1 << 5), //!< Packet is already composed.
+        FlagRTCP = (1 << 6)      //!< Packet contains RTCP compound packet.
     };
 
     //! Add flags.
@@ -71,6 +73,12 @@ public:
     //! FEC packet.
     FEC* fec();
 
+    //! RTCP packet.
+    const RTCP* rtcp() const;
+
+    //! RTCP packet.
+    RTCP* rtcp();
+
     //! Get packet data.
     const core::Slice<uint8_t>& data() const;
 
@@ -124,6 +132,7 @@ private:
     UDP udp_;
     RTP rtp_;
     FEC fec_;
+    RTCP rtcp_;
 
     core::Slice<uint8_t> data_;
 };
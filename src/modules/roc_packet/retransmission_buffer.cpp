@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/retransmission_buffer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+RetransmissionBuffer::RetransmissionBuffer(IWriter& writer,
+                                           PacketPool& pool,
+                                           core::IAllocator& allocator,
+                                           size_t size)
+    : writer_(writer)
+    , pool_(pool)
+    , packets_(allocator)
+    , num_resent_(0)
+    , valid_(false) {
+    roc_panic_if(size == 0);
+
+    if (!packets_.resize(size)) {
+        return;
+    }
+
+    roc_log(LogDebug, "retransmission buffer: initializing: size=%lu",
+            (unsigned long)size);
+
+    valid_ = true;
+}
+
+bool RetransmissionBuffer::valid() const {
+    return valid_;
+}
+
+void RetransmissionBuffer::write(const PacketPtr& packet) {
+    roc_panic_if_not(valid());
+
+    if (const RTP* rtp = packet->rtp()) {
+        packets_[rtp->seqnum % packets_.size()] = packet;
+    }
+
+    writer_.write(packet);
+}
+
+bool RetransmissionBuffer::resend(source_t source, seqnum_t seqnum) {
+    roc_panic_if_not(valid());
+
+    const PacketPtr& orig = packets_[seqnum % packets_.size()];
+
+    if (!orig || orig->rtp()->source != source || orig->rtp()->seqnum != seqnum) {
+        roc_log(LogTrace, "retransmission buffer: packet not found: sn=%lu",
+                (unsigned long)seqnum);
+        return false;
+    }
+
+    // the original packet is composed by the output writer
+    if ((orig->flags() & Packet::FlagComposed) == 0) {
+        roc_log(LogDebug, "retransmission buffer: packet is not composed yet: sn=%lu",
+                (unsigned long)seqnum);
+        return false;
+    }
+
+    PacketPtr pp = new (pool_) Packet(pool_);
+    if (!pp) {
+        roc_log(LogError, "retransmission buffer: can't allocate packet");
+        return false;
+    }
+
+    pp->add_flags(orig->flags() & ~(unsigned)Packet::FlagUDP);
+
+    *pp->rtp() = *orig->rtp();
+    if (orig->fec()) {
+        *pp->fec() = *orig->fec();
+    }
+
+    pp->set_data(orig->data());
+
+    writer_.write(pp);
+    num_resent_++;
+
+    return true;
+}
+
+size_t RetransmissionBuffer::num_resent() const {
+    return num_resent_;
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/retransmission_buffer.h
+//! @brief Retransmission buffer.
+
+#ifndef ROC_PACKET_RETRANSMISSION_BUFFER_H_
+#define ROC_PACKET_RETRANSMISSION_BUFFER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace packet {
+
+//! Retransmission buffer.
+//! @remarks
+//!  Passes packets to output writer and remembers the most recent RTP
+//!  packets, so that they can be sent again when the receiver reports
+//!  them as lost. Packets are not copied; the retransmitted packet is a
+//!  new packet that shares the data buffer with the original one.
+class RetransmissionBuffer : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Packets passed to write() are written to @p writer. Up to @p size
+    //!  most recent packets are remembered.
+    RetransmissionBuffer(IWriter& writer,
+                         PacketPool& pool,
+                         core::IAllocator& allocator,
+                         size_t size);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Write next packet.
+    virtual void write(const PacketPtr& packet);
+
+    //! Send packet again.
+    //! @remarks
+    //!  Looks up previously written packet with given source and seqnum
+    //!  and writes its copy to output writer.
+    //! @returns
+    //!  false if the packet is not in the buffer anymore.
+    bool resend(source_t source, seqnum_t seqnum);
+
+    //! Get number of retransmitted packets.
+    size_t num_resent() const;
+
+private:
+    IWriter& writer_;
+    PacketPool& pool_;
+
+    core::Array<PacketPtr> packets_;
+
+    size_t num_resent_;
+
+    bool valid_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_RETRANSMISSION_BUFFER_H_
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/rtcp.h
+//! @brief RTCP packet.
+
+#ifndef ROC_PACKET_RTCP_H_
+#define ROC_PACKET_RTCP_H_
+
+#include "roc_core/slice.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace packet {
+
+//! RTCP compound packet.
+struct RTCP {
+    //! Compound packet data.
+    //! @remarks
+    //!  Contains one or several concatenated RTCP packets.
+    core::Slice<uint8_t> data;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_RTCP_H_
@@ -17,7 +17,8 @@ RTP::RTP()
     , timestamp(0)
     , duration(0)
     , marker(false)
-    , payload_type(0) {
+    , payload_type(0)
+    , capture_timestamp(0) {
 }
 
 int RTP::compare(const RTP& other) const {
@@ -14,6 +14,7 @@
 
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
 #include "roc_packet/units.h"
 
 namespace roc {
@@ -53,6 +54,12 @@ struct RTP {
     //! Packet payload type.
     unsigned int payload_type;
 
+    //! Packet capture timestamp.
+    //! @remarks
+    //!  Unix time in nanoseconds when the first sample of the packet was
+    //!  captured at the sender. Zero if unknown.
+    core::nanoseconds_t capture_timestamp;
+
     //! Packet header.
     core::Slice<uint8_t> header;
 
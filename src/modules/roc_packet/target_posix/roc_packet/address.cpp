@@ -113,6 +113,31 @@ bool Address::get_ip(char* buf, size_t bufsz) const {
     return true;
 }
 
+core::hash_t Address::hash() const {
+    const sa_family_t family = family_();
+
+    core::hash_t h = core::hash_bytes(&family, sizeof(family));
+
+    switch (family) {
+    case AF_INET:
+        h = core::hash_bytes(&sa_.addr4.sin_addr.s_addr, sizeof(sa_.addr4.sin_addr.s_addr),
+                             h);
+        h = core::hash_bytes(&sa_.addr4.sin_port, sizeof(sa_.addr4.sin_port), h);
+        break;
+
+    case AF_INET6:
+        h = core::hash_bytes(sa_.addr6.sin6_addr.s6_addr,
+                             sizeof(sa_.addr6.sin6_addr.s6_addr), h);
+        h = core::hash_bytes(&sa_.addr6.sin6_port, sizeof(sa_.addr6.sin6_port), h);
+        break;
+
+    default:
+        break;
+    }
+
+    return h;
+}
+
 bool Address::operator==(const Address& other) const {
     if (family_() != other.family_()) {
         return false;
@@ -129,7 +154,9 @@ bool Address::operator==(const Address& other) const {
         break;
 
     case AF_INET6:
-        if (sa_.addr6.sin6_addr.s6_addr != other.sa_.addr6.sin6_addr.s6_addr) {
+        if (memcmp(sa_.addr6.sin6_addr.s6_addr, other.sa_.addr6.sin6_addr.s6_addr,
+                   sizeof(sa_.addr6.sin6_addr.s6_addr))
+            != 0) {
             return false;
         }
         if (sa_.addr6.sin6_port != other.sa_.addr6.sin6_port) {
@@ -15,6 +15,7 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 
+#include "roc_core/hash.h"
 #include "roc_core/stddefs.h"
 
 namespace roc {
@@ -56,6 +57,11 @@ public:
     //! Get IP address.
     bool get_ip(char* buf, size_t bufsz) const;
 
+    //! Compute hash of the address.
+    //! @remarks
+    //!  Equal addresses have equal hashes.
+    core::hash_t hash() const;
+
     //! Compare addresses.
     bool operator==(const Address& other) const;
 
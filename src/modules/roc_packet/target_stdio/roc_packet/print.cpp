@@ -48,6 +48,14 @@ void print(const Packet& p, int flags) {
             core::print_memory(p.fec()->payload.data(), p.fec()->payload.size());
         }
     }
+
+    if (p.rtcp()) {
+        fprintf(stderr, " rtcp: sz=%lu\n", (unsigned long)p.rtcp()->data.size());
+
+        if ((flags & PrintPayload) && p.rtcp()->data) {
+            core::print_memory(p.rtcp()->data.data(), p.rtcp()->data.size());
+        }
+    }
 }
 
 } // namespace packet
@@ -12,13 +12,16 @@
 #ifndef ROC_PIPELINE_CONFIG_H_
 #define ROC_PIPELINE_CONFIG_H_
 
+#include "roc_audio/channel_layout.h"
 #include "roc_audio/latency_monitor.h"
-#include "roc_audio/resampler.h"
+#include "roc_audio/latency_tuner.h"
+#include "roc_audio/resampler_config.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/time.h"
 #include "roc_fec/config.h"
 #include "roc_packet/units.h"
+#include "roc_rtcp/nack_generator.h"
 #include "roc_rtp/headers.h"
 #include "roc_rtp/validator.h"
 
@@ -37,6 +40,17 @@ const core::nanoseconds_t DefaultPacketLength = 7 * core::Millisecond;
 //! Default internal frame size.
 const size_t DefaultInternalFrameSize = 640;
 
+//! Default interval between RTCP reports.
+const core::nanoseconds_t DefaultReportInterval = 1 * core::Second;
+
+//! Default interval between keep-alive packets when DTX is enabled.
+//! @remarks
+//!  Should be less than receiver no_playback_timeout.
+const core::nanoseconds_t DefaultDTXKeepaliveInterval = 500 * core::Millisecond;
+
+//! Default maximum number of packets queued in receiver before routing.
+const size_t DefaultMaxReceiverPackets = 2048;
+
 //! Default minum latency relative to target latency.
 const int DefaultMinLatencyFactor = -1;
 
@@ -61,7 +75,16 @@ enum Protocol {
     Proto_RTP_LDPC_Source,
 
     //! FEC repair packet + FECFRAME LDPC header.
-    Proto_LDPC_Repair
+    Proto_LDPC_Repair,
+
+    //! RTP source packet + FECFRAME RLC footer (m=8).
+    Proto_RTP_RLC_Source,
+
+    //! FEC repair packet + FECFRAME RLC header (m=8).
+    Proto_RLC_Repair,
+
+    //! RTCP compound packet.
+    Proto_RTCP
 };
 
 //! Port parameters.
@@ -100,31 +123,76 @@ struct SenderConfig {
     //! Packet length, in nanoseconds.
     core::nanoseconds_t packet_length;
 
+    //! Maximum packet size, in bytes.
+    //! @remarks
+    //!  If non-zero, packet_length is derived from it: the sender uses the
+    //!  longest packets for which source and repair packets, including all
+    //!  headers, fit into this size. Should not exceed path MTU minus IP and
+    //!  UDP headers. When FEC is used, the receiver should be configured with
+    //!  the same packet length, see Sender::packet_length().
+    size_t max_packet_size;
+
+    //! Interval between RTCP sender reports, in nanoseconds.
+    //! @remarks
+    //!  Measured in stream time. Used only if control port is set.
+    core::nanoseconds_t report_interval;
+
+    //! Number of recent source packets kept for retransmission.
+    //! @remarks
+    //!  If non-zero, source packets requested by the receiver via RTCP generic
+    //!  NACKs are sent again. Used only if control port is set.
+    size_t retransmission_buffer;
+
     //! RTP payload type for audio packets.
     rtp::PayloadType payload_type;
 
+    //! Interval between keep-alive packets during silence, in nanoseconds.
+    //! @remarks
+    //!  Used only if DTX is enabled.
+    core::nanoseconds_t dtx_keepalive_interval;
+
     //! Resample frames with a constant ratio.
     bool resampling;
 
     //! Interleave packets.
     bool interleaving;
 
+    //! Enable discontinuous transmission (DTX).
+    //! @remarks
+    //!  Packets with digital silence are replaced with rare keep-alive packets.
+    bool dtx;
+
+    //! Add capture timestamps to audio packets.
+    //! @remarks
+    //!  Uses RTP header extension defined in RFC 8285.
+    bool capture_timestamps;
+
     //! Constrain receiver speed using a CPU timer according to the sample rate.
     bool timing;
 
     //! Fill unitialized data with large values to make them more noticable.
     bool poisoning;
 
+    //! Periodically log CPU time spent on resampling.
+    bool profiling;
+
     SenderConfig()
         : input_sample_rate(DefaultSampleRate)
         , input_channels(DefaultChannelMask)
         , internal_frame_size(DefaultInternalFrameSize)
         , packet_length(DefaultPacketLength)
+        , max_packet_size(0)
+        , report_interval(DefaultReportInterval)
+        , retransmission_buffer(0)
         , payload_type(rtp::PayloadType_L16_Stereo)
+        , dtx_keepalive_interval(DefaultDTXKeepaliveInterval)
         , resampling(false)
         , interleaving(false)
+        , dtx(false)
+        , capture_timestamps(false)
         , timing(false)
-        , poisoning(false) {
+        , poisoning(false)
+        , profiling(false) {
     }
 };
 
@@ -141,15 +209,55 @@ struct ReceiverSessionConfig {
     //! Target latency, nanoseconds.
     core::nanoseconds_t target_latency;
 
+    //! Interval between RTCP receiver reports, in nanoseconds.
+    //! @remarks
+    //!  Measured in stream time. Used only if control port is added.
+    core::nanoseconds_t report_interval;
+
+    //! Adjust target latency according to measured network jitter.
+    //! @remarks
+    //!  Requires resampling. Target latency is used as initial value and then
+    //!  moved within the bounds defined by latency tuner parameters, which should
+    //!  fit into latency monitor bounds.
+    bool adaptive_latency;
+
+    //! Request retransmission of lost packets.
+    //! @remarks
+    //!  Sends RTCP generic NACKs for holes in sequence numbers as soon as they
+    //!  are detected. Used only if control port is added. Sender should have
+    //!  retransmission buffer enabled.
+    bool retransmission;
+
+    //! Sender attaches capture timestamps to packets.
+    //! @remarks
+    //!  Capture timestamps are used whenever packets carry them, regardless of
+    //!  this flag. However, RTP header extension is a part of FEC symbols, so
+    //!  when FEC is enabled, this flag should match the sender.
+    bool capture_timestamps;
+
+    //! Maximum number of source and repair packets queued in session.
+    //! @remarks
+    //!  When exceeded, repair packets are dropped first, and then source
+    //!  packets of the stalest blocks. Zero means no limit. Should be large
+    //!  enough to hold packets of the maximum latency, which depends on the
+    //!  packet length, so there is no limit by default.
+    size_t max_session_packets;
+
     //! FEC scheme parameters.
     fec::Config fec;
 
+    //! NACK generator parameters.
+    rtcp::NackConfig nack;
+
     //! RTP validator parameters.
     rtp::ValidatorConfig rtp_validator;
 
     //! LatencyMonitor parameters.
     audio::LatencyMonitorConfig latency_monitor;
 
+    //! LatencyTuner parameters.
+    audio::LatencyTunerConfig latency_tuner;
+
     //! Watchdog parameters.
     audio::WatchdogConfig watchdog;
 
@@ -159,7 +267,12 @@ struct ReceiverSessionConfig {
     ReceiverSessionConfig()
         : channels(DefaultChannelMask)
         , packet_length(DefaultPacketLength)
-        , target_latency(200 * core::Millisecond) {
+        , target_latency(200 * core::Millisecond)
+        , report_interval(DefaultReportInterval)
+        , adaptive_latency(false)
+        , retransmission(false)
+        , capture_timestamps(false)
+        , max_session_packets(0) {
         latency_monitor.min_latency = target_latency * DefaultMinLatencyFactor;
         latency_monitor.max_latency = target_latency * DefaultMaxLatencyFactor;
     }
@@ -178,6 +291,12 @@ struct ReceiverOutputConfig {
     //! Number of samples for internal frames.
     size_t internal_frame_size;
 
+    //! Layout of channels in internal frames.
+    //! @remarks
+    //!  Frames returned by Receiver::read() are always interleaved. If planar
+    //!  layout is used, they are converted from planar internal frames.
+    audio::ChannelLayout internal_layout;
+
     //! Perform resampling to compensate sender and receiver frequency difference.
     bool resampling;
 
@@ -190,14 +309,22 @@ struct ReceiverOutputConfig {
     //! Insert weird beeps instead of silence on packet loss.
     bool beeping;
 
+    //! Maximum number of packets queued in receiver before routing to sessions.
+    //! @remarks
+    //!  When exceeded, repair packets are dropped first, and then the oldest
+    //!  packets. Zero means no limit.
+    size_t max_receiver_packets;
+
     ReceiverOutputConfig()
         : sample_rate(DefaultSampleRate)
         , channels(DefaultChannelMask)
         , internal_frame_size(DefaultInternalFrameSize)
+        , internal_layout(audio::ChannelLayout_Interleaved)
         , resampling(false)
         , timing(false)
         , poisoning(false)
-        , beeping(false) {
+        , beeping(false)
+        , max_receiver_packets(DefaultMaxReceiverPackets) {
     }
 };
 
@@ -25,6 +25,12 @@ const char* proto_to_str(Protocol proto) {
         return "rtp_ldpc_source";
     case Proto_LDPC_Repair:
         return "ldpc_repair";
+    case Proto_RTP_RLC_Source:
+        return "rtp_rlc_source";
+    case Proto_RLC_Repair:
+        return "rlc_repair";
+    case Proto_RTCP:
+        return "rtcp";
     }
     return "invalid";
 }
@@ -9,6 +9,7 @@
 #include "roc_pipeline/receiver.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
+#include "roc_core/random.h"
 #include "roc_core/shared_ptr.h"
 
 namespace roc {
@@ -25,11 +26,20 @@ Receiver::Receiver(const ReceiverConfig& config,
     , byte_buffer_pool_(byte_buffer_pool)
     , sample_buffer_pool_(sample_buffer_pool)
     , allocator_(allocator)
+    , port_map_(allocator)
+    , session_map_(allocator)
+    , num_dropped_source_(0)
+    , num_dropped_repair_(0)
     , ticker_(config.output.sample_rate)
     , audio_reader_(NULL)
     , config_(config)
     , timestamp_(0)
     , num_channels_(packet::num_channels(config.output.channels))
+    , control_writer_(NULL)
+    , ssrc_((uint32_t)core::random(uint32_t(-1)))
+    , report_interval_((packet::timestamp_t)packet::timestamp_from_ns(
+          config.default_session.report_interval, config.output.sample_rate))
+    , next_report_(0)
     , active_cond_(control_mutex_) {
     mixer_.reset(new (allocator_)
                      audio::Mixer(sample_buffer_pool, config.output.internal_frame_size),
@@ -47,6 +57,20 @@ Receiver::Receiver(const ReceiverConfig& config,
         areader = poisoner_.get();
     }
 
+    if (config.output.internal_layout == audio::ChannelLayout_Planar) {
+        planar_buf_ =
+            new (sample_buffer_pool) core::Buffer<audio::sample_t>(sample_buffer_pool);
+        if (!planar_buf_) {
+            roc_log(LogError, "receiver: can't allocate temporary buffer");
+            return;
+        }
+        if (planar_buf_.capacity() < config.output.internal_frame_size) {
+            roc_log(LogError, "receiver: allocated buffer is too small");
+            return;
+        }
+        planar_buf_.resize(config.output.internal_frame_size);
+    }
+
     audio_reader_ = areader;
 }
 
@@ -57,6 +81,33 @@ bool Receiver::valid() {
 bool Receiver::add_port(const PortConfig& config) {
     core::Mutex::Lock lock(control_mutex_);
 
+    return add_port_(config);
+}
+
+bool Receiver::add_port(const PortConfig& config, packet::IWriter& control_writer) {
+    core::Mutex::Lock lock(control_mutex_);
+
+    if (config.protocol != Proto_RTCP) {
+        roc_log(LogError, "receiver: can't create port, control writer requires rtcp");
+        return false;
+    }
+
+    if (control_writer_) {
+        roc_log(LogError, "receiver: can't create port, control port is already added");
+        return false;
+    }
+
+    if (!add_port_(config)) {
+        return false;
+    }
+
+    control_writer_ = &control_writer;
+    control_address_ = config.address;
+
+    return true;
+}
+
+bool Receiver::add_port_(const PortConfig& config) {
     core::SharedPtr<ReceiverPort> port =
         new (allocator_) ReceiverPort(config, format_map_, allocator_);
 
@@ -65,6 +116,16 @@ bool Receiver::add_port(const PortConfig& config) {
         return false;
     }
 
+    if (port_map_.find(config.address)) {
+        roc_log(LogError, "receiver: can't create port, address is already in use");
+        return false;
+    }
+
+    if (!port_map_.insert(config.address, port.get())) {
+        roc_log(LogError, "receiver: can't create port, allocation failed");
+        return false;
+    }
+
     ports_.push_back(*port);
     return true;
 }
@@ -85,12 +146,67 @@ size_t Receiver::num_sessions() const {
     return sessions_.size();
 }
 
+ReceiverStats Receiver::stats() const {
+    core::Mutex::Lock pipeline_lock(pipeline_mutex_);
+    core::Mutex::Lock control_lock(control_mutex_);
+
+    ReceiverStats stats;
+
+    stats.num_dropped_source = num_dropped_source_;
+    stats.num_dropped_repair = num_dropped_repair_;
+
+    core::SharedPtr<ReceiverSession> sess;
+
+    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
+        const rtcp::ReceiverStats& sess_stats = sess->stats();
+
+        if (stats.jitter < sess_stats.jitter) {
+            stats.jitter = sess_stats.jitter;
+        }
+        if (stats.fraction_lost < sess_stats.fraction_lost) {
+            stats.fraction_lost = sess_stats.fraction_lost;
+        }
+        stats.cumulative_lost += sess_stats.cumulative_lost;
+
+        core::nanoseconds_t e2e_latency = 0;
+        if (sess->e2e_latency(e2e_latency) && stats.e2e_latency < e2e_latency) {
+            stats.e2e_latency = e2e_latency;
+        }
+
+        const audio::LatencyHistogram& e2e_hist = sess->e2e_latency_histogram();
+        if (stats.e2e_latency_p50 < e2e_hist.percentile(0.50)) {
+            stats.e2e_latency_p50 = e2e_hist.percentile(0.50);
+        }
+        if (stats.e2e_latency_p95 < e2e_hist.percentile(0.95)) {
+            stats.e2e_latency_p95 = e2e_hist.percentile(0.95);
+        }
+        if (stats.e2e_latency_p99 < e2e_hist.percentile(0.99)) {
+            stats.e2e_latency_p99 = e2e_hist.percentile(0.99);
+        }
+
+        stats.num_dropped_source += sess->num_dropped_source();
+        stats.num_dropped_repair += sess->num_dropped_repair();
+
+        stats.num_sessions++;
+    }
+
+    return stats;
+}
+
 void Receiver::write(const packet::PacketPtr& packet) {
     core::Mutex::Lock lock(control_mutex_);
 
     const Status old_status = status_();
 
-    packets_.push_back(*packet);
+    if (is_repair_packet_(*packet)) {
+        repair_packets_.push_back(*packet);
+    } else {
+        packets_.push_back(*packet);
+    }
+
+    if (config_.output.max_receiver_packets != 0) {
+        shed_packets_();
+    }
 
     if (old_status != Active) {
         active_cond_.broadcast();
@@ -106,10 +222,44 @@ void Receiver::read(audio::Frame& frame) {
 
     prepare_();
 
-    audio_reader_->read(frame);
+    if (planar_buf_) {
+        read_planar_(frame);
+    } else {
+        audio_reader_->read(frame);
+    }
     timestamp_ += frame.size() / num_channels_;
 }
 
+// Pipeline produces planar frames not larger than internal frame size.
+// Read frame by parts and interleave every part into the output frame.
+void Receiver::read_planar_(audio::Frame& frame) {
+    if (frame.size() % num_channels_ != 0) {
+        roc_panic("receiver: unexpected frame size");
+    }
+
+    const size_t max_samples = planar_buf_.size() / num_channels_;
+
+    audio::sample_t* samples = frame.data();
+    size_t n_samples = frame.size() / num_channels_;
+
+    unsigned flags = 0;
+
+    while (n_samples != 0) {
+        const size_t n_read = std::min(n_samples, max_samples);
+
+        audio::Frame part(planar_buf_.data(), n_read * num_channels_);
+        audio_reader_->read(part);
+
+        audio::interleave_samples(samples, part.data(), n_read, n_read, num_channels_);
+        flags |= part.flags();
+
+        samples += n_read * num_channels_;
+        n_samples -= n_read;
+    }
+
+    frame.set_flags(flags);
+}
+
 IReceiver::Status Receiver::status() const {
     core::Mutex::Lock lock(control_mutex_);
 
@@ -132,6 +282,17 @@ void Receiver::prepare_() {
     fetch_packets_();
     update_sessions_();
 
+    if (control_writer_ && packet::timestamp_diff(timestamp_, next_report_) >= 0) {
+        send_reports_();
+        next_report_ = timestamp_ + report_interval_;
+    }
+
+    // NACKs are not bound to report interval, to request lost packets
+    // while they can still be played
+    if (control_writer_) {
+        send_nacks_();
+    }
+
     if (old_status != Active && status_() == Active) {
         active_cond_.broadcast();
     }
@@ -142,7 +303,7 @@ IReceiver::Status Receiver::status_() const {
         return Active;
     }
 
-    if (packets_.size() != 0) {
+    if (packets_.size() != 0 || repair_packets_.size() != 0) {
         return Active;
     }
 
@@ -150,13 +311,18 @@ IReceiver::Status Receiver::status_() const {
 }
 
 void Receiver::fetch_packets_() {
+    fetch_packets_(packets_);
+    fetch_packets_(repair_packets_);
+}
+
+void Receiver::fetch_packets_(core::List<packet::Packet>& packets) {
     for (;;) {
-        packet::PacketPtr packet = packets_.front();
+        packet::PacketPtr packet = packets.front();
         if (!packet) {
             break;
         }
 
-        packets_.remove(*packet);
+        packets.remove(*packet);
 
         if (!parse_packet_(packet)) {
             roc_log(LogDebug, "receiver: can't parse packet, dropping");
@@ -170,25 +336,65 @@ void Receiver::fetch_packets_() {
     }
 }
 
+void Receiver::shed_packets_() {
+    const size_t max_packets = config_.output.max_receiver_packets;
+
+    // Repair packets are only needed to recover losses, so drop them first.
+    while (packets_.size() + repair_packets_.size() > max_packets) {
+        if (packet::PacketPtr packet = repair_packets_.front()) {
+            repair_packets_.remove(*packet);
+            num_dropped_repair_++;
+        } else {
+            packets_.remove(*packets_.front());
+            num_dropped_source_++;
+        }
+    }
+}
+
+bool Receiver::is_repair_packet_(const packet::Packet& packet) const {
+    const packet::UDP* udp = packet.udp();
+    if (!udp) {
+        return false;
+    }
+
+    ReceiverPort* const* port = port_map_.find(udp->dst_addr);
+    if (!port) {
+        return false;
+    }
+
+    const Protocol proto = (*port)->config().protocol;
+
+    return proto == Proto_RSm8_Repair || proto == Proto_LDPC_Repair
+        || proto == Proto_RLC_Repair;
+}
+
 bool Receiver::parse_packet_(const packet::PacketPtr& packet) {
-    core::SharedPtr<ReceiverPort> port;
+    const packet::UDP* udp = packet->udp();
+    if (!udp) {
+        return false;
+    }
 
-    for (port = ports_.front(); port; port = ports_.nextof(*port)) {
-        if (port->handle(*packet)) {
-            return true;
-        }
+    ReceiverPort** port = port_map_.find(udp->dst_addr);
+    if (!port) {
+        return false;
     }
 
-    return false;
+    return (*port)->handle(*packet);
 }
 
 bool Receiver::route_packet_(const packet::PacketPtr& packet) {
-    core::SharedPtr<ReceiverSession> sess;
+    const packet::UDP* udp = packet->udp();
+    if (!udp) {
+        return false;
+    }
 
-    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
-        if (sess->handle(packet)) {
-            return true;
-        }
+    if (ReceiverSession** sess = session_map_.find(udp->src_addr)) {
+        return (*sess)->handle(packet);
+    }
+
+    if (packet->rtcp()) {
+        roc_log(LogDebug, "receiver: dropping rtcp packet for non-existent session");
+        return false;
     }
 
     return create_session_(packet);
@@ -228,6 +434,11 @@ bool Receiver::create_session_(const packet::PacketPtr& packet) {
         return false;
     }
 
+    if (!session_map_.insert(src_address, sess.get())) {
+        roc_log(LogError, "receiver: can't create session, allocation failed");
+        return false;
+    }
+
     mixer_->add(sess->reader());
     sessions_.push_back(*sess);
 
@@ -237,6 +448,11 @@ bool Receiver::create_session_(const packet::PacketPtr& packet) {
 void Receiver::remove_session_(ReceiverSession& sess) {
     roc_log(LogInfo, "receiver: removing session");
 
+    num_dropped_source_ += sess.num_dropped_source();
+    num_dropped_repair_ += sess.num_dropped_repair();
+
+    session_map_.remove(sess.address());
+
     mixer_->remove(sess.reader());
     sessions_.remove(sess);
 }
@@ -253,5 +469,57 @@ void Receiver::update_sessions_() {
     }
 }
 
+void Receiver::send_reports_() {
+    core::SharedPtr<ReceiverSession> sess;
+
+    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
+        rtcp::Report report;
+        if (sess->generate_report(report, ssrc_)) {
+            send_report_(*sess, report);
+        }
+    }
+}
+
+void Receiver::send_nacks_() {
+    core::SharedPtr<ReceiverSession> sess;
+
+    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
+        rtcp::Report report;
+        if (sess->generate_nack(report, ssrc_)) {
+            send_report_(*sess, report);
+        }
+    }
+}
+
+void Receiver::send_report_(ReceiverSession& sess, const rtcp::Report& report) {
+    packet::PacketPtr packet = new (packet_pool_) packet::Packet(packet_pool_);
+    if (!packet) {
+        roc_log(LogError, "receiver: can't allocate rtcp packet");
+        return;
+    }
+
+    core::Slice<uint8_t> data =
+        new (byte_buffer_pool_) core::Buffer<uint8_t>(byte_buffer_pool_);
+    if (!data) {
+        roc_log(LogError, "receiver: can't allocate rtcp buffer");
+        return;
+    }
+
+    if (!rtcp_composer_.compose(data, report)) {
+        roc_log(LogError, "receiver: can't compose rtcp packet");
+        return;
+    }
+
+    packet->add_flags(packet::Packet::FlagUDP | packet::Packet::FlagRTCP
+                      | packet::Packet::FlagComposed);
+
+    packet->udp()->src_addr = control_address_;
+    packet->udp()->dst_addr = sess.address();
+    packet->rtcp()->data = data;
+    packet->set_data(data);
+
+    control_writer_->write(packet);
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -17,11 +17,14 @@
 #include "roc_audio/poison_reader.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/cond.h"
+#include "roc_core/hash_map.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
 #include "roc_core/unique_ptr.h"
+#include "roc_packet/address.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_pool.h"
@@ -29,11 +32,64 @@
 #include "roc_pipeline/ireceiver.h"
 #include "roc_pipeline/receiver_port.h"
 #include "roc_pipeline/receiver_session.h"
+#include "roc_rtcp/composer.h"
 #include "roc_rtp/format_map.h"
 
 namespace roc {
 namespace pipeline {
 
+//! Receiver statistics.
+struct ReceiverStats {
+    //! Number of alive sessions.
+    size_t num_sessions;
+
+    //! Maximum interarrival jitter among sessions, nanoseconds.
+    core::nanoseconds_t jitter;
+
+    //! Maximum fraction of packets lost among sessions.
+    float fraction_lost;
+
+    //! Total number of packets lost in all sessions.
+    int64_t cumulative_lost;
+
+    //! Maximum end-to-end latency among sessions, nanoseconds.
+    //! @remarks
+    //!  Zero if no session knows the sender capture time yet.
+    core::nanoseconds_t e2e_latency;
+
+    //! Maximum 50th percentile of end-to-end latency among sessions, nanoseconds.
+    core::nanoseconds_t e2e_latency_p50;
+
+    //! Maximum 95th percentile of end-to-end latency among sessions, nanoseconds.
+    core::nanoseconds_t e2e_latency_p95;
+
+    //! Maximum 99th percentile of end-to-end latency among sessions, nanoseconds.
+    core::nanoseconds_t e2e_latency_p99;
+
+    //! Total number of source packets dropped because of queue overflow.
+    //! @remarks
+    //!  Includes packets of already removed sessions.
+    uint64_t num_dropped_source;
+
+    //! Total number of repair packets dropped because of queue overflow.
+    //! @remarks
+    //!  Includes packets of already removed sessions.
+    uint64_t num_dropped_repair;
+
+    ReceiverStats()
+        : num_sessions(0)
+        , jitter(0)
+        , fraction_lost(0)
+        , cumulative_lost(0)
+        , e2e_latency(0)
+        , e2e_latency_p50(0)
+        , e2e_latency_p95(0)
+        , e2e_latency_p99(0)
+        , num_dropped_source(0)
+        , num_dropped_repair(0) {
+    }
+};
+
 //! Receiver pipeline.
 class Receiver : public IReceiver, public packet::IWriter, public core::NonCopyable<> {
 public:
@@ -51,12 +107,21 @@ public:
     //! Add receiving port.
     bool add_port(const PortConfig& config);
 
+    //! Add receiving port and enable sending RTCP receiver reports.
+    //! @remarks
+    //!  @p config should define RTCP port. Receiver reports are written to
+    //!  @p control_writer and addressed to the source address of every session.
+    bool add_port(const PortConfig& config, packet::IWriter& control_writer);
+
     //! Iterate added ports.
     void iterate_ports(void (*fn)(void*, const PortConfig&), void* arg) const;
 
     //! Get number of alive sessions.
     size_t num_sessions() const;
 
+    //! Get statistics.
+    ReceiverStats stats() const;
+
     //! Write packet.
     virtual void write(const packet::PacketPtr&);
 
@@ -74,7 +139,13 @@ private:
 
     void prepare_();
 
+    void read_planar_(audio::Frame& frame);
+
     void fetch_packets_();
+    void fetch_packets_(core::List<packet::Packet>& packets);
+    void shed_packets_();
+
+    bool is_repair_packet_(const packet::Packet& packet) const;
 
     bool parse_packet_(const packet::PacketPtr& packet);
     bool route_packet_(const packet::PacketPtr& packet);
@@ -84,6 +155,12 @@ private:
 
     void update_sessions_();
 
+    bool add_port_(const PortConfig& config);
+
+    void send_reports_();
+    void send_nacks_();
+    void send_report_(ReceiverSession& sess, const rtcp::Report& report);
+
     const rtp::FormatMap& format_map_;
 
     packet::PacketPool& packet_pool_;
@@ -94,7 +171,14 @@ private:
     core::List<ReceiverPort> ports_;
     core::List<ReceiverSession> sessions_;
 
+    core::HashMap<packet::Address, ReceiverPort*> port_map_;
+    core::HashMap<packet::Address, ReceiverSession*> session_map_;
+
     core::List<packet::Packet> packets_;
+    core::List<packet::Packet> repair_packets_;
+
+    uint64_t num_dropped_source_;
+    uint64_t num_dropped_repair_;
 
     core::Ticker ticker_;
 
@@ -103,11 +187,22 @@ private:
 
     audio::IReader* audio_reader_;
 
+    // internal planar frame, converted to interleaved in read()
+    core::Slice<audio::sample_t> planar_buf_;
+
     ReceiverConfig config_;
 
     packet::timestamp_t timestamp_;
     size_t num_channels_;
 
+    packet::IWriter* control_writer_;
+    packet::Address control_address_;
+    rtcp::Composer rtcp_composer_;
+    uint32_t ssrc_;
+
+    packet::timestamp_t report_interval_;
+    packet::timestamp_t next_report_;
+
     core::Mutex control_mutex_;
     core::Mutex pipeline_mutex_;
     core::Cond active_cond_;
@@ -9,7 +9,6 @@
 #include "roc_pipeline/receiver_port.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
-#include "roc_fec/composer.h"
 #include "roc_fec/headers.h"
 #include "roc_fec/parser.h"
 
@@ -28,6 +27,7 @@ ReceiverPort::ReceiverPort(const PortConfig& config,
     case Proto_RTP:
     case Proto_RTP_LDPC_Source:
     case Proto_RTP_RSm8_Source:
+    case Proto_RTP_RLC_Source:
         rtp_parser_.reset(new (allocator) rtp::Parser(format_map, NULL), allocator);
         if (!rtp_parser_) {
             return;
@@ -36,11 +36,13 @@ ReceiverPort::ReceiverPort(const PortConfig& config,
         break;
     }
 
+    // Inner parser of source packets is always rtp::Parser for the given
+    // protocol, so it's bound at compile time instead of via packet::IParser.
     switch ((unsigned)config.protocol) {
     case Proto_RTP_LDPC_Source:
         fec_parser_.reset(
-            new (allocator)
-                fec::Parser<fec::LDPC_Source_PayloadID, fec::Source, fec::Footer>(parser),
+            new (allocator) fec::Parser<fec::LDPC_Source_PayloadID, fec::Source,
+                                        fec::Footer, rtp::Parser>(rtp_parser_.get()),
             allocator);
         if (!fec_parser_) {
             return;
@@ -50,7 +52,7 @@ ReceiverPort::ReceiverPort(const PortConfig& config,
     case Proto_LDPC_Repair:
         fec_parser_.reset(
             new (allocator)
-                fec::Parser<fec::LDPC_Repair_PayloadID, fec::Repair, fec::Header>(parser),
+                fec::Parser<fec::LDPC_Repair_PayloadID, fec::Repair, fec::Header>(NULL),
             allocator);
         if (!fec_parser_) {
             return;
@@ -59,8 +61,8 @@ ReceiverPort::ReceiverPort(const PortConfig& config,
         break;
     case Proto_RTP_RSm8_Source:
         fec_parser_.reset(
-            new (allocator)
-                fec::Parser<fec::RSm8_PayloadID, fec::Source, fec::Footer>(parser),
+            new (allocator) fec::Parser<fec::RSm8_PayloadID, fec::Source,
+                                        fec::Footer, rtp::Parser>(rtp_parser_.get()),
             allocator);
         if (!fec_parser_) {
             return;
@@ -70,13 +72,40 @@ ReceiverPort::ReceiverPort(const PortConfig& config,
     case Proto_RSm8_Repair:
         fec_parser_.reset(
             new (allocator)
-                fec::Parser<fec::RSm8_PayloadID, fec::Repair, fec::Header>(parser),
+                fec::Parser<fec::RSm8_PayloadID, fec::Repair, fec::Header>(NULL),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
+    case Proto_RTP_RLC_Source:
+        fec_parser_.reset(
+            new (allocator) fec::Parser<fec::RLC_Source_PayloadID, fec::Source,
+                                        fec::Footer, rtp::Parser>(rtp_parser_.get()),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
+    case Proto_RLC_Repair:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::RLC_Repair_PayloadID, fec::Repair, fec::Header>(NULL),
             allocator);
         if (!fec_parser_) {
             return;
         }
         parser = fec_parser_.get();
         break;
+    case Proto_RTCP:
+        rtcp_parser_.reset(new (allocator) rtcp::Parser(), allocator);
+        if (!rtcp_parser_) {
+            return;
+        }
+        parser = rtcp_parser_.get();
+        break;
     }
 
     parser_ = parser;
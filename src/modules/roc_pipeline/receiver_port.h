@@ -18,6 +18,7 @@
 #include "roc_core/unique_ptr.h"
 #include "roc_packet/iparser.h"
 #include "roc_pipeline/config.h"
+#include "roc_rtcp/parser.h"
 #include "roc_rtp/format_map.h"
 #include "roc_rtp/parser.h"
 
@@ -58,6 +59,7 @@ private:
 
     core::UniquePtr<rtp::Parser> rtp_parser_;
     core::UniquePtr<packet::IParser> fec_parser_;
+    core::UniquePtr<rtcp::Parser> rtcp_parser_;
 };
 
 } // namespace pipeline
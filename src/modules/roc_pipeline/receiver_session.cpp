@@ -9,14 +9,18 @@
 #include "roc_pipeline/receiver_session.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
-
-#ifdef ROC_TARGET_OPENFEC
-#include "roc_fec/of_decoder.h"
-#endif
+#include "roc_fec/codec_factory.h"
+#include "roc_rtp/headers.h"
 
 namespace roc {
 namespace pipeline {
 
+namespace {
+
+const core::nanoseconds_t E2ELogInterval = 5 * core::Second;
+
+} // namespace
+
 ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
                                  const ReceiverOutputConfig& output_config,
                                  const unsigned int payload_type,
@@ -28,12 +32,19 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
                                  core::IAllocator& allocator)
     : src_address_(src_address)
     , allocator_(allocator)
-    , audio_reader_(NULL) {
+    , audio_reader_(NULL)
+    , max_packets_(session_config.max_session_packets)
+    , num_dropped_source_(0)
+    , num_dropped_repair_(0)
+    , sample_rate_(0)
+    , e2e_rate_limiter_(E2ELogInterval) {
     const rtp::Format* format = format_map.format(payload_type);
     if (!format) {
         return;
     }
 
+    sample_rate_ = format->sample_rate;
+
     queue_router_.reset(new (allocator_) packet::Router(allocator_, 2), allocator_);
     if (!queue_router_ || !queue_router_->valid()) {
         return;
@@ -69,7 +80,6 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
     }
     preader = validator_.get();
 
-#ifdef ROC_TARGET_OPENFEC
     if (session_config.fec.codec != fec::NoCodec) {
         repair_queue_.reset(new (allocator_) packet::SortedQueue(0), allocator_);
         if (!repair_queue_) {
@@ -79,29 +89,51 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
             return;
         }
 
-        core::UniquePtr<fec::OFDecoder> fec_decoder(
-            new (allocator_) fec::OFDecoder(session_config.fec,
-                                            format->size(session_config.packet_length),
-                                            byte_buffer_pool, allocator_),
-            allocator_);
-        if (!fec_decoder || !fec_decoder->valid()) {
-            return;
+        // FEC symbols are whole RTP packets, including header extension.
+        size_t payload_size =
+            format->size(session_config.packet_length, format->sample_rate);
+        if (session_config.capture_timestamps) {
+            payload_size += sizeof(rtp::CaptureTimestampExtension);
         }
-        fec_decoder_.reset(fec_decoder.release(), allocator_);
 
         fec_parser_.reset(new (allocator_) rtp::Parser(format_map, NULL), allocator_);
         if (!fec_parser_) {
             return;
         }
 
-        fec_reader_.reset(new (allocator_) fec::Reader(
-                              session_config.fec, *fec_decoder_, *preader, *repair_queue_,
-                              *fec_parser_, packet_pool, allocator_),
-                          allocator_);
-        if (!fec_reader_ || !fec_reader_->valid()) {
-            return;
+        if (session_config.fec.codec == fec::RLC8m) {
+            rlc_decoder_.reset(fec::new_rlc_decoder(session_config.fec, payload_size,
+                                                    byte_buffer_pool, allocator_),
+                               allocator_);
+            if (!rlc_decoder_) {
+                return;
+            }
+
+            rlc_reader_.reset(new (allocator_) fec::RLCReader(
+                                  session_config.fec, *rlc_decoder_, *preader,
+                                  *repair_queue_, *fec_parser_, packet_pool, allocator_),
+                              allocator_);
+            if (!rlc_reader_ || !rlc_reader_->valid()) {
+                return;
+            }
+            preader = rlc_reader_.get();
+        } else {
+            fec_decoder_.reset(fec::new_decoder(session_config.fec, payload_size,
+                                                byte_buffer_pool, allocator_),
+                               allocator_);
+            if (!fec_decoder_) {
+                return;
+            }
+
+            fec_reader_.reset(new (allocator_) fec::Reader(
+                                  session_config.fec, *fec_decoder_, *preader,
+                                  *repair_queue_, *fec_parser_, packet_pool, allocator_),
+                              allocator_);
+            if (!fec_reader_ || !fec_reader_->valid()) {
+                return;
+            }
+            preader = fec_reader_.get();
         }
-        preader = fec_reader_.get();
 
         fec_validator_.reset(new (allocator_) rtp::Validator(
                                  *preader, *format, session_config.rtp_validator),
@@ -111,16 +143,15 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         }
         preader = fec_validator_.get();
     }
-#endif // ROC_TARGET_OPENFEC
 
     decoder_.reset(format->new_decoder(allocator_), allocator_);
     if (!decoder_) {
         return;
     }
 
-    depacketizer_.reset(new (allocator_) audio::Depacketizer(*preader, *decoder_,
-                                                             session_config.channels,
-                                                             output_config.beeping),
+    depacketizer_.reset(new (allocator_) audio::Depacketizer(
+                            *preader, *decoder_, session_config.channels,
+                            output_config.internal_layout, output_config.beeping),
                         allocator_);
     if (!depacketizer_) {
         return;
@@ -154,6 +185,7 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         resampler_.reset(new (allocator_) audio::ResamplerReader(
                              *areader, sample_buffer_pool, allocator,
                              session_config.resampler, session_config.channels,
+                             output_config.internal_layout,
                              output_config.internal_frame_size),
                          allocator_);
         if (!resampler_ || !resampler_->valid()) {
@@ -171,9 +203,33 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         areader = session_poisoner_.get();
     }
 
+    if (session_config.adaptive_latency) {
+        latency_tuner_.reset(new (allocator_) audio::LatencyTuner(
+                                 session_config.latency_tuner,
+                                 session_config.target_latency, format->sample_rate),
+                             allocator_);
+        if (!latency_tuner_ || !latency_tuner_->valid()) {
+            return;
+        }
+    }
+
+    reporter_.reset(new (allocator_) rtcp::ReceiverReporter(format->sample_rate),
+                    allocator_);
+    if (!reporter_) {
+        return;
+    }
+
+    if (session_config.retransmission) {
+        nack_generator_.reset(new (allocator_) rtcp::NackGenerator(session_config.nack),
+                              allocator_);
+        if (!nack_generator_) {
+            return;
+        }
+    }
+
     latency_monitor_.reset(new (allocator_) audio::LatencyMonitor(
                                *source_queue_, *depacketizer_, resampler_.get(),
-                               session_config.latency_monitor,
+                               latency_tuner_.get(), session_config.latency_monitor,
                                session_config.target_latency, format->sample_rate,
                                output_config.sample_rate),
                            allocator_);
@@ -192,6 +248,10 @@ bool ReceiverSession::valid() const {
     return audio_reader_;
 }
 
+const packet::Address& ReceiverSession::address() const {
+    return src_address_;
+}
+
 bool ReceiverSession::handle(const packet::PacketPtr& packet) {
     roc_panic_if(!valid());
 
@@ -204,10 +264,74 @@ bool ReceiverSession::handle(const packet::PacketPtr& packet) {
         return false;
     }
 
+    if (packet->rtcp()) {
+        rtcp::Report report;
+        if (!rtcp_parser_.parse_report(packet->rtcp()->data, report)) {
+            roc_log(LogDebug, "receiver session: can't parse rtcp report");
+            return false;
+        }
+
+        const core::nanoseconds_t receive_time =
+            udp->receive_timestamp != 0 ? udp->receive_timestamp : core::timestamp();
+
+        reporter_->process(report, receive_time);
+        return true;
+    }
+
+    if (packet->flags() & packet::Packet::FlagAudio) {
+        reporter_->add_packet(*packet);
+
+        if (nack_generator_) {
+            nack_generator_->add_packet(*packet);
+        }
+    }
+
+    if (latency_tuner_ && (packet->flags() & packet::Packet::FlagAudio)) {
+        latency_tuner_->add_packet(*packet);
+    }
+
     queue_router_->write(packet);
+
+    if (max_packets_ != 0) {
+        shed_packets_();
+    }
+
     return true;
 }
 
+void ReceiverSession::shed_packets_() {
+    size_t num_packets = source_queue_->size();
+    if (repair_queue_) {
+        num_packets += repair_queue_->size();
+    }
+
+    if (num_packets <= max_packets_) {
+        return;
+    }
+
+    // Repair packets are only needed to recover losses, so drop them first.
+    // Queue heads hold packets of the stalest blocks.
+    if (repair_queue_) {
+        while (num_packets > max_packets_ && repair_queue_->read()) {
+            num_dropped_repair_++;
+            num_packets--;
+        }
+    }
+
+    while (num_packets > max_packets_ && source_queue_->read()) {
+        num_dropped_source_++;
+        num_packets--;
+    }
+}
+
+size_t ReceiverSession::num_dropped_source() const {
+    return num_dropped_source_;
+}
+
+size_t ReceiverSession::num_dropped_repair() const {
+    return num_dropped_repair_;
+}
+
 bool ReceiverSession::update(packet::timestamp_t time) {
     roc_panic_if(!valid());
 
@@ -223,14 +347,99 @@ bool ReceiverSession::update(packet::timestamp_t time) {
         }
     }
 
+    update_e2e_latency_();
+
     return true;
 }
 
+bool ReceiverSession::generate_report(rtcp::Report& report, uint32_t ssrc) {
+    roc_panic_if(!valid());
+
+    if (!reporter_->has_report()) {
+        return false;
+    }
+
+    reporter_->generate(report, ssrc, core::timestamp());
+    return true;
+}
+
+bool ReceiverSession::generate_nack(rtcp::Report& report, uint32_t ssrc) {
+    roc_panic_if(!valid());
+
+    if (!nack_generator_) {
+        return false;
+    }
+
+    report = rtcp::Report();
+    report.ssrc = ssrc;
+
+    return nack_generator_->generate(report.nack, core::timestamp());
+}
+
+const rtcp::ReceiverStats& ReceiverSession::stats() const {
+    roc_panic_if(!valid());
+
+    return reporter_->stats();
+}
+
+bool ReceiverSession::e2e_latency(core::nanoseconds_t& latency) const {
+    roc_panic_if(!valid());
+
+    if (!depacketizer_->started()) {
+        return false;
+    }
+
+    packet::timestamp_t capture_rtp_ts = 0;
+    core::nanoseconds_t capture_ts = 0;
+
+    if (depacketizer_->capture_timestamp(capture_rtp_ts, capture_ts)) {
+        const core::nanoseconds_t capture_time = capture_ts
+            + packet::timestamp_to_ns(
+                  packet::timestamp_diff(depacketizer_->timestamp(), capture_rtp_ts),
+                  sample_rate_);
+
+        latency = core::unix_timestamp() - capture_time;
+        return true;
+    }
+
+    if (reporter_->has_sender_clock()) {
+        latency = reporter_->e2e_latency(depacketizer_->timestamp());
+        return true;
+    }
+
+    return false;
+}
+
+const audio::LatencyHistogram& ReceiverSession::e2e_latency_histogram() const {
+    roc_panic_if(!valid());
+
+    return e2e_histogram_;
+}
+
 audio::IReader& ReceiverSession::reader() {
     roc_panic_if(!valid());
 
     return *audio_reader_;
 }
 
+void ReceiverSession::update_e2e_latency_() {
+    core::nanoseconds_t latency = 0;
+    if (!e2e_latency(latency)) {
+        return;
+    }
+
+    e2e_histogram_.add(latency);
+
+    if (e2e_rate_limiter_.allow()) {
+        roc_log(LogDebug,
+                "receiver session: e2e latency: last=%.3fms p50=%.3fms p95=%.3fms"
+                " p99=%.3fms",
+                (double)latency / core::Millisecond,
+                (double)e2e_histogram_.percentile(0.50) / core::Millisecond,
+                (double)e2e_histogram_.percentile(0.95) / core::Millisecond,
+                (double)e2e_histogram_.percentile(0.99) / core::Millisecond);
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -15,17 +15,22 @@
 #include "roc_audio/depacketizer.h"
 #include "roc_audio/idecoder.h"
 #include "roc_audio/ireader.h"
+#include "roc_audio/latency_histogram.h"
 #include "roc_audio/latency_monitor.h"
+#include "roc_audio/latency_tuner.h"
 #include "roc_audio/poison_reader.h"
 #include "roc_audio/resampler_reader.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list_node.h"
+#include "roc_core/rate_limiter.h"
 #include "roc_core/refcnt.h"
 #include "roc_core/unique_ptr.h"
 #include "roc_fec/idecoder.h"
 #include "roc_fec/reader.h"
+#include "roc_fec/rlc_decoder.h"
+#include "roc_fec/rlc_reader.h"
 #include "roc_packet/address.h"
 #include "roc_packet/delayed_reader.h"
 #include "roc_packet/iparser.h"
@@ -35,6 +40,10 @@
 #include "roc_packet/router.h"
 #include "roc_packet/sorted_queue.h"
 #include "roc_pipeline/config.h"
+#include "roc_rtcp/nack_generator.h"
+#include "roc_rtcp/parser.h"
+#include "roc_rtcp/receiver_reporter.h"
+#include "roc_rtcp/report.h"
 #include "roc_rtp/format_map.h"
 #include "roc_rtp/parser.h"
 #include "roc_rtp/validator.h"
@@ -61,11 +70,55 @@ public:
     //! Check if the session pipeline was succefully constructed.
     bool valid() const;
 
+    //! Get source address of the session.
+    const packet::Address& address() const;
+
     //! Try to route a packet to this session.
+    //! @remarks
+    //!  RTCP packets are processed immediately, other packets are queued.
     //! @returns
     //!  true if the packet is dedicated for this session
     bool handle(const packet::PacketPtr& packet);
 
+    //! Generate RTCP receiver report.
+    //! @remarks
+    //!  @p ssrc identifies the receiver.
+    //! @returns
+    //!  false if no packets were received yet.
+    bool generate_report(rtcp::Report& report, uint32_t ssrc);
+
+    //! Generate RTCP receiver report with generic NACK.
+    //! @remarks
+    //!  @p ssrc identifies the receiver. The report has no reception blocks
+    //!  and only requests retransmission of lost packets.
+    //! @returns
+    //!  false if retransmission is disabled or there is nothing to request.
+    bool generate_nack(rtcp::Report& report, uint32_t ssrc);
+
+    //! Get reception statistics.
+    const rtcp::ReceiverStats& stats() const;
+
+    //! Get end-to-end latency.
+    //! @remarks
+    //!  Difference between sender capture time and current time of the sample
+    //!  being read from the session. Capture time is taken from the packet
+    //!  capture timestamps if the sender provides them, or else is derived
+    //!  from the last RTCP sender report.
+    //! @returns
+    //!  false if capture time is unknown or playback is not started.
+    bool e2e_latency(core::nanoseconds_t& latency) const;
+
+    //! Get end-to-end latency histogram.
+    //! @remarks
+    //!  Updated with e2e_latency() on every update() call.
+    const audio::LatencyHistogram& e2e_latency_histogram() const;
+
+    //! Get number of source packets dropped because the session queue was full.
+    size_t num_dropped_source() const;
+
+    //! Get number of repair packets dropped because the session queue was full.
+    size_t num_dropped_repair() const;
+
     //! Update session.
     //! @returns
     //!  false if the session is terminated
@@ -79,6 +132,9 @@ private:
 
     void destroy();
 
+    void shed_packets_();
+    void update_e2e_latency_();
+
     const packet::Address src_address_;
 
     core::IAllocator& allocator_;
@@ -97,6 +153,8 @@ private:
     core::UniquePtr<rtp::Parser> fec_parser_;
     core::UniquePtr<fec::IDecoder> fec_decoder_;
     core::UniquePtr<fec::Reader> fec_reader_;
+    core::UniquePtr<fec::RLCDecoder> rlc_decoder_;
+    core::UniquePtr<fec::RLCReader> rlc_reader_;
     core::UniquePtr<rtp::Validator> fec_validator_;
 
     core::UniquePtr<audio::IDecoder> decoder_;
@@ -107,7 +165,21 @@ private:
 
     core::UniquePtr<audio::PoisonReader> session_poisoner_;
 
+    core::UniquePtr<audio::LatencyTuner> latency_tuner_;
     core::UniquePtr<audio::LatencyMonitor> latency_monitor_;
+
+    core::UniquePtr<rtcp::ReceiverReporter> reporter_;
+    core::UniquePtr<rtcp::NackGenerator> nack_generator_;
+    rtcp::Parser rtcp_parser_;
+
+    const size_t max_packets_;
+    size_t num_dropped_source_;
+    size_t num_dropped_repair_;
+
+    size_t sample_rate_;
+
+    audio::LatencyHistogram e2e_histogram_;
+    core::RateLimiter e2e_rate_limiter_;
 };
 
 } // namespace pipeline
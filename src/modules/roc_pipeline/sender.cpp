@@ -9,27 +9,48 @@
 #include "roc_pipeline/sender.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
-
-#ifdef ROC_TARGET_OPENFEC
-#include "roc_fec/of_encoder.h"
-#endif
+#include "roc_fec/codec_factory.h"
+#include "roc_pipeline/proto_to_str.h"
+#include "roc_rtp/headers.h"
 
 namespace roc {
 namespace pipeline {
 
+namespace {
+
+// Size of RTP header extensions in source packets. FEC symbols are whole
+// RTP packets, so they include extensions too.
+size_t rtp_extension_size(const SenderConfig& config) {
+    if (config.capture_timestamps) {
+        return sizeof(rtp::CaptureTimestampExtension);
+    }
+    return 0;
+}
+
+} // namespace
+
 Sender::Sender(const SenderConfig& config,
                const PortConfig& source_port_config,
                packet::IWriter& source_writer,
                const PortConfig& repair_port_config,
                packet::IWriter& repair_writer,
+               const PortConfig& control_port_config,
+               packet::IWriter& control_writer,
+               fec::EncoderWorker* fec_worker,
                const rtp::FormatMap& format_map,
                packet::PacketPool& packet_pool,
                core::BufferPool<uint8_t>& byte_buffer_pool,
                core::BufferPool<audio::sample_t>& sample_buffer_pool,
                core::IAllocator& allocator)
-    : audio_writer_(NULL)
+    : packet_pool_(packet_pool)
+    , byte_buffer_pool_(byte_buffer_pool)
+    , audio_writer_(NULL)
     , timestamp_(0)
-    , num_channels_(packet::num_channels(config.input_channels)) {
+    , num_channels_(packet::num_channels(config.input_channels))
+    , packet_length_(config.packet_length)
+    , report_interval_((packet::timestamp_t)packet::timestamp_from_ns(
+          config.report_interval, config.input_sample_rate))
+    , next_report_(0) {
     const rtp::Format* format = format_map.format(config.payload_type);
     if (!format) {
         return;
@@ -42,29 +63,67 @@ Sender::Sender(const SenderConfig& config,
         }
     }
 
-    source_port_.reset(new (allocator)
-                           SenderPort(source_port_config, source_writer, allocator),
+    source_port_.reset(new (allocator) SenderPort(source_port_config,
+                                                  config.capture_timestamps,
+                                                  source_writer, allocator),
                        allocator);
     if (!source_port_ || !source_port_->valid()) {
         return;
     }
 
     if (repair_port_config.protocol != Proto_None) {
-        repair_port_.reset(new (allocator)
-                               SenderPort(repair_port_config, repair_writer, allocator),
+        repair_port_.reset(new (allocator) SenderPort(repair_port_config, false,
+                                                      repair_writer, allocator),
                            allocator);
         if (!repair_port_ || !repair_port_->valid()) {
             return;
         }
     }
 
+    packet::IWriter* source_writer_ptr = source_port_.get();
+
+    if (control_port_config.protocol != Proto_None) {
+        if (control_port_config.protocol != Proto_RTCP) {
+            roc_log(LogError, "sender: unsupported control port protocol %s",
+                    proto_to_str(control_port_config.protocol));
+            return;
+        }
+
+        control_port_.reset(new (allocator) SenderPort(control_port_config, false,
+                                                       control_writer, allocator),
+                            allocator);
+        if (!control_port_ || !control_port_->valid()) {
+            return;
+        }
+
+        if (config.retransmission_buffer != 0) {
+            retransmission_buffer_.reset(
+                new (allocator) packet::RetransmissionBuffer(
+                    *source_writer_ptr, packet_pool, allocator,
+                    config.retransmission_buffer),
+                allocator);
+            if (!retransmission_buffer_ || !retransmission_buffer_->valid()) {
+                return;
+            }
+            source_writer_ptr = retransmission_buffer_.get();
+        }
+
+        reporter_.reset(new (allocator)
+                            rtcp::SenderReporter(*source_writer_ptr, format->sample_rate),
+                        allocator);
+        if (!reporter_) {
+            return;
+        }
+        source_writer_ptr = reporter_.get();
+    }
+
     router_.reset(new (allocator) packet::Router(allocator, 2), allocator);
     if (!router_ || !router_->valid()) {
         return;
     }
     packet::IWriter* pwriter = router_.get();
 
-    if (!router_->add_route(*source_port_, packet::Packet::FlagAudio)) {
+    if (!router_->add_route(*source_writer_ptr, packet::Packet::FlagAudio)) {
         return;
     }
     if (repair_port_) {
@@ -73,7 +132,17 @@ Sender::Sender(const SenderConfig& config,
         }
     }
 
-#ifdef ROC_TARGET_OPENFEC
+    encoder_.reset(format->new_encoder(allocator), allocator);
+    if (!encoder_) {
+        return;
+    }
+
+    if (config.max_packet_size != 0) {
+        if (!init_packet_length_(config, *format)) {
+            return;
+        }
+    }
+
     if (config.fec.codec != fec::NoCodec) {
         if (!repair_port_) {
             return;
@@ -91,42 +160,84 @@ Sender::Sender(const SenderConfig& config,
             pwriter = interleaver_.get();
         }
 
-        const size_t source_packet_size = format->size(config.packet_length);
+        const size_t source_packet_size =
+            format->size(packet_length_, format->sample_rate)
+            + rtp_extension_size(config);
 
-        core::UniquePtr<fec::OFEncoder> fec_encoder(
-            new (allocator) fec::OFEncoder(config.fec, source_packet_size, allocator),
-            allocator);
-        if (!fec_encoder || !fec_encoder->valid()) {
-            return;
-        }
-        fec_encoder_.reset(fec_encoder.release(), allocator);
+        if (config.fec.codec == fec::RLC8m) {
+            rlc_encoder_.reset(
+                fec::new_rlc_encoder(config.fec, source_packet_size, allocator),
+                allocator);
+            if (!rlc_encoder_) {
+                return;
+            }
 
-        fec_writer_.reset(new (allocator) fec::Writer(
-                              config.fec, source_packet_size, *fec_encoder_, *pwriter,
-                              source_port_->composer(), repair_port_->composer(),
-                              packet_pool, byte_buffer_pool, allocator),
-                          allocator);
-        if (!fec_writer_ || !fec_writer_->valid()) {
-            return;
-        }
-        pwriter = fec_writer_.get();
-    }
-#endif // ROC_TARGET_OPENFEC
+            rlc_writer_.reset(new (allocator) fec::RLCWriter(
+                                  config.fec, source_packet_size, *rlc_encoder_,
+                                  *pwriter, source_port_->composer(),
+                                  repair_port_->composer(), packet_pool,
+                                  byte_buffer_pool),
+                              allocator);
+            if (!rlc_writer_ || !rlc_writer_->valid()) {
+                return;
+            }
+            // Repair packets are produced every few source packets from the
+            // encoding window and are cheap to encode, so fec_worker is not
+            // used.
+            pwriter = rlc_writer_.get();
+        } else {
+            fec_encoder_.reset(
+                fec::new_encoder(config.fec, source_packet_size, allocator), allocator);
+            if (!fec_encoder_) {
+                return;
+            }
 
-    encoder_.reset(format->new_encoder(allocator), allocator);
-    if (!encoder_) {
-        return;
+            fec_writer_.reset(new (allocator) fec::Writer(
+                                  config.fec, source_packet_size, *fec_encoder_,
+                                  *pwriter, source_port_->composer(),
+                                  repair_port_->composer(), packet_pool,
+                                  byte_buffer_pool, allocator),
+                              allocator);
+            if (!fec_writer_ || !fec_writer_->valid()) {
+                return;
+            }
+            if (fec_worker && config.interleaving) {
+                // The interleaver is not thread-safe and its blocks should
+                // contain repair packets, so they can't be written from the
+                // worker thread.
+                roc_log(LogDebug,
+                        "sender: interleaving is enabled, not using fec worker");
+            } else if (fec_worker) {
+                // Repair packets are written from the worker thread, so they
+                // bypass the router and go directly to the port.
+                fec_writer_->enable_async(*fec_worker, *repair_port_);
+            }
+            pwriter = fec_writer_.get();
+        }
     }
 
     packetizer_.reset(new (allocator) audio::Packetizer(
                           *pwriter, source_port_->composer(), *encoder_, packet_pool,
-                          byte_buffer_pool, config.input_channels, config.packet_length,
+                          byte_buffer_pool, config.input_channels, packet_length_,
                           format->sample_rate, config.payload_type),
                       allocator);
     if (!packetizer_) {
         return;
     }
 
+    if (config.capture_timestamps) {
+        packetizer_->enable_capture_timestamps();
+    }
+
+    if (config.dtx) {
+        if (config.dtx_keepalive_interval <= 0) {
+            roc_log(LogError, "sender: invalid dtx keepalive interval: %ld",
+                    (long)config.dtx_keepalive_interval);
+            return;
+        }
+        packetizer_->enable_dtx(config.dtx_keepalive_interval);
+    }
+
     audio::IWriter* awriter = packetizer_.get();
 
     if (config.resampling && config.input_sample_rate != format->sample_rate) {
@@ -149,6 +260,9 @@ Sender::Sender(const SenderConfig& config,
                                      / format->sample_rate)) {
             return;
         }
+        if (config.profiling) {
+            resampler_->enable_profiling(config.input_sample_rate);
+        }
         awriter = resampler_.get();
     }
 
@@ -177,6 +291,163 @@ void Sender::write(audio::Frame& frame) {
 
     audio_writer_->write(frame);
     timestamp_ += frame.size() / num_channels_;
+
+    if (control_port_ && packet::timestamp_diff(timestamp_, next_report_) >= 0) {
+        send_report_();
+        next_report_ = timestamp_ + report_interval_;
+    }
+}
+
+void Sender::write(const packet::PacketPtr& packet) {
+    roc_panic_if(!valid());
+
+    if (!reporter_) {
+        roc_log(LogDebug, "sender: dropping packet, control port is not set");
+        return;
+    }
+
+    if (!rtcp_parser_.parse(*packet, packet->data())) {
+        roc_log(LogDebug, "sender: dropping packet, can't parse rtcp packet");
+        return;
+    }
+
+    rtcp::Report report;
+    if (!rtcp_parser_.parse_report(packet->rtcp()->data, report)) {
+        roc_log(LogDebug, "sender: dropping packet, can't parse rtcp report");
+        return;
+    }
+
+    reporter_->process(report);
+
+    if (retransmission_buffer_ && report.nack.num_seqnums != 0) {
+        resend_(report.nack);
+    }
+}
+
+rtcp::SenderStats Sender::stats() const {
+    if (!reporter_) {
+        return rtcp::SenderStats();
+    }
+    return reporter_->stats();
+}
+
+core::nanoseconds_t Sender::packet_length() const {
+    return packet_length_;
+}
+
+bool Sender::init_packet_length_(const SenderConfig& config, const rtp::Format& format) {
+    const size_t max_size = config.max_packet_size;
+
+    if (max_size > byte_buffer_pool_.buffer_size()) {
+        roc_log(LogError,
+                "sender: max packet size exceeds buffer size:"
+                " max_packet_size=%lu buffer_size=%lu",
+                (unsigned long)max_size, (unsigned long)byte_buffer_pool_.buffer_size());
+        return false;
+    }
+
+    const size_t source_overhead = source_port_->composer().overhead();
+
+    size_t max_payload_size = max_size > source_overhead ? max_size - source_overhead : 0;
+    double overhead = (double)source_overhead;
+
+    if (repair_port_ && config.fec.codec != fec::NoCodec
+        && config.fec.n_source_packets != 0) {
+        // Repair packets carry FEC symbols, which have the same size as
+        // source packets with RTP header, but without FEC payload ID.
+        const size_t repair_overhead =
+            repair_port_->composer().overhead() + sizeof(rtp::Header)
+            + rtp_extension_size(config);
+
+        const size_t max_repair_payload_size =
+            max_size > repair_overhead ? max_size - repair_overhead : 0;
+
+        if (max_payload_size > max_repair_payload_size) {
+            max_payload_size = max_repair_payload_size;
+        }
+
+        overhead += (double)repair_overhead * config.fec.n_repair_packets
+            / config.fec.n_source_packets;
+    }
+
+    const size_t num_samples = encoder_->payload_samples(max_payload_size);
+    if (num_samples == 0) {
+        roc_log(LogError,
+                "sender: max packet size is too small: max_packet_size=%lu overhead=%lu",
+                (unsigned long)max_size, (unsigned long)(max_size - max_payload_size));
+        return false;
+    }
+
+    packet_length_ = packet::timestamp_to_ns((packet::timestamp_diff_t)num_samples,
+                                             format.sample_rate);
+
+    const double packets_per_sec = (double)format.sample_rate / num_samples;
+
+    const packet::timestamp_diff_t ref_num_samples =
+        packet::timestamp_from_ns(config.packet_length, format.sample_rate);
+    const double ref_packets_per_sec =
+        ref_num_samples > 0 ? (double)format.sample_rate / ref_num_samples : 0;
+
+    roc_log(LogInfo,
+            "sender: derived packet length from max packet size:"
+            " max_packet_size=%lu payload_size=%lu samples=%lu packet_length=%.3fms",
+            (unsigned long)max_size, (unsigned long)encoder_->payload_size(num_samples),
+            (unsigned long)num_samples, (double)packet_length_ / core::Millisecond);
+
+    roc_log(LogInfo,
+            "sender: packet rate: packets_per_sec=%.1f overhead_per_sec=%.0f"
+            " saved_overhead_per_sec=%.0f ref_packet_length=%.3fms",
+            packets_per_sec, packets_per_sec * overhead,
+            (ref_packets_per_sec - packets_per_sec) * overhead,
+            (double)config.packet_length / core::Millisecond);
+
+    return true;
+}
+
+void Sender::resend_(const rtcp::Nack& nack) {
+    size_t n_resent = 0;
+
+    for (size_t n = 0; n < nack.num_seqnums; n++) {
+        if (retransmission_buffer_->resend(nack.ssrc, nack.seqnums[n])) {
+            n_resent++;
+        }
+    }
+
+    roc_log(LogTrace, "sender: got nack: requested=%lu resent=%lu",
+            (unsigned long)nack.num_seqnums, (unsigned long)n_resent);
+}
+
+void Sender::send_report_() {
+    if (!reporter_->has_report()) {
+        return;
+    }
+
+    rtcp::Report report;
+    reporter_->generate(report);
+
+    packet::PacketPtr packet = new (packet_pool_) packet::Packet(packet_pool_);
+    if (!packet) {
+        roc_log(LogError, "sender: can't allocate rtcp packet");
+        return;
+    }
+
+    core::Slice<uint8_t> data =
+        new (byte_buffer_pool_) core::Buffer<uint8_t>(byte_buffer_pool_);
+    if (!data) {
+        roc_log(LogError, "sender: can't allocate rtcp buffer");
+        return;
+    }
+
+    if (!rtcp_composer_.compose(data, report)) {
+        roc_log(LogError, "sender: can't compose rtcp packet");
+        return;
+    }
+
+    packet->add_flags(packet::Packet::FlagRTCP | packet::Packet::FlagComposed);
+    packet->rtcp()->data = data;
+    packet->set_data(data);
+
+    control_port_->write(packet);
 }
 
 } // namespace pipeline
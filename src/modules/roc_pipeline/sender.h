@@ -22,27 +22,50 @@
 #include "roc_core/noncopyable.h"
 #include "roc_core/ticker.h"
 #include "roc_core/unique_ptr.h"
+#include "roc_fec/encoder_worker.h"
 #include "roc_fec/iencoder.h"
+#include "roc_fec/rlc_encoder.h"
+#include "roc_fec/rlc_writer.h"
 #include "roc_fec/writer.h"
 #include "roc_packet/interleaver.h"
 #include "roc_packet/packet_pool.h"
+#include "roc_packet/retransmission_buffer.h"
 #include "roc_packet/router.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/sender_port.h"
+#include "roc_rtcp/composer.h"
+#include "roc_rtcp/parser.h"
+#include "roc_rtcp/sender_reporter.h"
 #include "roc_rtp/format_map.h"
 
 namespace roc {
 namespace pipeline {
 
 //! Sender pipeline.
-class Sender : public audio::IWriter, public core::NonCopyable<> {
+//! @remarks
+//!  If control port is set, sends RTCP sender reports to it and accepts
+//!  RTCP receiver reports via packet::IWriter interface. If retransmission
+//!  buffer is enabled, source packets requested by generic NACKs in those
+//!  reports are sent again.
+class Sender : public audio::IWriter,
+               public packet::IWriter,
+               public core::NonCopyable<> {
 public:
     //! Initialize.
+    //! @remarks
+    //!  If @p fec_worker is not NULL, FEC blocks are encoded on its thread
+    //!  instead of the thread calling write(), and repair packets are written
+    //!  to @p repair_writer from that thread. If interleaving is enabled,
+    //!  @p fec_worker is not used, since repair packets should go through
+    //!  the interleaver, which is used from the thread calling write().
     Sender(const SenderConfig& config,
            const PortConfig& source_port,
            packet::IWriter& source_writer,
            const PortConfig& repair_port,
            packet::IWriter& repair_writer,
+           const PortConfig& control_port,
+           packet::IWriter& control_writer,
+           fec::EncoderWorker* fec_worker,
            const rtp::FormatMap& format_map,
            packet::PacketPool& packet_pool,
            core::BufferPool<uint8_t>& byte_buffer_pool,
@@ -55,9 +78,36 @@ public:
     //! Write audio frame.
     virtual void write(audio::Frame& frame);
 
+    //! Write packet received on control port.
+    //! @remarks
+    //!  Should be called from the same thread as write(audio::Frame&).
+    virtual void write(const packet::PacketPtr& packet);
+
+    //! Get statistics built from received RTCP reports.
+    rtcp::SenderStats stats() const;
+
+    //! Get packet length, in nanoseconds.
+    //! @remarks
+    //!  Differs from SenderConfig::packet_length if max_packet_size is set.
+    core::nanoseconds_t packet_length() const;
+
 private:
+    bool init_packet_length_(const SenderConfig& config, const rtp::Format& format);
+
+    void resend_(const rtcp::Nack& nack);
+    void send_report_();
+
+    packet::PacketPool& packet_pool_;
+    core::BufferPool<uint8_t>& byte_buffer_pool_;
+
     core::UniquePtr<SenderPort> source_port_;
     core::UniquePtr<SenderPort> repair_port_;
+    core::UniquePtr<SenderPort> control_port_;
+
+    core::UniquePtr<packet::RetransmissionBuffer> retransmission_buffer_;
+    core::UniquePtr<rtcp::SenderReporter> reporter_;
+    rtcp::Parser rtcp_parser_;
+    rtcp::Composer rtcp_composer_;
 
     core::UniquePtr<packet::Router> router_;
 
@@ -66,6 +116,9 @@ private:
     core::UniquePtr<fec::IEncoder> fec_encoder_;
     core::UniquePtr<fec::Writer> fec_writer_;
 
+    core::UniquePtr<fec::RLCEncoder> rlc_encoder_;
+    core::UniquePtr<fec::RLCWriter> rlc_writer_;
+
     core::UniquePtr<audio::IEncoder> encoder_;
     core::UniquePtr<audio::Packetizer> packetizer_;
 
@@ -80,6 +133,11 @@ private:
 
     packet::timestamp_t timestamp_;
     size_t num_channels_;
+
+    core::nanoseconds_t packet_length_;
+
+    packet::timestamp_t report_interval_;
+    packet::timestamp_t next_report_;
 };
 
 } // namespace pipeline
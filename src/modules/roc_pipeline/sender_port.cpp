@@ -11,14 +11,17 @@
 #include "roc_core/panic.h"
 #include "roc_fec/composer.h"
 #include "roc_fec/headers.h"
+#include "roc_pipeline/proto_to_str.h"
 
 namespace roc {
 namespace pipeline {
 
 SenderPort::SenderPort(const PortConfig& config,
+                       bool capture_timestamps,
                        packet::IWriter& writer,
                        core::IAllocator& allocator)
     : dst_address_(config.address)
+    , protocol_(config.protocol)
     , writer_(writer)
     , composer_(NULL) {
     packet::IComposer* composer = NULL;
@@ -27,7 +30,9 @@ SenderPort::SenderPort(const PortConfig& config,
     case Proto_RTP:
     case Proto_RTP_LDPC_Source:
     case Proto_RTP_RSm8_Source:
-        rtp_composer_.reset(new (allocator) rtp::Composer(NULL), allocator);
+    case Proto_RTP_RLC_Source:
+        rtp_composer_.reset(new (allocator) rtp::Composer(NULL, capture_timestamps),
+                            allocator);
         if (!rtp_composer_) {
             return;
         }
@@ -78,18 +83,44 @@ SenderPort::SenderPort(const PortConfig& config,
         }
         composer = fec_composer_.get();
         break;
+    case Proto_RTP_RLC_Source:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::RLC_Source_PayloadID, fec::Source, fec::Footer>(
+                    composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
+    case Proto_RLC_Repair:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::RLC_Repair_PayloadID, fec::Repair, fec::Header>(
+                    composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
     }
 
     composer_ = composer;
 }
 
 bool SenderPort::valid() const {
-    return composer_;
+    return composer_ || protocol_ == Proto_RTCP;
 }
 
 packet::IComposer& SenderPort::composer() {
     roc_panic_if(!valid());
 
+    if (!composer_) {
+        roc_panic("sender port: no composer for %s port", proto_to_str(protocol_));
+    }
+
     return *composer_;
 }
 
@@ -103,6 +134,10 @@ void SenderPort::write(const packet::PacketPtr& packet) {
     udp.dst_addr = dst_address_;
 
     if ((packet->flags() & packet::Packet::FlagComposed) == 0) {
+        if (!composer_) {
+            roc_panic("sender port: unexpected non-composed packet for %s port",
+                      proto_to_str(protocol_));
+        }
         if (!composer_->compose(*packet)) {
             roc_panic("sender port: can't compose packet");
         }
@@ -29,7 +29,11 @@ namespace pipeline {
 class SenderPort : public packet::IWriter, public core::NonCopyable<> {
 public:
     //! Initialize.
+    //! @remarks
+    //!  If @p capture_timestamps is true, RTP packets will carry capture
+    //!  timestamps in header extension.
     SenderPort(const PortConfig& config,
+               bool capture_timestamps,
                packet::IWriter& writer,
                core::IAllocator& allocator);
 
@@ -37,6 +41,8 @@ public:
     bool valid() const;
 
     //! Get packet composer.
+    //! @remarks
+    //!  Not available for RTCP ports, which accept only composed packets.
     packet::IComposer& composer();
 
     //! Write packet.
@@ -44,6 +50,7 @@ public:
 
 private:
     const packet::Address dst_address_;
+    const Protocol protocol_;
 
     packet::IWriter& writer_;
     packet::IComposer* composer_;
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtcp/composer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_rtcp/headers.h"
+
+namespace roc {
+namespace rtcp {
+
+namespace {
+
+enum { CnameLen = 12 };
+
+void format_cname(char* buf, uint32_t ssrc) {
+    static const char hex[] = "0123456789abcdef";
+
+    buf[0] = 'r';
+    buf[1] = 'o';
+    buf[2] = 'c';
+    buf[3] = '-';
+
+    for (size_t n = 0; n < 8; n++) {
+        buf[4 + n] = hex[(ssrc >> (28 - n * 4)) & 0xf];
+    }
+}
+
+size_t report_size(const Report& report) {
+    size_t size = sizeof(Header) + sizeof(SSRC);
+    if (report.has_sender_info) {
+        size += sizeof(SenderInfo);
+    }
+    size += report.num_reports * sizeof(ReceptionBlock);
+    return size;
+}
+
+size_t sdes_size() {
+    // SSRC, item type, item length, item text, and at least one null octet
+    // terminating the item list, padded to 32-bit boundary
+    const size_t size = sizeof(Header) + sizeof(SSRC) + 2 + CnameLen + 1;
+    return (size + 3) / 4 * 4;
+}
+
+// groups seqnums into PID/BLP entries; seqnums are expected to be sorted
+size_t nack_entries(const Nack& nack, NackFCI* fci) {
+    size_t n_entries = 0;
+
+    for (size_t n = 0; n < nack.num_seqnums;) {
+        const uint16_t pid = nack.seqnums[n++];
+        uint16_t blp = 0;
+
+        while (n < nack.num_seqnums) {
+            const uint16_t dist = (uint16_t)(nack.seqnums[n] - pid);
+            if (dist == 0 || dist >= NackFCI::MaxPackets) {
+                break;
+            }
+            blp |= (uint16_t)(1 << (dist - 1));
+            n++;
+        }
+
+        if (fci) {
+            fci[n_entries].set_pid(pid);
+            fci[n_entries].set_blp(blp);
+        }
+
+        n_entries++;
+    }
+
+    return n_entries;
+}
+
+size_t nack_size(const Nack& nack) {
+    if (nack.num_seqnums == 0) {
+        return 0;
+    }
+    return sizeof(Header) + sizeof(SSRC) * 2
+        + nack_entries(nack, NULL) * sizeof(NackFCI);
+}
+
+} // namespace
+
+bool Composer::compose(core::Slice<uint8_t>& buffer, const Report& report) const {
+    if (report.num_reports > Report::MaxReceptionReports) {
+        roc_panic("rtcp composer: too many reception reports: num=%lu max=%lu",
+                  (unsigned long)report.num_reports,
+                  (unsigned long)Report::MaxReceptionReports);
+    }
+
+    if (report.nack.num_seqnums > Nack::MaxSeqnums) {
+        roc_panic("rtcp composer: too many nack seqnums: num=%lu max=%lu",
+                  (unsigned long)report.nack.num_seqnums,
+                  (unsigned long)Nack::MaxSeqnums);
+    }
+
+    const size_t rep_size = report_size(report);
+    const size_t total_size = rep_size + sdes_size() + nack_size(report.nack);
+
+    if (buffer.capacity() < total_size) {
+        roc_log(LogDebug,
+                "rtcp composer: not enough space for rtcp packet: size=%lu cap=%lu",
+                (unsigned long)total_size, (unsigned long)buffer.capacity());
+        return false;
+    }
+
+    buffer.resize(total_size);
+    memset(buffer.data(), 0, total_size);
+
+    uint8_t* data = buffer.data();
+
+    Header& header = *(Header*)data;
+    header.set_version(V2);
+    header.set_type(report.has_sender_info ? RTCP_SR : RTCP_RR);
+    header.set_counter(report.num_reports);
+    header.set_size(rep_size);
+
+    size_t pos = sizeof(Header);
+
+    ((SSRC*)(data + pos))->set_ssrc(report.ssrc);
+    pos += sizeof(SSRC);
+
+    if (report.has_sender_info) {
+        SenderInfo& info = *(SenderInfo*)(data + pos);
+
+        info.set_ntp_timestamp(report.ntp_timestamp);
+        info.set_rtp_timestamp(report.rtp_timestamp);
+        info.set_packet_count(report.packet_count);
+        info.set_byte_count(report.byte_count);
+
+        pos += sizeof(SenderInfo);
+    }
+
+    for (size_t n = 0; n < report.num_reports; n++) {
+        const ReceptionReport& rr = report.reports[n];
+        ReceptionBlock& block = *(ReceptionBlock*)(data + pos);
+
+        float fraction = rr.fraction_lost * 256;
+        if (fraction < 0) {
+            fraction = 0;
+        }
+        if (fraction > 255) {
+            fraction = 255;
+        }
+
+        block.set_ssrc(rr.ssrc);
+        block.set_losses((uint8_t)fraction, rr.cumulative_lost);
+        block.set_last_seqnum(rr.last_seqnum);
+        block.set_jitter(rr.jitter);
+        block.set_last_sr(rr.last_sr);
+        block.set_delay_last_sr(rr.delay_last_sr);
+
+        pos += sizeof(ReceptionBlock);
+    }
+
+    Header& sdes = *(Header*)(data + pos);
+    sdes.set_version(V2);
+    sdes.set_type(RTCP_SDES);
+    sdes.set_counter(1);
+    sdes.set_size(sdes_size());
+
+    pos += sizeof(Header);
+
+    ((SSRC*)(data + pos))->set_ssrc(report.ssrc);
+    pos += sizeof(SSRC);
+
+    data[pos++] = SDES_CNAME;
+    data[pos++] = CnameLen;
+
+    format_cname((char*)data + pos, report.ssrc);
+
+    if (report.nack.num_seqnums != 0) {
+        pos = rep_size + sdes_size();
+
+        Header& fb = *(Header*)(data + pos);
+        fb.set_version(V2);
+        fb.set_type(RTCP_RTPFB);
+        fb.set_counter(RTPFB_NACK);
+        fb.set_size(nack_size(report.nack));
+
+        pos += sizeof(Header);
+
+        ((SSRC*)(data + pos))->set_ssrc(report.ssrc);
+        pos += sizeof(SSRC);
+
+        ((SSRC*)(data + pos))->set_ssrc(report.nack.ssrc);
+        pos += sizeof(SSRC);
+
+        nack_entries(report.nack, (NackFCI*)(data + pos));
+    }
+
+    return true;
+}
+
+} // namespace rtcp
+} // namespace roc
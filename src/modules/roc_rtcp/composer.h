@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/composer.h
+//! @brief RTCP packet composer.
+
+#ifndef ROC_RTCP_COMPOSER_H_
+#define ROC_RTCP_COMPOSER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_rtcp/report.h"
+
+namespace roc {
+namespace rtcp {
+
+//! RTCP packet composer.
+class Composer : public core::NonCopyable<> {
+public:
+    //! Compose compound RTCP packet to buffer.
+    //! @remarks
+    //!  Writes SR or RR, depending on whether @p report has sender info,
+    //!  followed by SDES with CNAME item, as required by RFC 3550. If
+    //!  @p report has a NACK, also writes RTPFB generic NACK (RFC 4585).
+    //!  Buffer is resized to the size of the composed packet.
+    //! @returns
+    //!  false if the buffer capacity is not enough.
+    bool compose(core::Slice<uint8_t>& buffer, const Report& report) const;
+};
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_COMPOSER_H_
@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/headers.h
+//! @brief RTCP headers.
+
+#ifndef ROC_RTCP_HEADERS_H_
+#define ROC_RTCP_HEADERS_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/endian.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace rtcp {
+
+//! RTCP protocol version.
+enum Version {
+    V2 = 2 //!< RTCP version 2.
+};
+
+//! RTCP packet type.
+enum PacketType {
+    RTCP_SR = 200,   //!< Sender report.
+    RTCP_RR = 201,   //!< Receiver report.
+    RTCP_SDES = 202, //!< Source description.
+    RTCP_BYE = 203,  //!< Goodbye.
+    RTCP_APP = 204,  //!< Application-defined.
+    RTCP_RTPFB = 205 //!< Transport layer feedback.
+};
+
+//! Transport layer feedback message type (FMT).
+enum RtpfbFormat {
+    RTPFB_NACK = 1 //!< Generic NACK.
+};
+
+//! SDES item type.
+enum SdesItemType {
+    SDES_END = 0,  //!< End of item list.
+    SDES_CNAME = 1 //!< Canonical end-point identifier.
+};
+
+//! RTCP header.
+//! @remarks
+//!  Common header of all RTCP packets.
+//!
+//! @code
+//!    0             1               2               3               4
+//!    0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |V=2|P|   RC    |      PT       |             length            |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED Header {
+private:
+    enum {
+        //! @name RTCP protocol version.
+        // @{
+        Flag_VersionShift = 6,
+        Flag_VersionMask = 0x3,
+        // @}
+
+        //! @name RTCP padding flag.
+        // @{
+        Flag_PaddingShift = 5,
+        Flag_PaddingMask = 0x1,
+        // @}
+
+        //! @name Number of report blocks or SDES chunks, or feedback type.
+        // @{
+        Flag_CounterShift = 0,
+        Flag_CounterMask = 0x1f
+        // @}
+    };
+
+    //! Packed flags (Flag_*).
+    uint8_t flags_;
+
+    //! Packet type.
+    uint8_t type_;
+
+    //! Packet length in 32-bit words minus one, including header.
+    uint16_t length_;
+
+public:
+    //! Maximum value of counter field.
+    enum { MaxCounter = Flag_CounterMask };
+
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    //! Get version.
+    uint8_t version() const {
+        return ((flags_ >> Flag_VersionShift) & Flag_VersionMask);
+    }
+
+    //! Set version.
+    void set_version(Version v) {
+        roc_panic_if((v & Flag_VersionMask) != v);
+        flags_ &= ~(Flag_VersionMask << Flag_VersionShift);
+        flags_ |= (v << Flag_VersionShift);
+    }
+
+    //! Get padding flag.
+    bool has_padding() const {
+        return (flags_ & (Flag_PaddingMask << Flag_PaddingShift));
+    }
+
+    //! Get number of report blocks or SDES chunks.
+    //! @remarks
+    //!  For feedback packets, this field holds feedback message type (FMT).
+    uint8_t counter() const {
+        return ((flags_ >> Flag_CounterShift) & Flag_CounterMask);
+    }
+
+    //! Set number of report blocks or SDES chunks.
+    void set_counter(size_t c) {
+        roc_panic_if(c > Flag_CounterMask);
+        flags_ &= ~(Flag_CounterMask << Flag_CounterShift);
+        flags_ |= ((uint8_t)c << Flag_CounterShift);
+    }
+
+    //! Get packet type.
+    uint8_t type() const {
+        return type_;
+    }
+
+    //! Set packet type.
+    void set_type(PacketType t) {
+        type_ = (uint8_t)t;
+    }
+
+    //! Get packet size in bytes, including header.
+    size_t size() const {
+        return ((size_t)core::ntoh16(length_) + 1) * 4;
+    }
+
+    //! Set packet size in bytes, including header.
+    //! @remarks
+    //!  Size should be a multiple of four.
+    void set_size(size_t sz) {
+        roc_panic_if(sz < 4 || sz % 4 != 0 || sz / 4 - 1 > 0xffff);
+        length_ = core::hton16((uint16_t)(sz / 4 - 1));
+    }
+};
+
+//! RTCP SSRC field.
+//! @remarks
+//!  Follows header in SR, RR, and SDES chunk.
+class ROC_ATTR_PACKED SSRC {
+private:
+    uint32_t ssrc_;
+
+public:
+    //! Get SSRC.
+    uint32_t ssrc() const {
+        return core::ntoh32(ssrc_);
+    }
+
+    //! Set SSRC.
+    void set_ssrc(uint32_t s) {
+        ssrc_ = core::hton32(s);
+    }
+};
+
+//! Sender info.
+//! @remarks
+//!  Follows header and SSRC in sender report.
+//!
+//! @code
+//!    0             1               2               3               4
+//!    0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |              NTP timestamp, most significant word             |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |             NTP timestamp, least significant word             |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                         RTP timestamp                         |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                     sender's packet count                     |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                      sender's octet count                     |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED SenderInfo {
+private:
+    uint32_t ntp_msw_;
+    uint32_t ntp_lsw_;
+    uint32_t rtp_timestamp_;
+    uint32_t packet_count_;
+    uint32_t byte_count_;
+
+public:
+    //! Get NTP timestamp.
+    uint64_t ntp_timestamp() const {
+        return ((uint64_t)core::ntoh32(ntp_msw_) << 32) | core::ntoh32(ntp_lsw_);
+    }
+
+    //! Set NTP timestamp.
+    void set_ntp_timestamp(uint64_t ts) {
+        ntp_msw_ = core::hton32((uint32_t)(ts >> 32));
+        ntp_lsw_ = core::hton32((uint32_t)ts);
+    }
+
+    //! Get RTP timestamp.
+    uint32_t rtp_timestamp() const {
+        return core::ntoh32(rtp_timestamp_);
+    }
+
+    //! Set RTP timestamp.
+    void set_rtp_timestamp(uint32_t ts) {
+        rtp_timestamp_ = core::hton32(ts);
+    }
+
+    //! Get packet count.
+    uint32_t packet_count() const {
+        return core::ntoh32(packet_count_);
+    }
+
+    //! Set packet count.
+    void set_packet_count(uint32_t n) {
+        packet_count_ = core::hton32(n);
+    }
+
+    //! Get payload octet count.
+    uint32_t byte_count() const {
+        return core::ntoh32(byte_count_);
+    }
+
+    //! Set payload octet count.
+    void set_byte_count(uint32_t n) {
+        byte_count_ = core::hton32(n);
+    }
+};
+
+//! Reception report block.
+//! @remarks
+//!  Zero or more blocks follow sender info in SR or SSRC in RR.
+//!
+//! @code
+//!    0             1               2               3               4
+//!    0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                 SSRC_n (SSRC of n-th source)                  |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   | fraction lost |       cumulative number of packets lost       |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |           extended highest sequence number received           |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                      interarrival jitter                      |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                         last SR (LSR)                         |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                   delay since last SR (DLSR)                  |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED ReceptionBlock {
+private:
+    enum {
+        //! @name Fraction lost.
+        // @{
+        Losses_FractionShift = 24,
+        Losses_FractionMask = 0xff,
+        // @}
+
+        //! @name Cumulative number of packets lost.
+        // @{
+        Losses_CumulativeShift = 0,
+        Losses_CumulativeMask = 0xffffff
+        // @}
+    };
+
+    uint32_t ssrc_;
+    uint32_t losses_;
+    uint32_t last_seqnum_;
+    uint32_t jitter_;
+    uint32_t last_sr_;
+    uint32_t delay_last_sr_;
+
+public:
+    //! Get SSRC.
+    uint32_t ssrc() const {
+        return core::ntoh32(ssrc_);
+    }
+
+    //! Set SSRC.
+    void set_ssrc(uint32_t s) {
+        ssrc_ = core::hton32(s);
+    }
+
+    //! Get fraction lost, fixed point number with 8 fractional bits.
+    uint8_t fraction_lost() const {
+        return (uint8_t)((core::ntoh32(losses_) >> Losses_FractionShift)
+                         & Losses_FractionMask);
+    }
+
+    //! Get cumulative number of packets lost.
+    int32_t cumulative_lost() const {
+        uint32_t v =
+            (core::ntoh32(losses_) >> Losses_CumulativeShift) & Losses_CumulativeMask;
+        // sign-extend 24-bit value
+        if (v & 0x800000) {
+            v |= 0xff000000;
+        }
+        return (int32_t)v;
+    }
+
+    //! Set fraction and cumulative number of packets lost.
+    void set_losses(uint8_t fraction, int32_t cumulative) {
+        if (cumulative > 0x7fffff) {
+            cumulative = 0x7fffff;
+        }
+        if (cumulative < -0x800000) {
+            cumulative = -0x800000;
+        }
+        losses_ = core::hton32(((uint32_t)fraction << Losses_FractionShift)
+                               | (((uint32_t)cumulative & Losses_CumulativeMask)
+                                  << Losses_CumulativeShift));
+    }
+
+    //! Get extended highest sequence number.
+    uint32_t last_seqnum() const {
+        return core::ntoh32(last_seqnum_);
+    }
+
+    //! Set extended highest sequence number.
+    void set_last_seqnum(uint32_t sn) {
+        last_seqnum_ = core::hton32(sn);
+    }
+
+    //! Get interarrival jitter, in timestamp units.
+    uint32_t jitter() const {
+        return core::ntoh32(jitter_);
+    }
+
+    //! Set interarrival jitter, in timestamp units.
+    void set_jitter(uint32_t j) {
+        jitter_ = core::hton32(j);
+    }
+
+    //! Get middle 32 bits of the NTP timestamp of the last SR.
+    uint32_t last_sr() const {
+        return core::ntoh32(last_sr_);
+    }
+
+    //! Set middle 32 bits of the NTP timestamp of the last SR.
+    void set_last_sr(uint32_t lsr) {
+        last_sr_ = core::hton32(lsr);
+    }
+
+    //! Get delay since last SR, in 1/65536 seconds.
+    uint32_t delay_last_sr() const {
+        return core::ntoh32(delay_last_sr_);
+    }
+
+    //! Set delay since last SR, in 1/65536 seconds.
+    void set_delay_last_sr(uint32_t dlsr) {
+        delay_last_sr_ = core::hton32(dlsr);
+    }
+};
+
+//! Generic NACK feedback control information.
+//! @remarks
+//!  One or more entries follow header, sender SSRC, and media source SSRC
+//!  in RTPFB packet with FMT=1. See RFC 4585, section 6.2.1.
+//!
+//! @code
+//!    0             1               2               3               4
+//!    0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |            PID                |             BLP               |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED NackFCI {
+private:
+    uint16_t pid_;
+    uint16_t blp_;
+
+public:
+    //! Maximum number of packets described by a single entry.
+    enum { MaxPackets = 17 };
+
+    //! Get packet ID, i.e. seqnum of the first lost packet.
+    uint16_t pid() const {
+        return core::ntoh16(pid_);
+    }
+
+    //! Set packet ID.
+    void set_pid(uint16_t pid) {
+        pid_ = core::hton16(pid);
+    }
+
+    //! Get bitmask of following lost packets.
+    //! @remarks
+    //!  Bit i is set if packet with seqnum pid + i + 1 is lost.
+    uint16_t blp() const {
+        return core::ntoh16(blp_);
+    }
+
+    //! Set bitmask of following lost packets.
+    void set_blp(uint16_t blp) {
+        blp_ = core::hton16(blp);
+    }
+};
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_HEADERS_H_
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtcp/nack_generator.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace rtcp {
+
+NackGenerator::NackGenerator(const NackConfig& config)
+    : config_(config)
+    , started_(false)
+    , ssrc_(0)
+    , max_seqnum_(0)
+    , num_entries_(0) {
+}
+
+void NackGenerator::add_packet(const packet::Packet& packet) {
+    const packet::RTP* rtp = packet.rtp();
+    if (!rtp) {
+        return;
+    }
+
+    if (!started_ || rtp->source != ssrc_) {
+        ssrc_ = rtp->source;
+        max_seqnum_ = rtp->seqnum;
+        num_entries_ = 0;
+        started_ = true;
+        return;
+    }
+
+    const packet::seqnum_diff_t sn_diff = packet::seqnum_diff(rtp->seqnum, max_seqnum_);
+
+    if (sn_diff <= 0) {
+        remove_missing_(rtp->seqnum);
+        return;
+    }
+
+    if (sn_diff > 1) {
+        roc_log(LogTrace, "nack generator: detected hole: first=%lu last=%lu",
+                (unsigned long)(packet::seqnum_t)(max_seqnum_ + 1),
+                (unsigned long)(packet::seqnum_t)(rtp->seqnum - 1));
+    }
+
+    // only the most recent holes fit into the table
+    packet::seqnum_t sn = (packet::seqnum_t)(max_seqnum_ + 1);
+    if (sn_diff - 1 > (packet::seqnum_diff_t)Nack::MaxSeqnums) {
+        sn = (packet::seqnum_t)(rtp->seqnum - Nack::MaxSeqnums);
+    }
+
+    for (; sn != rtp->seqnum; sn++) {
+        add_missing_(sn);
+    }
+
+    max_seqnum_ = rtp->seqnum;
+}
+
+bool NackGenerator::generate(Nack& nack, core::nanoseconds_t now) {
+    nack = Nack();
+    nack.ssrc = ssrc_;
+
+    size_t n_kept = 0;
+
+    for (size_t n = 0; n < num_entries_; n++) {
+        Entry& entry = entries_[n];
+
+        if (entry.retries != 0 && now - entry.last_sent < config_.retry_interval) {
+            entries_[n_kept++] = entry;
+            continue;
+        }
+
+        if (entry.retries >= config_.max_retries) {
+            roc_log(LogTrace, "nack generator: giving up: sn=%lu retries=%lu",
+                    (unsigned long)entry.seqnum, (unsigned long)entry.retries);
+            continue;
+        }
+
+        entry.last_sent = now;
+        entry.retries++;
+
+        nack.seqnums[nack.num_seqnums++] = entry.seqnum;
+
+        entries_[n_kept++] = entry;
+    }
+
+    num_entries_ = n_kept;
+
+    return nack.num_seqnums != 0;
+}
+
+size_t NackGenerator::num_missing() const {
+    return num_entries_;
+}
+
+void NackGenerator::add_missing_(packet::seqnum_t seqnum) {
+    if (num_entries_ == Nack::MaxSeqnums) {
+        for (size_t n = 1; n < num_entries_; n++) {
+            entries_[n - 1] = entries_[n];
+        }
+        num_entries_--;
+    }
+
+    Entry& entry = entries_[num_entries_++];
+    entry.seqnum = seqnum;
+    entry.last_sent = 0;
+    entry.retries = 0;
+}
+
+void NackGenerator::remove_missing_(packet::seqnum_t seqnum) {
+    for (size_t n = 0; n < num_entries_; n++) {
+        if (entries_[n].seqnum != seqnum) {
+            continue;
+        }
+        for (size_t k = n + 1; k < num_entries_; k++) {
+            entries_[k - 1] = entries_[k];
+        }
+        num_entries_--;
+        return;
+    }
+}
+
+} // namespace rtcp
+} // namespace roc
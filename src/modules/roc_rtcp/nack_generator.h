@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/nack_generator.h
+//! @brief NACK generator.
+
+#ifndef ROC_RTCP_NACK_GENERATOR_H_
+#define ROC_RTCP_NACK_GENERATOR_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/units.h"
+#include "roc_rtcp/report.h"
+
+namespace roc {
+namespace rtcp {
+
+//! NACK generator parameters.
+struct NackConfig {
+    //! Minimum interval between requests for the same packet, in nanoseconds.
+    core::nanoseconds_t retry_interval;
+
+    //! Maximum number of requests for the same packet.
+    size_t max_retries;
+
+    NackConfig()
+        : retry_interval(20 * core::Millisecond)
+        , max_retries(3) {
+    }
+};
+
+//! NACK generator.
+//! @remarks
+//!  Detects holes in sequence numbers of a single RTP source as soon as
+//!  packets arrive, and generates generic NACKs (RFC 4585) for them until
+//!  the lost packets arrive or the retry limit is reached.
+class NackGenerator : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    NackGenerator(const NackConfig& config);
+
+    //! Update state with a packet received from network.
+    //! @remarks
+    //!  Packets without RTP header are ignored.
+    void add_packet(const packet::Packet& packet);
+
+    //! Generate NACK for packets that are still missing.
+    //! @remarks
+    //!  @p now is the current local time, as returned by core::timestamp().
+    //! @returns
+    //!  false if there is nothing to request.
+    bool generate(Nack& nack, core::nanoseconds_t now);
+
+    //! Get number of packets that are currently tracked as missing.
+    size_t num_missing() const;
+
+private:
+    struct Entry {
+        packet::seqnum_t seqnum;
+        core::nanoseconds_t last_sent;
+        size_t retries;
+    };
+
+    void add_missing_(packet::seqnum_t seqnum);
+    void remove_missing_(packet::seqnum_t seqnum);
+
+    const NackConfig config_;
+
+    bool started_;
+    packet::source_t ssrc_;
+    packet::seqnum_t max_seqnum_;
+
+    // sorted by seqnum, oldest first
+    Entry entries_[Nack::MaxSeqnums];
+    size_t num_entries_;
+};
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_NACK_GENERATOR_H_
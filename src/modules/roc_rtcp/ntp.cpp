@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtcp/ntp.h"
+
+namespace roc {
+namespace rtcp {
+
+namespace {
+
+// Seconds between 1 Jan 1900 (NTP epoch) and 1 Jan 1970 (Unix epoch).
+const uint64_t NtpUnixOffset = 2208988800ull;
+
+} // namespace
+
+ntp_timestamp_t unix_to_ntp(core::nanoseconds_t unix_time) {
+    if (unix_time < 0) {
+        unix_time = 0;
+    }
+
+    const uint64_t secs = (uint64_t)(unix_time / core::Second);
+    const uint64_t nsecs = (uint64_t)(unix_time % core::Second);
+
+    const uint64_t frac = (nsecs << 32) / (uint64_t)core::Second;
+
+    return ((secs + NtpUnixOffset) << 32) | frac;
+}
+
+core::nanoseconds_t ntp_to_unix(ntp_timestamp_t ntp_time) {
+    const uint64_t secs = ntp_time >> 32;
+    const uint64_t frac = ntp_time & 0xffffffff;
+
+    if (secs < NtpUnixOffset) {
+        return 0;
+    }
+
+    const uint64_t nsecs = (frac * (uint64_t)core::Second + (1ull << 31)) >> 32;
+
+    return (core::nanoseconds_t)(secs - NtpUnixOffset) * core::Second
+        + (core::nanoseconds_t)nsecs;
+}
+
+uint32_t ntp_compact(ntp_timestamp_t ntp_time) {
+    return (uint32_t)(ntp_time >> 16);
+}
+
+uint32_t ns_to_compact(core::nanoseconds_t duration) {
+    if (duration <= 0) {
+        return 0;
+    }
+
+    if (duration >= 65536 * core::Second) {
+        return 0xffffffff;
+    }
+
+    return (uint32_t)(((uint64_t)duration << 16) / (uint64_t)core::Second);
+}
+
+core::nanoseconds_t compact_to_ns(uint32_t duration) {
+    return (core::nanoseconds_t)(((uint64_t)duration * (uint64_t)core::Second) >> 16);
+}
+
+} // namespace rtcp
+} // namespace roc
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/ntp.h
+//! @brief NTP timestamps.
+
+#ifndef ROC_RTCP_NTP_H_
+#define ROC_RTCP_NTP_H_
+
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace rtcp {
+
+//! NTP timestamp.
+//! @remarks
+//!  64-bit fixed point number of seconds since 1 Jan 1900,
+//!  with 32 integer and 32 fractional bits.
+typedef uint64_t ntp_timestamp_t;
+
+//! Convert Unix time in nanoseconds to NTP timestamp.
+ntp_timestamp_t unix_to_ntp(core::nanoseconds_t unix_time);
+
+//! Convert NTP timestamp to Unix time in nanoseconds.
+core::nanoseconds_t ntp_to_unix(ntp_timestamp_t ntp_time);
+
+//! Get middle 32 bits of NTP timestamp.
+//! @remarks
+//!  Used in LSR field of reception report block.
+uint32_t ntp_compact(ntp_timestamp_t ntp_time);
+
+//! Convert duration in nanoseconds to 1/65536 seconds units.
+//! @remarks
+//!  Used in DLSR field of reception report block.
+uint32_t ns_to_compact(core::nanoseconds_t duration);
+
+//! Convert duration in 1/65536 seconds units to nanoseconds.
+core::nanoseconds_t compact_to_ns(uint32_t duration);
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_NTP_H_
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtcp/parser.h"
+#include "roc_core/log.h"
+#include "roc_rtcp/headers.h"
+
+namespace roc {
+namespace rtcp {
+
+namespace {
+
+bool validate(const core::Slice<uint8_t>& buffer) {
+    const uint8_t* data = buffer.data();
+    size_t size = buffer.size();
+
+    if (size < sizeof(Header)) {
+        roc_log(LogDebug, "rtcp parser: bad packet, size < %d (rtcp header)",
+                (int)sizeof(Header));
+        return false;
+    }
+
+    // RFC 3550, appendix A.2
+    const Header& first = *(const Header*)data;
+    if (first.type() != RTCP_SR && first.type() != RTCP_RR) {
+        roc_log(LogDebug, "rtcp parser: bad packet, first packet type %d is not SR or RR",
+                (int)first.type());
+        return false;
+    }
+
+    while (size != 0) {
+        if (size < sizeof(Header)) {
+            roc_log(LogDebug, "rtcp parser: bad packet, trailing %d bytes", (int)size);
+            return false;
+        }
+
+        const Header& header = *(const Header*)data;
+
+        if (header.version() != V2) {
+            roc_log(LogDebug, "rtcp parser: bad version, get %d, expected %d",
+                    (int)header.version(), (int)V2);
+            return false;
+        }
+
+        if (header.size() > size) {
+            roc_log(LogDebug, "rtcp parser: bad packet, length %d > %d (remaining size)",
+                    (int)header.size(), (int)size);
+            return false;
+        }
+
+        data += header.size();
+        size -= header.size();
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool Parser::parse(packet::Packet& packet, const core::Slice<uint8_t>& buffer) {
+    if (!validate(buffer)) {
+        return false;
+    }
+
+    packet.add_flags(packet::Packet::FlagRTCP);
+    packet.rtcp()->data = buffer;
+
+    return true;
+}
+
+bool Parser::parse_report(const core::Slice<uint8_t>& buffer, Report& report) const {
+    if (!validate(buffer)) {
+        return false;
+    }
+
+    report = Report();
+
+    const uint8_t* data = buffer.data();
+    size_t size = buffer.size();
+
+    bool found_report = false;
+
+    while (size != 0) {
+        const Header& header = *(const Header*)data;
+        const size_t packet_size = header.size();
+
+        if (header.type() == RTCP_RTPFB && header.counter() == RTPFB_NACK) {
+            if (!parse_nack_(data, packet_size, report.nack)) {
+                return false;
+            }
+        } else if ((header.type() == RTCP_SR || header.type() == RTCP_RR)
+                   && !found_report) {
+            if (!parse_sr_rr_(data, packet_size, report)) {
+                return false;
+            }
+            found_report = true;
+        }
+
+        data += packet_size;
+        size -= packet_size;
+    }
+
+    if (!found_report) {
+        roc_log(LogDebug, "rtcp parser: no sender or receiver report found");
+        return false;
+    }
+
+    return true;
+}
+
+bool Parser::parse_sr_rr_(const uint8_t* data, size_t packet_size, Report& report) const {
+    const Header& header = *(const Header*)data;
+
+    size_t pos = sizeof(Header) + sizeof(SSRC);
+
+    if (header.type() == RTCP_SR) {
+        pos += sizeof(SenderInfo);
+    }
+
+    if (packet_size < pos + header.counter() * sizeof(ReceptionBlock)) {
+        roc_log(LogDebug, "rtcp parser: bad packet, length %d is too small for %d blocks",
+                (int)packet_size, (int)header.counter());
+        return false;
+    }
+
+    report.ssrc = ((const SSRC*)(data + sizeof(Header)))->ssrc();
+
+    if (header.type() == RTCP_SR) {
+        const SenderInfo& info =
+            *(const SenderInfo*)(data + sizeof(Header) + sizeof(SSRC));
+
+        report.has_sender_info = true;
+        report.ntp_timestamp = info.ntp_timestamp();
+        report.rtp_timestamp = info.rtp_timestamp();
+        report.packet_count = info.packet_count();
+        report.byte_count = info.byte_count();
+    }
+
+    report.num_reports = header.counter();
+
+    for (size_t n = 0; n < report.num_reports; n++) {
+        const ReceptionBlock& block = *(const ReceptionBlock*)(data + pos);
+        ReceptionReport& rr = report.reports[n];
+
+        rr.ssrc = block.ssrc();
+        rr.fraction_lost = (float)block.fraction_lost() / 256;
+        rr.cumulative_lost = block.cumulative_lost();
+        rr.last_seqnum = block.last_seqnum();
+        rr.jitter = block.jitter();
+        rr.last_sr = block.last_sr();
+        rr.delay_last_sr = block.delay_last_sr();
+
+        pos += sizeof(ReceptionBlock);
+    }
+
+    return true;
+}
+
+bool Parser::parse_nack_(const uint8_t* data, size_t packet_size, Nack& nack) const {
+    size_t pos = sizeof(Header) + sizeof(SSRC) * 2;
+
+    if (packet_size < pos) {
+        roc_log(LogDebug, "rtcp parser: bad packet, length %d is too small for nack",
+                (int)packet_size);
+        return false;
+    }
+
+    nack.ssrc = ((const SSRC*)(data + sizeof(Header) + sizeof(SSRC)))->ssrc();
+
+    for (; pos + sizeof(NackFCI) <= packet_size; pos += sizeof(NackFCI)) {
+        const NackFCI& fci = *(const NackFCI*)(data + pos);
+
+        for (size_t n = 0; n < NackFCI::MaxPackets; n++) {
+            if (n != 0 && !(fci.blp() & (1 << (n - 1)))) {
+                continue;
+            }
+            if (nack.num_seqnums == Nack::MaxSeqnums) {
+                roc_log(LogDebug,
+                        "rtcp parser: too many nack seqnums, truncating: max=%d",
+                        (int)Nack::MaxSeqnums);
+                return true;
+            }
+            nack.seqnums[nack.num_seqnums++] = (uint16_t)(fci.pid() + n);
+        }
+    }
+
+    return true;
+}
+
+} // namespace rtcp
+} // namespace roc
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/parser.h
+//! @brief RTCP packet parser.
+
+#ifndef ROC_RTCP_PARSER_H_
+#define ROC_RTCP_PARSER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_packet/iparser.h"
+#include "roc_rtcp/report.h"
+
+namespace roc {
+namespace rtcp {
+
+//! RTCP packet parser.
+class Parser : public packet::IParser, public core::NonCopyable<> {
+public:
+    //! Parse packet from buffer.
+    //! @remarks
+    //!  Validates compound RTCP packet and sets packet RTCP data.
+    virtual bool parse(packet::Packet& packet, const core::Slice<uint8_t>& buffer);
+
+    //! Parse report from compound RTCP packet.
+    //! @remarks
+    //!  Decodes the first SR or RR packet and generic NACKs (RFC 4585), if any.
+    //!  SDES, BYE, and APP packets are skipped.
+    //! @returns
+    //!  false if the packet is malformed or contains no SR or RR.
+    bool parse_report(const core::Slice<uint8_t>& data, Report& report) const;
+
+private:
+    bool parse_sr_rr_(const uint8_t* data, size_t packet_size, Report& report) const;
+    bool parse_nack_(const uint8_t* data, size_t packet_size, Nack& nack) const;
+};
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_PARSER_H_
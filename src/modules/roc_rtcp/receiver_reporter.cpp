@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtcp/receiver_reporter.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_rtcp/ntp.h"
+
+namespace roc {
+namespace rtcp {
+
+namespace {
+
+// Jitter estimator gain, see RFC 3550, section 6.4.1.
+const double JitterGain = 1.0 / 16;
+
+} // namespace
+
+ReceiverReporter::ReceiverReporter(size_t sample_rate)
+    : sample_rate_(sample_rate)
+    , started_(false)
+    , ssrc_(0)
+    , base_seqnum_(0)
+    , max_seqnum_(0)
+    , cycles_(0)
+    , received_(0)
+    , expected_prior_(0)
+    , received_prior_(0)
+    , last_arrival_(0)
+    , last_ts_(0)
+    , jitter_(0)
+    , has_sr_(false)
+    , sr_ntp_(0)
+    , sr_rtp_(0)
+    , sr_receive_time_(0) {
+}
+
+void ReceiverReporter::add_packet(const packet::Packet& packet) {
+    const packet::RTP* rtp = packet.rtp();
+    if (!rtp) {
+        return;
+    }
+
+    if (!started_ || rtp->source != ssrc_) {
+        ssrc_ = rtp->source;
+        base_seqnum_ = max_seqnum_ = rtp->seqnum;
+        cycles_ = 0;
+        received_ = 0;
+        expected_prior_ = 0;
+        received_prior_ = 0;
+        jitter_ = 0;
+        last_arrival_ = 0;
+        started_ = true;
+    }
+
+    // RFC 3550, appendix A.1
+    const packet::seqnum_diff_t sn_diff = packet::seqnum_diff(rtp->seqnum, max_seqnum_);
+    if (sn_diff > 0) {
+        if (rtp->seqnum < max_seqnum_) {
+            cycles_ += 0x10000;
+        }
+        max_seqnum_ = rtp->seqnum;
+    }
+
+    received_++;
+
+    // RFC 3550, appendix A.8
+    const packet::UDP* udp = packet.udp();
+    if (udp && udp->receive_timestamp != 0) {
+        if (last_arrival_ != 0) {
+            const double arrival_diff = (double)(udp->receive_timestamp - last_arrival_)
+                * sample_rate_ / core::Second;
+            const double ts_diff = (double)packet::timestamp_diff(rtp->timestamp, last_ts_);
+
+            double d = arrival_diff - ts_diff;
+            if (d < 0) {
+                d = -d;
+            }
+            jitter_ += (d - jitter_) * JitterGain;
+        }
+
+        last_arrival_ = udp->receive_timestamp;
+        last_ts_ = rtp->timestamp;
+    }
+
+    stats_.num_packets++;
+    stats_.jitter = (core::nanoseconds_t)(jitter_ * core::Second / sample_rate_);
+}
+
+void ReceiverReporter::process(const Report& report, core::nanoseconds_t receive_time) {
+    if (!report.has_sender_info) {
+        return;
+    }
+
+    if (started_ && report.ssrc != ssrc_) {
+        roc_log(LogDebug, "receiver reporter: ignoring sender report for unknown ssrc");
+        return;
+    }
+
+    has_sr_ = true;
+    sr_ntp_ = report.ntp_timestamp;
+    sr_rtp_ = report.rtp_timestamp;
+    sr_receive_time_ = receive_time;
+
+    stats_.num_reports++;
+}
+
+bool ReceiverReporter::has_report() const {
+    return started_;
+}
+
+void ReceiverReporter::generate(Report& report, uint32_t ssrc, core::nanoseconds_t now) {
+    roc_panic_if(!started_);
+
+    // RFC 3550, appendix A.3
+    const uint32_t ext_max = cycles_ + max_seqnum_;
+    const uint32_t expected = ext_max - base_seqnum_ + 1;
+
+    const int64_t lost = (int64_t)expected - (int64_t)received_;
+
+    const uint32_t expected_interval = expected - expected_prior_;
+    const uint32_t received_interval = received_ - received_prior_;
+
+    expected_prior_ = expected;
+    received_prior_ = received_;
+
+    const int64_t lost_interval = (int64_t)expected_interval - (int64_t)received_interval;
+
+    float fraction = 0;
+    if (expected_interval != 0 && lost_interval > 0) {
+        fraction = (float)lost_interval / expected_interval;
+    }
+
+    stats_.fraction_lost = fraction;
+    stats_.cumulative_lost = (int32_t)lost;
+
+    report = Report();
+    report.ssrc = ssrc;
+    report.num_reports = 1;
+
+    ReceptionReport& rr = report.reports[0];
+
+    rr.ssrc = ssrc_;
+    rr.fraction_lost = fraction;
+    rr.cumulative_lost = (int32_t)lost;
+    rr.last_seqnum = ext_max;
+    rr.jitter = (uint32_t)jitter_;
+
+    if (has_sr_) {
+        rr.last_sr = ntp_compact(sr_ntp_);
+        rr.delay_last_sr = ns_to_compact(now - sr_receive_time_);
+    }
+}
+
+const ReceiverStats& ReceiverReporter::stats() const {
+    return stats_;
+}
+
+bool ReceiverReporter::has_sender_clock() const {
+    return has_sr_;
+}
+
+core::nanoseconds_t ReceiverReporter::e2e_latency(packet::timestamp_t ts) const {
+    roc_panic_if(!has_sr_);
+
+    const core::nanoseconds_t capture_time = ntp_to_unix(sr_ntp_)
+        + packet::timestamp_to_ns(packet::timestamp_diff(ts, sr_rtp_), sample_rate_);
+
+    return core::unix_timestamp() - capture_time;
+}
+
+} // namespace rtcp
+} // namespace roc
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/receiver_reporter.h
+//! @brief Receiver reporter.
+
+#ifndef ROC_RTCP_RECEIVER_REPORTER_H_
+#define ROC_RTCP_RECEIVER_REPORTER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/units.h"
+#include "roc_rtcp/report.h"
+
+namespace roc {
+namespace rtcp {
+
+//! Receiver statistics.
+//! @remarks
+//!  Built from received RTP packets and sender reports.
+struct ReceiverStats {
+    //! Number of RTP packets received.
+    size_t num_packets;
+
+    //! Number of sender reports processed.
+    size_t num_reports;
+
+    //! Fraction of packets lost since the previous receiver report.
+    float fraction_lost;
+
+    //! Cumulative number of packets lost.
+    int32_t cumulative_lost;
+
+    //! Interarrival jitter, nanoseconds.
+    core::nanoseconds_t jitter;
+
+    ReceiverStats()
+        : num_packets(0)
+        , num_reports(0)
+        , fraction_lost(0)
+        , cumulative_lost(0)
+        , jitter(0) {
+    }
+};
+
+//! Receiver reporter.
+//! @remarks
+//!  Collects reception statistics for a single RTP source as described
+//!  in RFC 3550, appendix A, processes sender reports, and generates
+//!  receiver reports.
+class ReceiverReporter : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p sample_rate defines RTP timestamp rate.
+    ReceiverReporter(size_t sample_rate);
+
+    //! Update statistics with a packet received from network.
+    //! @remarks
+    //!  Packets without RTP header are ignored.
+    void add_packet(const packet::Packet& packet);
+
+    //! Process sender report.
+    //! @remarks
+    //!  @p receive_time is the local time when the report was received, as
+    //!  returned by core::timestamp().
+    void process(const Report& report, core::nanoseconds_t receive_time);
+
+    //! Check if receiver report can be generated.
+    //! @remarks
+    //!  Returns true after at least one RTP packet was received.
+    bool has_report() const;
+
+    //! Generate receiver report.
+    //! @remarks
+    //!  @p ssrc defines report originator. @p now is the current local time,
+    //!  as returned by core::timestamp(). Resets fraction lost counters.
+    void generate(Report& report, uint32_t ssrc, core::nanoseconds_t now);
+
+    //! Get statistics.
+    const ReceiverStats& stats() const;
+
+    //! Check if sender report was received and timestamps can be mapped to
+    //! sender wall clock.
+    bool has_sender_clock() const;
+
+    //! Get end-to-end latency for the given RTP timestamp.
+    //! @remarks
+    //!  Computes the difference between the current wall clock time and the
+    //!  sender wall clock time when the sample with RTP timestamp @p ts was
+    //!  captured. Both hosts should have synchronized clocks, e.g. using NTP.
+    core::nanoseconds_t e2e_latency(packet::timestamp_t ts) const;
+
+private:
+    const size_t sample_rate_;
+
+    bool started_;
+    packet::source_t ssrc_;
+
+    packet::seqnum_t base_seqnum_;
+    packet::seqnum_t max_seqnum_;
+    uint32_t cycles_;
+    uint32_t received_;
+    uint32_t expected_prior_;
+    uint32_t received_prior_;
+
+    core::nanoseconds_t last_arrival_;
+    packet::timestamp_t last_ts_;
+    double jitter_;
+
+    bool has_sr_;
+    ntp_timestamp_t sr_ntp_;
+    packet::timestamp_t sr_rtp_;
+    core::nanoseconds_t sr_receive_time_;
+
+    ReceiverStats stats_;
+};
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_RECEIVER_REPORTER_H_
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/report.h
+//! @brief RTCP report.
+
+#ifndef ROC_RTCP_REPORT_H_
+#define ROC_RTCP_REPORT_H_
+
+#include "roc_core/stddefs.h"
+#include "roc_rtcp/ntp.h"
+
+namespace roc {
+namespace rtcp {
+
+//! Reception report.
+//! @remarks
+//!  Describes reception statistics of a single RTP source.
+struct ReceptionReport {
+    //! SSRC of the RTP source.
+    uint32_t ssrc;
+
+    //! Fraction of packets lost since the previous report, in range [0; 1].
+    float fraction_lost;
+
+    //! Cumulative number of packets lost since the beginning of reception.
+    int32_t cumulative_lost;
+
+    //! Extended highest sequence number received.
+    uint32_t last_seqnum;
+
+    //! Interarrival jitter, in RTP timestamp units.
+    uint32_t jitter;
+
+    //! Middle 32 bits of the NTP timestamp of the last SR received.
+    uint32_t last_sr;
+
+    //! Delay since the last SR received, in 1/65536 seconds.
+    uint32_t delay_last_sr;
+
+    ReceptionReport()
+        : ssrc(0)
+        , fraction_lost(0)
+        , cumulative_lost(0)
+        , last_seqnum(0)
+        , jitter(0)
+        , last_sr(0)
+        , delay_last_sr(0) {
+    }
+};
+
+//! Generic NACK.
+//! @remarks
+//!  Lists RTP packets of a single source that should be retransmitted.
+struct Nack {
+    //! Maximum number of seqnums in a single NACK.
+    enum { MaxSeqnums = 64 };
+
+    //! SSRC of the RTP source.
+    uint32_t ssrc;
+
+    //! Number of seqnums.
+    size_t num_seqnums;
+
+    //! Seqnums of lost packets.
+    uint16_t seqnums[MaxSeqnums];
+
+    Nack()
+        : ssrc(0)
+        , num_seqnums(0) {
+    }
+};
+
+//! RTCP report.
+//! @remarks
+//!  Represents a sender report (SR) if has_sender_info is set,
+//!  or a receiver report (RR) otherwise.
+struct Report {
+    //! Maximum number of reception reports in a single report.
+    enum { MaxReceptionReports = 31 };
+
+    //! SSRC of the report originator.
+    uint32_t ssrc;
+
+    //! Whether sender info is present.
+    bool has_sender_info;
+
+    //! Wall clock time when the report was sent.
+    ntp_timestamp_t ntp_timestamp;
+
+    //! RTP timestamp corresponding to ntp_timestamp.
+    uint32_t rtp_timestamp;
+
+    //! Number of RTP packets sent.
+    uint32_t packet_count;
+
+    //! Number of RTP payload octets sent.
+    uint32_t byte_count;
+
+    //! Number of reception reports.
+    size_t num_reports;
+
+    //! Reception reports.
+    ReceptionReport reports[MaxReceptionReports];
+
+    //! Generic NACK, present if nack.num_seqnums is non-zero.
+    Nack nack;
+
+    Report()
+        : ssrc(0)
+        , has_sender_info(false)
+        , ntp_timestamp(0)
+        , rtp_timestamp(0)
+        , packet_count(0)
+        , byte_count(0)
+        , num_reports(0) {
+    }
+};
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_REPORT_H_
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtcp/sender_reporter.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_rtcp/ntp.h"
+
+namespace roc {
+namespace rtcp {
+
+SenderReporter::SenderReporter(packet::IWriter& writer, size_t sample_rate)
+    : writer_(writer)
+    , sample_rate_(sample_rate)
+    , started_(false)
+    , ssrc_(0)
+    , next_ts_(0)
+    , write_time_(0)
+    , packet_count_(0)
+    , byte_count_(0) {
+}
+
+void SenderReporter::write(const packet::PacketPtr& packet) {
+    if (const packet::RTP* rtp = packet->rtp()) {
+        if (!started_ || rtp->source != ssrc_) {
+            ssrc_ = rtp->source;
+            packet_count_ = 0;
+            byte_count_ = 0;
+            started_ = true;
+        }
+
+        // RFC 3550 requires counters to wrap around
+        packet_count_++;
+        byte_count_ += (uint32_t)rtp->payload.size();
+
+        next_ts_ = rtp->timestamp + rtp->duration;
+        write_time_ = core::timestamp();
+    }
+
+    writer_.write(packet);
+}
+
+bool SenderReporter::has_report() const {
+    return started_;
+}
+
+void SenderReporter::generate(Report& report) const {
+    roc_panic_if(!started_);
+
+    const core::nanoseconds_t elapsed = core::timestamp() - write_time_;
+
+    report = Report();
+
+    report.ssrc = ssrc_;
+    report.has_sender_info = true;
+    report.ntp_timestamp = unix_to_ntp(core::unix_timestamp());
+    report.rtp_timestamp =
+        next_ts_ + (packet::timestamp_t)packet::timestamp_from_ns(elapsed, sample_rate_);
+    report.packet_count = packet_count_;
+    report.byte_count = byte_count_;
+}
+
+void SenderReporter::process(const Report& report) {
+    for (size_t n = 0; n < report.num_reports; n++) {
+        const ReceptionReport& rr = report.reports[n];
+
+        if (!started_ || rr.ssrc != ssrc_) {
+            continue;
+        }
+
+        // RFC 3550, section 6.4.1
+        if (rr.last_sr != 0) {
+            const uint32_t now = ntp_compact(unix_to_ntp(core::unix_timestamp()));
+            const uint32_t rtt = now - rr.last_sr - rr.delay_last_sr;
+
+            // ignore bogus values caused by clock adjustments
+            if (rtt < 0x80000000) {
+                stats_.rtt = compact_to_ns(rtt);
+            }
+        }
+
+        stats_.fraction_lost = rr.fraction_lost;
+        stats_.cumulative_lost = rr.cumulative_lost;
+        stats_.jitter = packet::timestamp_to_ns((packet::timestamp_diff_t)rr.jitter,
+                                                sample_rate_);
+        stats_.num_reports++;
+
+        roc_log(LogDebug,
+                "sender reporter: got receiver report:"
+                " rtt=%ldms jitter=%ldms fraction_lost=%.3f cumulative_lost=%ld",
+                (long)(stats_.rtt / core::Millisecond),
+                (long)(stats_.jitter / core::Millisecond), (double)stats_.fraction_lost,
+                (long)stats_.cumulative_lost);
+    }
+}
+
+const SenderStats& SenderReporter::stats() const {
+    return stats_;
+}
+
+} // namespace rtcp
+} // namespace roc
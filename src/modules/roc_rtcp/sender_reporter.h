@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtcp/sender_reporter.h
+//! @brief Sender reporter.
+
+#ifndef ROC_RTCP_SENDER_REPORTER_H_
+#define ROC_RTCP_SENDER_REPORTER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/time.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/units.h"
+#include "roc_rtcp/report.h"
+
+namespace roc {
+namespace rtcp {
+
+//! Sender statistics.
+//! @remarks
+//!  Built from receiver reports.
+struct SenderStats {
+    //! Number of receiver reports processed.
+    size_t num_reports;
+
+    //! Round-trip time, nanoseconds.
+    core::nanoseconds_t rtt;
+
+    //! Fraction of packets lost, as reported by the last receiver report.
+    float fraction_lost;
+
+    //! Cumulative number of packets lost.
+    int32_t cumulative_lost;
+
+    //! Interarrival jitter, nanoseconds.
+    core::nanoseconds_t jitter;
+
+    SenderStats()
+        : num_reports(0)
+        , rtt(0)
+        , fraction_lost(0)
+        , cumulative_lost(0)
+        , jitter(0) {
+    }
+};
+
+//! Sender reporter.
+//! @remarks
+//!  Counts outgoing RTP packets, generates sender reports, and
+//!  processes receiver reports.
+class SenderReporter : public packet::IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p writer is used to write packets
+    //!  - @p sample_rate defines RTP timestamp rate
+    SenderReporter(packet::IWriter& writer, size_t sample_rate);
+
+    //! Write packet.
+    //! @remarks
+    //!  Updates packet counters and passes the packet to the underlying writer.
+    virtual void write(const packet::PacketPtr& packet);
+
+    //! Check if sender report can be generated.
+    //! @remarks
+    //!  Returns true after at least one RTP packet was written.
+    bool has_report() const;
+
+    //! Generate sender report.
+    void generate(Report& report) const;
+
+    //! Process receiver report.
+    //! @remarks
+    //!  Reception reports for other sources are ignored.
+    void process(const Report& report);
+
+    //! Get statistics.
+    const SenderStats& stats() const;
+
+private:
+    packet::IWriter& writer_;
+    const size_t sample_rate_;
+
+    bool started_;
+
+    packet::source_t ssrc_;
+    packet::timestamp_t next_ts_;
+    core::nanoseconds_t write_time_;
+
+    uint32_t packet_count_;
+    uint32_t byte_count_;
+
+    SenderStats stats_;
+};
+
+} // namespace rtcp
+} // namespace roc
+
+#endif // ROC_RTCP_SENDER_REPORTER_H_
@@ -9,19 +9,34 @@
 #include "roc_rtp/composer.h"
 #include "roc_core/alignment.h"
 #include "roc_core/log.h"
+#include "roc_rtcp/ntp.h"
 #include "roc_rtp/headers.h"
 
 namespace roc {
 namespace rtp {
 
 Composer::Composer(packet::IComposer* inner_composer)
-    : inner_composer_(inner_composer) {
+    : inner_composer_(inner_composer)
+    , capture_timestamps_(false) {
+}
+
+Composer::Composer(packet::IComposer* inner_composer, bool capture_timestamps)
+    : inner_composer_(inner_composer)
+    , capture_timestamps_(capture_timestamps) {
+}
+
+size_t Composer::overhead() const {
+    size_t size = header_size_();
+    if (inner_composer_) {
+        size += inner_composer_->overhead();
+    }
+    return size;
 }
 
 bool Composer::align(core::Slice<uint8_t>& buffer,
                      size_t header_size,
                      size_t payload_alignment) {
-    header_size += sizeof(Header);
+    header_size += header_size_();
 
     if (inner_composer_ == NULL) {
         const size_t padding = core::padding(header_size, payload_alignment);
@@ -47,13 +62,13 @@ bool Composer::prepare(packet::Packet& packet,
                        size_t payload_size) {
     core::Slice<uint8_t> header = buffer.range(0, 0);
 
-    if (header.capacity() < sizeof(Header)) {
+    if (header.capacity() < header_size_()) {
         roc_log(LogDebug,
                 "rtp composer: not enough space for rtp header: size=%lu cap=%lu",
-                (unsigned long)sizeof(Header), (unsigned long)header.capacity());
+                (unsigned long)header_size_(), (unsigned long)header.capacity());
         return false;
     }
-    header.resize(sizeof(Header));
+    header.resize(header_size_());
 
     core::Slice<uint8_t> payload = header.range(header.size(), header.size());
 
@@ -114,7 +129,7 @@ bool Composer::compose(packet::Packet& packet) {
         roc_panic("rtp composer: unexpected non-rtp packet");
     }
 
-    if (packet.rtp()->header.size() != sizeof(Header)) {
+    if (packet.rtp()->header.size() != header_size_()) {
         roc_panic("rtp composer: unexpected rtp header size");
     }
 
@@ -130,6 +145,15 @@ bool Composer::compose(packet::Packet& packet) {
     header.set_marker(rtp.marker);
     header.set_payload_type(PayloadType(rtp.payload_type));
 
+    if (capture_timestamps_) {
+        CaptureTimestampExtension& extension =
+            *(CaptureTimestampExtension*)(rtp.header.data() + sizeof(Header));
+
+        header.set_extension(true);
+        extension.init();
+        extension.set_ntp_timestamp(rtcp::unix_to_ntp(rtp.capture_timestamp));
+    }
+
     if (inner_composer_) {
         return inner_composer_->compose(packet);
     }
@@ -137,5 +161,12 @@ bool Composer::compose(packet::Packet& packet) {
     return true;
 }
 
+size_t Composer::header_size_() const {
+    if (capture_timestamps_) {
+        return sizeof(Header) + sizeof(CaptureTimestampExtension);
+    }
+    return sizeof(Header);
+}
+
 } // namespace rtp
 } // namespace roc
@@ -26,6 +26,16 @@ public:
     //!  If @p inner_composer is not NULL, it is used to compose the packet payload.
     Composer(packet::IComposer* inner_composer);
 
+    //! Initialization.
+    //! @remarks
+    //!  If @p inner_composer is not NULL, it is used to compose the packet payload.
+    //!  If @p capture_timestamps is true, every packet gets a header extension
+    //!  with its capture timestamp.
+    Composer(packet::IComposer* inner_composer, bool capture_timestamps);
+
+    //! Get packet overhead.
+    virtual size_t overhead() const;
+
     //! Adjust buffer to align payload.
     virtual bool
     align(core::Slice<uint8_t>& buffer, size_t header_size, size_t payload_alignment);
@@ -41,7 +51,10 @@ public:
     virtual bool compose(packet::Packet& packet);
 
 private:
+    size_t header_size_() const;
+
     packet::IComposer* inner_composer_;
+    const bool capture_timestamps_;
 };
 
 } // namespace rtp
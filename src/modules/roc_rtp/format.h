@@ -40,8 +40,8 @@ struct Format {
     //! Get packet duration in samples.
     packet::timestamp_t (*duration)(const packet::RTP&);
 
-    //! Get packet size in bytes for given duration in nanoseconds.
-    size_t (*size)(core::nanoseconds_t duration);
+    //! Get packet size in bytes for given duration in nanoseconds and sample rate.
+    size_t (*size)(core::nanoseconds_t duration, size_t sample_rate);
 
     //! Create encoder.
     audio::IEncoder* (*new_encoder)(core::IAllocator& allocator);
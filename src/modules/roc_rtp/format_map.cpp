@@ -7,10 +7,19 @@
  */
 
 #include "roc_rtp/format_map.h"
+#include "roc_core/helpers.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
 #include "roc_rtp/pcm_decoder.h"
 #include "roc_rtp/pcm_encoder.h"
 #include "roc_rtp/pcm_helpers.h"
 
+#ifdef ROC_TARGET_OPUS
+#include "roc_rtp/opus_decoder.h"
+#include "roc_rtp/opus_encoder.h"
+#include "roc_rtp/opus_helpers.h"
+#endif // ROC_TARGET_OPUS
+
 namespace roc {
 namespace rtp {
 
@@ -22,7 +31,7 @@ Format pcm_l16_stereo = {
     /* sample_rate  */ 44100,
     /* channel_mask */ 0x3,
     /* duration     */ &pcm_duration_from_header<int16_t, 2>,
-    /* size         */ &pcm_packet_size_from_duration<int16_t, 2, 44100>,
+    /* size         */ &pcm_packet_size_from_duration<int16_t, 2>,
     /* new_encoder  */ &PCMEncoder<int16_t, 2>::create,
     /* new_decoder  */ &PCMDecoder<int16_t, 2>::create,
 };
@@ -33,24 +42,285 @@ Format pcm_l16_mono = {
     /* sample_rate  */ 44100,
     /* channel_mask */ 0x1,
     /* duration     */ &pcm_duration_from_header<int16_t, 1>,
-    /* size         */ &pcm_packet_size_from_duration<int16_t, 1, 44100>,
+    /* size         */ &pcm_packet_size_from_duration<int16_t, 1>,
+    /* new_encoder  */ &PCMEncoder<int16_t, 1>::create,
+    /* new_decoder  */ &PCMDecoder<int16_t, 1>::create,
+};
+
+Format pcm_l16_48k_stereo = {
+    /* payload_type */ PayloadType_L16_48k_Stereo,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 48000,
+    /* channel_mask */ 0x3,
+    /* duration     */ &pcm_duration_from_header<int16_t, 2>,
+    /* size         */ &pcm_packet_size_from_duration<int16_t, 2>,
+    /* new_encoder  */ &PCMEncoder<int16_t, 2>::create,
+    /* new_decoder  */ &PCMDecoder<int16_t, 2>::create,
+};
+
+Format pcm_l16_48k_mono = {
+    /* payload_type */ PayloadType_L16_48k_Mono,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 48000,
+    /* channel_mask */ 0x1,
+    /* duration     */ &pcm_duration_from_header<int16_t, 1>,
+    /* size         */ &pcm_packet_size_from_duration<int16_t, 1>,
+    /* new_encoder  */ &PCMEncoder<int16_t, 1>::create,
+    /* new_decoder  */ &PCMDecoder<int16_t, 1>::create,
+};
+
+Format pcm_l16_96k_stereo = {
+    /* payload_type */ PayloadType_L16_96k_Stereo,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 96000,
+    /* channel_mask */ 0x3,
+    /* duration     */ &pcm_duration_from_header<int16_t, 2>,
+    /* size         */ &pcm_packet_size_from_duration<int16_t, 2>,
+    /* new_encoder  */ &PCMEncoder<int16_t, 2>::create,
+    /* new_decoder  */ &PCMDecoder<int16_t, 2>::create,
+};
+
+Format pcm_l16_96k_mono = {
+    /* payload_type */ PayloadType_L16_96k_Mono,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 96000,
+    /* channel_mask */ 0x1,
+    /* duration     */ &pcm_duration_from_header<int16_t, 1>,
+    /* size         */ &pcm_packet_size_from_duration<int16_t, 1>,
     /* new_encoder  */ &PCMEncoder<int16_t, 1>::create,
     /* new_decoder  */ &PCMDecoder<int16_t, 1>::create,
 };
 
+Format pcm_l24_stereo = {
+    /* payload_type */ PayloadType_L24_Stereo,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 44100,
+    /* channel_mask */ 0x3,
+    /* duration     */ &pcm_duration_from_header<PCMInt24, 2>,
+    /* size         */ &pcm_packet_size_from_duration<PCMInt24, 2>,
+    /* new_encoder  */ &PCMEncoder<PCMInt24, 2>::create,
+    /* new_decoder  */ &PCMDecoder<PCMInt24, 2>::create,
+};
+
+Format pcm_l24_mono = {
+    /* payload_type */ PayloadType_L24_Mono,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 44100,
+    /* channel_mask */ 0x1,
+    /* duration     */ &pcm_duration_from_header<PCMInt24, 1>,
+    /* size         */ &pcm_packet_size_from_duration<PCMInt24, 1>,
+    /* new_encoder  */ &PCMEncoder<PCMInt24, 1>::create,
+    /* new_decoder  */ &PCMDecoder<PCMInt24, 1>::create,
+};
+
+Format pcm_l24_48k_stereo = {
+    /* payload_type */ PayloadType_L24_48k_Stereo,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 48000,
+    /* channel_mask */ 0x3,
+    /* duration     */ &pcm_duration_from_header<PCMInt24, 2>,
+    /* size         */ &pcm_packet_size_from_duration<PCMInt24, 2>,
+    /* new_encoder  */ &PCMEncoder<PCMInt24, 2>::create,
+    /* new_decoder  */ &PCMDecoder<PCMInt24, 2>::create,
+};
+
+Format pcm_l24_48k_mono = {
+    /* payload_type */ PayloadType_L24_48k_Mono,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 48000,
+    /* channel_mask */ 0x1,
+    /* duration     */ &pcm_duration_from_header<PCMInt24, 1>,
+    /* size         */ &pcm_packet_size_from_duration<PCMInt24, 1>,
+    /* new_encoder  */ &PCMEncoder<PCMInt24, 1>::create,
+    /* new_decoder  */ &PCMDecoder<PCMInt24, 1>::create,
+};
+
+Format pcm_l24_96k_stereo = {
+    /* payload_type */ PayloadType_L24_96k_Stereo,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 96000,
+    /* channel_mask */ 0x3,
+    /* duration     */ &pcm_duration_from_header<PCMInt24, 2>,
+    /* size         */ &pcm_packet_size_from_duration<PCMInt24, 2>,
+    /* new_encoder  */ &PCMEncoder<PCMInt24, 2>::create,
+    /* new_decoder  */ &PCMDecoder<PCMInt24, 2>::create,
+};
+
+Format pcm_l24_96k_mono = {
+    /* payload_type */ PayloadType_L24_96k_Mono,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 96000,
+    /* channel_mask */ 0x1,
+    /* duration     */ &pcm_duration_from_header<PCMInt24, 1>,
+    /* size         */ &pcm_packet_size_from_duration<PCMInt24, 1>,
+    /* new_encoder  */ &PCMEncoder<PCMInt24, 1>::create,
+    /* new_decoder  */ &PCMDecoder<PCMInt24, 1>::create,
+};
+
+Format pcm_float32_stereo = {
+    /* payload_type */ PayloadType_Float32_Stereo,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 44100,
+    /* channel_mask */ 0x3,
+    /* duration     */ &pcm_duration_from_header<PCMFloat32, 2>,
+    /* size         */ &pcm_packet_size_from_duration<PCMFloat32, 2>,
+    /* new_encoder  */ &PCMEncoder<PCMFloat32, 2>::create,
+    /* new_decoder  */ &PCMDecoder<PCMFloat32, 2>::create,
+};
+
+Format pcm_float32_mono = {
+    /* payload_type */ PayloadType_Float32_Mono,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 44100,
+    /* channel_mask */ 0x1,
+    /* duration     */ &pcm_duration_from_header<PCMFloat32, 1>,
+    /* size         */ &pcm_packet_size_from_duration<PCMFloat32, 1>,
+    /* new_encoder  */ &PCMEncoder<PCMFloat32, 1>::create,
+    /* new_decoder  */ &PCMDecoder<PCMFloat32, 1>::create,
+};
+
+Format pcm_float32_48k_stereo = {
+    /* payload_type */ PayloadType_Float32_48k_Stereo,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 48000,
+    /* channel_mask */ 0x3,
+    /* duration     */ &pcm_duration_from_header<PCMFloat32, 2>,
+    /* size         */ &pcm_packet_size_from_duration<PCMFloat32, 2>,
+    /* new_encoder  */ &PCMEncoder<PCMFloat32, 2>::create,
+    /* new_decoder  */ &PCMDecoder<PCMFloat32, 2>::create,
+};
+
+Format pcm_float32_48k_mono = {
+    /* payload_type */ PayloadType_Float32_48k_Mono,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 48000,
+    /* channel_mask */ 0x1,
+    /* duration     */ &pcm_duration_from_header<PCMFloat32, 1>,
+    /* size         */ &pcm_packet_size_from_duration<PCMFloat32, 1>,
+    /* new_encoder  */ &PCMEncoder<PCMFloat32, 1>::create,
+    /* new_decoder  */ &PCMDecoder<PCMFloat32, 1>::create,
+};
+
+Format pcm_float32_96k_stereo = {
+    /* payload_type */ PayloadType_Float32_96k_Stereo,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 96000,
+    /* channel_mask */ 0x3,
+    /* duration     */ &pcm_duration_from_header<PCMFloat32, 2>,
+    /* size         */ &pcm_packet_size_from_duration<PCMFloat32, 2>,
+    /* new_encoder  */ &PCMEncoder<PCMFloat32, 2>::create,
+    /* new_decoder  */ &PCMDecoder<PCMFloat32, 2>::create,
+};
+
+Format pcm_float32_96k_mono = {
+    /* payload_type */ PayloadType_Float32_96k_Mono,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ 96000,
+    /* channel_mask */ 0x1,
+    /* duration     */ &pcm_duration_from_header<PCMFloat32, 1>,
+    /* size         */ &pcm_packet_size_from_duration<PCMFloat32, 1>,
+    /* new_encoder  */ &PCMEncoder<PCMFloat32, 1>::create,
+    /* new_decoder  */ &PCMDecoder<PCMFloat32, 1>::create,
+};
+
+#ifdef ROC_TARGET_OPUS
+
+Format opus_stereo = {
+    /* payload_type */ PayloadType_Opus_Stereo,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ OpusSampleRate,
+    /* channel_mask */ 0x3,
+    /* duration     */ &opus_duration_from_header,
+    /* size         */ &opus_packet_size_from_duration<2>,
+    /* new_encoder  */ &new_opus_encoder<2>,
+    /* new_decoder  */ &new_opus_decoder<2>,
+};
+
+Format opus_mono = {
+    /* payload_type */ PayloadType_Opus_Mono,
+    /* flags        */ packet::Packet::FlagAudio,
+    /* sample_rate  */ OpusSampleRate,
+    /* channel_mask */ 0x1,
+    /* duration     */ &opus_duration_from_header,
+    /* size         */ &opus_packet_size_from_duration<1>,
+    /* new_encoder  */ &new_opus_encoder<1>,
+    /* new_decoder  */ &new_opus_decoder<1>,
+};
+
+#endif // ROC_TARGET_OPUS
+
+const Format* builtin_formats[] = {
+    &pcm_l16_stereo,
+    &pcm_l16_mono,
+    &pcm_l16_48k_stereo,
+    &pcm_l16_48k_mono,
+    &pcm_l16_96k_stereo,
+    &pcm_l16_96k_mono,
+    &pcm_l24_stereo,
+    &pcm_l24_mono,
+    &pcm_l24_48k_stereo,
+    &pcm_l24_48k_mono,
+    &pcm_l24_96k_stereo,
+    &pcm_l24_96k_mono,
+    &pcm_float32_stereo,
+    &pcm_float32_mono,
+    &pcm_float32_48k_stereo,
+    &pcm_float32_48k_mono,
+    &pcm_float32_96k_stereo,
+    &pcm_float32_96k_mono,
+#ifdef ROC_TARGET_OPUS
+    &opus_stereo,
+    &opus_mono,
+#endif // ROC_TARGET_OPUS
+};
+
 } // namespace
 
-const Format* FormatMap::format(unsigned int pt) const {
-    switch (pt) {
-    case PayloadType_L16_Stereo:
-        return &pcm_l16_stereo;
+FormatMap::FormatMap() {
+    memset(index_, 0, sizeof(index_));
+    memset(formats_, 0, sizeof(formats_));
 
-    case PayloadType_L16_Mono:
-        return &pcm_l16_mono;
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(builtin_formats); n++) {
+        if (!add_format(*builtin_formats[n])) {
+            roc_panic("format map: invalid builtin format: pt=%u",
+                      (unsigned)builtin_formats[n]->payload_type);
+        }
+    }
+}
+
+const Format* FormatMap::builtin_format(unsigned int pt) {
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(builtin_formats); n++) {
+        if ((unsigned)builtin_formats[n]->payload_type == pt) {
+            return builtin_formats[n];
+        }
+    }
+    return NULL;
+}
 
-    default:
-        return NULL;
+bool FormatMap::add_format(const Format& fmt) {
+    if ((unsigned)fmt.payload_type >= MaxPayloadTypes) {
+        roc_log(LogError, "format map: invalid payload type: pt=%u",
+                (unsigned)fmt.payload_type);
+        return false;
     }
+
+    if (fmt.sample_rate == 0 || fmt.channel_mask == 0) {
+        roc_log(LogError, "format map: invalid format: pt=%u rate=%lu ch=0x%x",
+                (unsigned)fmt.payload_type, (unsigned long)fmt.sample_rate,
+                (unsigned)fmt.channel_mask);
+        return false;
+    }
+
+    if (!fmt.duration || !fmt.size || !fmt.new_encoder || !fmt.new_decoder) {
+        roc_log(LogError, "format map: invalid format: pt=%u: missing functions",
+                (unsigned)fmt.payload_type);
+        return false;
+    }
+
+    formats_[fmt.payload_type] = fmt;
+    index_[fmt.payload_type] = &formats_[fmt.payload_type];
+
+    return true;
 }
 
 } // namespace rtp
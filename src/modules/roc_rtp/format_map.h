@@ -13,19 +13,56 @@
 #define ROC_RTP_FORMAT_MAP_H_
 
 #include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
 #include "roc_rtp/format.h"
 
 namespace roc {
 namespace rtp {
 
 //! RTP payload format map.
+//! @remarks
+//!  Formats are stored in a table indexed by payload type. The table is
+//!  filled with built-in formats on construction; more formats may be
+//!  added or replaced later using add_format().
+//! @note
+//!  Not thread-safe. Formats should be added before the map is used by
+//!  pipelines.
 class FormatMap : public core::NonCopyable<> {
 public:
+    //! Initialize map with built-in formats.
+    FormatMap();
+
     //! Get format by payload type.
     //! @returns
     //!  pointer to the format structure or null if there is no format
     //!  registered for this payload type.
-    const Format* format(unsigned int pt) const;
+    const Format* format(unsigned int pt) const {
+        if (pt >= MaxPayloadTypes) {
+            return NULL;
+        }
+        return index_[pt];
+    }
+
+    //! Add format.
+    //! @remarks
+    //!  Copies the format into the map. If there is already a format with
+    //!  the same payload type, it is replaced.
+    //! @returns
+    //!  false if the format is invalid.
+    bool add_format(const Format& fmt);
+
+    //! Get built-in format by payload type.
+    //! @returns
+    //!  pointer to the format structure or null if there is no built-in
+    //!  format for this payload type. Unlike format(), isn't affected by
+    //!  add_format().
+    static const Format* builtin_format(unsigned int pt);
+
+private:
+    enum { MaxPayloadTypes = 128 };
+
+    const Format* index_[MaxPayloadTypes];
+    Format formats_[MaxPayloadTypes];
 };
 
 } // namespace rtp
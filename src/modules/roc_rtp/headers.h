@@ -26,9 +26,30 @@ enum Version {
 };
 
 //! RTP payload type.
+//! @remarks
+//!  Payload types from the dynamic range (96-127) are assigned statically,
+//!  so that sender and receiver don't need to negotiate them.
 enum PayloadType {
-    PayloadType_L16_Stereo = 10, //!< Audio, 16-bit samples, 2 channels, 44100 Hz.
-    PayloadType_L16_Mono = 11    //!< Audio, 16-bit samples, 1 channel, 44100 Hz.
+    PayloadType_L16_Stereo = 10,          //!< Audio, 16-bit, 2 channels, 44100 Hz.
+    PayloadType_L16_Mono = 11,            //!< Audio, 16-bit, 1 channel, 44100 Hz.
+    PayloadType_L16_48k_Stereo = 96,      //!< Audio, 16-bit, 2 channels, 48000 Hz.
+    PayloadType_L16_48k_Mono = 97,        //!< Audio, 16-bit, 1 channel, 48000 Hz.
+    PayloadType_L16_96k_Stereo = 98,      //!< Audio, 16-bit, 2 channels, 96000 Hz.
+    PayloadType_L16_96k_Mono = 99,        //!< Audio, 16-bit, 1 channel, 96000 Hz.
+    PayloadType_L24_Stereo = 100,         //!< Audio, 24-bit, 2 channels, 44100 Hz.
+    PayloadType_L24_Mono = 101,           //!< Audio, 24-bit, 1 channel, 44100 Hz.
+    PayloadType_L24_48k_Stereo = 102,     //!< Audio, 24-bit, 2 channels, 48000 Hz.
+    PayloadType_L24_48k_Mono = 103,       //!< Audio, 24-bit, 1 channel, 48000 Hz.
+    PayloadType_L24_96k_Stereo = 104,     //!< Audio, 24-bit, 2 channels, 96000 Hz.
+    PayloadType_L24_96k_Mono = 105,       //!< Audio, 24-bit, 1 channel, 96000 Hz.
+    PayloadType_Float32_Stereo = 106,     //!< Audio, 32-bit float, 2 channels, 44100 Hz.
+    PayloadType_Float32_Mono = 107,       //!< Audio, 32-bit float, 1 channel, 44100 Hz.
+    PayloadType_Float32_48k_Stereo = 108, //!< Audio, 32-bit float, 2 channels, 48000 Hz.
+    PayloadType_Float32_48k_Mono = 109,   //!< Audio, 32-bit float, 1 channel, 48000 Hz.
+    PayloadType_Float32_96k_Stereo = 110, //!< Audio, 32-bit float, 2 channels, 96000 Hz.
+    PayloadType_Float32_96k_Mono = 111,   //!< Audio, 32-bit float, 1 channel, 96000 Hz.
+    PayloadType_Opus_Stereo = 112,        //!< Audio, Opus, 2 channels, 48000 Hz.
+    PayloadType_Opus_Mono = 113           //!< Audio, Opus, 1 channel, 48000 Hz.
 };
 
 //! RTP header.
@@ -146,6 +167,12 @@ public:
         return (flags_ & (Flag_ExtensionMask << Flag_ExtensionShift));
     }
 
+    //! Set extension flag.
+    void set_extension(bool e) {
+        flags_ &= ~(Flag_ExtensionMask << Flag_ExtensionShift);
+        flags_ |= ((!!e) << Flag_ExtensionShift);
+    }
+
     //! Get CSRC array size.
     uint8_t num_csrc() const {
         return ((flags_ >> Flag_CSRCShift) & Flag_CSRCMask);
@@ -240,10 +267,85 @@ public:
         return core::ntoh16(type_);
     }
 
+    //! Set extension type.
+    void set_type(uint16_t t) {
+        type_ = core::hton16(t);
+    }
+
     //! Get extension data size in bytes (without extension header itself).
     uint32_t data_size() const {
         return (uint32_t(core::ntoh16(len_)) << 2);
     }
+
+    //! Set extension data size in bytes (without extension header itself).
+    void set_data_size(uint32_t size) {
+        roc_panic_if((size & 0x3) != 0 || (size >> 2) > 0xffff);
+        len_ = core::hton16(uint16_t(size >> 2));
+    }
+};
+
+//! Extension type of RFC 8285 one-byte header extensions.
+const uint16_t ExtensionType_OneByte = 0xBEDE;
+
+//! ID of one-byte extension element with capture timestamp.
+//! @remarks
+//!  Extension element IDs are usually negotiated using SDP. Roc doesn't use
+//!  signaling, so the ID is fixed.
+const uint8_t ExtensionID_CaptureTimestamp = 1;
+
+//! RTP header extension with capture timestamp.
+//! @remarks
+//!  RFC 8285 one-byte header extension with a single element containing
+//!  64-bit NTP timestamp of the first sample of the packet, padded to
+//!  32-bit boundary.
+//!
+//! @code
+//!    0             1               2               3               4
+//!    0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7 0 1 2 3 4 5 6 7
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |             0xBEDE            |           length=3            |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |  ID=1 |  L=7  |   NTP timestamp, most significant word ...    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |  ...  |     NTP timestamp, least significant word ...         |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |  ...  |                    padding                            |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED CaptureTimestampExtension {
+private:
+    enum {
+        //! Size of NTP timestamp in bytes.
+        TimestampSize = 8
+    };
+
+    //! Extension header.
+    ExtentionHeader header_;
+
+    //! Element ID and length minus one.
+    uint8_t element_;
+
+    //! NTP timestamp.
+    uint32_t ntp_msw_;
+    uint32_t ntp_lsw_;
+
+    //! Padding.
+    uint8_t padding_[3];
+
+public:
+    //! Clear extension and set header and element fields.
+    void init() {
+        memset(this, 0, sizeof(*this));
+        header_.set_type(ExtensionType_OneByte);
+        header_.set_data_size(sizeof(*this) - sizeof(ExtentionHeader));
+        element_ = uint8_t((ExtensionID_CaptureTimestamp << 4) | (TimestampSize - 1));
+    }
+
+    //! Set NTP timestamp.
+    void set_ntp_timestamp(uint64_t ts) {
+        ntp_msw_ = core::hton32((uint32_t)(ts >> 32));
+        ntp_lsw_ = core::hton32((uint32_t)ts);
+    }
 };
 
 } // namespace rtp
@@ -8,11 +8,57 @@
 
 #include "roc_rtp/parser.h"
 #include "roc_core/log.h"
+#include "roc_rtcp/ntp.h"
 #include "roc_rtp/headers.h"
 
 namespace roc {
 namespace rtp {
 
+namespace {
+
+// Walks elements of RFC 8285 one-byte header extension.
+core::nanoseconds_t parse_capture_timestamp(const uint8_t* data, size_t size) {
+    size_t pos = 0;
+
+    while (pos < size) {
+        // Padding byte.
+        if (data[pos] == 0) {
+            pos++;
+            continue;
+        }
+
+        const uint8_t id = uint8_t(data[pos] >> 4);
+        const size_t len = size_t(data[pos] & 0xf) + 1;
+
+        // Reserved ID, parsing should stop.
+        if (id == 0xf) {
+            break;
+        }
+
+        pos++;
+
+        if (pos + len > size) {
+            roc_log(LogDebug, "rtp parser: bad extension element: id=%u len=%lu",
+                    (unsigned)id, (unsigned long)len);
+            break;
+        }
+
+        if (id == ExtensionID_CaptureTimestamp && len == sizeof(uint64_t)) {
+            uint64_t ntp = 0;
+            for (size_t n = 0; n < len; n++) {
+                ntp = (ntp << 8) | data[pos + n];
+            }
+            return rtcp::ntp_to_unix(ntp);
+        }
+
+        pos += len;
+    }
+
+    return 0;
+}
+
+} // namespace
+
 Parser::Parser(const FormatMap& format_map, packet::IParser* inner_parser)
     : format_map_(format_map)
     , inner_parser_(inner_parser) {
@@ -45,18 +91,27 @@ bool Parser::parse(packet::Packet& packet, const core::Slice<uint8_t>& buffer) {
         return false;
     }
 
+    core::nanoseconds_t capture_timestamp = 0;
+
     if (header.has_extension()) {
         const ExtentionHeader& extension =
             *(const ExtentionHeader*)(buffer.data() + header.header_size());
 
         header_size += extension.data_size();
-    }
 
-    if (buffer.size() < header_size) {
-        roc_log(LogDebug,
-                "rtp parser: bad packet, size < %d (rtp header + ext header + ext data)",
-                (int)header_size);
-        return false;
+        if (buffer.size() < header_size) {
+            roc_log(LogDebug,
+                    "rtp parser: bad packet,"
+                    " size < %d (rtp header + ext header + ext data)",
+                    (int)header_size);
+            return false;
+        }
+
+        if (extension.type() == ExtensionType_OneByte) {
+            capture_timestamp = parse_capture_timestamp(
+                buffer.data() + header.header_size() + sizeof(ExtentionHeader),
+                extension.data_size());
+        }
     }
 
     size_t payload_begin = header_size;
@@ -95,6 +150,7 @@ bool Parser::parse(packet::Packet& packet, const core::Slice<uint8_t>& buffer) {
     rtp.timestamp = header.timestamp();
     rtp.marker = header.marker();
     rtp.payload_type = header.payload_type();
+    rtp.capture_timestamp = capture_timestamp;
     rtp.header = buffer.range(0, header_size);
     rtp.payload = buffer.range(payload_begin, payload_end);
 
@@ -38,6 +38,14 @@ public:
                                        packet.rtp()->payload.size(), offset, samples,
                                        n_samples, channels);
     }
+
+    //! Generate samples for lost packets.
+    virtual void conceal_samples(audio::sample_t* samples,
+                                 size_t n_samples,
+                                 packet::channel_mask_t channels) {
+        memset(samples, 0,
+               n_samples * packet::num_channels(channels) * sizeof(audio::sample_t));
+    }
 };
 
 } // namespace rtp
@@ -33,6 +33,11 @@ public:
         return pcm_payload_size_from_samples<Sample, NumCh>(num_samples);
     }
 
+    //! Get number of samples that fit into payload.
+    virtual size_t payload_samples(size_t payload_size) const {
+        return pcm_samples_from_payload_size<Sample, NumCh>(payload_size);
+    }
+
     //! Write samples to packet.
     virtual size_t write_samples(packet::Packet& packet,
                                  size_t offset,
@@ -43,6 +48,11 @@ public:
                                         packet.rtp()->payload.size(), offset, samples,
                                         n_samples, channels);
     }
+
+    //! Finish writing samples to packet.
+    virtual bool finish(packet::Packet&, size_t) {
+        return true;
+    }
 };
 
 } // namespace rtp
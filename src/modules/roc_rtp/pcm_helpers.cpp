@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtp/pcm_helpers.h"
+#include "roc_core/panic.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ROC_RTP_PCM_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__BYTE_ORDER__)                                   \
+    && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ROC_RTP_PCM_NEON
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace rtp {
+
+// Vectorized loops below return the number of samples they processed and leave
+// the tail to the scalar pcm_pack() and pcm_unpack(). All variants truncate
+// towards zero and saturate exactly like the scalar code, and all assume that
+// the host is little-endian, so every 16-bit lane is byte-swapped.
+
+namespace {
+
+#ifdef ROC_RTP_PCM_X86
+
+__attribute__((target("sse2"))) size_t
+pack_sse2(int16_t* out, const audio::sample_t* in, size_t n_samples) {
+    const __m128 scale = _mm_set1_ps(32768.0f);
+    const __m128 max_val = _mm_set1_ps(+32767.0f);
+    const __m128 min_val = _mm_set1_ps(-32768.0f);
+
+    size_t ns = 0;
+
+    for (; ns + 8 <= n_samples; ns += 8) {
+        __m128 lo = _mm_mul_ps(_mm_loadu_ps(in + ns), scale);
+        __m128 hi = _mm_mul_ps(_mm_loadu_ps(in + ns + 4), scale);
+
+        lo = _mm_max_ps(_mm_min_ps(lo, max_val), min_val);
+        hi = _mm_max_ps(_mm_min_ps(hi, max_val), min_val);
+
+        const __m128i v =
+            _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi));
+
+        _mm_storeu_si128((__m128i*)(out + ns),
+                         _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+
+    return ns;
+}
+
+__attribute__((target("sse2"))) size_t
+unpack_sse2(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+    const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+
+    size_t ns = 0;
+
+    for (; ns + 8 <= n_samples; ns += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + ns));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+        _mm_storeu_ps(out + ns, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + ns + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+
+    return ns;
+}
+
+__attribute__((target("avx2"))) size_t
+pack_avx2(int16_t* out, const audio::sample_t* in, size_t n_samples) {
+    const __m256 scale = _mm256_set1_ps(32768.0f);
+    const __m256 max_val = _mm256_set1_ps(+32767.0f);
+    const __m256 min_val = _mm256_set1_ps(-32768.0f);
+
+    size_t ns = 0;
+
+    for (; ns + 16 <= n_samples; ns += 16) {
+        __m256 lo = _mm256_mul_ps(_mm256_loadu_ps(in + ns), scale);
+        __m256 hi = _mm256_mul_ps(_mm256_loadu_ps(in + ns + 8), scale);
+
+        lo = _mm256_max_ps(_mm256_min_ps(lo, max_val), min_val);
+        hi = _mm256_max_ps(_mm256_min_ps(hi, max_val), min_val);
+
+        // packs works within 128-bit lanes and yields lo0 hi0 lo1 hi1,
+        // so swap the middle quadwords to restore sample order
+        const __m256i v = _mm256_permute4x64_epi64(
+            _mm256_packs_epi32(_mm256_cvttps_epi32(lo), _mm256_cvttps_epi32(hi)),
+            0xD8);
+
+        _mm256_storeu_si256(
+            (__m256i*)(out + ns),
+            _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8)));
+    }
+
+    return ns;
+}
+
+__attribute__((target("avx2"))) size_t
+unpack_avx2(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+    const __m256 scale = _mm256_set1_ps(1.0f / 32768.0f);
+
+    size_t ns = 0;
+
+    for (; ns + 16 <= n_samples; ns += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(in + ns));
+        v = _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+
+        const __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(v));
+        const __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1));
+
+        _mm256_storeu_ps(out + ns, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+        _mm256_storeu_ps(out + ns + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+    }
+
+    return ns;
+}
+
+bool has_avx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+bool has_sse2() {
+    return __builtin_cpu_supports("sse2");
+}
+
+#endif // ROC_RTP_PCM_X86
+
+#ifdef ROC_RTP_PCM_NEON
+
+size_t pack_neon(int16_t* out, const audio::sample_t* in, size_t n_samples) {
+    const float32x4_t scale = vdupq_n_f32(32768.0f);
+    const float32x4_t max_val = vdupq_n_f32(+32767.0f);
+    const float32x4_t min_val = vdupq_n_f32(-32768.0f);
+
+    size_t ns = 0;
+
+    for (; ns + 8 <= n_samples; ns += 8) {
+        float32x4_t lo = vmulq_f32(vld1q_f32(in + ns), scale);
+        float32x4_t hi = vmulq_f32(vld1q_f32(in + ns + 4), scale);
+
+        lo = vmaxq_f32(vminq_f32(lo, max_val), min_val);
+        hi = vmaxq_f32(vminq_f32(hi, max_val), min_val);
+
+        const int16x8_t v = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(lo)),
+                                         vqmovn_s32(vcvtq_s32_f32(hi)));
+
+        vst1q_s16(out + ns, vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(v))));
+    }
+
+    return ns;
+}
+
+size_t unpack_neon(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+    const float32x4_t scale = vdupq_n_f32(1.0f / 32768.0f);
+
+    size_t ns = 0;
+
+    for (; ns + 8 <= n_samples; ns += 8) {
+        const int16x8_t v = vreinterpretq_s16_u8(
+            vrev16q_u8(vreinterpretq_u8_s16(vld1q_s16(in + ns))));
+
+        vst1q_f32(out + ns,
+                  vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+        vst1q_f32(out + ns + 4,
+                  vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+    }
+
+    return ns;
+}
+
+#endif // ROC_RTP_PCM_NEON
+
+} // namespace
+
+bool pcm_isa_supported(PCMIsa isa) {
+    switch (isa) {
+    case PCMIsa_Scalar:
+        return true;
+#if defined(ROC_RTP_PCM_X86)
+    case PCMIsa_SSE2:
+        return has_sse2();
+    case PCMIsa_AVX2:
+        return has_avx2();
+#elif defined(ROC_RTP_PCM_NEON)
+    case PCMIsa_NEON:
+        return true;
+#endif
+    default:
+        break;
+    }
+    return false;
+}
+
+PCMIsa pcm_isa() {
+    if (pcm_isa_supported(PCMIsa_AVX2)) {
+        return PCMIsa_AVX2;
+    }
+    if (pcm_isa_supported(PCMIsa_SSE2)) {
+        return PCMIsa_SSE2;
+    }
+    if (pcm_isa_supported(PCMIsa_NEON)) {
+        return PCMIsa_NEON;
+    }
+    return PCMIsa_Scalar;
+}
+
+const char* pcm_isa_to_str(PCMIsa isa) {
+    switch (isa) {
+    case PCMIsa_Scalar:
+        return "scalar";
+    case PCMIsa_SSE2:
+        return "sse2";
+    case PCMIsa_AVX2:
+        return "avx2";
+    case PCMIsa_NEON:
+        return "neon";
+    default:
+        break;
+    }
+    return "<invalid>";
+}
+
+void pcm_pack_n_isa(PCMIsa isa,
+                    int16_t* out,
+                    const audio::sample_t* in,
+                    size_t n_samples) {
+    roc_panic_if_not(pcm_isa_supported(isa));
+
+    size_t ns = 0;
+
+    switch (isa) {
+#if defined(ROC_RTP_PCM_X86)
+    case PCMIsa_SSE2:
+        ns = pack_sse2(out, in, n_samples);
+        break;
+    case PCMIsa_AVX2:
+        ns = pack_avx2(out, in, n_samples);
+        break;
+#elif defined(ROC_RTP_PCM_NEON)
+    case PCMIsa_NEON:
+        ns = pack_neon(out, in, n_samples);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    for (; ns < n_samples; ns++) {
+        out[ns] = pcm_pack<int16_t>(in[ns]);
+    }
+}
+
+void pcm_unpack_n_isa(PCMIsa isa,
+                      audio::sample_t* out,
+                      const int16_t* in,
+                      size_t n_samples) {
+    roc_panic_if_not(pcm_isa_supported(isa));
+
+    size_t ns = 0;
+
+    switch (isa) {
+#if defined(ROC_RTP_PCM_X86)
+    case PCMIsa_SSE2:
+        ns = unpack_sse2(out, in, n_samples);
+        break;
+    case PCMIsa_AVX2:
+        ns = unpack_avx2(out, in, n_samples);
+        break;
+#elif defined(ROC_RTP_PCM_NEON)
+    case PCMIsa_NEON:
+        ns = unpack_neon(out, in, n_samples);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    for (; ns < n_samples; ns++) {
+        out[ns] = pcm_unpack(in[ns]);
+    }
+}
+
+template <>
+void pcm_pack_n(int16_t* out, const audio::sample_t* in, size_t n_samples) {
+    pcm_pack_n_isa(pcm_isa(), out, in, n_samples);
+}
+
+template <>
+void pcm_unpack_n(audio::sample_t* out, const int16_t* in, size_t n_samples) {
+    pcm_unpack_n_isa(pcm_isa(), out, in, n_samples);
+}
+
+} // namespace rtp
+} // namespace roc
@@ -15,12 +15,23 @@
 #include "roc_audio/units.h"
 #include "roc_core/endian.h"
 #include "roc_core/stddefs.h"
+#include "roc_packet/rtp.h"
 #include "roc_packet/units.h"
 #include "roc_rtp/headers.h"
 
 namespace roc {
 namespace rtp {
 
+//! 24-bit signed integer sample in network byte order.
+struct PCMInt24 {
+    uint8_t bytes[3]; //!< Big-endian two's complement value.
+};
+
+//! 32-bit IEEE 754 floating point sample in network byte order.
+struct PCMFloat32 {
+    uint8_t bytes[4]; //!< Big-endian binary32 value.
+};
+
 //! Calculate packet duration.
 template <class Sample, size_t NumCh>
 packet::timestamp_t pcm_duration_from_header(const packet::RTP& rtp) {
@@ -33,11 +44,17 @@ size_t pcm_payload_size_from_samples(size_t num_samples) {
     return num_samples * NumCh * sizeof(Sample);
 }
 
+//! Calculate number of samples per channel that fit into payload.
+template <class Sample, size_t NumCh>
+size_t pcm_samples_from_payload_size(size_t payload_size) {
+    return payload_size / NumCh / sizeof(Sample);
+}
+
 //! Calculate packet size.
-template <class Sample, size_t NumCh, size_t SampleRate>
-size_t pcm_packet_size_from_duration(core::nanoseconds_t duration) {
+template <class Sample, size_t NumCh>
+size_t pcm_packet_size_from_duration(core::nanoseconds_t duration, size_t sample_rate) {
     const packet::timestamp_diff_t num_samples =
-        packet::timestamp_from_ns(duration, SampleRate);
+        packet::timestamp_from_ns(duration, sample_rate);
     if (num_samples < 0) {
         return 0;
     }
@@ -56,12 +73,133 @@ template <> int16_t inline pcm_pack(float s) {
     return (int16_t)core::hton16((uint16_t)(int16_t)s);
 }
 
+//! Encode single sample (PCMInt24).
+template <> inline PCMInt24 pcm_pack(float s) {
+    s *= 8388608.0f;
+    s = std::min(s, +8388607.0f);
+    s = std::max(s, -8388608.0f);
+
+    const uint32_t v = (uint32_t)(int32_t)s;
+
+    PCMInt24 ret;
+    ret.bytes[0] = uint8_t((v >> 16) & 0xff);
+    ret.bytes[1] = uint8_t((v >> 8) & 0xff);
+    ret.bytes[2] = uint8_t(v & 0xff);
+    return ret;
+}
+
+//! Encode single sample (PCMFloat32).
+template <> inline PCMFloat32 pcm_pack(float s) {
+    uint32_t v = 0;
+    memcpy(&v, &s, sizeof(v));
+
+    PCMFloat32 ret;
+    ret.bytes[0] = uint8_t((v >> 24) & 0xff);
+    ret.bytes[1] = uint8_t((v >> 16) & 0xff);
+    ret.bytes[2] = uint8_t((v >> 8) & 0xff);
+    ret.bytes[3] = uint8_t(v & 0xff);
+    return ret;
+}
+
 //! Decode single sample (int16_t).
 inline float pcm_unpack(int16_t s) {
     return float((int16_t)core::ntoh16((uint16_t)s)) / 32768.0f;
 }
 
-//! Decode multiple samples.
+//! Decode single sample (PCMInt24).
+inline float pcm_unpack(PCMInt24 s) {
+    uint32_t v = (uint32_t(s.bytes[0]) << 16) | (uint32_t(s.bytes[1]) << 8)
+        | uint32_t(s.bytes[2]);
+    if (v & 0x800000) {
+        v |= 0xff000000;
+    }
+    return float((int32_t)v) / 8388608.0f;
+}
+
+//! Decode single sample (PCMFloat32).
+inline float pcm_unpack(PCMFloat32 s) {
+    const uint32_t v = (uint32_t(s.bytes[0]) << 24) | (uint32_t(s.bytes[1]) << 16)
+        | (uint32_t(s.bytes[2]) << 8) | uint32_t(s.bytes[3]);
+
+    float ret = 0;
+    memcpy(&ret, &v, sizeof(ret));
+    return ret;
+}
+
+//! Encode multiple interleaved samples.
+template <class Sample>
+void pcm_pack_n(Sample* out, const audio::sample_t* in, size_t n_samples) {
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        out[ns] = pcm_pack<Sample>(in[ns]);
+    }
+}
+
+//! Decode multiple interleaved samples.
+template <class Sample>
+void pcm_unpack_n(audio::sample_t* out, const Sample* in, size_t n_samples) {
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        out[ns] = pcm_unpack(in[ns]);
+    }
+}
+
+//! Instruction set used to encode and decode int16_t samples.
+enum PCMIsa {
+    //! Plain C++ code.
+    PCMIsa_Scalar,
+
+    //! x86 SSE2.
+    PCMIsa_SSE2,
+
+    //! x86 AVX2.
+    PCMIsa_AVX2,
+
+    //! ARM NEON.
+    PCMIsa_NEON,
+
+    //! Maximum for iterating through the enum.
+    PCMIsa_Max
+};
+
+//! Check if instruction set can be used on this CPU.
+bool pcm_isa_supported(PCMIsa isa);
+
+//! Get best instruction set that can be used on this CPU.
+PCMIsa pcm_isa();
+
+//! Get instruction set name.
+//! @remarks
+//!  Returns "scalar", "sse2", "avx2", or "neon".
+const char* pcm_isa_to_str(PCMIsa isa);
+
+//! Encode multiple interleaved samples (int16_t) using given instruction set.
+//! @pre
+//!  @p isa should be supported by the CPU.
+void pcm_pack_n_isa(PCMIsa isa,
+                    int16_t* out,
+                    const audio::sample_t* in,
+                    size_t n_samples);
+
+//! Decode multiple interleaved samples (int16_t) using given instruction set.
+//! @pre
+//!  @p isa should be supported by the CPU.
+void pcm_unpack_n_isa(PCMIsa isa,
+                      audio::sample_t* out,
+                      const int16_t* in,
+                      size_t n_samples);
+
+//! Encode multiple interleaved samples (int16_t).
+//! @remarks
+//!  Uses the best instruction set returned by pcm_isa().
+template <>
+void pcm_pack_n(int16_t* out, const audio::sample_t* in, size_t n_samples);
+
+//! Decode multiple interleaved samples (int16_t).
+//! @remarks
+//!  Uses the best instruction set returned by pcm_isa().
+template <>
+void pcm_unpack_n(audio::sample_t* out, const int16_t* in, size_t n_samples);
+
+//! Encode multiple samples.
 template <class Sample, size_t NumCh>
 size_t pcm_write(void* out_data,
                  size_t out_size,
@@ -84,6 +222,11 @@ size_t pcm_write(void* out_data,
 
     Sample* out_samples = (Sample*)out_data + (off * NumCh);
 
+    if (in_chan_mask == out_chan_mask) {
+        pcm_pack_n<Sample>(out_samples, in_samples, in_n_samples * NumCh);
+        return in_n_samples;
+    }
+
     for (size_t ns = 0; ns < in_n_samples; ns++) {
         for (packet::channel_mask_t ch = 1; ch <= inout_chan_mask && ch != 0; ch <<= 1) {
             if (in_chan_mask & ch) {
@@ -124,6 +267,11 @@ size_t pcm_read(const void* in_data,
 
     const Sample* in_samples = (const Sample*)in_data + (off * NumCh);
 
+    if (in_chan_mask == out_chan_mask) {
+        pcm_unpack_n<Sample>(out_samples, in_samples, out_n_samples * NumCh);
+        return out_n_samples;
+    }
+
     for (size_t ns = 0; ns < out_n_samples; ns++) {
         for (packet::channel_mask_t ch = 1; ch <= inout_chan_mask && ch != 0; ch <<= 1) {
             audio::sample_t s = 0;
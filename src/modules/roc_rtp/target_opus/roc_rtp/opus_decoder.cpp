@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtp/opus_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+// Frame size used for concealment until the first packet is decoded (10ms).
+const size_t DefaultFrameSamples = 480;
+
+} // namespace
+
+audio::IDecoder* OpusDecoder::create(size_t num_channels, core::IAllocator& allocator) {
+    OpusDecoder* decoder = new (allocator) OpusDecoder(num_channels, allocator);
+    if (!decoder) {
+        return NULL;
+    }
+
+    if (!decoder->valid()) {
+        allocator.destroy(*decoder);
+        return NULL;
+    }
+
+    return decoder;
+}
+
+OpusDecoder::OpusDecoder(size_t num_channels, core::IAllocator& allocator)
+    : allocator_(allocator)
+    , decoder_(NULL)
+    , num_channels_(num_channels)
+    , channels_(packet::channel_mask_t(1 << num_channels) - 1)
+    , packet_(NULL)
+    , packet_seqnum_(0)
+    , packet_timestamp_(0)
+    , frame_samples_(DefaultFrameSamples)
+    , buffer_pos_(0)
+    , buffer_samples_(0) {
+    if (num_channels == 0 || num_channels > OpusMaxChannels) {
+        roc_log(LogError, "opus decoder: unsupported number of channels: %lu",
+                (unsigned long)num_channels);
+        return;
+    }
+
+    const int size = opus_decoder_get_size((int)num_channels);
+    if (size <= 0) {
+        roc_log(LogError, "opus decoder: can't get decoder size");
+        return;
+    }
+
+    ::OpusDecoder* decoder = (::OpusDecoder*)allocator_.allocate((size_t)size);
+    if (!decoder) {
+        roc_log(LogError, "opus decoder: can't allocate decoder");
+        return;
+    }
+
+    const int err =
+        opus_decoder_init(decoder, (opus_int32)OpusSampleRate, (int)num_channels);
+    if (err != OPUS_OK) {
+        roc_log(LogError, "opus decoder: can't initialize decoder: %s",
+                opus_strerror(err));
+        allocator_.deallocate(decoder);
+        return;
+    }
+
+    decoder_ = decoder;
+}
+
+OpusDecoder::~OpusDecoder() {
+    if (decoder_) {
+        allocator_.deallocate(decoder_);
+    }
+}
+
+bool OpusDecoder::valid() const {
+    return decoder_;
+}
+
+size_t OpusDecoder::read_samples(const packet::Packet& packet,
+                                 size_t offset,
+                                 audio::sample_t* samples,
+                                 size_t n_samples,
+                                 packet::channel_mask_t channels) {
+    roc_panic_if(!valid());
+
+    if (!decode_packet_(packet)) {
+        return 0;
+    }
+
+    if (offset > buffer_samples_) {
+        offset = buffer_samples_;
+    }
+
+    if (n_samples > buffer_samples_ - offset) {
+        n_samples = buffer_samples_ - offset;
+    }
+
+    opus_map_channels(samples, channels, buffer_ + offset * num_channels_, channels_,
+                      n_samples);
+
+    return n_samples;
+}
+
+void OpusDecoder::conceal_samples(audio::sample_t* samples,
+                                  size_t n_samples,
+                                  packet::channel_mask_t channels) {
+    roc_panic_if(!valid());
+
+    while (n_samples != 0) {
+        if (packet_ || buffer_pos_ == buffer_samples_) {
+            if (!decode_missing_()) {
+                memset(samples, 0,
+                       n_samples * packet::num_channels(channels)
+                           * sizeof(audio::sample_t));
+                return;
+            }
+        }
+
+        size_t ns = buffer_samples_ - buffer_pos_;
+        if (ns > n_samples) {
+            ns = n_samples;
+        }
+
+        opus_map_channels(samples, channels, buffer_ + buffer_pos_ * num_channels_,
+                          channels_, ns);
+
+        buffer_pos_ += ns;
+        samples += ns * packet::num_channels(channels);
+        n_samples -= ns;
+    }
+}
+
+bool OpusDecoder::decode_packet_(const packet::Packet& packet) {
+    const packet::RTP* rtp = packet.rtp();
+    if (!rtp) {
+        return false;
+    }
+
+    if (packet_ == &packet && packet_seqnum_ == rtp->seqnum
+        && packet_timestamp_ == rtp->timestamp) {
+        return true;
+    }
+
+    const int num_samples = opus_decode_float(
+        decoder_, rtp->payload.data(), (opus_int32)rtp->payload.size(), buffer_,
+        (int)OpusMaxFrameSamples, 0);
+
+    // Decoded packet is cached even on failure, to avoid decoding it again.
+    packet_ = &packet;
+    packet_seqnum_ = rtp->seqnum;
+    packet_timestamp_ = rtp->timestamp;
+
+    if (num_samples < 0) {
+        roc_log(LogDebug, "opus decoder: can't decode packet: %s",
+                opus_strerror(num_samples));
+        buffer_pos_ = buffer_samples_ = 0;
+        return false;
+    }
+
+    frame_samples_ = (size_t)num_samples;
+    buffer_pos_ = 0;
+    buffer_samples_ = (size_t)num_samples;
+
+    return true;
+}
+
+bool OpusDecoder::decode_missing_() {
+    packet_ = NULL;
+    buffer_pos_ = buffer_samples_ = 0;
+
+    const int num_samples =
+        opus_decode_float(decoder_, NULL, 0, buffer_, (int)frame_samples_, 0);
+
+    if (num_samples <= 0) {
+        return false;
+    }
+
+    buffer_samples_ = (size_t)num_samples;
+    return true;
+}
+
+} // namespace rtp
+} // namespace roc
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtp/target_opus/roc_rtp/opus_decoder.h
+//! @brief Opus decoder.
+
+#ifndef ROC_RTP_OPUS_DECODER_H_
+#define ROC_RTP_OPUS_DECODER_H_
+
+#include "roc_audio/idecoder.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_rtp/opus_helpers.h"
+
+namespace roc {
+namespace rtp {
+
+//! Opus decoder.
+//! @remarks
+//!  Decodes the whole packet when it's read for the first time and then returns
+//!  decoded samples from internal buffer. Uses Opus packet loss concealment to
+//!  generate samples for lost packets.
+class OpusDecoder : public audio::IDecoder, public core::NonCopyable<> {
+public:
+    //! Create decoder.
+    //! @returns
+    //!  NULL if decoder can't be initialized.
+    static audio::IDecoder* create(size_t num_channels, core::IAllocator& allocator);
+
+    //! Initialize.
+    OpusDecoder(size_t num_channels, core::IAllocator& allocator);
+
+    virtual ~OpusDecoder();
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Read samples from packet.
+    virtual size_t read_samples(const packet::Packet& packet,
+                                size_t offset,
+                                audio::sample_t* samples,
+                                size_t n_samples,
+                                packet::channel_mask_t channels);
+
+    //! Generate samples for lost packets.
+    virtual void conceal_samples(audio::sample_t* samples,
+                                 size_t n_samples,
+                                 packet::channel_mask_t channels);
+
+private:
+    bool decode_packet_(const packet::Packet& packet);
+    bool decode_missing_();
+
+    core::IAllocator& allocator_;
+
+    ::OpusDecoder* decoder_;
+
+    const size_t num_channels_;
+    const packet::channel_mask_t channels_;
+
+    const packet::Packet* packet_;
+    packet::seqnum_t packet_seqnum_;
+    packet::timestamp_t packet_timestamp_;
+
+    size_t frame_samples_;
+    size_t buffer_pos_;
+    size_t buffer_samples_;
+
+    audio::sample_t buffer_[OpusMaxFrameSamples * OpusMaxChannels];
+};
+
+//! Create Opus decoder.
+template <size_t NumCh> audio::IDecoder* new_opus_decoder(core::IAllocator& allocator) {
+    return OpusDecoder::create(NumCh, allocator);
+}
+
+} // namespace rtp
+} // namespace roc
+
+#endif // ROC_RTP_OPUS_DECODER_H_
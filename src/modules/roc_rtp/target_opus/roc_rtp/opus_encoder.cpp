@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_rtp/opus_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace rtp {
+
+audio::IEncoder* OpusEncoder::create(size_t num_channels, core::IAllocator& allocator) {
+    OpusEncoder* encoder = new (allocator) OpusEncoder(num_channels, allocator);
+    if (!encoder) {
+        return NULL;
+    }
+
+    if (!encoder->valid()) {
+        allocator.destroy(*encoder);
+        return NULL;
+    }
+
+    return encoder;
+}
+
+OpusEncoder::OpusEncoder(size_t num_channels, core::IAllocator& allocator)
+    : allocator_(allocator)
+    , encoder_(NULL)
+    , num_channels_(num_channels)
+    , channels_(packet::channel_mask_t(1 << num_channels) - 1) {
+    if (num_channels == 0 || num_channels > OpusMaxChannels) {
+        roc_log(LogError, "opus encoder: unsupported number of channels: %lu",
+                (unsigned long)num_channels);
+        return;
+    }
+
+    const int size = opus_encoder_get_size((int)num_channels);
+    if (size <= 0) {
+        roc_log(LogError, "opus encoder: can't get encoder size");
+        return;
+    }
+
+    ::OpusEncoder* encoder = (::OpusEncoder*)allocator_.allocate((size_t)size);
+    if (!encoder) {
+        roc_log(LogError, "opus encoder: can't allocate encoder");
+        return;
+    }
+
+    int err = opus_encoder_init(encoder, (opus_int32)OpusSampleRate, (int)num_channels,
+                                OPUS_APPLICATION_AUDIO);
+    if (err != OPUS_OK) {
+        roc_log(LogError, "opus encoder: can't initialize encoder: %s",
+                opus_strerror(err));
+        allocator_.deallocate(encoder);
+        return;
+    }
+
+    if ((err = opus_encoder_ctl(encoder,
+                                OPUS_SET_BITRATE((opus_int32)(OpusBitrate * num_channels))))
+            != OPUS_OK
+        || (err = opus_encoder_ctl(encoder, OPUS_SET_VBR(0))) != OPUS_OK
+        || (err = opus_encoder_ctl(encoder, OPUS_SET_COMPLEXITY(OpusComplexity)))
+            != OPUS_OK) {
+        roc_log(LogError, "opus encoder: can't configure encoder: %s",
+                opus_strerror(err));
+        allocator_.deallocate(encoder);
+        return;
+    }
+
+    encoder_ = encoder;
+}
+
+OpusEncoder::~OpusEncoder() {
+    if (encoder_) {
+        allocator_.deallocate(encoder_);
+    }
+}
+
+bool OpusEncoder::valid() const {
+    return encoder_;
+}
+
+size_t OpusEncoder::payload_size(size_t num_samples) const {
+    return opus_payload_size(num_samples, num_channels_);
+}
+
+size_t OpusEncoder::payload_samples(size_t payload_size) const {
+    return opus_payload_frame_samples(payload_size, num_channels_);
+}
+
+size_t OpusEncoder::write_samples(packet::Packet& packet,
+                                  size_t offset,
+                                  const audio::sample_t* samples,
+                                  size_t n_samples,
+                                  packet::channel_mask_t channels) {
+    roc_panic_if(!valid());
+
+    const size_t frame_samples =
+        opus_payload_samples(packet.rtp()->payload.size(), num_channels_);
+
+    if (offset > frame_samples) {
+        offset = frame_samples;
+    }
+
+    if (n_samples > frame_samples - offset) {
+        n_samples = frame_samples - offset;
+    }
+
+    opus_map_channels(buffer_ + offset * num_channels_, channels_, samples, channels,
+                      n_samples);
+
+    return n_samples;
+}
+
+bool OpusEncoder::finish(packet::Packet& packet, size_t n_samples) {
+    roc_panic_if(!valid());
+
+    core::Slice<uint8_t>& payload = packet.rtp()->payload;
+
+    const size_t frame_samples = opus_frame_samples(n_samples);
+
+    if (n_samples < frame_samples) {
+        memset(buffer_ + n_samples * num_channels_, 0,
+               (frame_samples - n_samples) * num_channels_ * sizeof(audio::sample_t));
+    }
+
+    const opus_int32 size = opus_encode_float(encoder_, buffer_, (int)frame_samples,
+                                              payload.data(), (opus_int32)payload.size());
+    if (size < 0) {
+        roc_log(LogError, "opus encoder: can't encode frame: %s", opus_strerror(size));
+        return false;
+    }
+
+    // Keep all packets of the same duration equally sized.
+    if ((size_t)size < payload.size()) {
+        const int err = opus_packet_pad(payload.data(), size, (opus_int32)payload.size());
+        if (err != OPUS_OK) {
+            roc_log(LogError, "opus encoder: can't pad frame: %s", opus_strerror(err));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace rtp
+} // namespace roc
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtp/target_opus/roc_rtp/opus_encoder.h
+//! @brief Opus encoder.
+
+#ifndef ROC_RTP_OPUS_ENCODER_H_
+#define ROC_RTP_OPUS_ENCODER_H_
+
+#include "roc_audio/iencoder.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_rtp/opus_helpers.h"
+
+namespace roc {
+namespace rtp {
+
+//! Opus encoder.
+//! @remarks
+//!  Accumulates samples of a packet and encodes them as a single Opus frame
+//!  when the packet is finished. Packet length should be a valid Opus frame
+//!  duration, i.e. 2.5, 5, 10, 20, 40, or 60 ms.
+class OpusEncoder : public audio::IEncoder, public core::NonCopyable<> {
+public:
+    //! Create encoder.
+    //! @returns
+    //!  NULL if encoder can't be initialized.
+    static audio::IEncoder* create(size_t num_channels, core::IAllocator& allocator);
+
+    //! Initialize.
+    OpusEncoder(size_t num_channels, core::IAllocator& allocator);
+
+    virtual ~OpusEncoder();
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Get packet payload size.
+    virtual size_t payload_size(size_t num_samples) const;
+
+    //! Get number of samples that fit into payload.
+    virtual size_t payload_samples(size_t payload_size) const;
+
+    //! Write samples to packet.
+    virtual size_t write_samples(packet::Packet& packet,
+                                 size_t offset,
+                                 const audio::sample_t* samples,
+                                 size_t n_samples,
+                                 packet::channel_mask_t channels);
+
+    //! Encode samples written to packet.
+    virtual bool finish(packet::Packet& packet, size_t n_samples);
+
+private:
+    core::IAllocator& allocator_;
+
+    ::OpusEncoder* encoder_;
+
+    const size_t num_channels_;
+    const packet::channel_mask_t channels_;
+
+    audio::sample_t buffer_[OpusMaxFrameSamples * OpusMaxChannels];
+};
+
+//! Create Opus encoder.
+template <size_t NumCh> audio::IEncoder* new_opus_encoder(core::IAllocator& allocator) {
+    return OpusEncoder::create(NumCh, allocator);
+}
+
+} // namespace rtp
+} // namespace roc
+
+#endif // ROC_RTP_OPUS_ENCODER_H_
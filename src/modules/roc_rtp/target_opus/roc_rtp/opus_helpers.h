@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_rtp/target_opus/roc_rtp/opus_helpers.h
+//! @brief Opus helpers.
+
+#ifndef ROC_RTP_OPUS_HELPERS_H_
+#define ROC_RTP_OPUS_HELPERS_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/helpers.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_packet/rtp.h"
+#include "roc_packet/units.h"
+#include "roc_rtp/headers.h"
+
+#include <opus.h>
+
+namespace roc {
+namespace rtp {
+
+//! Opus RTP clock rate (RFC 7587).
+const size_t OpusSampleRate = 48000;
+
+//! Opus bitrate per channel, bits per second.
+//! @remarks
+//!  Encoder works in constant bitrate mode, so that every packet of the same
+//!  duration has the same size, as required by FEC.
+const size_t OpusBitrate = 64000;
+
+//! Opus encoder complexity, from 0 to 10.
+const int OpusComplexity = 5;
+
+//! Maximum number of channels in Opus stream.
+const size_t OpusMaxChannels = 2;
+
+//! Maximum Opus frame size (60ms), number of samples per channel.
+const size_t OpusMaxFrameSamples = 2880;
+
+//! Get Opus frame size for given number of samples.
+//! @remarks
+//!  Opus frames may be 2.5, 5, 10, 20, 40, or 60 ms long. Returns the
+//!  shortest frame that holds @p num_samples samples per channel.
+inline size_t opus_frame_samples(size_t num_samples) {
+    static const size_t frame_sizes[] = { 120, 240, 480, 960, 1920, 2880 };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(frame_sizes); n++) {
+        if (num_samples <= frame_sizes[n]) {
+            return frame_sizes[n];
+        }
+    }
+
+    return OpusMaxFrameSamples;
+}
+
+//! Calculate payload size.
+inline size_t opus_payload_size(size_t num_samples, size_t num_channels) {
+    return opus_frame_samples(num_samples) * OpusBitrate * num_channels / 8
+        / OpusSampleRate;
+}
+
+//! Calculate number of samples per channel that fit into payload.
+inline size_t opus_payload_samples(size_t payload_size, size_t num_channels) {
+    const size_t num_samples =
+        payload_size * 8 * OpusSampleRate / (OpusBitrate * num_channels);
+    return num_samples < OpusMaxFrameSamples ? num_samples : OpusMaxFrameSamples;
+}
+
+//! Calculate number of samples per channel in the longest frame that fits
+//! into payload.
+//! @remarks
+//!  Unlike opus_payload_samples(), returns only valid Opus frame sizes.
+//!  Returns zero if even the shortest frame doesn't fit.
+inline size_t opus_payload_frame_samples(size_t payload_size, size_t num_channels) {
+    static const size_t frame_sizes[] = { 2880, 1920, 960, 480, 240, 120 };
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(frame_sizes); n++) {
+        if (opus_payload_size(frame_sizes[n], num_channels) <= payload_size) {
+            return frame_sizes[n];
+        }
+    }
+
+    return 0;
+}
+
+//! Calculate packet duration.
+inline packet::timestamp_t opus_duration_from_header(const packet::RTP& rtp) {
+    const int num_samples = opus_packet_get_nb_samples(
+        rtp.payload.data(), (opus_int32)rtp.payload.size(), (opus_int32)OpusSampleRate);
+    if (num_samples <= 0) {
+        return 0;
+    }
+    return packet::timestamp_t(num_samples);
+}
+
+//! Calculate packet size.
+//! @remarks
+//!  Opus RTP clock rate is always 48000, so @p sample_rate is ignored.
+template <size_t NumCh>
+size_t opus_packet_size_from_duration(core::nanoseconds_t duration, size_t sample_rate) {
+    (void)sample_rate;
+
+    const packet::timestamp_diff_t num_samples =
+        packet::timestamp_from_ns(duration, OpusSampleRate);
+    if (num_samples < 0) {
+        return 0;
+    }
+    return sizeof(Header) + opus_payload_size((size_t)num_samples, NumCh);
+}
+
+//! Copy samples between buffers with different channel masks.
+//! @remarks
+//!  Channels missing in @p in_chan_mask are filled with zeros.
+inline void opus_map_channels(audio::sample_t* out_samples,
+                              packet::channel_mask_t out_chan_mask,
+                              const audio::sample_t* in_samples,
+                              packet::channel_mask_t in_chan_mask,
+                              size_t n_samples) {
+    if (in_chan_mask == out_chan_mask) {
+        memcpy(out_samples, in_samples,
+               n_samples * packet::num_channels(out_chan_mask) * sizeof(audio::sample_t));
+        return;
+    }
+
+    const packet::channel_mask_t inout_chan_mask = in_chan_mask | out_chan_mask;
+
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        for (packet::channel_mask_t ch = 1; ch <= inout_chan_mask && ch != 0; ch <<= 1) {
+            audio::sample_t s = 0;
+            if (in_chan_mask & ch) {
+                s = *in_samples++;
+            }
+            if (out_chan_mask & ch) {
+                *out_samples++ = s;
+            }
+        }
+    }
+}
+
+} // namespace rtp
+} // namespace roc
+
+#endif // ROC_RTP_OPUS_HELPERS_H_
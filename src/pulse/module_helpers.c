@@ -118,6 +118,15 @@ int rocpa_parse_resampler_profile(roc_resampler_profile* out,
     } else if (strcmp(str, "low") == 0) {
         *out = ROC_RESAMPLER_LOW;
         return 0;
+    } else if (strcmp(str, "short") == 0) {
+        *out = ROC_RESAMPLER_SHORT;
+        return 0;
+    } else if (strcmp(str, "cubic") == 0) {
+        *out = ROC_RESAMPLER_CUBIC;
+        return 0;
+    } else if (strcmp(str, "linear") == 0) {
+        *out = ROC_RESAMPLER_LINEAR;
+        return 0;
     } else {
         pa_log("invalid %s: %s", arg_name, str);
         return -1;
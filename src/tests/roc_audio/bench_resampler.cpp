@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// Resampler benchmark.
+//
+// BM_Resampler measures CPU time per output frame for every resampler profile.
+// BM_ResamplerQuality measures quality of a resampled sine wave:
+//
+//  - snr_db is the ratio of the fundamental to everything else in the output,
+//    including harmonics, aliasing, and interpolation noise (SINAD)
+//  - thd_db is the ratio of the first harmonics to the fundamental
+//
+// To compare profiles, run:
+//
+//   roc-bench-audio --benchmark_filter=BM_Resampler --benchmark_format=json
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_dot.h"
+#include "roc_audio/resampler_factory.h"
+#include "roc_audio/resampler_profile.h"
+#include "roc_audio/resampler_reader.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/random.h"
+#include "roc_core/unique_ptr.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    FrameSizeCh = 320,
+    MaxChannels = 4,
+
+    SampleRate = 44100,
+    QualitySamples = FrameSizeCh * 50,
+    QualityWarmup = FrameSizeCh * 2,
+    NumHarmonics = 5
+};
+
+const float Scaling = 1.001f;
+
+const double SineAmplitude = 0.5;
+
+core::HeapAllocator allocator;
+core::BufferPool<sample_t> buffer_pool(allocator, FrameSizeCh * MaxChannels, true);
+
+core::Slice<sample_t> make_buffer(size_t size) {
+    core::Slice<sample_t> buf = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
+    roc_panic_if(!buf);
+    buf.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        buf.data()[i] = (sample_t)core::random(0, 0xffff) / 0xffff - 0.5f;
+    }
+    return buf;
+}
+
+// Generates mono sine wave.
+class SineReader : public IReader {
+public:
+    explicit SineReader(double freq)
+        : freq_(freq)
+        , pos_(0) {
+    }
+
+    virtual void read(Frame& frame) {
+        for (size_t i = 0; i < frame.size(); i++) {
+            frame.data()[i] = (sample_t)(SineAmplitude * std::sin(freq_ * double(pos_)));
+            pos_++;
+        }
+    }
+
+private:
+    const double freq_;
+    size_t pos_;
+};
+
+// Returns power of the projection of the signal onto the sine wave with given
+// frequency and subtracts this projection from the signal.
+double extract_tone(double* signal, const double* times, size_t size, double freq) {
+    double sin_sum = 0, cos_sum = 0;
+    for (size_t i = 0; i < size; i++) {
+        sin_sum += signal[i] * std::sin(freq * times[i]);
+        cos_sum += signal[i] * std::cos(freq * times[i]);
+    }
+
+    const double a = sin_sum * 2 / double(size);
+    const double b = cos_sum * 2 / double(size);
+
+    for (size_t i = 0; i < size; i++) {
+        signal[i] -= a * std::sin(freq * times[i]) + b * std::cos(freq * times[i]);
+    }
+
+    return (a * a + b * b) / 2;
+}
+
+double power(const double* signal, size_t size) {
+    double sum = 0;
+    for (size_t i = 0; i < size; i++) {
+        sum += signal[i] * signal[i];
+    }
+    return sum / double(size);
+}
+
+double to_db(double ratio) {
+    return 10 * std::log10(ratio);
+}
+
+ResamplerConfig make_config(ResamplerProfile profile, bool polyphase) {
+    ResamplerConfig config = resampler_profile(profile);
+    if (config.backend == ResamplerBackend_Sinc) {
+        config.polyphase = polyphase;
+    }
+    return config;
+}
+
+// Measures time spent per output frame.
+// Arguments: number of channels, whether polyphase filter bank is used,
+// whether planar layout is used.
+void BM_Resampler(benchmark::State& state, ResamplerProfile profile) {
+    const size_t n_channels = (size_t)state.range(0);
+    const size_t frame_size = FrameSizeCh * n_channels;
+
+    const ResamplerConfig config = make_config(profile, state.range(1));
+
+    const ChannelLayout layout =
+        state.range(2) ? ChannelLayout_Planar : ChannelLayout_Interleaved;
+
+    core::UniquePtr<IResampler> resampler(
+        new_resampler(allocator, config, packet::channel_mask_t((1 << n_channels) - 1),
+                      layout, frame_size),
+        allocator);
+    roc_panic_if(!resampler);
+    roc_panic_if(!resampler->set_scaling(Scaling));
+
+    core::Slice<sample_t> buffer = make_buffer(frame_size);
+    Frame input(buffer.data(), buffer.size());
+
+    sample_t samples[FrameSizeCh * MaxChannels];
+    Frame frame(samples, frame_size);
+
+    while (state.KeepRunning()) {
+        while (!resampler->resample_buff(frame)) {
+            resampler->push_input(input);
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(FrameSizeCh));
+    state.SetLabel(config.backend == ResamplerBackend_Sinc
+                       ? resampler_dot_isa()
+                       : resampler_backend_to_str(config.backend));
+}
+
+// Resamples mono sine wave and measures quality of the output.
+// Arguments: sine frequency in Hz, resampling factor deviation from 1 in ppm.
+void BM_ResamplerQuality(benchmark::State& state, ResamplerProfile profile) {
+    const double freq = 2 * M_PI * (double)state.range(0) / SampleRate;
+    const double scaling = 1 + (double)state.range(1) / 1e6;
+
+    const ResamplerConfig config = make_config(profile, true);
+
+    static double output[QualitySamples];
+    static double times[QualitySamples];
+
+    double snr = 0, thd = 0;
+
+    while (state.KeepRunning()) {
+        SineReader sine_reader(freq);
+
+        ResamplerReader resampler(sine_reader, buffer_pool, allocator, config, 0x1,
+                                  ChannelLayout_Interleaved, FrameSizeCh);
+        roc_panic_if(!resampler.valid());
+        roc_panic_if(!resampler.set_scaling((float)scaling));
+
+        sample_t samples[FrameSizeCh];
+
+        // skip output affected by zeros before the first input sample
+        for (size_t pos = 0; pos < QualityWarmup; pos += FrameSizeCh) {
+            Frame frame(samples, FrameSizeCh);
+            resampler.read(frame);
+        }
+
+        for (size_t pos = 0; pos < QualitySamples; pos += FrameSizeCh) {
+            Frame frame(samples, FrameSizeCh);
+            resampler.read(frame);
+
+            for (size_t i = 0; i < FrameSizeCh; i++) {
+                output[pos + i] = (double)samples[i];
+                // output starts from the first input sample
+                times[pos + i] = double(QualityWarmup + pos + i) * scaling;
+            }
+        }
+
+        const double fundamental = extract_tone(output, times, QualitySamples, freq);
+
+        double harmonics = 0;
+        for (size_t h = 2; h <= NumHarmonics; h++) {
+            // skip harmonics above output Nyquist frequency
+            if (freq * double(h) * scaling < M_PI) {
+                harmonics +=
+                    extract_tone(output, times, QualitySamples, freq * double(h));
+            }
+        }
+
+        snr = to_db(fundamental / (power(output, QualitySamples) + harmonics));
+        thd = to_db(harmonics / fundamental);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(QualitySamples));
+    state.counters["snr_db"] = snr;
+    state.counters["thd_db"] = thd;
+}
+
+void resampler_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "nch", "poly", "planar" });
+
+    for (int poly = 0; poly <= 1; poly++) {
+        b->Args({ 1, poly, 0 });
+        for (int planar = 0; planar <= 1; planar++) {
+            b->Args({ 2, poly, planar });
+            b->Args({ 4, poly, planar });
+        }
+    }
+}
+
+void interp_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "nch", "poly", "planar" });
+
+    b->Args({ 1, 0, 0 });
+    for (int planar = 0; planar <= 1; planar++) {
+        b->Args({ 2, 0, planar });
+        b->Args({ 4, 0, planar });
+    }
+}
+
+void quality_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "freq", "ppm" });
+
+    const int freqs[] = { 1000, 5000, 10000 };
+
+    // clock drift and 44100 to 48000 conversion
+    const int ppms[] = { 1000, 88435 };
+
+    for (size_t f = 0; f < ROC_ARRAY_SIZE(freqs); f++) {
+        for (size_t p = 0; p < ROC_ARRAY_SIZE(ppms); p++) {
+            b->Args({ freqs[f], ppms[p] });
+        }
+    }
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_Resampler, low, ResamplerProfile_Low)
+    ->Apply(resampler_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_Resampler, medium, ResamplerProfile_Medium)
+    ->Apply(resampler_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_Resampler, high, ResamplerProfile_High)
+    ->Apply(resampler_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_Resampler, short, ResamplerProfile_Short)
+    ->Apply(resampler_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_Resampler, cubic, ResamplerProfile_Cubic)
+    ->Apply(interp_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_Resampler, linear, ResamplerProfile_Linear)
+    ->Apply(interp_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_ResamplerQuality, high, ResamplerProfile_High)
+    ->Apply(quality_args)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_ResamplerQuality, medium, ResamplerProfile_Medium)
+    ->Apply(quality_args)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_ResamplerQuality, low, ResamplerProfile_Low)
+    ->Apply(quality_args)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_ResamplerQuality, short, ResamplerProfile_Short)
+    ->Apply(quality_args)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_ResamplerQuality, cubic, ResamplerProfile_Cubic)
+    ->Apply(quality_args)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_ResamplerQuality, linear, ResamplerProfile_Linear)
+    ->Apply(quality_args)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/channel_layout.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { MaxChannels = 3, MaxSamples = 50 };
+
+sample_t make_sample(size_t n, size_t ch) {
+    return sample_t(ch + 1) + sample_t(n) / 100;
+}
+
+void check_round_trip(size_t n_channels, size_t n_samples, size_t plane_size) {
+    sample_t interleaved[MaxSamples * MaxChannels];
+    sample_t planar[MaxSamples * MaxChannels];
+    sample_t result[MaxSamples * MaxChannels];
+
+    for (size_t n = 0; n < n_samples; n++) {
+        for (size_t ch = 0; ch < n_channels; ch++) {
+            interleaved[n * n_channels + ch] = make_sample(n, ch);
+        }
+    }
+
+    for (size_t n = 0; n < MaxSamples * MaxChannels; n++) {
+        planar[n] = -1;
+    }
+
+    deinterleave_samples(planar, plane_size, interleaved, n_samples, n_channels);
+
+    for (size_t ch = 0; ch < n_channels; ch++) {
+        for (size_t n = 0; n < plane_size; n++) {
+            if (n < n_samples) {
+                DOUBLES_EQUAL(make_sample(n, ch), planar[ch * plane_size + n], 0);
+            } else {
+                DOUBLES_EQUAL(-1, planar[ch * plane_size + n], 0);
+            }
+        }
+    }
+
+    interleave_samples(result, planar, plane_size, n_samples, n_channels);
+
+    for (size_t n = 0; n < n_samples * n_channels; n++) {
+        DOUBLES_EQUAL(interleaved[n], result[n], 0);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(channel_layout) {};
+
+TEST(channel_layout, mono) {
+    check_round_trip(1, MaxSamples, MaxSamples);
+}
+
+TEST(channel_layout, stereo) {
+    check_round_trip(2, MaxSamples, MaxSamples);
+}
+
+TEST(channel_layout, three_channels) {
+    check_round_trip(3, MaxSamples, MaxSamples);
+}
+
+TEST(channel_layout, partial_plane) {
+    for (size_t n_channels = 1; n_channels <= MaxChannels; n_channels++) {
+        check_round_trip(n_channels, MaxSamples / 2, MaxSamples);
+        check_round_trip(n_channels, 1, MaxSamples);
+        check_round_trip(n_channels, 0, MaxSamples);
+    }
+}
+
+TEST(channel_layout, to_str) {
+    STRCMP_EQUAL("interleaved", channel_layout_to_str(ChannelLayout_Interleaved));
+    STRCMP_EQUAL("planar", channel_layout_to_str(ChannelLayout_Planar));
+}
+
+} // namespace audio
+} // namespace roc
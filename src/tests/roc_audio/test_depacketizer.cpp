@@ -40,6 +40,10 @@ rtp::PCMDecoder<int16_t, NumCh> pcm_decoder;
 
 TEST_GROUP(depacketizer) {
     packet::PacketPtr new_packet(packet::timestamp_t ts, sample_t value) {
+        return new_packet(ts, value, value);
+    }
+
+    packet::PacketPtr new_packet(packet::timestamp_t ts, sample_t left, sample_t right) {
         packet::PacketPtr pp = new(packet_pool) packet::Packet(packet_pool);
         CHECK(pp);
 
@@ -55,8 +59,9 @@ TEST_GROUP(depacketizer) {
         pp->rtp()->duration = SamplesPerPacket;
 
         sample_t samples[SamplesPerPacket * NumCh];
-        for (size_t n = 0; n < SamplesPerPacket * NumCh; n++) {
-            samples[n] = value;
+        for (size_t n = 0; n < SamplesPerPacket; n++) {
+            samples[n * NumCh] = left;
+            samples[n * NumCh + 1] = right;
         }
 
         UNSIGNED_LONGS_EQUAL(
@@ -104,7 +109,7 @@ TEST_GROUP(depacketizer) {
 
 TEST(depacketizer, one_packet_one_read) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     queue.write(new_packet(0, 0.11f));
 
@@ -113,7 +118,7 @@ TEST(depacketizer, one_packet_one_read) {
 
 TEST(depacketizer, one_packet_multiple_reads) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     queue.write(new_packet(0, 0.11f));
 
@@ -126,7 +131,7 @@ TEST(depacketizer, multiple_packets_one_read) {
     enum { NumPackets = 10 };
 
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     for (packet::timestamp_t n = 0; n < NumPackets; n++) {
         queue.write(new_packet(n * SamplesPerPacket, 0.11f));
@@ -141,7 +146,7 @@ TEST(depacketizer, multiple_packets_multiple_reads) {
     CHECK(SamplesPerPacket % FramesPerPacket== 0);
 
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     queue.write(new_packet(1 * SamplesPerPacket, 0.11f));
     queue.write(new_packet(2 * SamplesPerPacket, 0.22f));
@@ -162,7 +167,7 @@ TEST(depacketizer, multiple_packets_multiple_reads) {
 
 TEST(depacketizer, timestamp_overflow) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     const packet::timestamp_t ts2 = 0;
     const packet::timestamp_t ts1 = ts2 - SamplesPerPacket;
@@ -179,7 +184,7 @@ TEST(depacketizer, timestamp_overflow) {
 
 TEST(depacketizer, drop_late_packets) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     const packet::timestamp_t ts1 = SamplesPerPacket * 2;
     const packet::timestamp_t ts2 = SamplesPerPacket * 1;
@@ -195,7 +200,7 @@ TEST(depacketizer, drop_late_packets) {
 
 TEST(depacketizer, drop_late_packets_timestamp_overflow) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     const packet::timestamp_t ts1 = 0;
     const packet::timestamp_t ts2 = ts1 - SamplesPerPacket;
@@ -211,14 +216,14 @@ TEST(depacketizer, drop_late_packets_timestamp_overflow) {
 
 TEST(depacketizer, zeros_no_packets) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     expect_output(dp, SamplesPerPacket, 0.00f);
 }
 
 TEST(depacketizer, zeros_no_next_packet) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     queue.write(new_packet(0, 0.11f));
 
@@ -228,7 +233,7 @@ TEST(depacketizer, zeros_no_next_packet) {
 
 TEST(depacketizer, zeros_between_packets) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     queue.write(new_packet(1 * SamplesPerPacket, 0.11f));
     queue.write(new_packet(3 * SamplesPerPacket, 0.33f));
@@ -240,7 +245,7 @@ TEST(depacketizer, zeros_between_packets) {
 
 TEST(depacketizer, zeros_between_packets_timestamp_overflow) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     const packet::timestamp_t ts2 = 0;
     const packet::timestamp_t ts1 = ts2 - SamplesPerPacket;
@@ -258,7 +263,7 @@ TEST(depacketizer, zeros_after_packet) {
     CHECK(SamplesPerPacket % 2 == 0);
 
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     queue.write(new_packet(0, 0.11f));
 
@@ -279,7 +284,7 @@ TEST(depacketizer, zeros_after_packet) {
 
 TEST(depacketizer, packet_after_zeros) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     expect_output(dp, SamplesPerPacket, 0.00f);
 
@@ -292,7 +297,7 @@ TEST(depacketizer, overlapping_packets) {
     CHECK(SamplesPerPacket % 2 == 0);
 
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     packet::timestamp_t ts1 = 0;
     packet::timestamp_t ts2 = SamplesPerPacket / 2;
@@ -311,7 +316,7 @@ TEST(depacketizer, frame_flags_incompltete_blank) {
     enum { PacketsPerFrame = 3 };
 
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     packet::PacketPtr packets[][PacketsPerFrame] = {
         {
@@ -378,7 +383,7 @@ TEST(depacketizer, frame_flags_incompltete_blank) {
 
 TEST(depacketizer, frame_flags_drops) {
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     packet::PacketPtr packets[] = {
         new_packet(SamplesPerPacket * 4, 0.11f),
@@ -418,7 +423,7 @@ TEST(depacketizer, timestamp) {
     CHECK(SamplesPerPacket % FramesPerPacket== 0);
 
     packet::Queue queue;
-    Depacketizer dp(queue, pcm_decoder, ChMask, false);
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
 
     for (size_t n = 0; n < NumPackets * FramesPerPacket; n++) {
         expect_output(dp, SamplesPerFrame, 0.0f);
@@ -453,5 +458,117 @@ TEST(depacketizer, timestamp) {
     }
 }
 
+TEST(depacketizer, dtx) {
+    enum { GapPackets = 3 };
+
+    packet::Queue queue;
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, true);
+
+    queue.write(new_packet(0, 0.0f));
+
+    CHECK(!dp.dtx());
+
+    expect_output(dp, SamplesPerPacket, 0.0f);
+
+    // Intentional silence is filled with zeros instead of beeps.
+    for (size_t n = 0; n < GapPackets; n++) {
+        expect_output(dp, SamplesPerPacket, 0.0f);
+        CHECK(dp.dtx());
+    }
+
+    queue.write(new_packet((GapPackets + 1) * SamplesPerPacket, 0.22f));
+    queue.write(new_packet((GapPackets + 3) * SamplesPerPacket, 0.33f));
+
+    expect_output(dp, SamplesPerPacket, 0.22f);
+
+    CHECK(!dp.dtx());
+
+    // Gap after non-silent packet is a loss, filled with beeps.
+    core::Slice<sample_t> buf = new_buffer(SamplesPerPacket);
+    Frame frame(buf.data(), buf.size());
+    dp.read(frame);
+
+    bool has_beep = false;
+    for (size_t n = 0; n < frame.size(); n++) {
+        if (frame.data()[n] > 0.001f || frame.data()[n] < -0.001f) {
+            has_beep = true;
+        }
+    }
+    CHECK(has_beep);
+
+    expect_output(dp, SamplesPerPacket, 0.33f);
+}
+
+TEST(depacketizer, frame_flags_dtx) {
+    enum { GapPackets = 3 };
+
+    packet::Queue queue;
+    Depacketizer dp(queue, pcm_decoder, ChMask, ChannelLayout_Interleaved, false);
+
+    queue.write(new_packet(0, 0.0f));
+
+    expect_flags(dp, SamplesPerPacket, 0);
+
+    // Intentional silence is blank, but not incomplete.
+    for (size_t n = 0; n < GapPackets; n++) {
+        expect_flags(dp, SamplesPerPacket, Frame::FlagBlank);
+    }
+
+    const packet::timestamp_t ts =
+        (GapPackets + 1) * SamplesPerPacket + SamplesPerPacket / 2;
+
+    queue.write(new_packet(ts, 0.22f));
+    queue.write(new_packet(ts + SamplesPerPacket * 2, 0.33f));
+
+    // Frame partially filled with intentional silence is complete.
+    expect_flags(dp, SamplesPerPacket, 0);
+
+    // Gap after non-silent packet is a loss.
+    expect_flags(dp, SamplesPerPacket, Frame::FlagIncomplete);
+}
+
+TEST(depacketizer, planar) {
+    enum { NumPackets = 6, ReadSize = SamplesPerPacket * 2 / 3 };
+
+    packet::Queue interleaved_queue;
+    packet::Queue planar_queue;
+
+    Depacketizer interleaved_dp(interleaved_queue, pcm_decoder, ChMask,
+                                ChannelLayout_Interleaved, false);
+    Depacketizer planar_dp(planar_queue, pcm_decoder, ChMask, ChannelLayout_Planar,
+                           false);
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        // one packet is lost
+        if (n == NumPackets / 2) {
+            continue;
+        }
+        const sample_t left = 0.01f * (n + 1);
+        const sample_t right = -0.01f * (n + 1);
+        interleaved_queue.write(new_packet(n * SamplesPerPacket, left, right));
+        planar_queue.write(new_packet(n * SamplesPerPacket, left, right));
+    }
+
+    for (size_t n = 0; n < NumPackets * SamplesPerPacket / ReadSize; n++) {
+        core::Slice<sample_t> interleaved_buf = new_buffer(ReadSize);
+        core::Slice<sample_t> planar_buf = new_buffer(ReadSize);
+
+        Frame interleaved_frame(interleaved_buf.data(), interleaved_buf.size());
+        Frame planar_frame(planar_buf.data(), planar_buf.size());
+
+        interleaved_dp.read(interleaved_frame);
+        planar_dp.read(planar_frame);
+
+        UNSIGNED_LONGS_EQUAL(interleaved_frame.flags(), planar_frame.flags());
+
+        for (size_t i = 0; i < ReadSize; i++) {
+            for (size_t ch = 0; ch < NumCh; ch++) {
+                DOUBLES_EQUAL(interleaved_frame.data()[i * NumCh + ch],
+                              planar_frame.data()[ch * ReadSize + i], 0.0001);
+            }
+        }
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/latency_histogram.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Maximum relative error of a percentile estimate.
+const double Epsilon = 0.05;
+
+void check_percentile(core::nanoseconds_t expected, core::nanoseconds_t actual) {
+    DOUBLES_EQUAL((double)expected, (double)actual, (double)expected * Epsilon);
+}
+
+} // namespace
+
+TEST_GROUP(latency_histogram) {};
+
+TEST(latency_histogram, empty) {
+    LatencyHistogram hist;
+
+    UNSIGNED_LONGS_EQUAL(0, hist.size());
+
+    LONGS_EQUAL(0, hist.percentile(0.5));
+    LONGS_EQUAL(0, hist.percentile(0.99));
+}
+
+TEST(latency_histogram, single) {
+    LatencyHistogram hist;
+
+    hist.add(20 * core::Millisecond);
+
+    UNSIGNED_LONGS_EQUAL(1, hist.size());
+
+    check_percentile(20 * core::Millisecond, hist.percentile(0));
+    check_percentile(20 * core::Millisecond, hist.percentile(0.5));
+    check_percentile(20 * core::Millisecond, hist.percentile(1));
+}
+
+TEST(latency_histogram, percentiles) {
+    LatencyHistogram hist;
+
+    for (core::nanoseconds_t n = 1; n <= 100; n++) {
+        hist.add(n * core::Millisecond);
+    }
+
+    UNSIGNED_LONGS_EQUAL(100, hist.size());
+
+    check_percentile(50 * core::Millisecond, hist.percentile(0.50));
+    check_percentile(95 * core::Millisecond, hist.percentile(0.95));
+    check_percentile(99 * core::Millisecond, hist.percentile(0.99));
+}
+
+TEST(latency_histogram, out_of_range) {
+    LatencyHistogram hist;
+
+    hist.add(-core::Second);
+    hist.add(0);
+
+    check_percentile(100 * core::Microsecond, hist.percentile(0.5));
+
+    for (size_t n = 0; n < 10; n++) {
+        hist.add(1000 * core::Second);
+    }
+
+    CHECK(hist.percentile(0.99) > core::Second);
+    CHECK(hist.percentile(0.99) < 1000 * core::Second);
+}
+
+TEST(latency_histogram, forget) {
+    enum { NumMeasurements = 100000 };
+
+    LatencyHistogram hist;
+
+    for (size_t n = 0; n < NumMeasurements; n++) {
+        hist.add(10 * core::Millisecond);
+    }
+
+    CHECK(hist.size() < NumMeasurements);
+
+    check_percentile(10 * core::Millisecond, hist.percentile(0.5));
+
+    for (size_t n = 0; n < NumMeasurements; n++) {
+        hist.add(50 * core::Millisecond);
+    }
+
+    check_percentile(50 * core::Millisecond, hist.percentile(0.5));
+    check_percentile(50 * core::Millisecond, hist.percentile(0.99));
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/latency_tuner.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet_pool.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// One sample per millisecond.
+enum { SampleRate = 1000, SamplesPerPacket = 10 };
+
+const core::nanoseconds_t PacketInterval = SamplesPerPacket * core::Millisecond;
+
+const core::nanoseconds_t MinTarget = 20 * core::Millisecond;
+const core::nanoseconds_t MaxTarget = 500 * core::Millisecond;
+const core::nanoseconds_t InitialTarget = 200 * core::Millisecond;
+const core::nanoseconds_t Window = 1 * core::Second;
+
+// Number of packets per statistics window.
+const size_t WindowPackets = (size_t)(Window / PacketInterval);
+
+core::HeapAllocator allocator;
+packet::PacketPool packet_pool(allocator, true);
+
+LatencyTunerConfig make_config() {
+    LatencyTunerConfig config;
+    config.min_target_latency = MinTarget;
+    config.max_target_latency = MaxTarget;
+    config.window = Window;
+    config.jitter_factor = 4.0f;
+    config.delay_factor = 1.25f;
+    return config;
+}
+
+} // namespace
+
+TEST_GROUP(latency_tuner) {
+    packet::seqnum_t seqnum;
+
+    void setup() {
+        seqnum = 0;
+    }
+
+    packet::PacketPtr new_packet(size_t n, core::nanoseconds_t delay) {
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        CHECK(pp);
+
+        pp->add_flags(packet::Packet::FlagUDP | packet::Packet::FlagRTP);
+
+        pp->udp()->receive_timestamp =
+            core::Second + (core::nanoseconds_t)n * PacketInterval + delay;
+
+        pp->rtp()->seqnum = packet::seqnum_t(n);
+        pp->rtp()->timestamp = packet::timestamp_t(n * SamplesPerPacket);
+        pp->rtp()->duration = SamplesPerPacket;
+
+        return pp;
+    }
+
+    void add_packets(LatencyTuner & tuner, size_t first, size_t count,
+                     core::nanoseconds_t even_delay, core::nanoseconds_t odd_delay) {
+        for (size_t n = first; n < first + count; n++) {
+            tuner.add_packet(*new_packet(n, n % 2 == 0 ? even_delay : odd_delay));
+        }
+    }
+};
+
+TEST(latency_tuner, initial) {
+    LatencyTuner tuner(make_config(), InitialTarget, SampleRate);
+    CHECK(tuner.valid());
+
+    UNSIGNED_LONGS_EQUAL(200, tuner.target_latency());
+
+    add_packets(tuner, 0, WindowPackets / 2, 0, 0);
+
+    UNSIGNED_LONGS_EQUAL(200, tuner.target_latency());
+}
+
+TEST(latency_tuner, initial_clamped) {
+    LatencyTuner tuner(make_config(), 2 * MaxTarget, SampleRate);
+    CHECK(tuner.valid());
+
+    UNSIGNED_LONGS_EQUAL(500, tuner.target_latency());
+}
+
+TEST(latency_tuner, invalid_config) {
+    LatencyTunerConfig config = make_config();
+    config.min_target_latency = MaxTarget + 1;
+
+    LatencyTuner tuner(config, InitialTarget, SampleRate);
+    CHECK(!tuner.valid());
+}
+
+TEST(latency_tuner, no_jitter) {
+    LatencyTuner tuner(make_config(), InitialTarget, SampleRate);
+    CHECK(tuner.valid());
+
+    add_packets(tuner, 0, WindowPackets * 2, 0, 0);
+
+    DOUBLES_EQUAL(0.0, (double)tuner.jitter(), 0.001);
+    UNSIGNED_LONGS_EQUAL(0, tuner.peak_delay());
+    UNSIGNED_LONGS_EQUAL(20, tuner.target_latency());
+}
+
+TEST(latency_tuner, constant_jitter) {
+    LatencyTuner tuner(make_config(), InitialTarget, SampleRate);
+    CHECK(tuner.valid());
+
+    add_packets(tuner, 0, WindowPackets * 2, 0, 40 * core::Millisecond);
+
+    DOUBLES_EQUAL(40.0, (double)tuner.jitter(), 0.1);
+    UNSIGNED_LONGS_EQUAL(40, tuner.peak_delay());
+
+    // 4 * jitter is above 1.25 * peak delay
+    UNSIGNED_LONGS_EQUAL(159, tuner.target_latency());
+}
+
+TEST(latency_tuner, delay_spike) {
+    LatencyTuner tuner(make_config(), InitialTarget, SampleRate);
+    CHECK(tuner.valid());
+
+    add_packets(tuner, 0, WindowPackets * 2, 0, 0);
+    UNSIGNED_LONGS_EQUAL(20, tuner.target_latency());
+
+    tuner.add_packet(*new_packet(WindowPackets * 2, 160 * core::Millisecond));
+    UNSIGNED_LONGS_EQUAL(160, tuner.peak_delay());
+    UNSIGNED_LONGS_EQUAL(200, tuner.target_latency());
+
+    // spike is remembered during the current and the next window
+    add_packets(tuner, WindowPackets * 2 + 1, WindowPackets, 0, 0);
+    UNSIGNED_LONGS_EQUAL(160, tuner.peak_delay());
+
+    add_packets(tuner, WindowPackets * 3 + 1, WindowPackets * 2, 0, 0);
+    UNSIGNED_LONGS_EQUAL(0, tuner.peak_delay());
+    CHECK(tuner.target_latency() < 200);
+}
+
+TEST(latency_tuner, max_target) {
+    LatencyTuner tuner(make_config(), InitialTarget, SampleRate);
+    CHECK(tuner.valid());
+
+    add_packets(tuner, 0, WindowPackets * 2, 0, 0);
+    tuner.add_packet(*new_packet(WindowPackets * 2, 2 * core::Second));
+
+    UNSIGNED_LONGS_EQUAL(500, tuner.target_latency());
+}
+
+TEST(latency_tuner, reordering) {
+    LatencyTuner tuner(make_config(), InitialTarget, SampleRate);
+    CHECK(tuner.valid());
+
+    for (size_t n = 0; n < WindowPackets * 2; n += 4) {
+        tuner.add_packet(*new_packet(n + 0, 0));
+        tuner.add_packet(*new_packet(n + 2, 0));
+        tuner.add_packet(*new_packet(n + 3, 0));
+        tuner.add_packet(*new_packet(n + 1, 30 * core::Millisecond));
+    }
+
+    UNSIGNED_LONGS_EQUAL(30, tuner.peak_delay());
+    CHECK(tuner.target_latency() >= 37);
+    DOUBLES_EQUAL(0.0, (double)tuner.loss_ratio(), 0.001);
+}
+
+TEST(latency_tuner, losses) {
+    LatencyTuner tuner(make_config(), InitialTarget, SampleRate);
+    CHECK(tuner.valid());
+
+    for (size_t n = 0; n < WindowPackets * 3; n++) {
+        if (n % 4 == 3) {
+            continue;
+        }
+        tuner.add_packet(*new_packet(n, 0));
+    }
+
+    DOUBLES_EQUAL(0.25, (double)tuner.loss_ratio(), 0.02);
+    UNSIGNED_LONGS_EQUAL(20, tuner.target_latency());
+}
+
+TEST(latency_tuner, no_receive_timestamp) {
+    LatencyTuner tuner(make_config(), InitialTarget, SampleRate);
+    CHECK(tuner.valid());
+
+    for (size_t n = 0; n < WindowPackets * 2; n++) {
+        packet::PacketPtr pp = new_packet(n, 0);
+        pp->udp()->receive_timestamp = 0;
+        tuner.add_packet(*pp);
+    }
+
+    UNSIGNED_LONGS_EQUAL(200, tuner.target_latency());
+}
+
+} // namespace audio
+} // namespace roc
@@ -13,6 +13,7 @@
 #include "roc_audio/packetizer.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/time.h"
 #include "roc_packet/packet_pool.h"
 #include "roc_packet/queue.h"
 #include "roc_rtp/composer.h"
@@ -275,5 +276,87 @@ TEST(packetizer, flush) {
     UNSIGNED_LONGS_EQUAL(0, packet_queue.size());
 }
 
+TEST(packetizer, capture_timestamps) {
+    packet::Queue packet_queue;
+
+    Packetizer packetizer(packet_queue, rtp_composer, pcm_encoder, packet_pool,
+                          byte_buffer_pool, ChMask, PacketDuration, SampleRate,
+                          PayloadType);
+
+    FrameMaker frame_maker;
+
+    frame_maker.write(packetizer, SamplesPerPacket);
+
+    packet::PacketPtr pp = packet_queue.read();
+    CHECK(pp);
+    LONGS_EQUAL(0, pp->rtp()->capture_timestamp);
+
+    packetizer.enable_capture_timestamps();
+
+    const core::nanoseconds_t start_ts = core::unix_timestamp();
+    frame_maker.write(packetizer, SamplesPerPacket);
+    const core::nanoseconds_t end_ts = core::unix_timestamp();
+
+    pp = packet_queue.read();
+    CHECK(pp);
+    CHECK(pp->rtp()->capture_timestamp >= start_ts);
+    CHECK(pp->rtp()->capture_timestamp <= end_ts);
+}
+
+TEST(packetizer, dtx) {
+    enum { KeepalivePackets = 4, NumPackets = 14 };
+
+    // Packets 2..11 are silent. Packet 2 starts silence, packets 6 and 10
+    // are keep-alives, and packets 12 and 13 are sent normally. Packet 12
+    // starts a talkspurt and has the marker bit.
+    const bool silent[NumPackets] = { 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0 };
+    const bool sent[NumPackets] = { 1, 1, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1 };
+    const bool marker[NumPackets] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0 };
+
+    packet::Queue packet_queue;
+
+    Packetizer packetizer(packet_queue, rtp_composer, pcm_encoder, packet_pool,
+                          byte_buffer_pool, ChMask, PacketDuration, SampleRate,
+                          PayloadType);
+
+    packetizer.enable_dtx(PacketDuration * KeepalivePackets);
+
+    for (size_t np = 0; np < NumPackets; np++) {
+        sample_t samples[SamplesPerPacket * NumCh];
+        for (size_t n = 0; n < SamplesPerPacket * NumCh; n++) {
+            samples[n] = silent[np] ? 0.0f : 0.5f;
+        }
+
+        Frame frame(samples, SamplesPerPacket * NumCh);
+        packetizer.write(frame);
+    }
+
+    packet::PacketPtr first = packet_queue.read();
+    CHECK(first);
+
+    packet::PacketPtr pp = first;
+    packet::seqnum_t sn = 0;
+
+    for (size_t np = 0; np < NumPackets; np++) {
+        if (!sent[np]) {
+            continue;
+        }
+
+        CHECK(pp);
+
+        UNSIGNED_LONGS_EQUAL(packet::seqnum_t(first->rtp()->seqnum + sn),
+                             pp->rtp()->seqnum);
+        UNSIGNED_LONGS_EQUAL(
+            packet::timestamp_t(first->rtp()->timestamp + np * SamplesPerPacket),
+            pp->rtp()->timestamp);
+        CHECK(pp->rtp()->marker == marker[np]);
+
+        pp = packet_queue.read();
+        sn++;
+    }
+
+    CHECK(!pp);
+}
+
 } // namespace audio
 } // namespace roc
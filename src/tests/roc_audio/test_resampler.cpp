@@ -8,9 +8,12 @@
 
 #include <CppUTest/TestHarness.h>
 
-#include "roc_audio/resampler.h"
+#include "roc_audio/channel_layout.h"
+#include "roc_audio/resampler_config.h"
+#include "roc_audio/resampler_profile.h"
 #include "roc_audio/resampler_reader.h"
 #include "roc_core/buffer_pool.h"
+#include "roc_core/helpers.h"
 #include "roc_core/heap_allocator.h"
 #include "roc_core/random.h"
 #include "roc_core/stddefs.h"
@@ -29,6 +32,10 @@ enum {
     ResamplerFIRLen = 200,
     FrameSize = 512,
 
+    // output samples skipped before analysis, since the beginning of the output
+    // is affected by zeros before the first input sample
+    WarmupSamples = FrameSize * 2,
+
     OutSamples = FrameSize * 100 + 1,
     InSamples = OutSamples + (FrameSize * 3)
 };
@@ -52,9 +59,19 @@ TEST_GROUP(resampler) {
         return buf;
     }
 
+    // Reads and drops first output samples of every channel.
+    void skip_warmup(IReader & reader, size_t n_channels) {
+        core::Slice<sample_t> buf = new_buffer(WarmupSamples * n_channels);
+
+        Frame frame(buf.data(), buf.size());
+        reader.read(frame);
+    }
+
     // Reads signal from the resampler and puts its spectrum into @p spectrum.
     // Spectrum must have twice bigger space than the length of the input signal.
     void get_sample_spectrum1(IReader & reader, double* spectrum, const size_t sig_len) {
+        skip_warmup(reader, 1);
+
         core::Slice<sample_t> buf = new_buffer(sig_len);
 
         Frame frame(buf.data(), buf.size());
@@ -74,6 +91,8 @@ TEST_GROUP(resampler) {
                               size_t sig_len) {
         enum { nChannels = 2 };
 
+        skip_warmup(reader, nChannels);
+
         core::Slice<sample_t> buf = new_buffer(sig_len);
 
         Frame frame(buf.data(), buf.size());
@@ -117,13 +136,89 @@ TEST_GROUP(resampler) {
 
         return result; // return the generated random sample to the caller
     }
+
+    // Resamples two sine waves using polyphase filter bank and returns maximum
+    // difference between output and the exact values of the sine waves.
+    // If @p drift is non-zero, resampler is first configured with @p scaling
+    // and then its scaling is changed by @p drift.
+    double polyphase_error(float scaling, float drift) {
+        ResamplerConfig poly_config = config;
+        poly_config.polyphase = true;
+
+        // 1 / 0.9 is filter gain in pass band
+        return resampling_error(poly_config, scaling, drift, M_PI / 40, M_PI / 7,
+                                1 / 0.9);
+    }
+
+    // Resamples two sine waves with given frequencies using given backend and
+    // returns maximum difference between output and the exact values of the sine
+    // waves multiplied by @p gain.
+    double resampling_error(const ResamplerConfig& resampler_config,
+                            float scaling,
+                            float drift,
+                            double freq1,
+                            double freq2,
+                            double gain) {
+        enum { ChMask = 0x3, nChannels = 2, NumFrames = 20 };
+
+        MockReader reader;
+
+        ResamplerReader rr(reader, buffer_pool, allocator, resampler_config, ChMask,
+                           ChannelLayout_Interleaved, FrameSize);
+        CHECK(rr.valid());
+
+        CHECK(rr.set_scaling(scaling));
+        CHECK(rr.set_scaling(scaling + drift));
+
+        for (size_t n = 0; n < FrameSize / nChannels * (NumFrames + 4); n++) {
+            reader.add(1, (sample_t)std::sin(freq1 * double(n)));
+            reader.add(1, (sample_t)std::sin(freq2 * double(n)));
+        }
+
+        core::Slice<sample_t> buf = new_buffer(FrameSize);
+
+        double max_error = 0;
+
+        // output starts from the first input sample
+        double t = 0;
+
+        for (size_t n = 0; n < NumFrames; n++) {
+            Frame frame(buf.data(), buf.size());
+            rr.read(frame);
+
+            for (size_t i = 0; i < FrameSize; i += nChannels) {
+                // skip samples affected by zeros before the first input sample
+                if (t < FrameSize / nChannels) {
+                    t += double(scaling + drift);
+                    continue;
+                }
+
+                const double error1 =
+                    std::fabs(double(buf.data()[i]) - gain * std::sin(freq1 * t));
+                const double error2 =
+                    std::fabs(double(buf.data()[i + 1]) - gain * std::sin(freq2 * t));
+
+                if (error1 > max_error) {
+                    max_error = error1;
+                }
+                if (error2 > max_error) {
+                    max_error = error2;
+                }
+
+                t += double(scaling + drift);
+            }
+        }
+
+        return max_error;
+    }
 };
 
 TEST(resampler, invalid_scaling) {
     enum { ChMask = 0x1, InvalidScaling = FrameSize };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask,
+                       ChannelLayout_Interleaved, FrameSize);
 
     CHECK(rr.valid());
 
@@ -135,7 +230,8 @@ TEST(resampler, upscaling_twice_single) {
     enum { ChMask = 0x1 };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask,
+                       ChannelLayout_Interleaved, FrameSize);
 
     CHECK(rr.valid());
 
@@ -171,7 +267,8 @@ TEST(resampler, upscaling_twice_awgn) {
     enum { ChMask = 0x1 };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask,
+                       ChannelLayout_Interleaved, FrameSize);
 
     CHECK(rr.valid());
 
@@ -203,7 +300,8 @@ TEST(resampler, downsample) {
     enum { ChMask = 0x1 };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask,
+                       ChannelLayout_Interleaved, FrameSize);
 
     CHECK(rr.valid());
 
@@ -233,7 +331,8 @@ TEST(resampler, two_tones_sep_channels) {
     enum { ChMask = 0x3, nChannels = 2 };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask,
+                       ChannelLayout_Interleaved, FrameSize);
 
     CHECK(rr.valid());
 
@@ -263,5 +362,263 @@ TEST(resampler, two_tones_sep_channels) {
     }
 }
 
+// Output samples fall exactly on the phases of the filter bank.
+TEST(resampler, polyphase_exact_ratio) {
+    DOUBLES_EQUAL(0, polyphase_error(48000.0f / 44100, 0), 5e-4);
+    DOUBLES_EQUAL(0, polyphase_error(44100.0f / 48000, 0), 5e-4);
+    DOUBLES_EQUAL(0, polyphase_error(0.5f, 0), 5e-4);
+    DOUBLES_EQUAL(0, polyphase_error(1.0f, 0), 5e-4);
+}
+
+// Output samples fall between the phases of the filter bank and are
+// interpolated.
+TEST(resampler, polyphase_inexact_ratio) {
+    DOUBLES_EQUAL(0, polyphase_error(0.987654f, 0), 2e-3);
+    DOUBLES_EQUAL(0, polyphase_error(1.0076543f, 0), 2e-3);
+}
+
+// Small changes of scaling are applied on top of the filter bank.
+TEST(resampler, polyphase_drift) {
+    DOUBLES_EQUAL(0, polyphase_error(1.0f, 0.002f), 2e-3);
+    DOUBLES_EQUAL(0, polyphase_error(1.0f, -0.002f), 2e-3);
+    DOUBLES_EQUAL(0, polyphase_error(48000.0f / 44100, 0.0005f), 2e-3);
+}
+
+// Polyphase filter bank is accurate near Nyquist frequency, both when output
+// samples fall on its phases and when they fall between them because of the
+// clock drift, and it's not less accurate than interpolated sinc table.
+TEST(resampler, polyphase_profiles_high_freq) {
+    const ResamplerProfile profiles[] = { ResamplerProfile_Low, ResamplerProfile_Medium,
+                                          ResamplerProfile_High,
+                                          ResamplerProfile_Short };
+
+    // short window has a lower gain near Nyquist frequency
+    const double max_errors[] = { 3e-3, 2e-3, 2e-3, 0.5 };
+
+    const float drifts[] = { 0, 0.0003f, -0.002f };
+
+    for (size_t np = 0; np < ROC_ARRAY_SIZE(profiles); np++) {
+        for (size_t nd = 0; nd < ROC_ARRAY_SIZE(drifts); nd++) {
+            ResamplerConfig interp_config = resampler_profile(profiles[np]);
+            interp_config.polyphase = false;
+
+            ResamplerConfig poly_config = resampler_profile(profiles[np]);
+            poly_config.polyphase = true;
+
+            const double interp_error = resampling_error(
+                interp_config, 1.0f, drifts[nd], M_PI * 0.8, M_PI * 0.75, 1 / 0.9);
+            const double poly_error = resampling_error(
+                poly_config, 1.0f, drifts[nd], M_PI * 0.8, M_PI * 0.75, 1 / 0.9);
+
+            CHECK(poly_error < max_errors[np]);
+            CHECK(poly_error < interp_error * 1.05 + 1e-3);
+        }
+    }
+}
+
+// Planar layout gives the same output as interleaved one.
+TEST(resampler, planar_layout) {
+    enum { ChMask = 0x3, NumCh = 2, ReadSize = 300 * NumCh, NumReads = 20 };
+
+    for (int n = 0; n < 4; n++) {
+        ResamplerConfig layout_config = config;
+        layout_config.polyphase = (n == 1);
+        if (n == 2) {
+            layout_config.backend = ResamplerBackend_Linear;
+        }
+        if (n == 3) {
+            layout_config.backend = ResamplerBackend_Cubic;
+        }
+
+        MockReader interleaved_reader;
+        MockReader planar_reader;
+
+        sample_t interleaved[FrameSize];
+        sample_t planar[FrameSize];
+
+        for (size_t f = 0; f < InSamples / FrameSize; f++) {
+            for (size_t n = 0; n < FrameSize / NumCh; n++) {
+                const double t = double(f * FrameSize / NumCh + n);
+                interleaved[n * NumCh] = (sample_t)std::sin(M_PI / 4 * t);
+                interleaved[n * NumCh + 1] = (sample_t)std::sin(M_PI / 9 * t);
+            }
+            deinterleave_samples(planar, FrameSize / NumCh, interleaved,
+                                 FrameSize / NumCh, NumCh);
+            for (size_t n = 0; n < FrameSize; n++) {
+                interleaved_reader.add(1, interleaved[n]);
+                planar_reader.add(1, planar[n]);
+            }
+        }
+
+        ResamplerReader interleaved_rr(interleaved_reader, buffer_pool, allocator,
+                                       layout_config, ChMask,
+                                       ChannelLayout_Interleaved, FrameSize);
+        ResamplerReader planar_rr(planar_reader, buffer_pool, allocator, layout_config,
+                                  ChMask, ChannelLayout_Planar, FrameSize);
+
+        CHECK(interleaved_rr.valid());
+        CHECK(planar_rr.valid());
+
+        CHECK(interleaved_rr.set_scaling(0.93f));
+        CHECK(planar_rr.set_scaling(0.93f));
+
+        for (size_t r = 0; r < NumReads; r++) {
+            sample_t interleaved_out[ReadSize];
+            sample_t planar_out[ReadSize];
+
+            Frame interleaved_frame(interleaved_out, ReadSize);
+            Frame planar_frame(planar_out, ReadSize);
+
+            interleaved_rr.read(interleaved_frame);
+            planar_rr.read(planar_frame);
+
+            for (size_t n = 0; n < ReadSize / NumCh; n++) {
+                for (size_t ch = 0; ch < NumCh; ch++) {
+                    DOUBLES_EQUAL(interleaved_out[n * NumCh + ch],
+                                  planar_out[ch * (ReadSize / NumCh) + n], 1e-5);
+                }
+            }
+        }
+    }
+}
+
+// Output doesn't depend on the size of frames read from resampler.
+TEST(resampler, frame_size_independent) {
+    enum { ChMask = 0x3, NumCh = 2, NumSamples = FrameSize * 20 };
+
+    const size_t read_sizes[] = { 2, 30, 512, 6, 200, 126, 1000 };
+
+    for (int n = 0; n < 4; n++) {
+        ResamplerConfig chunk_config = config;
+        chunk_config.polyphase = (n == 1);
+        if (n == 2) {
+            chunk_config.backend = ResamplerBackend_Linear;
+        }
+        if (n == 3) {
+            chunk_config.backend = ResamplerBackend_Cubic;
+        }
+
+        MockReader fixed_reader;
+        MockReader chunked_reader;
+
+        for (size_t i = 0; i < InSamples; i++) {
+            const sample_t s = (sample_t)std::sin(M_PI / 11 * double(i / NumCh));
+            fixed_reader.add(1, s);
+            chunked_reader.add(1, s);
+        }
+
+        ResamplerReader fixed_rr(fixed_reader, buffer_pool, allocator, chunk_config,
+                                 ChMask, ChannelLayout_Interleaved, FrameSize);
+        ResamplerReader chunked_rr(chunked_reader, buffer_pool, allocator, chunk_config,
+                                   ChMask, ChannelLayout_Interleaved, FrameSize);
+
+        CHECK(fixed_rr.valid());
+        CHECK(chunked_rr.valid());
+
+        CHECK(fixed_rr.set_scaling(1.0076543f));
+        CHECK(chunked_rr.set_scaling(1.0076543f));
+
+        sample_t fixed_out[NumSamples];
+        sample_t chunked_out[NumSamples];
+
+        for (size_t pos = 0; pos < NumSamples; pos += FrameSize) {
+            Frame frame(fixed_out + pos, FrameSize);
+            fixed_rr.read(frame);
+        }
+
+        for (size_t pos = 0, r = 0; pos < NumSamples; r++) {
+            const size_t read_size =
+                std::min(read_sizes[r % ROC_ARRAY_SIZE(read_sizes)], NumSamples - pos);
+
+            Frame frame(chunked_out + pos, read_size);
+            chunked_rr.read(frame);
+
+            pos += read_size;
+        }
+
+        for (size_t i = 0; i < NumSamples; i++) {
+            DOUBLES_EQUAL(fixed_out[i], chunked_out[i], 0);
+        }
+    }
+}
+
+TEST(resampler, interp_invalid_scaling) {
+    enum { ChMask = 0x1 };
+
+    ResamplerConfig interp_config;
+    interp_config.backend = ResamplerBackend_Cubic;
+
+    MockReader reader;
+    ResamplerReader rr(reader, buffer_pool, allocator, interp_config, ChMask,
+                       ChannelLayout_Interleaved, FrameSize);
+
+    CHECK(rr.valid());
+
+    CHECK(!rr.set_scaling(0));
+    CHECK(!rr.set_scaling(-1));
+
+    // scaling is not limited by frame size
+    CHECK(rr.set_scaling(FrameSize));
+    CHECK(rr.set_scaling(1.001f));
+}
+
+// Without resampling, output samples fall exactly on input samples.
+TEST(resampler, interp_no_scaling) {
+    enum { ChMask = 0x1 };
+
+    for (int n = 0; n < 2; n++) {
+        ResamplerConfig interp_config;
+        interp_config.backend = n ? ResamplerBackend_Cubic : ResamplerBackend_Linear;
+
+        MockReader reader;
+        ResamplerReader rr(reader, buffer_pool, allocator, interp_config, ChMask,
+                           ChannelLayout_Interleaved, FrameSize);
+
+        CHECK(rr.valid());
+        CHECK(rr.set_scaling(1.0f));
+
+        for (size_t i = 0; i < InSamples; i++) {
+            reader.add(1, sample_t(i % 1000) / 1000);
+        }
+
+        core::Slice<sample_t> buf = new_buffer(FrameSize);
+
+        // output starts from the first input sample
+        size_t pos = 0;
+
+        for (size_t i = 0; i < 10; i++) {
+            Frame frame(buf.data(), buf.size());
+            rr.read(frame);
+
+            for (size_t j = 0; j < FrameSize; j++) {
+                DOUBLES_EQUAL(sample_t(pos % 1000) / 1000, buf.data()[j], 0);
+                pos++;
+            }
+        }
+    }
+}
+
+// Interpolation error is small for low frequencies and small scaling changes.
+TEST(resampler, interp_error) {
+    const float scalings[] = { 1.0f, 1.001f, 0.999f, 1.0076543f, 0.987654f };
+
+    ResamplerConfig linear_config;
+    linear_config.backend = ResamplerBackend_Linear;
+
+    ResamplerConfig cubic_config;
+    cubic_config.backend = ResamplerBackend_Cubic;
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(scalings); n++) {
+        DOUBLES_EQUAL(0,
+                      resampling_error(linear_config, scalings[n], 0, M_PI / 40,
+                                       M_PI / 20, 1),
+                      4e-3);
+        DOUBLES_EQUAL(0,
+                      resampling_error(cubic_config, scalings[n], 0, M_PI / 40,
+                                       M_PI / 20, 1),
+                      4e-4);
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/resampler_dot.h"
+#include "roc_core/random.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { MaxTaps = 67, MaxChannels = 3 };
+
+const double Epsilon = 1e-5;
+
+sample_t random_sample() {
+    return (sample_t)core::random(0, 0xffff) / 0xffff - 0.5f;
+}
+
+} // namespace
+
+TEST_GROUP(resampler_dot) {};
+
+TEST(resampler_dot, random) {
+    sample_t in[MaxTaps * MaxChannels];
+    sample_t coeffs[MaxTaps];
+
+    for (size_t i = 0; i < MaxTaps * MaxChannels; i++) {
+        in[i] = random_sample();
+    }
+    for (size_t i = 0; i < MaxTaps; i++) {
+        coeffs[i] = random_sample();
+    }
+
+    for (size_t n_ch = 1; n_ch <= MaxChannels; n_ch++) {
+        for (size_t n_taps = 0; n_taps <= MaxTaps; n_taps++) {
+            sample_t acc[MaxChannels];
+            double expected[MaxChannels];
+
+            for (size_t ch = 0; ch < n_ch; ch++) {
+                acc[ch] = (sample_t)ch;
+                expected[ch] = (double)ch;
+                for (size_t i = 0; i < n_taps; i++) {
+                    expected[ch] += (double)in[i * n_ch + ch] * (double)coeffs[i];
+                }
+            }
+
+            resampler_dot(acc, in, coeffs, n_taps, n_ch);
+
+            for (size_t ch = 0; ch < n_ch; ch++) {
+                DOUBLES_EQUAL(expected[ch], (double)acc[ch], Epsilon);
+            }
+        }
+    }
+}
+
+TEST(resampler_dot, isa) {
+    CHECK(resampler_dot_isa() != NULL);
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/resampler_history.h"
+#include "roc_core/heap_allocator.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { NumCh = 2, Capacity = 10 };
+
+core::HeapAllocator allocator;
+
+} // namespace
+
+TEST_GROUP(resampler_history) {
+    // Checks that sample of channel ch at position pos equals to expected.
+    void expect_sample(const ResamplerHistory& history, size_t pos, size_t ch,
+                       sample_t expected) {
+        DOUBLES_EQUAL(expected, history.data(pos)[ch * history.channel_stride()], 0);
+    }
+};
+
+TEST(resampler_history, append_remove_interleaved) {
+    ResamplerHistory history(allocator, NumCh, ChannelLayout_Interleaved);
+
+    CHECK(history.reserve(Capacity));
+    UNSIGNED_LONGS_EQUAL(Capacity, history.capacity());
+    UNSIGNED_LONGS_EQUAL(0, history.size());
+
+    const sample_t samples[] = { 0.1f, -0.1f, 0.2f, -0.2f, 0.3f, -0.3f };
+
+    history.append(samples, ROC_ARRAY_SIZE(samples));
+    UNSIGNED_LONGS_EQUAL(3, history.size());
+
+    UNSIGNED_LONGS_EQUAL(1, history.channel_stride());
+    UNSIGNED_LONGS_EQUAL(NumCh, history.sample_stride());
+
+    history.remove(1);
+    UNSIGNED_LONGS_EQUAL(2, history.size());
+
+    expect_sample(history, 0, 0, 0.2f);
+    expect_sample(history, 0, 1, -0.2f);
+    expect_sample(history, 1, 0, 0.3f);
+    expect_sample(history, 1, 1, -0.3f);
+
+    history.prepend_zeros(2);
+    UNSIGNED_LONGS_EQUAL(4, history.size());
+
+    expect_sample(history, 0, 0, 0);
+    expect_sample(history, 1, 1, 0);
+    expect_sample(history, 2, 0, 0.2f);
+    expect_sample(history, 3, 1, -0.3f);
+}
+
+TEST(resampler_history, append_remove_planar) {
+    ResamplerHistory history(allocator, NumCh, ChannelLayout_Planar);
+
+    CHECK(history.reserve(Capacity));
+
+    // first plane, then second plane
+    const sample_t samples[] = { 0.1f, 0.2f, 0.3f, -0.1f, -0.2f, -0.3f };
+
+    history.append(samples, ROC_ARRAY_SIZE(samples));
+    UNSIGNED_LONGS_EQUAL(3, history.size());
+
+    UNSIGNED_LONGS_EQUAL(Capacity, history.channel_stride());
+    UNSIGNED_LONGS_EQUAL(1, history.sample_stride());
+
+    history.remove(1);
+    UNSIGNED_LONGS_EQUAL(2, history.size());
+
+    expect_sample(history, 0, 0, 0.2f);
+    expect_sample(history, 0, 1, -0.2f);
+    expect_sample(history, 1, 0, 0.3f);
+    expect_sample(history, 1, 1, -0.3f);
+}
+
+// Growing capacity keeps samples of every channel.
+TEST(resampler_history, reserve_planar) {
+    ResamplerHistory history(allocator, NumCh, ChannelLayout_Planar);
+
+    CHECK(history.reserve(Capacity));
+
+    const sample_t samples[] = { 0.1f, 0.2f, -0.1f, -0.2f };
+    history.append(samples, ROC_ARRAY_SIZE(samples));
+
+    CHECK(history.reserve(Capacity * 3));
+    UNSIGNED_LONGS_EQUAL(Capacity * 3, history.capacity());
+    UNSIGNED_LONGS_EQUAL(Capacity * 3, history.channel_stride());
+
+    // smaller capacity is ignored
+    CHECK(history.reserve(Capacity));
+    UNSIGNED_LONGS_EQUAL(Capacity * 3, history.capacity());
+
+    UNSIGNED_LONGS_EQUAL(2, history.size());
+
+    expect_sample(history, 0, 0, 0.1f);
+    expect_sample(history, 1, 0, 0.2f);
+    expect_sample(history, 0, 1, -0.1f);
+    expect_sample(history, 1, 1, -0.2f);
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/hash_map.h"
+#include "roc_core/heap_allocator.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { NumElems = 1000, NumBuckets = 7 };
+
+struct Key {
+    size_t value;
+
+    Key(size_t v = 0)
+        : value(v) {
+    }
+
+    // Deliberately bad hash, to force long probe sequences.
+    hash_t hash() const {
+        return hash_t(value % NumBuckets);
+    }
+
+    bool operator==(const Key& other) const {
+        return value == other.value;
+    }
+};
+
+} // namespace
+
+TEST_GROUP(hash_map) {
+    HeapAllocator allocator;
+};
+
+TEST(hash_map, empty) {
+    HashMap<Key, size_t> map(allocator);
+
+    UNSIGNED_LONGS_EQUAL(0, map.size());
+    CHECK(!map.find(Key(1)));
+    CHECK(!map.remove(Key(1)));
+
+    UNSIGNED_LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(hash_map, insert_find) {
+    HashMap<Key, size_t> map(allocator);
+
+    for (size_t n = 0; n < NumElems; n++) {
+        CHECK(map.insert(Key(n), n * 10));
+        UNSIGNED_LONGS_EQUAL(n + 1, map.size());
+    }
+
+    for (size_t n = 0; n < NumElems; n++) {
+        size_t* value = map.find(Key(n));
+        CHECK(value);
+        UNSIGNED_LONGS_EQUAL(n * 10, *value);
+    }
+
+    CHECK(!map.find(Key(NumElems)));
+}
+
+TEST(hash_map, insert_replace) {
+    HashMap<Key, size_t> map(allocator);
+
+    CHECK(map.insert(Key(1), 10));
+    CHECK(map.insert(Key(1), 20));
+
+    UNSIGNED_LONGS_EQUAL(1, map.size());
+    UNSIGNED_LONGS_EQUAL(20, *map.find(Key(1)));
+}
+
+TEST(hash_map, remove) {
+    HashMap<Key, size_t> map(allocator);
+
+    for (size_t n = 0; n < NumElems; n++) {
+        CHECK(map.insert(Key(n), n));
+    }
+
+    for (size_t n = 0; n < NumElems; n += 2) {
+        CHECK(map.remove(Key(n)));
+        CHECK(!map.remove(Key(n)));
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumElems / 2, map.size());
+
+    for (size_t n = 0; n < NumElems; n++) {
+        if (n % 2 == 0) {
+            CHECK(!map.find(Key(n)));
+        } else {
+            size_t* value = map.find(Key(n));
+            CHECK(value);
+            UNSIGNED_LONGS_EQUAL(n, *value);
+        }
+    }
+
+    for (size_t n = 1; n < NumElems; n += 2) {
+        CHECK(map.remove(Key(n)));
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, map.size());
+
+    for (size_t n = 0; n < NumElems; n++) {
+        CHECK(!map.find(Key(n)));
+    }
+}
+
+TEST(hash_map, reinsert) {
+    HashMap<Key, size_t> map(allocator);
+
+    for (size_t i = 0; i < 10; i++) {
+        for (size_t n = 0; n < NumElems; n++) {
+            CHECK(map.insert(Key(n), n + i));
+        }
+        for (size_t n = 0; n < NumElems; n++) {
+            UNSIGNED_LONGS_EQUAL(n + i, *map.find(Key(n)));
+            CHECK(map.remove(Key(n)));
+        }
+        UNSIGNED_LONGS_EQUAL(0, map.size());
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, allocator.num_allocations());
+}
+
+} // namespace core
+} // namespace roc
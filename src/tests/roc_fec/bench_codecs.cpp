@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// FEC block codecs benchmark.
+//
+// Measures encoding and decoding time per block and throughput for every
+// available block codec over a grid of block and payload sizes, and repair
+// success rate under several loss models. To get machine-readable results, run:
+//
+//   roc-bench-fec --benchmark_filter=BM_FEC --benchmark_format=json
+//
+// or use --benchmark_out=<file> --benchmark_out_format=json.
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/random.h"
+#include "roc_core/unique_ptr.h"
+#include "roc_fec/codec_factory.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxPayloadSize = 1280, MaxPackets = 255, NumPatterns = 256 };
+
+// Loss model.
+enum LossModel {
+    // Every packet is lost independently with the given probability.
+    Loss_Random,
+
+    // Every block loses a single run of consecutive packets, which length
+    // is the given fraction of the block size.
+    Loss_Burst,
+
+    // Two-state Markov channel with the given average loss rate and mean
+    // bad state duration of GE_BadLength packets.
+    Loss_GilbertElliott
+};
+
+// Gilbert-Elliott model parameters.
+const double GE_BadLength = 4;
+const double GE_GoodLoss = 0.001;
+const double GE_BadLoss = 0.75;
+
+// Block sizes: number of source and repair packets.
+const int BlockSizes[][2] = { { 10, 5 }, { 20, 10 }, { 40, 20 } };
+
+const int PayloadSizes[] = { 256, 1280 };
+
+const int LossModels[] = { Loss_Random, Loss_Burst, Loss_GilbertElliott };
+
+// Average loss rate, percents.
+const int LossRates[] = { 5, 15 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxPayloadSize, true);
+
+Config make_config(CodecType codec,
+                   CodecBackend backend,
+                   size_t n_source,
+                   size_t n_repair) {
+    Config config;
+    config.codec = codec;
+    config.backend = backend;
+    config.n_source_packets = n_source;
+    config.n_repair_packets = n_repair;
+    return config;
+}
+
+core::Slice<uint8_t> make_buffer(size_t size) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    roc_panic_if(!buf);
+    buf.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        buf.data()[i] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+bool chance(double probability) {
+    return core::random(1000000) < (unsigned)(probability * 1000000);
+}
+
+// Fills loss patterns for consecutive blocks; the channel state of
+// the Gilbert-Elliott model is carried from block to block.
+void make_patterns(bool patterns[NumPatterns][MaxPackets],
+                   size_t n_packets,
+                   LossModel model,
+                   double loss_rate) {
+    // stationary probability of the bad state
+    const double bad_prob = (loss_rate - GE_GoodLoss) / (GE_BadLoss - GE_GoodLoss);
+    const double bad_to_good = 1 / GE_BadLength;
+    const double good_to_bad = bad_to_good * bad_prob / (1 - bad_prob);
+
+    bool bad_state = false;
+
+    for (size_t n = 0; n < NumPatterns; n++) {
+        bool* lost = patterns[n];
+
+        switch (model) {
+        case Loss_Random:
+            for (size_t i = 0; i < n_packets; i++) {
+                lost[i] = chance(loss_rate);
+            }
+            break;
+
+        case Loss_Burst: {
+            const size_t burst_len = (size_t)(n_packets * loss_rate + 0.5);
+            const size_t burst_pos = core::random(0, unsigned(n_packets - burst_len));
+            for (size_t i = 0; i < n_packets; i++) {
+                lost[i] = (i >= burst_pos && i < burst_pos + burst_len);
+            }
+        } break;
+
+        case Loss_GilbertElliott:
+            for (size_t i = 0; i < n_packets; i++) {
+                bad_state = chance(bad_state ? 1 - bad_to_good : good_to_bad);
+                lost[i] = chance(bad_state ? GE_BadLoss : GE_GoodLoss);
+            }
+            break;
+        }
+    }
+}
+
+// Measures time spent per block, including the encoder reset.
+// Arguments: number of source packets, number of repair packets, payload size.
+void BM_FEC_Encode(benchmark::State& state, CodecType codec, CodecBackend backend) {
+    const size_t n_source = (size_t)state.range(0);
+    const size_t n_repair = (size_t)state.range(1);
+    const size_t payload_size = (size_t)state.range(2);
+
+    core::UniquePtr<IEncoder> encoder(
+        new_encoder(make_config(codec, backend, n_source, n_repair), payload_size,
+                    allocator),
+        allocator);
+    roc_panic_if(!encoder);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    for (size_t i = 0; i < n_source + n_repair; ++i) {
+        buffers[i] = make_buffer(payload_size);
+    }
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n_source + n_repair; ++i) {
+            encoder->set(i, buffers[i]);
+        }
+        encoder->commit();
+        encoder->reset();
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(n_source)
+                            * int64_t(payload_size));
+}
+
+// Measures time spent per block, including the decoder reset, and counts
+// repaired source packets.
+// Arguments: number of source packets, number of repair packets, payload size,
+// loss model, and average loss rate in percents.
+void BM_FEC_Decode(benchmark::State& state, CodecType codec, CodecBackend backend) {
+    const size_t n_source = (size_t)state.range(0);
+    const size_t n_repair = (size_t)state.range(1);
+    const size_t payload_size = (size_t)state.range(2);
+    const LossModel loss_model = (LossModel)state.range(3);
+    const double loss_rate = (double)state.range(4) / 100;
+
+    const size_t n_packets = n_source + n_repair;
+
+    const Config config = make_config(codec, backend, n_source, n_repair);
+
+    core::UniquePtr<IEncoder> encoder(new_encoder(config, payload_size, allocator),
+                                      allocator);
+    roc_panic_if(!encoder);
+
+    core::UniquePtr<IDecoder> decoder(
+        new_decoder(config, payload_size, buffer_pool, allocator), allocator);
+    roc_panic_if(!decoder);
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    for (size_t i = 0; i < n_packets; ++i) {
+        buffers[i] = make_buffer(payload_size);
+        encoder->set(i, buffers[i]);
+    }
+    encoder->commit();
+
+    static bool patterns[NumPatterns][MaxPackets];
+    make_patterns(patterns, n_packets, loss_model, loss_rate);
+
+    size_t n_blocks = 0;
+    size_t n_lost = 0;
+    size_t n_lost_source = 0;
+    size_t n_repaired = 0;
+    size_t n_damaged_blocks = 0;
+    size_t n_recovered_blocks = 0;
+
+    while (state.KeepRunning()) {
+        const bool* lost = patterns[n_blocks % NumPatterns];
+
+        for (size_t i = 0; i < n_packets; ++i) {
+            if (!lost[i]) {
+                decoder->set(i, buffers[i]);
+            }
+        }
+
+        size_t n_block_lost = 0;
+        size_t n_block_repaired = 0;
+
+        for (size_t i = 0; i < n_source; ++i) {
+            if (!lost[i]) {
+                continue;
+            }
+            n_block_lost++;
+            if (decoder->repair(i)) {
+                n_block_repaired++;
+            }
+        }
+
+        decoder->reset();
+
+        for (size_t i = 0; i < n_packets; ++i) {
+            n_lost += lost[i];
+        }
+
+        n_lost_source += n_block_lost;
+        n_repaired += n_block_repaired;
+
+        if (n_block_lost != 0) {
+            n_damaged_blocks++;
+            if (n_block_repaired == n_block_lost) {
+                n_recovered_blocks++;
+            }
+        }
+
+        n_blocks++;
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(n_source)
+                            * int64_t(payload_size));
+
+    state.counters["loss_rate"] = n_blocks ? (double)n_lost / (n_blocks * n_packets) : 0;
+    state.counters["repair_rate"] =
+        n_lost_source ? (double)n_repaired / n_lost_source : 1;
+    state.counters["block_recovery_rate"] =
+        n_damaged_blocks ? (double)n_recovered_blocks / n_damaged_blocks : 1;
+}
+
+void encode_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "nbsrc", "nbrpr", "size" });
+
+    for (size_t bs = 0; bs < ROC_ARRAY_SIZE(BlockSizes); bs++) {
+        for (size_t ps = 0; ps < ROC_ARRAY_SIZE(PayloadSizes); ps++) {
+            b->Args({ BlockSizes[bs][0], BlockSizes[bs][1], PayloadSizes[ps] });
+        }
+    }
+}
+
+void decode_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "nbsrc", "nbrpr", "size", "model", "loss" });
+
+    for (size_t bs = 0; bs < ROC_ARRAY_SIZE(BlockSizes); bs++) {
+        for (size_t ps = 0; ps < ROC_ARRAY_SIZE(PayloadSizes); ps++) {
+            for (size_t lm = 0; lm < ROC_ARRAY_SIZE(LossModels); lm++) {
+                for (size_t lr = 0; lr < ROC_ARRAY_SIZE(LossRates); lr++) {
+                    b->Args({ BlockSizes[bs][0], BlockSizes[bs][1], PayloadSizes[ps],
+                              LossModels[lm], LossRates[lr] });
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_FEC_Encode, rs8m_builtin, ReedSolomon8m, BuiltinBackend)
+    ->Apply(encode_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_FEC_Decode, rs8m_builtin, ReedSolomon8m, BuiltinBackend)
+    ->Apply(decode_args)
+    ->Unit(benchmark::kMicrosecond);
+
+#ifdef ROC_TARGET_OPENFEC
+
+BENCHMARK_CAPTURE(BM_FEC_Encode, rs8m_openfec, ReedSolomon8m, OpenFECBackend)
+    ->Apply(encode_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_FEC_Decode, rs8m_openfec, ReedSolomon8m, OpenFECBackend)
+    ->Apply(decode_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_FEC_Encode, ldpc_openfec, LDPCStaircase, OpenFECBackend)
+    ->Apply(encode_args)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_FEC_Decode, ldpc_openfec, LDPCStaircase, OpenFECBackend)
+    ->Apply(decode_args)
+    ->Unit(benchmark::kMicrosecond);
+
+#endif // ROC_TARGET_OPENFEC
+
+} // namespace fec
+} // namespace roc
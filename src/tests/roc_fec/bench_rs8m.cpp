@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/random.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxPayloadSize = 1500, MaxPackets = 255 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxPayloadSize, true);
+
+Config make_config(size_t n_source, size_t n_repair) {
+    Config config;
+    config.codec = ReedSolomon8m;
+    config.backend = BuiltinBackend;
+    config.n_source_packets = n_source;
+    config.n_repair_packets = n_repair;
+    return config;
+}
+
+core::Slice<uint8_t> make_buffer(size_t size) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    roc_panic_if(!buf);
+    buf.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        buf.data()[i] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+// Arguments: number of source packets, number of repair packets, payload size.
+void BM_RS8M_Encode(benchmark::State& state) {
+    const size_t n_source = (size_t)state.range(0);
+    const size_t n_repair = (size_t)state.range(1);
+    const size_t payload_size = (size_t)state.range(2);
+
+    RS8MEncoder encoder(make_config(n_source, n_repair), payload_size, allocator);
+    roc_panic_if(!encoder.valid());
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    for (size_t i = 0; i < n_source + n_repair; ++i) {
+        buffers[i] = make_buffer(payload_size);
+    }
+
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n_source + n_repair; ++i) {
+            encoder.set(i, buffers[i]);
+        }
+        encoder.commit();
+        encoder.reset();
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(n_source)
+                            * int64_t(payload_size));
+    state.SetLabel(gf256_region_isa());
+}
+
+// Arguments: number of source packets, number of repair packets, payload size.
+// Loses as many source packets as there are repair packets.
+void BM_RS8M_Decode(benchmark::State& state) {
+    const size_t n_source = (size_t)state.range(0);
+    const size_t n_repair = (size_t)state.range(1);
+    const size_t payload_size = (size_t)state.range(2);
+
+    const Config config = make_config(n_source, n_repair);
+
+    RS8MEncoder encoder(config, payload_size, allocator);
+    roc_panic_if(!encoder.valid());
+
+    RS8MDecoder decoder(config, payload_size, buffer_pool, allocator);
+    roc_panic_if(!decoder.valid());
+
+    core::Slice<uint8_t> buffers[MaxPackets];
+    for (size_t i = 0; i < n_source + n_repair; ++i) {
+        buffers[i] = make_buffer(payload_size);
+        encoder.set(i, buffers[i]);
+    }
+    encoder.commit();
+
+    while (state.KeepRunning()) {
+        for (size_t i = n_repair; i < n_source + n_repair; ++i) {
+            decoder.set(i, buffers[i]);
+        }
+        for (size_t i = 0; i < n_repair; ++i) {
+            benchmark::DoNotOptimize(decoder.repair(i).data());
+        }
+        decoder.reset();
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(n_source)
+                            * int64_t(payload_size));
+    state.SetLabel(gf256_region_isa());
+}
+
+void BM_GF256_MulAddRegion(benchmark::State& state) {
+    const size_t size = (size_t)state.range(0);
+
+    core::Slice<uint8_t> src = make_buffer(size);
+    core::Slice<uint8_t> dst = make_buffer(size);
+
+    while (state.KeepRunning()) {
+        gf256_mul_add_region(dst.data(), src.data(), 0x8e, size);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+    state.SetLabel(gf256_region_isa());
+}
+
+} // namespace
+
+BENCHMARK(BM_RS8M_Encode)->Args({ 20, 10, 256 })->Args({ 20, 10, 1280 });
+BENCHMARK(BM_RS8M_Decode)->Args({ 20, 10, 256 })->Args({ 20, 10, 1280 });
+BENCHMARK(BM_GF256_MulAddRegion)->Arg(256)->Arg(1280);
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/random.h"
+#include "roc_fec/of_decoder.h"
+#include "roc_fec/of_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum {
+    NumSourcePackets = 20,
+    NumRepairPackets = 10,
+    NumPackets = NumSourcePackets + NumRepairPackets,
+    PayloadSize = 1280
+};
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, true);
+
+Config make_config(CodecType codec) {
+    Config config;
+    config.codec = codec;
+    config.backend = OpenFECBackend;
+    config.n_source_packets = NumSourcePackets;
+    config.n_repair_packets = NumRepairPackets;
+    return config;
+}
+
+core::Slice<uint8_t> make_buffer() {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    roc_panic_if(!buf);
+    buf.resize(PayloadSize);
+    for (size_t i = 0; i < PayloadSize; ++i) {
+        buf.data()[i] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+// Measures time spent per block, including the decoder reset at the end of
+// the block. Arguments: number of lost source packets.
+void bench_decode(benchmark::State& state, CodecType codec) {
+    const size_t n_lost = (size_t)state.range(0);
+
+    const Config config = make_config(codec);
+
+    OFEncoder encoder(config, PayloadSize, allocator);
+    roc_panic_if(!encoder.valid());
+
+    OFDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+    roc_panic_if(!decoder.valid());
+
+    core::Slice<uint8_t> buffers[NumPackets];
+    for (size_t i = 0; i < NumPackets; ++i) {
+        buffers[i] = make_buffer();
+        encoder.set(i, buffers[i]);
+    }
+    encoder.commit();
+
+    while (state.KeepRunning()) {
+        for (size_t i = n_lost; i < NumPackets; ++i) {
+            decoder.set(i, buffers[i]);
+        }
+        for (size_t i = 0; i < n_lost; ++i) {
+            benchmark::DoNotOptimize(decoder.repair(i).data());
+        }
+        decoder.reset();
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+
+void BM_OFDecoder_RS8M(benchmark::State& state) {
+    bench_decode(state, ReedSolomon8m);
+}
+
+void BM_OFDecoder_LDPC(benchmark::State& state) {
+    bench_decode(state, LDPCStaircase);
+}
+
+} // namespace
+
+BENCHMARK(BM_OFDecoder_RS8M)->Arg(0)->Arg(1)->Arg(5);
+BENCHMARK(BM_OFDecoder_LDPC)->Arg(0)->Arg(1)->Arg(5);
+
+} // namespace fec
+} // namespace roc
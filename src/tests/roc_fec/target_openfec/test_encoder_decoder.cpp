@@ -101,7 +101,7 @@ TEST_GROUP(encoder_decoder) {
 };
 
 TEST(encoder_decoder, without_loss) {
-    for (int type = ReedSolomon8m; type != CodecTypeMax; ++type) {
+    for (int type = ReedSolomon8m; type <= LDPCStaircase; ++type) {
         config.codec = (CodecType)type;
         Codec code(config);
         code.encode();
@@ -114,7 +114,7 @@ TEST(encoder_decoder, without_loss) {
 }
 
 TEST(encoder_decoder, loss_1) {
-    for (int type = ReedSolomon8m; type != CodecTypeMax; ++type) {
+    for (int type = ReedSolomon8m; type <= LDPCStaircase; ++type) {
         config.codec = (CodecType)type;
         Codec code(config);
         code.encode();
@@ -131,7 +131,7 @@ TEST(encoder_decoder, loss_1) {
 
 TEST(encoder_decoder, load_test) {
     enum { NumIterations = 20, LossPercent = 10, MaxLoss = 3 };
-    for (int type = ReedSolomon8m; type != CodecTypeMax; ++type) {
+    for (int type = ReedSolomon8m; type <= LDPCStaircase; ++type) {
         config.codec = (CodecType)type;
         Codec code(config);
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/of_decoder.h"
+#include "roc_fec/of_encoder.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { NumSourcePackets = 20, NumRepairPackets = 10, PayloadSize = 256 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, true);
+
+core::Slice<uint8_t> make_buffer(bool random) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buf);
+    buf.resize(PayloadSize);
+    for (size_t i = 0; i < buf.size(); ++i) {
+        buf.data()[i] = random ? (uint8_t)core::random(0, 0xff) : 0;
+    }
+    return buf;
+}
+
+} // namespace
+
+TEST_GROUP(rs8m_openfec) {
+    Config config;
+
+    core::Slice<uint8_t> source[NumSourcePackets];
+    core::Slice<uint8_t> of_repair[NumRepairPackets];
+    core::Slice<uint8_t> rs_repair[NumRepairPackets];
+
+    void setup() {
+        config.codec = ReedSolomon8m;
+        config.n_source_packets = NumSourcePackets;
+        config.n_repair_packets = NumRepairPackets;
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            source[i] = make_buffer(true);
+        }
+
+        OFEncoder of_encoder(config, PayloadSize, allocator);
+        RS8MEncoder rs_encoder(config, PayloadSize, allocator);
+
+        CHECK(of_encoder.valid());
+        CHECK(rs_encoder.valid());
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            of_encoder.set(i, source[i]);
+            rs_encoder.set(i, source[i]);
+        }
+
+        for (size_t i = 0; i < NumRepairPackets; ++i) {
+            of_repair[i] = make_buffer(false);
+            rs_repair[i] = make_buffer(false);
+
+            of_encoder.set(NumSourcePackets + i, of_repair[i]);
+            rs_encoder.set(NumSourcePackets + i, rs_repair[i]);
+        }
+
+        of_encoder.commit();
+        rs_encoder.commit();
+    }
+
+    void check_decoder(IDecoder & decoder, core::Slice<uint8_t>* repair) {
+        for (size_t i = NumRepairPackets; i < NumSourcePackets; ++i) {
+            decoder.set(i, source[i]);
+        }
+        for (size_t i = 0; i < NumRepairPackets; ++i) {
+            decoder.set(NumSourcePackets + i, repair[i]);
+        }
+
+        for (size_t i = 0; i < NumRepairPackets; ++i) {
+            core::Slice<uint8_t> decoded = decoder.repair(i);
+            CHECK(decoded);
+            UNSIGNED_LONGS_EQUAL(PayloadSize, decoded.size());
+            CHECK(memcmp(source[i].data(), decoded.data(), PayloadSize) == 0);
+        }
+    }
+};
+
+TEST(rs8m_openfec, same_repair_symbols) {
+    for (size_t i = 0; i < NumRepairPackets; ++i) {
+        CHECK(memcmp(of_repair[i].data(), rs_repair[i].data(), PayloadSize) == 0);
+    }
+}
+
+TEST(rs8m_openfec, openfec_encoder_builtin_decoder) {
+    RS8MDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+    CHECK(decoder.valid());
+
+    check_decoder(decoder, of_repair);
+}
+
+TEST(rs8m_openfec, builtin_encoder_openfec_decoder) {
+    OFDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+    CHECK(decoder.valid());
+
+    check_decoder(decoder, rs_repair);
+}
+
+} // namespace fec
+} // namespace roc
@@ -234,6 +234,12 @@ TEST_GROUP(writer_reader) {
     }
 };
 
+TEST(writer_reader, composer_overhead) {
+    UNSIGNED_LONGS_EQUAL(sizeof(RSm8_PayloadID) + sizeof(rtp::Header),
+                         source_composer.overhead());
+    UNSIGNED_LONGS_EQUAL(sizeof(RSm8_PayloadID), repair_composer.overhead());
+}
+
 TEST(writer_reader, read_write_lossless) {
     OFEncoder encoder(config, FECPayloadSize, allocator);
     OFDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/encoder_task.h"
+#include "roc_fec/encoder_worker.h"
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_packet/concurrent_queue.h"
+#include "roc_packet/packet_pool.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum {
+    NumSourcePackets = 10,
+    NumRepairPackets = 5,
+    NumPackets = NumSourcePackets + NumRepairPackets,
+    PayloadSize = 200,
+    NumTasks = 4
+};
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+core::Slice<uint8_t> make_buffer(bool random) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buf);
+    buf.resize(PayloadSize);
+    for (size_t i = 0; i < PayloadSize; ++i) {
+        buf.data()[i] = random ? (uint8_t)core::random(0, 0xff) : 0;
+    }
+    return buf;
+}
+
+packet::PacketPtr make_repair_packet(const core::Slice<uint8_t>& payload) {
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    CHECK(pp);
+    pp->add_flags(packet::Packet::FlagFEC | packet::Packet::FlagRepair);
+    pp->fec()->payload = payload;
+    return pp;
+}
+
+} // namespace
+
+TEST_GROUP(encoder_worker) {
+    Config config;
+
+    core::Slice<uint8_t> buffers[NumTasks][NumPackets];
+    core::Slice<uint8_t> expected[NumTasks][NumRepairPackets];
+
+    void setup() {
+        config.codec = ReedSolomon8m;
+        config.n_source_packets = NumSourcePackets;
+        config.n_repair_packets = NumRepairPackets;
+
+        RS8MEncoder encoder(config, PayloadSize, allocator);
+        CHECK(encoder.valid());
+
+        for (size_t t = 0; t < NumTasks; t++) {
+            for (size_t i = 0; i < NumPackets; i++) {
+                buffers[t][i] = make_buffer(i < NumSourcePackets);
+            }
+            for (size_t i = 0; i < NumSourcePackets; i++) {
+                encoder.set(i, buffers[t][i]);
+            }
+            for (size_t i = 0; i < NumRepairPackets; i++) {
+                expected[t][i] = make_buffer(false);
+                encoder.set(NumSourcePackets + i, expected[t][i]);
+            }
+            encoder.commit();
+            encoder.reset();
+        }
+    }
+
+    void fill_task(EncoderTask & task, size_t t) {
+        for (size_t i = 0; i < NumSourcePackets; i++) {
+            task.set_source(i, buffers[t][i]);
+        }
+        for (size_t i = 0; i < NumRepairPackets; i++) {
+            task.set_repair(i, make_repair_packet(buffers[t][NumSourcePackets + i]));
+        }
+    }
+
+    void check_task(size_t t, packet::ConcurrentQueue & queue) {
+        for (size_t i = 0; i < NumRepairPackets; i++) {
+            packet::PacketPtr pp = queue.try_read();
+            CHECK(pp);
+            CHECK(pp->fec()->payload.data() == buffers[t][NumSourcePackets + i].data());
+            CHECK(memcmp(expected[t][i].data(), pp->fec()->payload.data(), PayloadSize)
+                  == 0);
+        }
+    }
+};
+
+TEST(encoder_worker, encode_in_place) {
+    RS8MEncoder encoder(config, PayloadSize, allocator);
+    CHECK(encoder.valid());
+
+    packet::ConcurrentQueue queue;
+
+    EncoderTask task(encoder, queue, NumSourcePackets, NumRepairPackets, allocator);
+    CHECK(task.valid());
+
+    fill_task(task, 0);
+    task.encode();
+
+    check_task(0, queue);
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+}
+
+TEST(encoder_worker, not_started) {
+    RS8MEncoder encoder(config, PayloadSize, allocator);
+    CHECK(encoder.valid());
+
+    packet::ConcurrentQueue queue;
+
+    EncoderTask task(encoder, queue, NumSourcePackets, NumRepairPackets, allocator);
+    CHECK(task.valid());
+
+    EncoderWorker worker;
+
+    fill_task(task, 0);
+    worker.schedule(task);
+
+    CHECK(!worker.pending(task));
+    check_task(0, queue);
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+}
+
+TEST(encoder_worker, schedule_and_wait) {
+    EncoderWorker worker;
+    CHECK(worker.start());
+
+    RS8MEncoder encoder(config, PayloadSize, allocator);
+    CHECK(encoder.valid());
+
+    packet::ConcurrentQueue queue;
+
+    EncoderTask task(encoder, queue, NumSourcePackets, NumRepairPackets, allocator);
+    CHECK(task.valid());
+
+    for (size_t t = 0; t < NumTasks; t++) {
+        fill_task(task, t);
+        worker.schedule(task);
+        worker.wait(task);
+
+        CHECK(!worker.pending(task));
+        check_task(t, queue);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+
+    worker.stop();
+    worker.join();
+}
+
+TEST(encoder_worker, stop_encodes_scheduled_tasks) {
+    EncoderWorker worker;
+    CHECK(worker.start());
+
+    RS8MEncoder encoder0(config, PayloadSize, allocator);
+    RS8MEncoder encoder1(config, PayloadSize, allocator);
+    RS8MEncoder encoder2(config, PayloadSize, allocator);
+    RS8MEncoder encoder3(config, PayloadSize, allocator);
+
+    packet::ConcurrentQueue queue;
+
+    EncoderTask task0(encoder0, queue, NumSourcePackets, NumRepairPackets, allocator);
+    EncoderTask task1(encoder1, queue, NumSourcePackets, NumRepairPackets, allocator);
+    EncoderTask task2(encoder2, queue, NumSourcePackets, NumRepairPackets, allocator);
+    EncoderTask task3(encoder3, queue, NumSourcePackets, NumRepairPackets, allocator);
+
+    EncoderTask* tasks[NumTasks] = { &task0, &task1, &task2, &task3 };
+
+    for (size_t t = 0; t < NumTasks; t++) {
+        fill_task(*tasks[t], t);
+        worker.schedule(*tasks[t]);
+    }
+
+    worker.stop();
+    worker.join();
+
+    for (size_t t = 0; t < NumTasks; t++) {
+        CHECK(!worker.pending(*tasks[t]));
+        check_task(t, queue);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/random.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxRegion = 300, MatrixSize = 8 };
+
+// Bitwise multiplication modulo x^8 + x^4 + x^3 + x^2 + 1.
+uint8_t slow_mul(uint8_t a, uint8_t b) {
+    unsigned res = 0;
+    unsigned x = a;
+    for (unsigned bit = 0; bit < 8; bit++) {
+        if (b & (1 << bit)) {
+            res ^= x;
+        }
+        x <<= 1;
+        if (x & 0x100) {
+            x ^= 0x11d;
+        }
+    }
+    return (uint8_t)res;
+}
+
+} // namespace
+
+TEST_GROUP(gf256) {};
+
+TEST(gf256, mul) {
+    for (unsigned a = 0; a < 256; a++) {
+        for (unsigned b = 0; b < 256; b++) {
+            UNSIGNED_LONGS_EQUAL(slow_mul((uint8_t)a, (uint8_t)b),
+                                 gf256_mul((uint8_t)a, (uint8_t)b));
+        }
+    }
+}
+
+TEST(gf256, inv) {
+    for (unsigned a = 1; a < 256; a++) {
+        UNSIGNED_LONGS_EQUAL(1, gf256_mul((uint8_t)a, gf256_inv((uint8_t)a)));
+    }
+}
+
+TEST(gf256, exp) {
+    UNSIGNED_LONGS_EQUAL(1, gf256_exp(0));
+    UNSIGNED_LONGS_EQUAL(2, gf256_exp(1));
+    UNSIGNED_LONGS_EQUAL(0x1d, gf256_exp(8));
+    UNSIGNED_LONGS_EQUAL(1, gf256_exp(255));
+    UNSIGNED_LONGS_EQUAL(gf256_exp(3), gf256_exp(255 * 4 + 3));
+}
+
+TEST(gf256, mul_region) {
+    uint8_t src[MaxRegion];
+    uint8_t dst[MaxRegion];
+    uint8_t orig[MaxRegion];
+
+    for (size_t size = 0; size < MaxRegion; size += 7) {
+        const uint8_t c = (uint8_t)core::random(0, 0xff);
+
+        for (size_t i = 0; i < size; i++) {
+            src[i] = (uint8_t)core::random(0, 0xff);
+            dst[i] = orig[i] = (uint8_t)core::random(0, 0xff);
+        }
+
+        gf256_mul_region(dst, src, c, size);
+
+        for (size_t i = 0; i < size; i++) {
+            UNSIGNED_LONGS_EQUAL(slow_mul(c, src[i]), dst[i]);
+        }
+
+        for (size_t i = 0; i < size; i++) {
+            dst[i] = orig[i];
+        }
+
+        gf256_mul_add_region(dst, src, c, size);
+
+        for (size_t i = 0; i < size; i++) {
+            UNSIGNED_LONGS_EQUAL(orig[i] ^ slow_mul(c, src[i]), dst[i]);
+        }
+    }
+}
+
+TEST(gf256, invert_matrix) {
+    uint8_t matrix[MatrixSize * MatrixSize];
+    uint8_t inverse[MatrixSize * MatrixSize];
+    uint8_t temp[MatrixSize * MatrixSize];
+
+    // Vandermonde matrix is never singular.
+    for (size_t row = 0; row < MatrixSize; row++) {
+        for (size_t col = 0; col < MatrixSize; col++) {
+            matrix[row * MatrixSize + col] = inverse[row * MatrixSize + col] =
+                gf256_exp(row * col);
+        }
+    }
+
+    CHECK(gf256_invert_matrix(inverse, temp, MatrixSize));
+
+    for (size_t row = 0; row < MatrixSize; row++) {
+        for (size_t col = 0; col < MatrixSize; col++) {
+            uint8_t sum = 0;
+            for (size_t i = 0; i < MatrixSize; i++) {
+                sum ^= gf256_mul(matrix[row * MatrixSize + i],
+                                 inverse[i * MatrixSize + col]);
+            }
+            UNSIGNED_LONGS_EQUAL(row == col ? 1 : 0, sum);
+        }
+    }
+}
+
+TEST(gf256, invert_singular_matrix) {
+    uint8_t matrix[MatrixSize * MatrixSize];
+    uint8_t temp[MatrixSize * MatrixSize];
+
+    for (size_t n = 0; n < MatrixSize * MatrixSize; n++) {
+        matrix[n] = (uint8_t)(n % MatrixSize + 1);
+    }
+
+    CHECK(!gf256_invert_matrix(matrix, temp, MatrixSize));
+}
+
+} // namespace fec
+} // namespace roc
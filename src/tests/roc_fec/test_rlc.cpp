@@ -0,0 +1,582 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/rlc_coefficients.h"
+#include "roc_fec/rlc_decoder.h"
+#include "roc_fec/rlc_encoder.h"
+#include "roc_fec/rlc_reader.h"
+#include "roc_fec/rlc_writer.h"
+#include "roc_fec/tinymt32.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/queue.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum {
+    WindowSize = 10,
+    NumRepairPackets = 5,
+    NumSymbols = 60,
+    PayloadSize = 251,
+    MaxRepairSymbols = NumSymbols * NumRepairPackets / WindowSize
+};
+
+const unsigned SourceID = 555;
+const unsigned PayloadType = rtp::PayloadType_L16_Stereo;
+
+const size_t RTPPayloadSize = 177;
+const size_t FECPayloadSize = RTPPayloadSize + sizeof(rtp::Header);
+
+const size_t MaxBuffSize = 500;
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxBuffSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+rtp::FormatMap format_map;
+rtp::Parser rtp_parser(format_map, NULL);
+rtp::Composer rtp_composer(NULL);
+fec::Composer<RLC_Source_PayloadID, Source, Footer> source_composer(&rtp_composer);
+fec::Composer<RLC_Repair_PayloadID, Repair, Header> repair_composer(NULL);
+
+core::Slice<uint8_t> make_buffer(size_t size) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buf);
+    buf.resize(size);
+    return buf;
+}
+
+core::Slice<uint8_t> make_random_buffer() {
+    core::Slice<uint8_t> buf = make_buffer(PayloadSize);
+    for (size_t i = 0; i < buf.size(); ++i) {
+        buf.data()[i] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+// Passes packets to source and repair queues, dropping source packets
+// with given seqnums and repair packets with given numbers.
+class PacketDispatcher : public packet::IWriter {
+public:
+    PacketDispatcher()
+        : n_repair_(0) {
+        for (size_t i = 0; i < NumSymbols; i++) {
+            lost_source_[i] = false;
+            lost_repair_[i] = false;
+        }
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        if (pp->flags() & packet::Packet::FlagAudio) {
+            CHECK(pp->rtp());
+            if (!lost_source_[pp->rtp()->seqnum % NumSymbols]) {
+                source_queue_.write(pp);
+            }
+        } else if (pp->flags() & packet::Packet::FlagRepair) {
+            // Repair packets are composed by sender port. Reader needs the
+            // composed payload ID to get density threshold.
+            if (!(pp->flags() & packet::Packet::FlagComposed)) {
+                CHECK(repair_composer.compose(*pp));
+                pp->add_flags(packet::Packet::FlagComposed);
+            }
+            if (!lost_repair_[n_repair_++ % NumSymbols]) {
+                repair_queue_.write(pp);
+            }
+        } else {
+            FAIL("unexpected packet type");
+        }
+    }
+
+    packet::IReader& source_reader() {
+        return source_queue_;
+    }
+
+    packet::IReader& repair_reader() {
+        return repair_queue_;
+    }
+
+    size_t source_size() const {
+        return source_queue_.size();
+    }
+
+    size_t repair_size() const {
+        return repair_queue_.size();
+    }
+
+    void lose_source(size_t sn) {
+        lost_source_[sn] = true;
+    }
+
+    void lose_repair(size_t n) {
+        lost_repair_[n] = true;
+    }
+
+private:
+    bool lost_source_[NumSymbols];
+    bool lost_repair_[NumSymbols];
+    size_t n_repair_;
+
+    packet::Queue source_queue_;
+    packet::Queue repair_queue_;
+};
+
+} // namespace
+
+TEST_GROUP(rlc) {
+    Config config;
+
+    core::Slice<uint8_t> source[NumSymbols];
+    bool lost[NumSymbols];
+
+    core::Slice<uint8_t> repair[MaxRepairSymbols];
+    packet::blknum_t repair_first[MaxRepairSymbols];
+    size_t repair_n_source[MaxRepairSymbols];
+    size_t repair_end[MaxRepairSymbols];
+    size_t n_repair;
+
+    void setup() {
+        config.codec = RLC8m;
+        config.n_source_packets = WindowSize;
+        config.n_repair_packets = NumRepairPackets;
+
+        for (size_t i = 0; i < NumSymbols; i++) {
+            lost[i] = false;
+        }
+        n_repair = 0;
+    }
+
+    // Generate a repair symbol after every two source symbols.
+    void encode(RLCEncoder & encoder) {
+        for (size_t i = 0; i < NumSymbols; i++) {
+            source[i] = make_random_buffer();
+            encoder.add(source[i]);
+
+            if (i % 2 == 0) {
+                continue;
+            }
+
+            CHECK(n_repair < MaxRepairSymbols);
+
+            repair[n_repair] = make_buffer(PayloadSize);
+            encoder.encode(uint16_t(n_repair), RLCDenseThreshold, repair[n_repair]);
+
+            repair_first[n_repair] = packet::blknum_t(i + 1 - encoder.window());
+            repair_n_source[n_repair] = encoder.window();
+            repair_end[n_repair] = i + 1;
+
+            n_repair++;
+        }
+    }
+
+    // Read symbols one by one, passing to decoder the symbols that are
+    // at most @p lookahead symbols ahead of the current one.
+    size_t decode(RLCDecoder & decoder, size_t lookahead) {
+        size_t n_fed_source = 0, n_fed_repair = 0, n_decoded = 0;
+
+        for (size_t i = 0; i < NumSymbols; i++) {
+            decoder.advance(packet::blknum_t(i));
+
+            for (; n_fed_source < NumSymbols && n_fed_source <= i + lookahead;
+                 n_fed_source++) {
+                if (!lost[n_fed_source]) {
+                    decoder.set_source(packet::blknum_t(n_fed_source),
+                                       source[n_fed_source]);
+                }
+            }
+
+            for (; n_fed_repair < n_repair && repair_end[n_fed_repair] <= n_fed_source;
+                 n_fed_repair++) {
+                decoder.set_repair(repair_first[n_fed_repair],
+                                   repair_n_source[n_fed_repair],
+                                   uint16_t(n_fed_repair), RLCDenseThreshold,
+                                   repair[n_fed_repair]);
+            }
+
+            core::Slice<uint8_t> decoded = decoder.repair(packet::blknum_t(i));
+            if (!decoded) {
+                continue;
+            }
+
+            UNSIGNED_LONGS_EQUAL(PayloadSize, decoded.size());
+            CHECK(memcmp(source[i].data(), decoded.data(), PayloadSize) == 0);
+
+            n_decoded++;
+        }
+
+        return n_decoded;
+    }
+
+    packet::PacketPtr fill_one_packet(size_t sn) {
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        CHECK(pp);
+
+        core::Slice<uint8_t> bp = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+        CHECK(bp);
+
+        CHECK(source_composer.prepare(*pp, bp, RTPPayloadSize));
+
+        pp->set_data(bp);
+
+        UNSIGNED_LONGS_EQUAL(RTPPayloadSize, pp->rtp()->payload.size());
+        UNSIGNED_LONGS_EQUAL(FECPayloadSize, pp->fec()->payload.size());
+
+        pp->add_flags(packet::Packet::FlagAudio);
+
+        pp->rtp()->source = SourceID;
+        pp->rtp()->payload_type = PayloadType;
+        pp->rtp()->seqnum = packet::seqnum_t(sn);
+        pp->rtp()->timestamp = packet::timestamp_t(sn * 10);
+
+        for (size_t i = 0; i < RTPPayloadSize; i++) {
+            pp->rtp()->payload.data()[i] = uint8_t(sn + i);
+        }
+
+        return pp;
+    }
+
+    void check_audio_packet(packet::PacketPtr pp, size_t sn) {
+        CHECK(pp);
+
+        CHECK(pp->flags() & packet::Packet::FlagRTP);
+        CHECK(pp->flags() & packet::Packet::FlagAudio);
+
+        CHECK(pp->rtp());
+        CHECK(pp->rtp()->header);
+        CHECK(pp->rtp()->payload);
+
+        UNSIGNED_LONGS_EQUAL(SourceID, pp->rtp()->source);
+
+        UNSIGNED_LONGS_EQUAL(sn, pp->rtp()->seqnum);
+        UNSIGNED_LONGS_EQUAL(packet::timestamp_t(sn * 10), pp->rtp()->timestamp);
+
+        UNSIGNED_LONGS_EQUAL(PayloadType, pp->rtp()->payload_type);
+        UNSIGNED_LONGS_EQUAL(RTPPayloadSize, pp->rtp()->payload.size());
+
+        for (size_t i = 0; i < RTPPayloadSize; i++) {
+            UNSIGNED_LONGS_EQUAL(uint8_t(sn + i), pp->rtp()->payload.data()[i]);
+        }
+    }
+};
+
+TEST(rlc, tinymt32) {
+    // First numbers generated with seed 1, from RFC 8682.
+    const uint32_t expected[] = { 2545341989u, 981918433u, 3715302833u, 2387538352u,
+                                  3591001365u };
+
+    TinyMT32 prng(1);
+
+    for (size_t i = 0; i < ROC_ARRAY_SIZE(expected); i++) {
+        UNSIGNED_LONGS_EQUAL(expected[i], prng.next());
+    }
+}
+
+TEST(rlc, coefficients) {
+    enum { NumCoefs = 100 };
+
+    for (uint16_t key = 0; key < 100; key++) {
+        uint8_t coefs1[NumCoefs];
+        uint8_t coefs2[NumCoefs];
+
+        rlc_coefficients(key, RLCDenseThreshold, coefs1, NumCoefs);
+        rlc_coefficients(key, RLCDenseThreshold, coefs2, NumCoefs);
+
+        CHECK(memcmp(coefs1, coefs2, NumCoefs) == 0);
+
+        for (size_t i = 0; i < NumCoefs; i++) {
+            CHECK(coefs1[i] != 0);
+        }
+
+        size_t n_zeros = 0;
+
+        rlc_coefficients(key, 0, coefs1, NumCoefs);
+        for (size_t i = 0; i < NumCoefs; i++) {
+            if (coefs1[i] == 0) {
+                n_zeros++;
+            }
+        }
+
+        CHECK(n_zeros > 0);
+        CHECK(n_zeros < NumCoefs);
+    }
+}
+
+TEST(rlc, invalid_config) {
+    config.n_source_packets = 0;
+
+    RLCEncoder encoder1(config, PayloadSize, allocator);
+    RLCDecoder decoder1(config, PayloadSize, buffer_pool, allocator);
+
+    CHECK(!encoder1.valid());
+    CHECK(!decoder1.valid());
+
+    config.n_source_packets = RLCMaxWindow + 1;
+
+    RLCEncoder encoder2(config, PayloadSize, allocator);
+    RLCDecoder decoder2(config, PayloadSize, buffer_pool, allocator);
+
+    CHECK(!encoder2.valid());
+    CHECK(!decoder2.valid());
+
+    config.n_source_packets = WindowSize;
+    config.codec = ReedSolomon8m;
+
+    RLCEncoder encoder3(config, PayloadSize, allocator);
+    RLCDecoder decoder3(config, PayloadSize, buffer_pool, allocator);
+
+    CHECK(!encoder3.valid());
+    CHECK(!decoder3.valid());
+}
+
+TEST(rlc, encoder_window) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    CHECK(encoder.valid());
+
+    UNSIGNED_LONGS_EQUAL(WindowSize, encoder.max_window());
+    UNSIGNED_LONGS_EQUAL(0, encoder.window());
+
+    for (size_t i = 0; i < WindowSize * 2; i++) {
+        encoder.add(make_random_buffer());
+
+        UNSIGNED_LONGS_EQUAL(i < WindowSize ? i + 1 : (size_t)WindowSize,
+                             encoder.window());
+    }
+
+    encoder.reset();
+    UNSIGNED_LONGS_EQUAL(0, encoder.window());
+}
+
+TEST(rlc, no_losses) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    encode(encoder);
+
+    UNSIGNED_LONGS_EQUAL(NumSymbols, decode(decoder, 0));
+}
+
+TEST(rlc, single_losses) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    for (size_t i = 3; i < NumSymbols; i += 7) {
+        lost[i] = true;
+    }
+
+    encode(encoder);
+
+    // Every loss is repaired by the next repair symbol, which is at most
+    // two symbols ahead.
+    UNSIGNED_LONGS_EQUAL(NumSymbols, decode(decoder, 2));
+}
+
+TEST(rlc, multiple_losses) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    // Three losses in a row and more losses inside the same window.
+    lost[11] = true;
+    lost[12] = true;
+    lost[13] = true;
+    lost[17] = true;
+
+    lost[40] = true;
+    lost[42] = true;
+    lost[44] = true;
+
+    encode(encoder);
+
+    UNSIGNED_LONGS_EQUAL(NumSymbols, decode(decoder, WindowSize - 1));
+}
+
+TEST(rlc, too_many_losses) {
+    RLCEncoder encoder(config, PayloadSize, allocator);
+    RLCDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    // More losses than repair symbols covering them.
+    for (size_t i = 20; i < 20 + WindowSize; i++) {
+        lost[i] = true;
+    }
+
+    encode(encoder);
+
+    const size_t n_decoded = decode(decoder, WindowSize - 1);
+
+    CHECK(n_decoded >= NumSymbols - WindowSize);
+    CHECK(n_decoded < NumSymbols);
+}
+
+TEST(rlc, composer_overhead) {
+    UNSIGNED_LONGS_EQUAL(sizeof(RLC_Source_PayloadID) + sizeof(rtp::Header),
+                         source_composer.overhead());
+    UNSIGNED_LONGS_EQUAL(sizeof(RLC_Repair_PayloadID), repair_composer.overhead());
+}
+
+TEST(rlc, writer_reader_no_losses) {
+    RLCEncoder encoder(config, FECPayloadSize, allocator);
+    RLCDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    PacketDispatcher dispatcher;
+
+    RLCWriter writer(config, FECPayloadSize, encoder, dispatcher, source_composer,
+                     repair_composer, packet_pool, buffer_pool);
+
+    RLCReader reader(config, decoder, dispatcher.source_reader(),
+                     dispatcher.repair_reader(), rtp_parser, packet_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    for (size_t i = 0; i < NumSymbols; ++i) {
+        writer.write(fill_one_packet(i));
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumSymbols, dispatcher.source_size());
+    UNSIGNED_LONGS_EQUAL(NumSymbols * NumRepairPackets / WindowSize,
+                         dispatcher.repair_size());
+
+    for (size_t i = 0; i < NumSymbols; ++i) {
+        check_audio_packet(reader.read(), i);
+    }
+
+    CHECK(reader.started());
+    CHECK(reader.alive());
+    CHECK(!reader.read());
+}
+
+TEST(rlc, writer_reader_losses) {
+    RLCEncoder encoder(config, FECPayloadSize, allocator);
+    RLCDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    PacketDispatcher dispatcher;
+
+    RLCWriter writer(config, FECPayloadSize, encoder, dispatcher, source_composer,
+                     repair_composer, packet_pool, buffer_pool);
+
+    RLCReader reader(config, decoder, dispatcher.source_reader(),
+                     dispatcher.repair_reader(), rtp_parser, packet_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    dispatcher.lose_source(5);
+    dispatcher.lose_source(21);
+    dispatcher.lose_source(22);
+    dispatcher.lose_source(38);
+    dispatcher.lose_repair(19);
+
+    for (size_t i = 0; i < NumSymbols; ++i) {
+        writer.write(fill_one_packet(i));
+    }
+
+    for (size_t i = 0; i < NumSymbols; ++i) {
+        check_audio_packet(reader.read(), i);
+    }
+
+    CHECK(reader.alive());
+    CHECK(!reader.read());
+}
+
+TEST(rlc, writer_reader_repair_early) {
+    RLCEncoder encoder(config, FECPayloadSize, allocator);
+    RLCDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    PacketDispatcher dispatcher;
+
+    RLCWriter writer(config, FECPayloadSize, encoder, dispatcher, source_composer,
+                     repair_composer, packet_pool, buffer_pool);
+
+    RLCReader reader(config, decoder, dispatcher.source_reader(),
+                     dispatcher.repair_reader(), rtp_parser, packet_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    dispatcher.lose_source(3);
+
+    // The lost packet is repaired by the repair packet sent right after it,
+    // long before the encoding window is filled.
+    for (size_t i = 0; i < 5; ++i) {
+        writer.write(fill_one_packet(i));
+    }
+
+    for (size_t i = 0; i < 5; ++i) {
+        check_audio_packet(reader.read(), i);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(rlc, writer_reader_first_packet_lost) {
+    RLCEncoder encoder(config, FECPayloadSize, allocator);
+    RLCDecoder decoder(config, FECPayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    PacketDispatcher dispatcher;
+
+    RLCWriter writer(config, FECPayloadSize, encoder, dispatcher, source_composer,
+                     repair_composer, packet_pool, buffer_pool);
+
+    RLCReader reader(config, decoder, dispatcher.source_reader(),
+                     dispatcher.repair_reader(), rtp_parser, packet_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    dispatcher.lose_source(0);
+
+    for (size_t i = 0; i < NumSymbols; ++i) {
+        writer.write(fill_one_packet(i));
+    }
+
+    // Reader starts from the first received packet.
+    for (size_t i = 1; i < NumSymbols; ++i) {
+        check_audio_packet(reader.read(), i);
+    }
+
+    CHECK(!reader.read());
+}
+
+} // namespace fec
+} // namespace roc
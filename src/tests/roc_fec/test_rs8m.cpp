@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_fec/rs8m_matrix.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { NumSourcePackets = 20, NumRepairPackets = 10, PayloadSize = 251 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, true);
+
+core::Slice<uint8_t> make_buffer(size_t size) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buf);
+    buf.resize(size);
+    return buf;
+}
+
+core::Slice<uint8_t> make_random_buffer() {
+    core::Slice<uint8_t> buf = make_buffer(PayloadSize);
+    for (size_t i = 0; i < buf.size(); ++i) {
+        buf.data()[i] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+} // namespace
+
+TEST_GROUP(rs8m) {
+    Config config;
+
+    core::Slice<uint8_t> buffers[NumSourcePackets + NumRepairPackets];
+
+    void setup() {
+        config.codec = ReedSolomon8m;
+        config.n_source_packets = NumSourcePackets;
+        config.n_repair_packets = NumRepairPackets;
+    }
+
+    void encode(RS8MEncoder & encoder) {
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            buffers[i] = make_random_buffer();
+            encoder.set(i, buffers[i]);
+        }
+        encoder.commit();
+        encoder.reset();
+    }
+
+    bool decode(RS8MDecoder & decoder) {
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            core::Slice<uint8_t> decoded = decoder.repair(i);
+            if (!decoded) {
+                return false;
+            }
+
+            UNSIGNED_LONGS_EQUAL(PayloadSize, decoded.size());
+
+            if (memcmp(buffers[i].data(), decoded.data(), PayloadSize) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Coefficients and symbols were computed using an independent implementation
+// of the generator matrix construction used by OpenFEC.
+TEST(rs8m, matrix) {
+    enum { K = 3, R = 3 };
+
+    const uint8_t expected[R][K] = {
+        { 15, 8, 6 },
+        { 45, 48, 28 },
+        { 153, 224, 120 },
+    };
+
+    RS8MMatrix matrix(K, R, allocator);
+    CHECK(matrix.valid());
+
+    for (size_t i = 0; i < K; ++i) {
+        for (size_t j = 0; j < K; ++j) {
+            UNSIGNED_LONGS_EQUAL(i == j ? 1 : 0, matrix.row(i)[j]);
+        }
+    }
+
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < K; ++j) {
+            UNSIGNED_LONGS_EQUAL(expected[i][j], matrix.row(K + i)[j]);
+        }
+    }
+}
+
+TEST(rs8m, repair_symbols) {
+    enum { K = 3, R = 3, Size = 8 };
+
+    const uint8_t source[K][Size] = {
+        { 1, 14, 27, 40, 53, 66, 79, 92 },
+        { 8, 21, 34, 47, 60, 73, 86, 99 },
+        { 15, 28, 41, 54, 67, 80, 93, 106 },
+    };
+
+    const uint8_t expected[R][Size] = {
+        { 109, 186, 98, 84, 84, 118, 235, 13 },
+        { 4, 1, 157, 205, 249, 106, 32, 10 },
+        { 88, 229, 199, 139, 136, 15, 121, 7 },
+    };
+
+    config.n_source_packets = K;
+    config.n_repair_packets = R;
+
+    RS8MEncoder encoder(config, Size, allocator);
+    CHECK(encoder.valid());
+
+    for (size_t i = 0; i < K; ++i) {
+        core::Slice<uint8_t> buf = make_buffer(Size);
+        memcpy(buf.data(), source[i], Size);
+        encoder.set(i, buf);
+    }
+
+    core::Slice<uint8_t> repair[R];
+    for (size_t i = 0; i < R; ++i) {
+        repair[i] = make_buffer(Size);
+        encoder.set(K + i, repair[i]);
+    }
+
+    encoder.commit();
+
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < Size; ++j) {
+            UNSIGNED_LONGS_EQUAL(expected[i][j], repair[i].data()[j]);
+        }
+    }
+}
+
+TEST(rs8m, invalid_config) {
+    config.n_source_packets = 200;
+    config.n_repair_packets = 56;
+
+    RS8MEncoder encoder(config, PayloadSize, allocator);
+    CHECK(!encoder.valid());
+
+    RS8MDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+    CHECK(!decoder.valid());
+
+    config.n_repair_packets = 55;
+    config.codec = LDPCStaircase;
+
+    RS8MEncoder ldpc_encoder(config, PayloadSize, allocator);
+    CHECK(!ldpc_encoder.valid());
+}
+
+TEST(rs8m, without_loss) {
+    RS8MEncoder encoder(config, PayloadSize, allocator);
+    RS8MDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    encode(encoder);
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        decoder.set(i, buffers[i]);
+    }
+
+    CHECK(decode(decoder));
+}
+
+TEST(rs8m, max_loss) {
+    RS8MEncoder encoder(config, PayloadSize, allocator);
+    RS8MDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    // Every window of NumRepairPackets lost packets, including only source,
+    // only repair, and mixed losses.
+    for (size_t first_lost = 0; first_lost <= NumSourcePackets; ++first_lost) {
+        encode(encoder);
+
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (i >= first_lost && i < first_lost + NumRepairPackets) {
+                continue;
+            }
+            decoder.set(i, buffers[i]);
+        }
+
+        CHECK(decode(decoder));
+        decoder.reset();
+    }
+}
+
+TEST(rs8m, random_loss) {
+    enum { NumIterations = 50 };
+
+    RS8MEncoder encoder(config, PayloadSize, allocator);
+    RS8MDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    for (size_t n = 0; n < NumIterations; ++n) {
+        encode(encoder);
+
+        size_t n_lost = 0;
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (n_lost < NumRepairPackets && core::random(0, 1) == 0) {
+                n_lost++;
+                continue;
+            }
+            decoder.set(i, buffers[i]);
+        }
+
+        CHECK(decode(decoder));
+        decoder.reset();
+    }
+}
+
+TEST(rs8m, too_much_loss) {
+    RS8MEncoder encoder(config, PayloadSize, allocator);
+    RS8MDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    for (size_t i = NumRepairPackets + 1; i < NumSourcePackets + NumRepairPackets;
+         ++i) {
+        decoder.set(i, buffers[i]);
+    }
+
+    for (size_t i = 0; i <= NumRepairPackets; ++i) {
+        CHECK(!decoder.repair(i));
+    }
+
+    // Receiving one more packet makes the block recoverable.
+    decoder.set(0, buffers[0]);
+
+    CHECK(decode(decoder));
+}
+
+TEST(rs8m, short_source_buffer) {
+    enum { ShortSize = PayloadSize / 2 };
+
+    RS8MEncoder encoder(config, PayloadSize, allocator);
+    RS8MDecoder decoder(config, PayloadSize, buffer_pool, allocator);
+
+    encode(encoder);
+
+    // Short buffers are encoded as if they were padded with zeros.
+    memset(buffers[0].data() + ShortSize, 0, PayloadSize - ShortSize);
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+        encoder.set(i, i == 0 ? buffers[0].range(0, ShortSize) : buffers[i]);
+    }
+    encoder.commit();
+    encoder.reset();
+
+    for (size_t i = 1; i < NumSourcePackets + NumRepairPackets; ++i) {
+        decoder.set(i, buffers[i]);
+    }
+
+    CHECK(decode(decoder));
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include "roc/context.h"
+#include "roc/receiver.h"
+
+namespace roc {
+
+namespace {
+
+const unsigned long long Millisecond = 1000000;
+
+} // namespace
+
+TEST_GROUP(config) {
+    roc_context_config context_conf;
+    roc_receiver_config receiver_conf;
+
+    roc_context* context;
+
+    void setup() {
+        memset(&context_conf, 0, sizeof(context_conf));
+
+        context = roc_context_open(&context_conf);
+        CHECK(context);
+
+        memset(&receiver_conf, 0, sizeof(receiver_conf));
+        receiver_conf.frame_sample_rate = 44100;
+        receiver_conf.frame_channels = ROC_CHANNEL_SET_STEREO;
+        receiver_conf.frame_encoding = ROC_FRAME_ENCODING_PCM_FLOAT;
+        receiver_conf.resampler_profile = ROC_RESAMPLER_DEFAULT;
+        receiver_conf.target_latency = 100 * Millisecond;
+        receiver_conf.adaptive_latency = 1;
+        receiver_conf.min_target_latency = 20 * Millisecond;
+        receiver_conf.max_target_latency = 500 * Millisecond;
+    }
+
+    void teardown() {
+        LONGS_EQUAL(0, roc_context_close(context));
+    }
+
+    bool receiver_opens() {
+        roc_receiver* receiver = roc_receiver_open(context, &receiver_conf);
+        if (!receiver) {
+            return false;
+        }
+        LONGS_EQUAL(0, roc_receiver_close(receiver));
+        return true;
+    }
+};
+
+TEST(config, adaptive_latency) {
+    CHECK(receiver_opens());
+}
+
+TEST(config, adaptive_latency_overrun_underrun) {
+    receiver_conf.max_latency_overrun = 400 * Millisecond;
+    receiver_conf.max_latency_underrun = 100 * Millisecond;
+
+    CHECK(receiver_opens());
+}
+
+TEST(config, adaptive_latency_small_overrun) {
+    // max latency is below max target latency
+    receiver_conf.max_latency_overrun = 300 * Millisecond;
+
+    CHECK(!receiver_opens());
+}
+
+TEST(config, adaptive_latency_small_underrun) {
+    // min latency is above min target latency
+    receiver_conf.max_latency_underrun = 50 * Millisecond;
+
+    CHECK(!receiver_opens());
+}
+
+} // namespace roc
@@ -26,6 +26,65 @@ TEST(context, open_close) {
     LONGS_EQUAL(0, roc_context_close(context));
 }
 
+TEST(context, register_format) {
+    roc_context_config config;
+    memset(&config, 0, sizeof(config));
+
+    roc_context* context = roc_context_open(&config);
+    CHECK(context);
+
+    roc_format format;
+    memset(&format, 0, sizeof(format));
+    format.payload_type = 100;
+    format.encoding = ROC_PACKET_ENCODING_AVP_L16;
+    format.sample_rate = 16000;
+    format.channels = ROC_CHANNEL_SET_MONO;
+
+    LONGS_EQUAL(0, roc_context_register_format(context, &format));
+
+    format.encoding = ROC_PACKET_ENCODING_FLOAT32;
+    format.channels = ROC_CHANNEL_SET_STEREO;
+
+    LONGS_EQUAL(0, roc_context_register_format(context, &format));
+
+    LONGS_EQUAL(0, roc_context_close(context));
+}
+
+TEST(context, register_format_invalid) {
+    roc_context_config config;
+    memset(&config, 0, sizeof(config));
+
+    roc_context* context = roc_context_open(&config);
+    CHECK(context);
+
+    roc_format format;
+    memset(&format, 0, sizeof(format));
+    format.payload_type = 100;
+    format.encoding = ROC_PACKET_ENCODING_AVP_L16;
+    format.sample_rate = 16000;
+    format.channels = ROC_CHANNEL_SET_STEREO;
+
+    LONGS_EQUAL(-1, roc_context_register_format(NULL, &format));
+    LONGS_EQUAL(-1, roc_context_register_format(context, NULL));
+
+    format.payload_type = 128;
+    LONGS_EQUAL(-1, roc_context_register_format(context, &format));
+    format.payload_type = 100;
+
+    format.sample_rate = 0;
+    LONGS_EQUAL(-1, roc_context_register_format(context, &format));
+    format.sample_rate = 16000;
+
+    format.channels = (roc_channel_set)0;
+    LONGS_EQUAL(-1, roc_context_register_format(context, &format));
+    format.channels = ROC_CHANNEL_SET_STEREO;
+
+    format.encoding = (roc_packet_encoding)0;
+    LONGS_EQUAL(-1, roc_context_register_format(context, &format));
+
+    LONGS_EQUAL(0, roc_context_close(context));
+}
+
 TEST(context, close_null) {
     LONGS_EQUAL(-1, roc_context_close(NULL));
 }
@@ -418,7 +418,32 @@ TEST(sender_receiver, simple) {
     sender.join();
 }
 
-#ifdef ROC_TARGET_OPENFEC
+TEST(sender_receiver, registered_format) {
+    enum { DynamicPayloadType = 120 };
+
+    Context context;
+
+    roc_format format;
+    memset(&format, 0, sizeof(format));
+    format.payload_type = DynamicPayloadType;
+    format.encoding = ROC_PACKET_ENCODING_AVP_L16;
+    format.sample_rate = SampleRate;
+    format.channels = ROC_CHANNEL_SET_STEREO;
+
+    CHECK(roc_context_register_format(context.get(), &format) == 0);
+
+    sender_conf.packet_payload_type = DynamicPayloadType;
+
+    Receiver receiver(context, receiver_conf, samples, TotalSamples, FrameSamples);
+
+    Sender sender(context, sender_conf, receiver.source_addr(), receiver.repair_addr(),
+                  samples, TotalSamples, FrameSamples);
+
+    sender.start();
+    receiver.run();
+    sender.join();
+}
+
 TEST(sender_receiver, losses) {
     Context context;
 
@@ -438,6 +463,5 @@ TEST(sender_receiver, losses) {
 
     proxy.stop();
 }
-#endif // ROC_TARGET_OPENFEC
 
 } // namespace roc
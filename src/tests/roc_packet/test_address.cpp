@@ -181,5 +181,36 @@ TEST(address, eq) {
     CHECK(addr1 != addr4);
 }
 
+TEST(address, eq_ipv6) {
+    Address addr1;
+    CHECK(parse_address("[2001:db8::1]:123", addr1));
+
+    Address addr2;
+    CHECK(parse_address("[2001:db8::1]:123", addr2));
+
+    Address addr3;
+    CHECK(parse_address("[2001:db8::2]:123", addr3));
+
+    CHECK(addr1 == addr2);
+    CHECK(!(addr1 == addr3));
+}
+
+TEST(address, hash) {
+    Address addr1;
+    CHECK(parse_address("1.2.3.4:123", addr1));
+
+    Address addr2;
+    CHECK(parse_address("1.2.3.4:123", addr2));
+
+    Address addr3;
+    CHECK(parse_address("[2001:db8::1]:123", addr3));
+
+    Address addr4;
+    CHECK(parse_address("[2001:db8::1]:123", addr4));
+
+    CHECK(addr1.hash() == addr2.hash());
+    CHECK(addr3.hash() == addr4.hash());
+}
+
 } // namespace packet
 } // namespace roc
@@ -11,6 +11,7 @@
 #include "roc_core/heap_allocator.h"
 #include "roc_packet/concurrent_queue.h"
 #include "roc_packet/packet_pool.h"
+#include "roc_packet/queue.h"
 
 namespace roc {
 namespace packet {
@@ -43,5 +44,102 @@ TEST(concurrent_queue, write_read) {
     CHECK(queue.read() == p2);
 }
 
+TEST(concurrent_queue, try_read) {
+    ConcurrentQueue queue;
+
+    CHECK(!queue.try_read());
+
+    PacketPtr p1 = new_packet();
+    PacketPtr p2 = new_packet();
+
+    queue.write(p1);
+    queue.write(p2);
+
+    CHECK(queue.try_read() == p1);
+    CHECK(queue.try_read() == p2);
+    CHECK(!queue.try_read());
+}
+
+TEST(concurrent_queue, read_until) {
+    ConcurrentQueue queue;
+
+    const core::nanoseconds_t start = core::timestamp();
+
+    CHECK(!queue.read_until(start + core::Millisecond));
+    CHECK(core::timestamp() >= start + core::Millisecond);
+
+    CHECK(!queue.read_until(start));
+
+    PacketPtr p1 = new_packet();
+    queue.write(p1);
+
+    CHECK(queue.read_until(start) == p1);
+}
+
+TEST(concurrent_queue, drain) {
+    ConcurrentQueue queue;
+    Queue out;
+
+    PacketPtr p1 = new_packet();
+    PacketPtr p2 = new_packet();
+    PacketPtr p3 = new_packet();
+
+    queue.write(p1);
+    queue.write(p2);
+    queue.write(p3);
+
+    UNSIGNED_LONGS_EQUAL(2, queue.drain(out, 2));
+    UNSIGNED_LONGS_EQUAL(1, queue.size());
+    UNSIGNED_LONGS_EQUAL(2, out.size());
+
+    UNSIGNED_LONGS_EQUAL(1, queue.drain(out, 0));
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+    UNSIGNED_LONGS_EQUAL(3, out.size());
+
+    UNSIGNED_LONGS_EQUAL(0, queue.drain(out, 0));
+
+    CHECK(out.read() == p1);
+    CHECK(out.read() == p2);
+    CHECK(out.read() == p3);
+}
+
+TEST(concurrent_queue, overflow_drop_newest) {
+    ConcurrentQueue queue(2, ConcurrentQueue::DropNewest);
+
+    PacketPtr p1 = new_packet();
+    PacketPtr p2 = new_packet();
+    PacketPtr p3 = new_packet();
+
+    queue.write(p1);
+    queue.write(p2);
+    queue.write(p3);
+
+    UNSIGNED_LONGS_EQUAL(2, queue.size());
+    UNSIGNED_LONGS_EQUAL(1, queue.num_dropped());
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+    CHECK(!queue.try_read());
+}
+
+TEST(concurrent_queue, overflow_drop_oldest) {
+    ConcurrentQueue queue(2, ConcurrentQueue::DropOldest);
+
+    PacketPtr p1 = new_packet();
+    PacketPtr p2 = new_packet();
+    PacketPtr p3 = new_packet();
+
+    queue.write(p1);
+    queue.write(p2);
+    queue.write(p3);
+
+    UNSIGNED_LONGS_EQUAL(2, queue.size());
+    UNSIGNED_LONGS_EQUAL(1, queue.num_dropped());
+
+    CHECK(queue.read() == p2);
+    CHECK(queue.read() == p3);
+    CHECK(!queue.try_read());
+}
+
 } // namespace packet
 } // namespace roc
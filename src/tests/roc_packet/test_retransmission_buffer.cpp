@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/queue.h"
+#include "roc_packet/retransmission_buffer.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { BufSize = 10, PayloadSize = 32, Ssrc = 0x1234 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, true);
+PacketPool pool(allocator, true);
+
+PacketPtr new_packet(seqnum_t sn) {
+    PacketPtr pp = new (pool) Packet(pool);
+    CHECK(pp);
+
+    core::Slice<uint8_t> data = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(data);
+
+    pp->add_flags(Packet::FlagRTP | Packet::FlagAudio | Packet::FlagComposed);
+    pp->rtp()->source = Ssrc;
+    pp->rtp()->seqnum = sn;
+    pp->set_data(data);
+
+    return pp;
+}
+
+} // namespace
+
+TEST_GROUP(retransmission_buffer) {};
+
+TEST(retransmission_buffer, pass_through) {
+    Queue queue;
+    RetransmissionBuffer rb(queue, pool, allocator, BufSize);
+    CHECK(rb.valid());
+
+    for (seqnum_t sn = 0; sn < BufSize * 3; sn++) {
+        PacketPtr pp = new_packet(sn);
+        rb.write(pp);
+        CHECK(queue.read() == pp);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+    UNSIGNED_LONGS_EQUAL(0, rb.num_resent());
+}
+
+TEST(retransmission_buffer, resend) {
+    Queue queue;
+    RetransmissionBuffer rb(queue, pool, allocator, BufSize);
+    CHECK(rb.valid());
+
+    PacketPtr packets[BufSize];
+
+    for (seqnum_t sn = 0; sn < BufSize; sn++) {
+        packets[sn] = new_packet(sn);
+        rb.write(packets[sn]);
+        CHECK(queue.read() == packets[sn]);
+    }
+
+    CHECK(rb.resend(Ssrc, 3));
+    CHECK(rb.resend(Ssrc, 7));
+
+    UNSIGNED_LONGS_EQUAL(2, rb.num_resent());
+    UNSIGNED_LONGS_EQUAL(2, queue.size());
+
+    const seqnum_t resent[] = { 3, 7 };
+
+    for (size_t n = 0; n < 2; n++) {
+        PacketPtr pp = queue.read();
+        CHECK(pp);
+
+        // new packet sharing the same data
+        CHECK(pp != packets[resent[n]]);
+        CHECK(pp->data().data() == packets[resent[n]]->data().data());
+        UNSIGNED_LONGS_EQUAL(packets[resent[n]]->data().size(), pp->data().size());
+
+        UNSIGNED_LONGS_EQUAL(packets[resent[n]]->flags(), pp->flags());
+        UNSIGNED_LONGS_EQUAL(Ssrc, pp->rtp()->source);
+        UNSIGNED_LONGS_EQUAL(resent[n], pp->rtp()->seqnum);
+    }
+}
+
+TEST(retransmission_buffer, overwritten) {
+    Queue queue;
+    RetransmissionBuffer rb(queue, pool, allocator, BufSize);
+    CHECK(rb.valid());
+
+    for (seqnum_t sn = 0; sn < BufSize + 3; sn++) {
+        rb.write(new_packet(sn));
+        CHECK(queue.read());
+    }
+
+    CHECK(!rb.resend(Ssrc, 0));
+    CHECK(!rb.resend(Ssrc, 2));
+    CHECK(rb.resend(Ssrc, 3));
+    CHECK(rb.resend(Ssrc, BufSize + 2));
+
+    // not written yet
+    CHECK(!rb.resend(Ssrc, BufSize * 2));
+
+    // other source
+    CHECK(!rb.resend(Ssrc + 1, 5));
+
+    UNSIGNED_LONGS_EQUAL(2, rb.num_resent());
+    UNSIGNED_LONGS_EQUAL(2, queue.size());
+}
+
+TEST(retransmission_buffer, not_composed) {
+    Queue queue;
+    RetransmissionBuffer rb(queue, pool, allocator, BufSize);
+    CHECK(rb.valid());
+
+    PacketPtr pp = new (pool) Packet(pool);
+    CHECK(pp);
+    pp->add_flags(Packet::FlagRTP | Packet::FlagAudio);
+    pp->rtp()->source = Ssrc;
+    pp->rtp()->seqnum = 1;
+
+    rb.write(pp);
+    CHECK(queue.read() == pp);
+
+    CHECK(!rb.resend(Ssrc, 1));
+    UNSIGNED_LONGS_EQUAL(0, queue.size());
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parser.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum { MaxBufSize = 2000, PayloadSize = 1024 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxBufSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+rtp::FormatMap format_map;
+
+core::Slice<uint8_t> compose_packet(packet::IComposer& composer) {
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    roc_panic_if(!pp);
+
+    core::Slice<uint8_t> buffer = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    roc_panic_if(!buffer);
+
+    if (!composer.prepare(*pp, buffer, PayloadSize)) {
+        roc_panic("bench parsers: can't prepare packet");
+    }
+
+    pp->set_data(buffer);
+
+    if (packet::RTP* rtp = pp->rtp()) {
+        rtp->source = 1;
+        rtp->seqnum = 2;
+        rtp->timestamp = 3;
+        rtp->payload_type = rtp::PayloadType_L16_Stereo;
+    }
+
+    if (packet::FEC* fec = pp->fec()) {
+        fec->source_block_number = 4;
+        fec->source_block_length = 20;
+        fec->encoding_symbol_id = 5;
+    }
+
+    if (!composer.compose(*pp)) {
+        roc_panic("bench parsers: can't compose packet");
+    }
+
+    return buffer;
+}
+
+void run_parser(benchmark::State& state,
+                packet::IComposer& composer,
+                packet::IParser& parser) {
+    const core::Slice<uint8_t> buffer = compose_packet(composer);
+
+    while (state.KeepRunning()) {
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        roc_panic_if(!pp);
+
+        if (!parser.parse(*pp, buffer)) {
+            state.SkipWithError("can't parse packet");
+            break;
+        }
+        benchmark::DoNotOptimize(pp.get());
+    }
+}
+
+// Inner RTP parser is called through packet::IParser.
+template <class PayloadID> void bench_source_chained(benchmark::State& state) {
+    rtp::Composer rtp_composer(NULL);
+    fec::Composer<PayloadID, fec::Source, fec::Footer> composer(&rtp_composer);
+
+    rtp::Parser rtp_parser(format_map, NULL);
+    fec::Parser<PayloadID, fec::Source, fec::Footer> parser(&rtp_parser);
+
+    run_parser(state, composer, parser);
+}
+
+// Inner RTP parser is called directly, as in ReceiverPort.
+template <class PayloadID> void bench_source_static(benchmark::State& state) {
+    rtp::Composer rtp_composer(NULL);
+    fec::Composer<PayloadID, fec::Source, fec::Footer> composer(&rtp_composer);
+
+    rtp::Parser rtp_parser(format_map, NULL);
+    fec::Parser<PayloadID, fec::Source, fec::Footer, rtp::Parser> parser(&rtp_parser);
+
+    run_parser(state, composer, parser);
+}
+
+template <class PayloadID> void bench_repair(benchmark::State& state) {
+    fec::Composer<PayloadID, fec::Repair, fec::Header> composer(NULL);
+
+    fec::Parser<PayloadID, fec::Repair, fec::Header> parser(NULL);
+
+    run_parser(state, composer, parser);
+}
+
+void BM_Parser_RTP(benchmark::State& state) {
+    rtp::Composer composer(NULL);
+    rtp::Parser parser(format_map, NULL);
+
+    run_parser(state, composer, parser);
+}
+
+void BM_Parser_RTP_RSm8_Source_Chained(benchmark::State& state) {
+    bench_source_chained<fec::RSm8_PayloadID>(state);
+}
+
+void BM_Parser_RTP_RSm8_Source_Static(benchmark::State& state) {
+    bench_source_static<fec::RSm8_PayloadID>(state);
+}
+
+void BM_Parser_RSm8_Repair(benchmark::State& state) {
+    bench_repair<fec::RSm8_PayloadID>(state);
+}
+
+void BM_Parser_RTP_LDPC_Source_Chained(benchmark::State& state) {
+    bench_source_chained<fec::LDPC_Source_PayloadID>(state);
+}
+
+void BM_Parser_RTP_LDPC_Source_Static(benchmark::State& state) {
+    bench_source_static<fec::LDPC_Source_PayloadID>(state);
+}
+
+void BM_Parser_LDPC_Repair(benchmark::State& state) {
+    bench_repair<fec::LDPC_Repair_PayloadID>(state);
+}
+
+void BM_Parser_RTP_RLC_Source_Chained(benchmark::State& state) {
+    bench_source_chained<fec::RLC_Source_PayloadID>(state);
+}
+
+void BM_Parser_RTP_RLC_Source_Static(benchmark::State& state) {
+    bench_source_static<fec::RLC_Source_PayloadID>(state);
+}
+
+void BM_Parser_RLC_Repair(benchmark::State& state) {
+    bench_repair<fec::RLC_Repair_PayloadID>(state);
+}
+
+} // namespace
+
+BENCHMARK(BM_Parser_RTP);
+BENCHMARK(BM_Parser_RTP_RSm8_Source_Chained);
+BENCHMARK(BM_Parser_RTP_RSm8_Source_Static);
+BENCHMARK(BM_Parser_RSm8_Repair);
+BENCHMARK(BM_Parser_RTP_LDPC_Source_Chained);
+BENCHMARK(BM_Parser_RTP_LDPC_Source_Static);
+BENCHMARK(BM_Parser_LDPC_Repair);
+BENCHMARK(BM_Parser_RTP_RLC_Source_Chained);
+BENCHMARK(BM_Parser_RTP_RLC_Source_Static);
+BENCHMARK(BM_Parser_RLC_Repair);
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/random.h"
+#include "roc_core/time.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/parse_address.h"
+#include "roc_pipeline/receiver.h"
+#include "roc_pipeline/sender.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum {
+    MaxBufSize = 4000,
+
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumCh = 2,
+
+    SamplesPerPacket = 220,
+
+    SourcePackets = 20,
+    RepairPackets = 10,
+
+    LossPercent = 5,
+
+    NumReads = 20000
+};
+
+core::HeapAllocator allocator;
+core::BufferPool<audio::sample_t> sample_buffer_pool(allocator, MaxBufSize, true);
+core::BufferPool<uint8_t> byte_buffer_pool(allocator, MaxBufSize, true);
+packet::PacketPool packet_pool(allocator, true);
+rtp::FormatMap format_map;
+
+// Passes packets from sender to receiver and randomly drops some of them.
+class LossyWriter : public packet::IWriter {
+public:
+    explicit LossyWriter(packet::IWriter& writer)
+        : writer_(writer) {
+    }
+
+    virtual void write(const packet::PacketPtr& pa) {
+        if (core::random(0, 99) < LossPercent) {
+            return;
+        }
+
+        // receiver expects packets that are not parsed yet
+        packet::PacketPtr pb = new (packet_pool) packet::Packet(packet_pool);
+        roc_panic_if(!pb);
+
+        pb->add_flags(packet::Packet::FlagUDP);
+        *pb->udp() = *pa->udp();
+        pb->set_data(pa->data());
+
+        writer_.write(pb);
+    }
+
+private:
+    packet::IWriter& writer_;
+};
+
+packet::Address make_address(const char* str) {
+    packet::Address addr;
+    if (!packet::parse_address(str, addr)) {
+        roc_panic("bench receiver fec: can't parse address");
+    }
+    return addr;
+}
+
+fec::Config make_fec_config() {
+    fec::Config config;
+    config.codec = fec::ReedSolomon8m;
+    config.backend = fec::BuiltinBackend;
+    config.n_source_packets = SourcePackets;
+    config.n_repair_packets = RepairPackets;
+    return config;
+}
+
+SenderConfig make_sender_config() {
+    SenderConfig config;
+
+    config.input_channels = ChMask;
+    config.input_sample_rate = SampleRate;
+    config.packet_length = SamplesPerPacket * core::Second / SampleRate;
+    config.internal_frame_size = MaxBufSize;
+    config.fec = make_fec_config();
+    config.resampling = false;
+    config.interleaving = false;
+    config.poisoning = false;
+    config.timing = false;
+
+    return config;
+}
+
+ReceiverConfig make_receiver_config() {
+    ReceiverConfig config;
+
+    config.output.sample_rate = SampleRate;
+    config.output.channels = ChMask;
+    config.output.internal_frame_size = MaxBufSize;
+    config.output.resampling = false;
+    config.output.timing = false;
+    config.output.poisoning = false;
+
+    config.default_session.channels = ChMask;
+    config.default_session.packet_length = SamplesPerPacket * core::Second / SampleRate;
+    config.default_session.target_latency =
+        SamplesPerPacket * SourcePackets * 2 * core::Second / SampleRate;
+    config.default_session.fec = make_fec_config();
+
+    return config;
+}
+
+// Measures worst-case time of receiver read with FEC and packet losses.
+// Every iteration writes and reads one packet worth of samples.
+void BM_ReceiverRead_FEC_Loss(benchmark::State& state) {
+    PortConfig source_port;
+    source_port.address = make_address("127.0.0.1:1");
+    source_port.protocol = Proto_RTP_RSm8_Source;
+
+    PortConfig repair_port;
+    repair_port.address = make_address("127.0.0.1:2");
+    repair_port.protocol = Proto_RSm8_Repair;
+
+    PortConfig control_port;
+
+    Receiver receiver(make_receiver_config(), format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+    roc_panic_if(!receiver.valid());
+    roc_panic_if(!receiver.add_port(source_port));
+    roc_panic_if(!receiver.add_port(repair_port));
+
+    LossyWriter writer(receiver);
+
+    Sender sender(make_sender_config(), source_port, writer, repair_port, writer,
+                  control_port, writer, NULL, format_map, packet_pool, byte_buffer_pool,
+                  sample_buffer_pool, allocator);
+    roc_panic_if(!sender.valid());
+
+    core::Slice<audio::sample_t> samples =
+        new (sample_buffer_pool) core::Buffer<audio::sample_t>(sample_buffer_pool);
+    roc_panic_if(!samples);
+    samples.resize(SamplesPerPacket * NumCh);
+
+    core::Array<core::nanoseconds_t> latencies(allocator);
+    roc_panic_if(!latencies.grow(NumReads));
+
+    // fill receiver latency before measuring
+    for (size_t n = 0; n < SourcePackets * 3; n++) {
+        audio::Frame frame(samples.data(), samples.size());
+        sender.write(frame);
+    }
+
+    while (state.KeepRunning()) {
+        for (size_t n = 0; n < samples.size(); n++) {
+            samples.data()[n] = (audio::sample_t)core::random(0, 100) / 100.0f;
+        }
+
+        audio::Frame send_frame(samples.data(), samples.size());
+        sender.write(send_frame);
+
+        audio::Frame recv_frame(samples.data(), samples.size());
+
+        const core::nanoseconds_t start = core::timestamp();
+        receiver.read(recv_frame);
+        latencies.push_back(core::timestamp() - start);
+    }
+
+    if (receiver.num_sessions() != 1) {
+        state.SkipWithError("receiver session is not running");
+        return;
+    }
+
+    std::sort(&latencies[0], &latencies[0] + latencies.size());
+
+    const size_t n = latencies.size();
+
+    state.counters["p50_us"] = double(latencies[n / 2]) / core::Microsecond;
+    state.counters["p99_us"] = double(latencies[n * 99 / 100]) / core::Microsecond;
+    state.counters["max_us"] = double(latencies[n - 1]) / core::Microsecond;
+}
+
+} // namespace
+
+BENCHMARK(BM_ReceiverRead_FEC_Loss)->Iterations(NumReads);
+
+} // namespace pipeline
+} // namespace roc
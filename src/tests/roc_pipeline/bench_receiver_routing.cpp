@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// Receiver routing benchmark.
+//
+// BM_ReceiverRouting measures receiver throughput in packets per second when
+// every session gets one packet per read. Besides routing, this includes
+// parsing and decoding of the packet and the session's share of mixing, which
+// don't depend on the number of sessions, so items_per_second should stay
+// roughly flat when the number of sessions grows. With many sessions, it
+// still slowly decreases, since the state of all sessions no longer fits
+// into the CPU cache.
+
+#include <benchmark/benchmark.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/time.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/parse_address.h"
+#include "roc_pipeline/receiver.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum {
+    MaxBufSize = 4000,
+
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumCh = 2,
+
+    SamplesPerPacket = 20,
+    LatencyPackets = 4,
+
+    MaxSessions = 1000
+};
+
+core::HeapAllocator allocator;
+core::BufferPool<audio::sample_t> sample_buffer_pool(allocator, MaxBufSize, true);
+core::BufferPool<uint8_t> byte_buffer_pool(allocator, MaxBufSize, true);
+packet::PacketPool packet_pool(allocator, true);
+rtp::FormatMap format_map;
+
+packet::Address make_address(size_t n) {
+    char str[64];
+    snprintf(str, sizeof(str), "127.0.%u.%u:%u", unsigned(n / 250 + 1),
+             unsigned(n % 250 + 1), unsigned(10000 + n));
+
+    packet::Address addr;
+    if (!packet::parse_address(str, addr)) {
+        roc_panic("bench receiver routing: can't parse address");
+    }
+    return addr;
+}
+
+// Sends packets of one session with increasing seqnums and timestamps.
+class SessionSender {
+public:
+    SessionSender()
+        : seqnum_(0)
+        , timestamp_(0) {
+    }
+
+    void init(size_t n, const packet::Address& dst_addr) {
+        src_addr_ = make_address(n);
+        dst_addr_ = dst_addr;
+
+        rtp::Composer composer(NULL);
+
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        roc_panic_if(!pp);
+
+        template_ = new (byte_buffer_pool) core::Buffer<uint8_t>(byte_buffer_pool);
+        roc_panic_if(!template_);
+
+        if (!composer.prepare(*pp, template_,
+                              SamplesPerPacket * NumCh * sizeof(int16_t))) {
+            roc_panic("bench receiver routing: can't prepare packet");
+        }
+        pp->set_data(template_);
+
+        pp->rtp()->source = packet::source_t(n + 1);
+        pp->rtp()->payload_type = rtp::PayloadType_L16_Stereo;
+        memset(pp->rtp()->payload.data(), 0x10, pp->rtp()->payload.size());
+
+        if (!composer.compose(*pp)) {
+            roc_panic("bench receiver routing: can't compose packet");
+        }
+    }
+
+    void write(packet::IWriter& writer) {
+        core::Slice<uint8_t> data =
+            new (byte_buffer_pool) core::Buffer<uint8_t>(byte_buffer_pool);
+        roc_panic_if(!data);
+
+        data.resize(template_.size());
+        memcpy(data.data(), template_.data(), template_.size());
+
+        rtp::Header& header = *(rtp::Header*)data.data();
+        header.set_seqnum(seqnum_);
+        header.set_timestamp(timestamp_);
+
+        seqnum_++;
+        timestamp_ += SamplesPerPacket;
+
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        roc_panic_if(!pp);
+
+        pp->add_flags(packet::Packet::FlagUDP);
+        pp->udp()->src_addr = src_addr_;
+        pp->udp()->dst_addr = dst_addr_;
+        pp->set_data(data);
+
+        writer.write(pp);
+    }
+
+private:
+    packet::Address src_addr_;
+    packet::Address dst_addr_;
+
+    core::Slice<uint8_t> template_;
+
+    packet::seqnum_t seqnum_;
+    packet::timestamp_t timestamp_;
+};
+
+ReceiverConfig make_receiver_config() {
+    ReceiverConfig config;
+
+    config.output.sample_rate = SampleRate;
+    config.output.channels = ChMask;
+    config.output.internal_frame_size = MaxBufSize;
+    config.output.resampling = false;
+    config.output.timing = false;
+    config.output.poisoning = false;
+
+    config.default_session.channels = ChMask;
+    config.default_session.packet_length =
+        SamplesPerPacket * core::Second / SampleRate;
+    config.default_session.target_latency =
+        SamplesPerPacket * LatencyPackets * core::Second / SampleRate;
+
+    return config;
+}
+
+// Argument: number of sessions.
+// Every iteration writes one packet to every session and reads one packet
+// worth of samples.
+void BM_ReceiverRouting(benchmark::State& state) {
+    const size_t n_sessions = (size_t)state.range(0);
+
+    PortConfig port;
+    port.address = make_address(MaxSessions);
+    port.protocol = Proto_RTP;
+
+    Receiver receiver(make_receiver_config(), format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+    roc_panic_if(!receiver.valid());
+    roc_panic_if(!receiver.add_port(port));
+
+    core::Array<SessionSender> senders(allocator);
+    roc_panic_if(!senders.resize(n_sessions));
+
+    for (size_t n = 0; n < n_sessions; n++) {
+        senders[n].init(n, port.address);
+    }
+
+    audio::sample_t samples[SamplesPerPacket * NumCh];
+
+    // create sessions and fill their latency before measuring
+    for (size_t p = 0; p < LatencyPackets; p++) {
+        for (size_t n = 0; n < n_sessions; n++) {
+            senders[n].write(receiver);
+        }
+        audio::Frame frame(samples, SamplesPerPacket * NumCh);
+        receiver.read(frame);
+    }
+
+    while (state.KeepRunning()) {
+        for (size_t n = 0; n < n_sessions; n++) {
+            senders[n].write(receiver);
+        }
+        audio::Frame frame(samples, SamplesPerPacket * NumCh);
+        receiver.read(frame);
+    }
+
+    if (receiver.num_sessions() != n_sessions) {
+        state.SkipWithError("receiver sessions are not running");
+        return;
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_sessions));
+}
+
+} // namespace
+
+BENCHMARK(BM_ReceiverRouting)
+    ->ArgName("sessions")
+    ->RangeMultiplier(10)
+    ->Range(1, MaxSessions)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/time.h"
+#include "roc_fec/encoder_worker.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_pipeline/sender.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum {
+    MaxBufSize = 4000,
+
+    SampleRate = 44100,
+    ChMask = 0x3,
+    NumCh = 2,
+
+    SamplesPerPacket = 220,
+
+    NumWrites = 4000
+};
+
+// Interval between writes. Smaller than packet length to make the benchmark
+// faster, but large enough for the worker to encode a block in background.
+const core::nanoseconds_t WriteInterval = 500 * core::Microsecond;
+
+core::HeapAllocator allocator;
+core::BufferPool<audio::sample_t> sample_buffer_pool(allocator, MaxBufSize, true);
+core::BufferPool<uint8_t> byte_buffer_pool(allocator, MaxBufSize, true);
+packet::PacketPool packet_pool(allocator, true);
+rtp::FormatMap format_map;
+
+class NullWriter : public packet::IWriter {
+public:
+    virtual void write(const packet::PacketPtr&) {
+    }
+};
+
+SenderConfig make_config(size_t n_source) {
+    SenderConfig config;
+
+    config.input_channels = ChMask;
+    config.input_sample_rate = SampleRate;
+    config.packet_length = SamplesPerPacket * core::Second / SampleRate;
+    config.internal_frame_size = MaxBufSize;
+
+    config.fec.codec = fec::ReedSolomon8m;
+    config.fec.backend = fec::BuiltinBackend;
+    config.fec.n_source_packets = n_source;
+    config.fec.n_repair_packets = n_source / 2;
+
+    config.resampling = false;
+    config.interleaving = false;
+    config.poisoning = false;
+    config.timing = false;
+
+    return config;
+}
+
+// Measures latency of every sender write. Each write produces one packet.
+// Writes are paced like in a real-time audio callback.
+// Arguments: number of source packets in FEC block.
+void bench_write(benchmark::State& state, bool async) {
+    PortConfig source_port;
+    source_port.protocol = Proto_RTP_RSm8_Source;
+
+    PortConfig repair_port;
+    repair_port.protocol = Proto_RSm8_Repair;
+
+    PortConfig control_port;
+
+    NullWriter writer;
+
+    fec::EncoderWorker fec_worker;
+    if (async && !fec_worker.start()) {
+        roc_panic("bench sender fec: can't start fec worker");
+    }
+
+    {
+        Sender sender(make_config((size_t)state.range(0)), source_port, writer,
+                      repair_port, writer, control_port, writer,
+                      async ? &fec_worker : NULL, format_map, packet_pool,
+                      byte_buffer_pool, sample_buffer_pool, allocator);
+        roc_panic_if(!sender.valid());
+
+        core::Slice<audio::sample_t> samples =
+            new (sample_buffer_pool) core::Buffer<audio::sample_t>(sample_buffer_pool);
+        roc_panic_if(!samples);
+        samples.resize(SamplesPerPacket * NumCh);
+
+        for (size_t n = 0; n < samples.size(); n++) {
+            samples.data()[n] = (audio::sample_t)(n % 100) / 100.0f;
+        }
+
+        core::Array<core::nanoseconds_t> latencies(allocator);
+        roc_panic_if(!latencies.grow(NumWrites));
+
+        core::nanoseconds_t next_write = core::timestamp();
+
+        while (state.KeepRunning()) {
+            audio::Frame frame(samples.data(), samples.size());
+
+            core::sleep_until(next_write);
+            next_write += WriteInterval;
+
+            const core::nanoseconds_t start = core::timestamp();
+            sender.write(frame);
+            latencies.push_back(core::timestamp() - start);
+        }
+
+        std::sort(&latencies[0], &latencies[0] + latencies.size());
+
+        const size_t n = latencies.size();
+
+        state.counters["p50_us"] = double(latencies[n / 2]) / core::Microsecond;
+        state.counters["p99_us"] = double(latencies[n * 99 / 100]) / core::Microsecond;
+        state.counters["max_us"] = double(latencies[n - 1]) / core::Microsecond;
+    }
+
+    if (async) {
+        fec_worker.stop();
+        fec_worker.join();
+    }
+}
+
+void BM_SenderWrite_FEC_Sync(benchmark::State& state) {
+    bench_write(state, false);
+}
+
+void BM_SenderWrite_FEC_Async(benchmark::State& state) {
+    bench_write(state, true);
+}
+
+} // namespace
+
+BENCHMARK(BM_SenderWrite_FEC_Sync)->Arg(20)->Arg(100)->Iterations(NumWrites);
+BENCHMARK(BM_SenderWrite_FEC_Async)->Arg(20)->Arg(100)->Iterations(NumWrites);
+
+} // namespace pipeline
+} // namespace roc
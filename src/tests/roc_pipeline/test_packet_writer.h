@@ -45,6 +45,7 @@ public:
         , timestamp_(0)
         , pt_(pt)
         , offset_(0)
+        , silent_(false)
         , corrupt_(false) {
     }
 
@@ -91,6 +92,10 @@ public:
         timestamp_ = timestamp;
     }
 
+    void set_silent(bool silent) {
+        silent_ = silent;
+    }
+
     void set_corrupt(bool corrupt) {
         corrupt_ = corrupt;
     }
@@ -141,7 +146,7 @@ private:
 
         audio::sample_t samples[MaxSamples];
         for (size_t n = 0; n < samples_per_packet * packet::num_channels(channels); n++) {
-            samples[n] = nth_sample(offset_++);
+            samples[n] = silent_ ? 0 : nth_sample(offset_++);
         }
 
         UNSIGNED_LONGS_EQUAL(
@@ -172,6 +177,7 @@ private:
 
     uint8_t offset_;
 
+    bool silent_;
     bool corrupt_;
 };
 
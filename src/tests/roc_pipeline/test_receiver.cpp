@@ -200,6 +200,39 @@ TEST(receiver, one_session_long_run) {
     }
 }
 
+TEST(receiver, planar_layout) {
+    config.output.internal_layout = audio::ChannelLayout_Planar;
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+    CHECK(receiver.add_port(port2));
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    PacketWriter packet_writer1(receiver, rtp_composer, pcm_encoder, packet_pool,
+                                byte_buffer_pool, PayloadType, src1, port1.address);
+
+    PacketWriter packet_writer2(receiver, rtp_composer, pcm_encoder, packet_pool,
+                                byte_buffer_pool, PayloadType, src2, port2.address);
+
+    packet_writer1.write_packets(Latency / SamplesPerPacket, SamplesPerPacket, ChMask);
+    packet_writer2.write_packets(Latency / SamplesPerPacket, SamplesPerPacket, ChMask);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 2);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, ChMask);
+        packet_writer2.write_packets(1, SamplesPerPacket, ChMask);
+    }
+}
+
 TEST(receiver, initial_latency) {
     Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
                       sample_buffer_pool, allocator);
@@ -287,6 +320,53 @@ TEST(receiver, timeout) {
     }
 }
 
+TEST(receiver, dtx_gap_longer_than_broken_playback_timeout) {
+    enum {
+        BrokenTimeout = Latency * 2,
+        KeepalivePackets = 20,
+        NumKeepalives = BrokenTimeout * 10 / (KeepalivePackets * SamplesPerPacket)
+    };
+
+    config.default_session.watchdog.broken_playback_timeout =
+        BrokenTimeout * core::Second / SampleRate;
+    config.default_session.watchdog.breakage_detection_window =
+        SamplesPerPacket * 2 * core::Second / SampleRate;
+
+    CHECK(KeepalivePackets * SamplesPerPacket < Timeout);
+    CHECK(NumKeepalives * KeepalivePackets * SamplesPerPacket > Timeout);
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket, ChMask);
+
+    // sender is silent and sends only silent keep-alive packets
+    packet_writer.set_silent(true);
+
+    packet::timestamp_t ts = Latency;
+
+    for (size_t nk = 0; nk < NumKeepalives; nk++) {
+        packet_writer.set_timestamp(ts);
+        packet_writer.write_packets(1, SamplesPerPacket, ChMask);
+
+        ts += KeepalivePackets * SamplesPerPacket;
+
+        for (size_t nf = 0; nf < KeepalivePackets * FramesPerPacket; nf++) {
+            audio::sample_t samples[SamplesPerFrame * NumCh];
+            audio::Frame frame(samples, SamplesPerFrame * NumCh);
+            receiver.read(frame);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+    }
+}
+
 TEST(receiver, initial_trim) {
     Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
                       sample_buffer_pool, allocator);
@@ -314,6 +394,141 @@ TEST(receiver, initial_trim) {
     }
 }
 
+TEST(receiver, max_receiver_packets) {
+    config.output.max_receiver_packets = Latency / SamplesPerPacket;
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    packet_writer.write_packets(Latency * 3 / SamplesPerPacket, SamplesPerPacket, ChMask);
+
+    UNSIGNED_LONGS_EQUAL(Latency * 2 / SamplesPerPacket,
+                         receiver.stats().num_dropped_source);
+    UNSIGNED_LONGS_EQUAL(0, receiver.stats().num_dropped_repair);
+
+    frame_reader.set_offset(Latency * 2 * NumCh);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+
+        packet_writer.write_packets(1, SamplesPerPacket, ChMask);
+    }
+
+    UNSIGNED_LONGS_EQUAL(Latency * 2 / SamplesPerPacket,
+                         receiver.stats().num_dropped_source);
+}
+
+TEST(receiver, max_receiver_packets_repair_first) {
+    enum { NumRepairPackets = 4 };
+
+    config.output.max_receiver_packets = Latency / SamplesPerPacket;
+
+    port2.protocol = Proto_RSm8_Repair;
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+    CHECK(receiver.add_port(port2));
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    PacketWriter repair_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port2.address);
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    repair_writer.write_packets(NumRepairPackets, SamplesPerPacket, ChMask);
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket, ChMask);
+
+    UNSIGNED_LONGS_EQUAL(0, receiver.stats().num_dropped_source);
+    UNSIGNED_LONGS_EQUAL(NumRepairPackets, receiver.stats().num_dropped_repair);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+
+        packet_writer.write_packets(1, SamplesPerPacket, ChMask);
+    }
+}
+
+TEST(receiver, max_session_packets) {
+    config.default_session.max_session_packets = Latency / SamplesPerPacket;
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    packet_writer.write_packets(Latency * 3 / SamplesPerPacket, SamplesPerPacket, ChMask);
+
+    UNSIGNED_LONGS_EQUAL(0, receiver.stats().num_dropped_source);
+
+    frame_reader.set_offset(Latency * 2 * NumCh);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+        }
+
+        packet_writer.write_packets(1, SamplesPerPacket, ChMask);
+    }
+
+    UNSIGNED_LONGS_EQUAL(Latency * 2 / SamplesPerPacket,
+                         receiver.stats().num_dropped_source);
+    UNSIGNED_LONGS_EQUAL(0, receiver.stats().num_dropped_repair);
+}
+
+// Session queue is not limited by default, since the number of packets needed
+// for the latency depends on the packet length.
+TEST(receiver, max_session_packets_unlimited_by_default) {
+    enum { NumPackets = 1000 };
+
+    Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    PacketWriter packet_writer(receiver, rtp_composer, pcm_encoder, packet_pool,
+                               byte_buffer_pool, PayloadType, src1, port1.address);
+
+    packet_writer.write_packets(NumPackets, SamplesPerPacket, ChMask);
+
+    frame_reader.read_samples(SamplesPerFrame * NumCh, 1);
+
+    UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+    UNSIGNED_LONGS_EQUAL(0, receiver.stats().num_dropped_source);
+    UNSIGNED_LONGS_EQUAL(0, receiver.stats().num_dropped_repair);
+}
+
 TEST(receiver, two_sessions_synchronous) {
     Receiver receiver(config, format_map, packet_pool, byte_buffer_pool,
                       sample_buffer_pool, allocator);
@@ -10,10 +10,14 @@
 
 #include "roc_core/buffer_pool.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_fec/encoder_worker.h"
 #include "roc_packet/packet_pool.h"
 #include "roc_packet/queue.h"
 #include "roc_pipeline/sender.h"
+#include "roc_rtcp/composer.h"
+#include "roc_rtcp/parser.h"
 #include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
 #include "roc_rtp/parser.h"
 #include "roc_rtp/pcm_decoder.h"
 
@@ -57,6 +61,7 @@ TEST_GROUP(sender) {
 
     PortConfig source_port;
     PortConfig repair_port;
+    PortConfig control_port;
 
     void setup() {
         source_port.address = new_address(1);
@@ -75,8 +80,9 @@ TEST_GROUP(sender) {
 TEST(sender, write) {
     packet::Queue queue;
 
-    Sender sender(config, source_port, queue, repair_port, queue, format_map, packet_pool,
-                  byte_buffer_pool, sample_buffer_pool, allocator);
+    Sender sender(config, source_port, queue, repair_port, queue, control_port, queue,
+                  NULL, format_map, packet_pool, byte_buffer_pool, sample_buffer_pool,
+                  allocator);
 
     CHECK(sender.valid());
 
@@ -105,8 +111,9 @@ TEST(sender, frame_size_small) {
 
     packet::Queue queue;
 
-    Sender sender(config, source_port, queue, repair_port, queue, format_map, packet_pool,
-                  byte_buffer_pool, sample_buffer_pool, allocator);
+    Sender sender(config, source_port, queue, repair_port, queue, control_port, queue,
+                  NULL, format_map, packet_pool, byte_buffer_pool, sample_buffer_pool,
+                  allocator);
 
     CHECK(sender.valid());
 
@@ -135,8 +142,9 @@ TEST(sender, frame_size_large) {
 
     packet::Queue queue;
 
-    Sender sender(config, source_port, queue, repair_port, queue, format_map, packet_pool,
-                  byte_buffer_pool, sample_buffer_pool, allocator);
+    Sender sender(config, source_port, queue, repair_port, queue, control_port, queue,
+                  NULL, format_map, packet_pool, byte_buffer_pool, sample_buffer_pool,
+                  allocator);
 
     CHECK(sender.valid());
 
@@ -156,5 +164,314 @@ TEST(sender, frame_size_large) {
     CHECK(!queue.read());
 }
 
+TEST(sender, max_packet_size) {
+    enum {
+        SamplesPerMaxPacket = 40,
+        MaxPacketSize = sizeof(rtp::Header) + SamplesPerMaxPacket * NumCh * 2 + 3,
+        MaxFrames = SamplesPerMaxPacket / SamplesPerFrame * 20
+    };
+
+    config.max_packet_size = MaxPacketSize;
+
+    packet::Queue queue;
+
+    Sender sender(config, source_port, queue, repair_port, queue, control_port, queue,
+                  NULL, format_map, packet_pool, byte_buffer_pool, sample_buffer_pool,
+                  allocator);
+
+    CHECK(sender.valid());
+
+    LONGS_EQUAL(SamplesPerMaxPacket,
+                packet::timestamp_from_ns(sender.packet_length(), SampleRate));
+
+    FrameWriter frame_writer(sender, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < MaxFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    UNSIGNED_LONGS_EQUAL(MaxFrames * SamplesPerFrame / SamplesPerMaxPacket,
+                         queue.size());
+
+    PacketReader packet_reader(queue, rtp_parser, pcm_decoder, packet_pool, PayloadType,
+                               source_port.address);
+
+    for (size_t np = 0; np < MaxFrames * SamplesPerFrame / SamplesPerMaxPacket; np++) {
+        packet_reader.read_packet(SamplesPerMaxPacket, ChMask);
+    }
+
+    CHECK(!queue.read());
+}
+
+TEST(sender, max_packet_size_fec_capture_timestamps) {
+    enum {
+        MaxPacketSize = 200,
+        SourcePackets = 5,
+        RepairPackets = 3,
+        MaxFrames = 200
+    };
+
+    source_port.protocol = Proto_RTP_RSm8_Source;
+    repair_port.address = new_address(2);
+    repair_port.protocol = Proto_RSm8_Repair;
+
+    config.fec.codec = fec::ReedSolomon8m;
+    config.fec.n_source_packets = SourcePackets;
+    config.fec.n_repair_packets = RepairPackets;
+    config.capture_timestamps = true;
+    config.max_packet_size = MaxPacketSize;
+
+    packet::Queue queue;
+
+    Sender sender(config, source_port, queue, repair_port, queue, control_port, queue,
+                  NULL, format_map, packet_pool, byte_buffer_pool, sample_buffer_pool,
+                  allocator);
+
+    CHECK(sender.valid());
+
+    FrameWriter frame_writer(sender, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < MaxFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    size_t n_source = 0, n_repair = 0;
+
+    while (packet::PacketPtr pp = queue.read()) {
+        CHECK(pp->data().size() <= MaxPacketSize);
+
+        if (pp->flags() & packet::Packet::FlagRepair) {
+            n_repair++;
+        } else {
+            n_source++;
+        }
+    }
+
+    CHECK(n_source >= SourcePackets);
+    CHECK(n_repair >= RepairPackets);
+}
+
+TEST(sender, fec_async_interleaving) {
+    enum { SourcePackets = 10, RepairPackets = 5, NumBlocks = 2 };
+
+    source_port.protocol = Proto_RTP_RSm8_Source;
+    repair_port.address = new_address(2);
+    repair_port.protocol = Proto_RSm8_Repair;
+
+    config.fec.codec = fec::ReedSolomon8m;
+    config.fec.n_source_packets = SourcePackets;
+    config.fec.n_repair_packets = RepairPackets;
+    config.interleaving = true;
+
+    fec::EncoderWorker fec_worker;
+    CHECK(fec_worker.start());
+
+    packet::Queue queue;
+
+    {
+        Sender sender(config, source_port, queue, repair_port, queue, control_port,
+                      queue, &fec_worker, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+        CHECK(sender.valid());
+
+        FrameWriter frame_writer(sender, sample_buffer_pool);
+
+        for (size_t nf = 0; nf < NumBlocks * SourcePackets * FramesPerPacket; nf++) {
+            frame_writer.write_samples(SamplesPerFrame * NumCh);
+        }
+
+        // interleaver block contains both source and repair packets, so all
+        // packets are released when the last block is written, without
+        // waiting for the worker
+        size_t n_source = 0, n_repair = 0;
+
+        while (packet::PacketPtr pp = queue.read()) {
+            if (pp->flags() & packet::Packet::FlagRepair) {
+                n_repair++;
+            } else {
+                n_source++;
+            }
+        }
+
+        UNSIGNED_LONGS_EQUAL(NumBlocks * SourcePackets, n_source);
+        UNSIGNED_LONGS_EQUAL(NumBlocks * RepairPackets, n_repair);
+    }
+
+    fec_worker.stop();
+    fec_worker.join();
+}
+
+TEST(sender, max_packet_size_too_small) {
+    config.max_packet_size = sizeof(rtp::Header) + NumCh * 2 - 1;
+
+    packet::Queue queue;
+
+    Sender sender(config, source_port, queue, repair_port, queue, control_port, queue,
+                  NULL, format_map, packet_pool, byte_buffer_pool, sample_buffer_pool,
+                  allocator);
+
+    CHECK(!sender.valid());
+}
+
+TEST(sender, max_packet_size_too_large) {
+    config.max_packet_size = MaxBufSize + 1;
+
+    packet::Queue queue;
+
+    Sender sender(config, source_port, queue, repair_port, queue, control_port, queue,
+                  NULL, format_map, packet_pool, byte_buffer_pool, sample_buffer_pool,
+                  allocator);
+
+    CHECK(!sender.valid());
+}
+
+TEST(sender, control_port) {
+    enum { ReportPackets = 10 };
+
+    control_port.address = new_address(3);
+    control_port.protocol = Proto_RTCP;
+
+    config.report_interval =
+        SamplesPerPacket * ReportPackets * core::Second / SampleRate;
+
+    packet::Queue queue;
+    packet::Queue control_queue;
+
+    Sender sender(config, source_port, queue, repair_port, queue, control_port,
+                  control_queue, NULL, format_map, packet_pool, byte_buffer_pool,
+                  sample_buffer_pool, allocator);
+
+    CHECK(sender.valid());
+
+    FrameWriter frame_writer(sender, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    UNSIGNED_LONGS_EQUAL(ManyFrames / FramesPerPacket, queue.size());
+    CHECK(control_queue.size() >= ManyFrames / FramesPerPacket / ReportPackets - 1);
+
+    packet::PacketPtr source_pp = queue.read();
+    CHECK(source_pp);
+    CHECK(source_pp->rtp());
+
+    rtcp::Parser rtcp_parser;
+
+    while (packet::PacketPtr pp = control_queue.read()) {
+        CHECK(pp->udp());
+        CHECK(pp->udp()->dst_addr == control_port.address);
+
+        rtcp::Report sr;
+        CHECK(rtcp_parser.parse_report(pp->data(), sr));
+
+        CHECK(sr.has_sender_info);
+        UNSIGNED_LONGS_EQUAL(source_pp->rtp()->source, sr.ssrc);
+        CHECK(sr.packet_count > 0);
+    }
+
+    rtcp::Report rr;
+    rr.num_reports = 1;
+    rr.reports[0].ssrc = source_pp->rtp()->source;
+    rr.reports[0].fraction_lost = 0.5f;
+    rr.reports[0].cumulative_lost = 7;
+
+    core::Slice<uint8_t> data =
+        new (byte_buffer_pool) core::Buffer<uint8_t>(byte_buffer_pool);
+    CHECK(data);
+
+    rtcp::Composer rtcp_composer;
+    CHECK(rtcp_composer.compose(data, rr));
+
+    packet::PacketPtr rr_pp = new (packet_pool) packet::Packet(packet_pool);
+    CHECK(rr_pp);
+    rr_pp->add_flags(packet::Packet::FlagUDP);
+    rr_pp->set_data(data);
+
+    UNSIGNED_LONGS_EQUAL(0, sender.stats().num_reports);
+
+    static_cast<packet::IWriter&>(sender).write(rr_pp);
+
+    UNSIGNED_LONGS_EQUAL(1, sender.stats().num_reports);
+    LONGS_EQUAL(7, sender.stats().cumulative_lost);
+    DOUBLES_EQUAL(0.5, (double)sender.stats().fraction_lost, 0.01);
+}
+
+TEST(sender, retransmission) {
+    enum { NumPackets = ManyFrames / FramesPerPacket, BufferedPackets = 8 };
+
+    control_port.address = new_address(3);
+    control_port.protocol = Proto_RTCP;
+
+    config.retransmission_buffer = BufferedPackets;
+
+    packet::Queue queue;
+    packet::Queue control_queue;
+
+    Sender sender(config, source_port, queue, repair_port, queue, control_port,
+                  control_queue, NULL, format_map, packet_pool, byte_buffer_pool,
+                  sample_buffer_pool, allocator);
+
+    CHECK(sender.valid());
+
+    FrameWriter frame_writer(sender, sample_buffer_pool);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame * NumCh);
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, queue.size());
+
+    packet::PacketPtr sent[NumPackets];
+    for (size_t np = 0; np < NumPackets; np++) {
+        sent[np] = queue.read();
+        CHECK(sent[np]);
+    }
+
+    rtcp::Report rr;
+    rr.nack.ssrc = sent[0]->rtp()->source;
+    rr.nack.num_seqnums = 3;
+    // too old, already evicted
+    rr.nack.seqnums[0] = sent[0]->rtp()->seqnum;
+    rr.nack.seqnums[1] = sent[NumPackets - 3]->rtp()->seqnum;
+    rr.nack.seqnums[2] = sent[NumPackets - 1]->rtp()->seqnum;
+
+    core::Slice<uint8_t> data =
+        new (byte_buffer_pool) core::Buffer<uint8_t>(byte_buffer_pool);
+    CHECK(data);
+
+    rtcp::Composer rtcp_composer;
+    CHECK(rtcp_composer.compose(data, rr));
+
+    packet::PacketPtr rr_pp = new (packet_pool) packet::Packet(packet_pool);
+    CHECK(rr_pp);
+    rr_pp->add_flags(packet::Packet::FlagUDP);
+    rr_pp->set_data(data);
+
+    static_cast<packet::IWriter&>(sender).write(rr_pp);
+
+    UNSIGNED_LONGS_EQUAL(2, queue.size());
+
+    for (size_t n = 1; n < 3; n++) {
+        packet::PacketPtr pp = queue.read();
+        CHECK(pp);
+
+        const size_t np = (n == 1 ? NumPackets - 3 : NumPackets - 1);
+
+        CHECK(pp->udp());
+        CHECK(pp->udp()->dst_addr == source_port.address);
+
+        CHECK(pp->data().data() == sent[np]->data().data());
+        UNSIGNED_LONGS_EQUAL(sent[np]->data().size(), pp->data().size());
+
+        packet::PacketPtr parsed = new (packet_pool) packet::Packet(packet_pool);
+        CHECK(parsed);
+        CHECK(rtp_parser.parse(*parsed, pp->data()));
+
+        UNSIGNED_LONGS_EQUAL(rr.nack.seqnums[n], parsed->rtp()->seqnum);
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -10,6 +10,8 @@
 
 #include "roc_core/buffer_pool.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_fec/encoder_worker.h"
+#include "roc_packet/concurrent_queue.h"
 #include "roc_packet/packet_pool.h"
 #include "roc_packet/queue.h"
 #include "roc_pipeline/receiver.h"
@@ -62,7 +64,16 @@ enum {
     FlagDropSource = (1 << 3),
 
     // drop all repair packets
-    FlagDropRepair = (1 << 4)
+    FlagDropRepair = (1 << 4),
+
+    // encode FEC blocks on background thread
+    FlagAsyncFEC = (1 << 5),
+
+    // use sliding window RLC instead of Reed-Solomon
+    FlagRLC = (1 << 6),
+
+    // add capture timestamps to source packets
+    FlagCaptureTimestamps = (1 << 7)
 };
 
 core::HeapAllocator allocator;
@@ -76,15 +87,29 @@ rtp::FormatMap format_map;
 TEST_GROUP(sender_receiver) {
     void send_receive(int flags, size_t num_sessions) {
         packet::Queue queue;
+        packet::ConcurrentQueue concurrent_queue;
+
+        // repair packets are written from another thread in async mode
+        packet::IWriter& sender_writer =
+            (flags & FlagAsyncFEC) ? (packet::IWriter&)concurrent_queue : queue;
 
         PortConfig source_port = source_port_config(flags);
         PortConfig repair_port = repair_port_config(flags);
+        PortConfig control_port;
+
+        fec::EncoderWorker fec_worker;
+        if (flags & FlagAsyncFEC) {
+            CHECK(fec_worker.start());
+        }
 
         Sender sender(sender_config(flags),
                       source_port,
-                      queue,
+                      sender_writer,
                       repair_port,
-                      queue,
+                      sender_writer,
+                      control_port,
+                      sender_writer,
+                      (flags & FlagAsyncFEC) ? &fec_worker : NULL,
                       format_map,
                       packet_pool,
                       byte_buffer_pool,
@@ -111,6 +136,13 @@ TEST_GROUP(sender_receiver) {
             frame_writer.write_samples(SamplesPerFrame * NumCh);
         }
 
+        if (flags & FlagAsyncFEC) {
+            fec_worker.stop();
+            fec_worker.join();
+
+            concurrent_queue.drain(queue, 0);
+        }
+
         PacketSender packet_sender(packet_pool, receiver);
 
         filter_packets(flags, queue, packet_sender);
@@ -155,14 +187,23 @@ TEST_GROUP(sender_receiver) {
     PortConfig source_port_config(int flags) {
         PortConfig port;
         port.address = new_address(1);
-        port.protocol = (flags & FlagFEC) ? Proto_RTP_RSm8_Source : Proto_RTP;
+        if (flags & FlagFEC) {
+            port.protocol =
+                (flags & FlagRLC) ? Proto_RTP_RLC_Source : Proto_RTP_RSm8_Source;
+        } else {
+            port.protocol = Proto_RTP;
+        }
         return port;
     }
 
     PortConfig repair_port_config(int flags) {
         PortConfig port;
         port.address = new_address(2);
-        port.protocol = (flags & FlagFEC) ? Proto_RSm8_Repair : Proto_RTP;
+        if (flags & FlagFEC) {
+            port.protocol = (flags & FlagRLC) ? Proto_RLC_Repair : Proto_RSm8_Repair;
+        } else {
+            port.protocol = Proto_RTP;
+        }
         return port;
     }
 
@@ -176,6 +217,7 @@ TEST_GROUP(sender_receiver) {
         config.fec = fec_config(flags);
 
         config.interleaving = (flags & FlagInterleaving);
+        config.capture_timestamps = (flags & FlagCaptureTimestamps);
         config.timing = false;
         config.poisoning = true;
 
@@ -202,6 +244,7 @@ TEST_GROUP(sender_receiver) {
             Timeout * core::Second / SampleRate;
 
         config.default_session.fec = fec_config(flags);
+        config.default_session.capture_timestamps = (flags & FlagCaptureTimestamps);
 
         return config;
     }
@@ -210,7 +253,7 @@ TEST_GROUP(sender_receiver) {
         fec::Config config;
 
         if (flags & FlagFEC) {
-            config.codec = fec::ReedSolomon8m;
+            config.codec = (flags & FlagRLC) ? fec::RLC8m : fec::ReedSolomon8m;
             config.n_source_packets = SourcePackets;
             config.n_repair_packets = RepairPackets;
         } else {
@@ -229,7 +272,6 @@ TEST(sender_receiver, interleaving) {
     send_receive(FlagInterleaving, 1);
 }
 
-#ifdef ROC_TARGET_OPENFEC
 TEST(sender_receiver, fec) {
     send_receive(FlagFEC, 1);
 }
@@ -242,6 +284,18 @@ TEST(sender_receiver, fec_loss) {
     send_receive(FlagFEC | FlagLoss, 1);
 }
 
+TEST(sender_receiver, fec_async_loss) {
+    send_receive(FlagFEC | FlagAsyncFEC | FlagLoss, 1);
+}
+
+TEST(sender_receiver, fec_async_interleaving) {
+    send_receive(FlagFEC | FlagAsyncFEC | FlagInterleaving, 1);
+}
+
+TEST(sender_receiver, fec_capture_timestamps_loss) {
+    send_receive(FlagFEC | FlagCaptureTimestamps | FlagLoss, 1);
+}
+
 TEST(sender_receiver, fec_drop_source) {
     send_receive(FlagFEC | FlagDropSource, 0);
 }
@@ -249,7 +303,26 @@ TEST(sender_receiver, fec_drop_source) {
 TEST(sender_receiver, fec_drop_repair) {
     send_receive(FlagFEC | FlagDropRepair, 1);
 }
-#endif //! ROC_TARGET_OPENFEC
+
+TEST(sender_receiver, rlc) {
+    send_receive(FlagFEC | FlagRLC, 1);
+}
+
+TEST(sender_receiver, rlc_interleaving) {
+    send_receive(FlagFEC | FlagRLC | FlagInterleaving, 1);
+}
+
+TEST(sender_receiver, rlc_loss) {
+    send_receive(FlagFEC | FlagRLC | FlagLoss, 1);
+}
+
+TEST(sender_receiver, rlc_capture_timestamps_loss) {
+    send_receive(FlagFEC | FlagRLC | FlagCaptureTimestamps | FlagLoss, 1);
+}
+
+TEST(sender_receiver, rlc_drop_repair) {
+    send_receive(FlagFEC | FlagRLC | FlagDropRepair, 1);
+}
 
 } // namespace pipeline
 } // namespace roc
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_rtcp/composer.h"
+#include "roc_rtcp/headers.h"
+#include "roc_rtcp/parser.h"
+
+namespace roc {
+namespace rtcp {
+
+namespace {
+
+enum { BufferSize = 1000, SmallBufferSize = 16 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, BufferSize, true);
+core::BufferPool<uint8_t> small_buffer_pool(allocator, SmallBufferSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+core::Slice<uint8_t> new_buffer() {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buf);
+    return buf;
+}
+
+ReceptionReport make_block(uint32_t ssrc) {
+    ReceptionReport rr;
+    rr.ssrc = ssrc;
+    rr.fraction_lost = 0.25f;
+    rr.cumulative_lost = 123;
+    rr.last_seqnum = 0x10005;
+    rr.jitter = 77;
+    rr.last_sr = 0x12345678;
+    rr.delay_last_sr = 0x8000;
+    return rr;
+}
+
+void check_block(const ReceptionReport& expected, const ReceptionReport& actual) {
+    UNSIGNED_LONGS_EQUAL(expected.ssrc, actual.ssrc);
+    DOUBLES_EQUAL((double)expected.fraction_lost, (double)actual.fraction_lost, 0.004);
+    LONGS_EQUAL(expected.cumulative_lost, actual.cumulative_lost);
+    UNSIGNED_LONGS_EQUAL(expected.last_seqnum, actual.last_seqnum);
+    UNSIGNED_LONGS_EQUAL(expected.jitter, actual.jitter);
+    UNSIGNED_LONGS_EQUAL(expected.last_sr, actual.last_sr);
+    UNSIGNED_LONGS_EQUAL(expected.delay_last_sr, actual.delay_last_sr);
+}
+
+} // namespace
+
+TEST_GROUP(composer_parser) {};
+
+TEST(composer_parser, sender_report) {
+    Report report;
+    report.ssrc = 0x11223344;
+    report.has_sender_info = true;
+    report.ntp_timestamp = 0x0102030405060708ull;
+    report.rtp_timestamp = 0xaabbccdd;
+    report.packet_count = 1000;
+    report.byte_count = 200000;
+
+    core::Slice<uint8_t> buf = new_buffer();
+
+    Composer composer;
+    CHECK(composer.compose(buf, report));
+
+    CHECK(buf.size() % 4 == 0);
+    UNSIGNED_LONGS_EQUAL(RTCP_SR, ((const Header*)buf.data())->type());
+
+    Parser parser;
+    Report parsed;
+    CHECK(parser.parse_report(buf, parsed));
+
+    UNSIGNED_LONGS_EQUAL(report.ssrc, parsed.ssrc);
+    CHECK(parsed.has_sender_info);
+    CHECK(report.ntp_timestamp == parsed.ntp_timestamp);
+    UNSIGNED_LONGS_EQUAL(report.rtp_timestamp, parsed.rtp_timestamp);
+    UNSIGNED_LONGS_EQUAL(report.packet_count, parsed.packet_count);
+    UNSIGNED_LONGS_EQUAL(report.byte_count, parsed.byte_count);
+    UNSIGNED_LONGS_EQUAL(0, parsed.num_reports);
+}
+
+TEST(composer_parser, receiver_report) {
+    Report report;
+    report.ssrc = 0x55667788;
+    report.num_reports = 2;
+    report.reports[0] = make_block(1);
+    report.reports[1] = make_block(2);
+    report.reports[1].cumulative_lost = -5;
+
+    core::Slice<uint8_t> buf = new_buffer();
+
+    Composer composer;
+    CHECK(composer.compose(buf, report));
+
+    UNSIGNED_LONGS_EQUAL(RTCP_RR, ((const Header*)buf.data())->type());
+
+    Parser parser;
+    Report parsed;
+    CHECK(parser.parse_report(buf, parsed));
+
+    UNSIGNED_LONGS_EQUAL(report.ssrc, parsed.ssrc);
+    CHECK(!parsed.has_sender_info);
+    UNSIGNED_LONGS_EQUAL(2, parsed.num_reports);
+
+    check_block(report.reports[0], parsed.reports[0]);
+    check_block(report.reports[1], parsed.reports[1]);
+}
+
+TEST(composer_parser, max_reports) {
+    Report report;
+    report.num_reports = Report::MaxReceptionReports;
+    for (size_t n = 0; n < report.num_reports; n++) {
+        report.reports[n] = make_block((uint32_t)n);
+    }
+
+    core::Slice<uint8_t> buf = new_buffer();
+
+    Composer composer;
+    CHECK(composer.compose(buf, report));
+
+    Parser parser;
+    Report parsed;
+    CHECK(parser.parse_report(buf, parsed));
+
+    UNSIGNED_LONGS_EQUAL(Report::MaxReceptionReports, parsed.num_reports);
+    for (size_t n = 0; n < parsed.num_reports; n++) {
+        check_block(report.reports[n], parsed.reports[n]);
+    }
+}
+
+TEST(composer_parser, nack) {
+    const uint16_t seqnums[] = { 65530, 65531, 65535, 3, 10, 11, 50 };
+    const size_t num_seqnums = sizeof(seqnums) / sizeof(seqnums[0]);
+
+    Report report;
+    report.ssrc = 0x55667788;
+    report.nack.ssrc = 0x11223344;
+    report.nack.num_seqnums = num_seqnums;
+    for (size_t n = 0; n < num_seqnums; n++) {
+        report.nack.seqnums[n] = seqnums[n];
+    }
+
+    core::Slice<uint8_t> buf = new_buffer();
+
+    Composer composer;
+    CHECK(composer.compose(buf, report));
+
+    CHECK(buf.size() % 4 == 0);
+
+    // RR, SDES, RTPFB with entries for 65530, 11, and 50
+    const Header& fb = *(const Header*)(buf.data() + buf.size() - sizeof(Header)
+                                        - sizeof(SSRC) * 2 - sizeof(NackFCI) * 3);
+    UNSIGNED_LONGS_EQUAL(RTCP_RTPFB, fb.type());
+    UNSIGNED_LONGS_EQUAL(RTPFB_NACK, fb.counter());
+
+    Parser parser;
+    Report parsed;
+    CHECK(parser.parse_report(buf, parsed));
+
+    UNSIGNED_LONGS_EQUAL(report.ssrc, parsed.ssrc);
+    UNSIGNED_LONGS_EQUAL(0, parsed.num_reports);
+    UNSIGNED_LONGS_EQUAL(report.nack.ssrc, parsed.nack.ssrc);
+    UNSIGNED_LONGS_EQUAL(num_seqnums, parsed.nack.num_seqnums);
+
+    for (size_t n = 0; n < num_seqnums; n++) {
+        UNSIGNED_LONGS_EQUAL(seqnums[n], parsed.nack.seqnums[n]);
+    }
+}
+
+TEST(composer_parser, max_nack) {
+    Report report;
+    report.nack.num_seqnums = Nack::MaxSeqnums;
+    for (size_t n = 0; n < report.nack.num_seqnums; n++) {
+        report.nack.seqnums[n] = (uint16_t)(n * 3);
+    }
+
+    core::Slice<uint8_t> buf = new_buffer();
+
+    Composer composer;
+    CHECK(composer.compose(buf, report));
+
+    Parser parser;
+    Report parsed;
+    CHECK(parser.parse_report(buf, parsed));
+
+    UNSIGNED_LONGS_EQUAL(Nack::MaxSeqnums, parsed.nack.num_seqnums);
+    for (size_t n = 0; n < parsed.nack.num_seqnums; n++) {
+        UNSIGNED_LONGS_EQUAL(report.nack.seqnums[n], parsed.nack.seqnums[n]);
+    }
+}
+
+TEST(composer_parser, no_nack) {
+    Report report;
+    report.has_sender_info = true;
+
+    core::Slice<uint8_t> buf = new_buffer();
+
+    Composer composer;
+    CHECK(composer.compose(buf, report));
+
+    Parser parser;
+    Report parsed;
+    parsed.nack.num_seqnums = 1;
+    CHECK(parser.parse_report(buf, parsed));
+
+    UNSIGNED_LONGS_EQUAL(0, parsed.nack.num_seqnums);
+}
+
+TEST(composer_parser, small_buffer) {
+    Report report;
+    report.has_sender_info = true;
+
+    core::Slice<uint8_t> buf =
+        new (small_buffer_pool) core::Buffer<uint8_t>(small_buffer_pool);
+    CHECK(buf);
+
+    Composer composer;
+    CHECK(!composer.compose(buf, report));
+}
+
+TEST(composer_parser, parse_packet) {
+    Report report;
+    report.has_sender_info = true;
+
+    core::Slice<uint8_t> buf = new_buffer();
+
+    Composer composer;
+    CHECK(composer.compose(buf, report));
+
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    CHECK(pp);
+
+    Parser parser;
+    CHECK(parser.parse(*pp, buf));
+
+    CHECK(pp->flags() & packet::Packet::FlagRTCP);
+    CHECK(pp->rtcp());
+    UNSIGNED_LONGS_EQUAL(buf.size(), pp->rtcp()->data.size());
+}
+
+TEST(composer_parser, bad_packets) {
+    Report report;
+    report.has_sender_info = true;
+
+    core::Slice<uint8_t> buf = new_buffer();
+
+    Composer composer;
+    CHECK(composer.compose(buf, report));
+
+    Parser parser;
+    Report parsed;
+
+    // truncated
+    CHECK(!parser.parse_report(buf.range(0, 2), parsed));
+    CHECK(!parser.parse_report(buf.range(0, buf.size() - 4), parsed));
+
+    // bad version
+    buf.data()[0] &= 0x3f;
+    CHECK(!parser.parse_report(buf, parsed));
+    buf.data()[0] |= 0x80;
+    CHECK(parser.parse_report(buf, parsed));
+
+    // first packet is not SR or RR
+    buf.data()[1] = RTCP_SDES;
+    CHECK(!parser.parse_report(buf, parsed));
+}
+
+} // namespace rtcp
+} // namespace roc
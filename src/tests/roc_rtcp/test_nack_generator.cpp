@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_rtcp/nack_generator.h"
+
+namespace roc {
+namespace rtcp {
+
+namespace {
+
+enum { Ssrc = 0xabcd };
+
+const core::nanoseconds_t Now = 100 * core::Second;
+
+core::HeapAllocator allocator;
+packet::PacketPool packet_pool(allocator, true);
+
+packet::PacketPtr new_packet(packet::source_t ssrc, packet::seqnum_t sn) {
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    CHECK(pp);
+
+    pp->add_flags(packet::Packet::FlagRTP | packet::Packet::FlagAudio);
+
+    pp->rtp()->source = ssrc;
+    pp->rtp()->seqnum = sn;
+
+    return pp;
+}
+
+void expect_nack(const Nack& nack, const packet::seqnum_t* seqnums, size_t n_seqnums) {
+    UNSIGNED_LONGS_EQUAL(Ssrc, nack.ssrc);
+    UNSIGNED_LONGS_EQUAL(n_seqnums, nack.num_seqnums);
+
+    for (size_t n = 0; n < n_seqnums; n++) {
+        UNSIGNED_LONGS_EQUAL(seqnums[n], nack.seqnums[n]);
+    }
+}
+
+} // namespace
+
+TEST_GROUP(nack_generator) {
+    NackConfig config;
+
+    void setup() {
+        config.retry_interval = 10 * core::Millisecond;
+        config.max_retries = 2;
+    }
+};
+
+TEST(nack_generator, no_losses) {
+    NackGenerator gen(config);
+    Nack nack;
+
+    CHECK(!gen.generate(nack, Now));
+
+    for (packet::seqnum_t sn = 0; sn < 10; sn++) {
+        gen.add_packet(*new_packet(Ssrc, sn));
+        CHECK(!gen.generate(nack, Now));
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, gen.num_missing());
+}
+
+TEST(nack_generator, losses) {
+    NackGenerator gen(config);
+    Nack nack;
+
+    gen.add_packet(*new_packet(Ssrc, 1));
+    gen.add_packet(*new_packet(Ssrc, 2));
+    gen.add_packet(*new_packet(Ssrc, 5));
+    gen.add_packet(*new_packet(Ssrc, 7));
+
+    UNSIGNED_LONGS_EQUAL(3, gen.num_missing());
+
+    CHECK(gen.generate(nack, Now));
+
+    const packet::seqnum_t expected[] = { 3, 4, 6 };
+    expect_nack(nack, expected, 3);
+}
+
+TEST(nack_generator, late_arrival) {
+    NackGenerator gen(config);
+    Nack nack;
+
+    gen.add_packet(*new_packet(Ssrc, 1));
+    gen.add_packet(*new_packet(Ssrc, 5));
+
+    UNSIGNED_LONGS_EQUAL(3, gen.num_missing());
+
+    gen.add_packet(*new_packet(Ssrc, 3));
+    gen.add_packet(*new_packet(Ssrc, 1));
+
+    UNSIGNED_LONGS_EQUAL(2, gen.num_missing());
+
+    CHECK(gen.generate(nack, Now));
+
+    const packet::seqnum_t expected[] = { 2, 4 };
+    expect_nack(nack, expected, 2);
+
+    gen.add_packet(*new_packet(Ssrc, 2));
+    gen.add_packet(*new_packet(Ssrc, 4));
+
+    UNSIGNED_LONGS_EQUAL(0, gen.num_missing());
+    CHECK(!gen.generate(nack, Now + core::Second));
+}
+
+TEST(nack_generator, retries) {
+    NackGenerator gen(config);
+    Nack nack;
+
+    gen.add_packet(*new_packet(Ssrc, 1));
+    gen.add_packet(*new_packet(Ssrc, 3));
+
+    const packet::seqnum_t expected[] = { 2 };
+
+    CHECK(gen.generate(nack, Now));
+    expect_nack(nack, expected, 1);
+
+    CHECK(!gen.generate(nack, Now + config.retry_interval / 2));
+
+    CHECK(gen.generate(nack, Now + config.retry_interval));
+    expect_nack(nack, expected, 1);
+
+    CHECK(!gen.generate(nack, Now + config.retry_interval * 3));
+    UNSIGNED_LONGS_EQUAL(0, gen.num_missing());
+}
+
+TEST(nack_generator, seqnum_wrap) {
+    NackGenerator gen(config);
+    Nack nack;
+
+    gen.add_packet(*new_packet(Ssrc, 65534));
+    gen.add_packet(*new_packet(Ssrc, 1));
+
+    CHECK(gen.generate(nack, Now));
+
+    const packet::seqnum_t expected[] = { 65535, 0 };
+    expect_nack(nack, expected, 2);
+}
+
+TEST(nack_generator, large_hole) {
+    NackGenerator gen(config);
+    Nack nack;
+
+    gen.add_packet(*new_packet(Ssrc, 0));
+    gen.add_packet(*new_packet(Ssrc, 1000));
+
+    UNSIGNED_LONGS_EQUAL(Nack::MaxSeqnums, gen.num_missing());
+
+    CHECK(gen.generate(nack, Now));
+
+    UNSIGNED_LONGS_EQUAL(Nack::MaxSeqnums, nack.num_seqnums);
+    UNSIGNED_LONGS_EQUAL(1000 - Nack::MaxSeqnums, nack.seqnums[0]);
+    UNSIGNED_LONGS_EQUAL(999, nack.seqnums[Nack::MaxSeqnums - 1]);
+}
+
+TEST(nack_generator, evict_oldest) {
+    NackGenerator gen(config);
+    Nack nack;
+
+    packet::seqnum_t sn = 0;
+    gen.add_packet(*new_packet(Ssrc, sn));
+
+    for (size_t n = 0; n < Nack::MaxSeqnums + 5; n++) {
+        sn += 2;
+        gen.add_packet(*new_packet(Ssrc, sn));
+    }
+
+    UNSIGNED_LONGS_EQUAL(Nack::MaxSeqnums, gen.num_missing());
+
+    CHECK(gen.generate(nack, Now));
+
+    UNSIGNED_LONGS_EQUAL(Nack::MaxSeqnums, nack.num_seqnums);
+    UNSIGNED_LONGS_EQUAL(11, nack.seqnums[0]);
+    UNSIGNED_LONGS_EQUAL(sn - 1, nack.seqnums[Nack::MaxSeqnums - 1]);
+}
+
+TEST(nack_generator, ssrc_change) {
+    NackGenerator gen(config);
+    Nack nack;
+
+    gen.add_packet(*new_packet(Ssrc + 1, 1));
+    gen.add_packet(*new_packet(Ssrc + 1, 5));
+
+    UNSIGNED_LONGS_EQUAL(3, gen.num_missing());
+
+    gen.add_packet(*new_packet(Ssrc, 100));
+    UNSIGNED_LONGS_EQUAL(0, gen.num_missing());
+
+    gen.add_packet(*new_packet(Ssrc, 102));
+
+    CHECK(gen.generate(nack, Now));
+
+    const packet::seqnum_t expected[] = { 101 };
+    expect_nack(nack, expected, 1);
+}
+
+} // namespace rtcp
+} // namespace roc
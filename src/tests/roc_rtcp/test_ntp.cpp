@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_rtcp/ntp.h"
+
+namespace roc {
+namespace rtcp {
+
+TEST_GROUP(ntp) {};
+
+TEST(ntp, unix_epoch) {
+    UNSIGNED_LONGS_EQUAL(2208988800ul, (unsigned long)(unix_to_ntp(0) >> 32));
+    UNSIGNED_LONGS_EQUAL(0, (unsigned long)(unix_to_ntp(0) & 0xffffffff));
+
+    LONGS_EQUAL(0, (long)ntp_to_unix(unix_to_ntp(0)));
+}
+
+TEST(ntp, fraction) {
+    const ntp_timestamp_t ntp = unix_to_ntp(core::Second / 2);
+
+    UNSIGNED_LONGS_EQUAL(2208988800ul, (unsigned long)(ntp >> 32));
+    UNSIGNED_LONGS_EQUAL(0x80000000ul, (unsigned long)(ntp & 0xffffffff));
+}
+
+TEST(ntp, round_trip) {
+    const core::nanoseconds_t times[] = {
+        1 * core::Nanosecond,
+        123 * core::Microsecond,
+        999 * core::Millisecond,
+        1500000000 * core::Second + 123456789 * core::Nanosecond,
+    };
+
+    for (size_t n = 0; n < sizeof(times) / sizeof(times[0]); n++) {
+        const core::nanoseconds_t t = ntp_to_unix(unix_to_ntp(times[n]));
+        CHECK(t - times[n] <= 1 && times[n] - t <= 1);
+    }
+}
+
+TEST(ntp, before_epoch) {
+    LONGS_EQUAL(0, (long)ntp_to_unix(0));
+}
+
+TEST(ntp, compact) {
+    const ntp_timestamp_t ntp = ((ntp_timestamp_t)0x12345678 << 32) | 0x9abcdef0;
+
+    UNSIGNED_LONGS_EQUAL(0x56789abc, ntp_compact(ntp));
+}
+
+TEST(ntp, compact_duration) {
+    UNSIGNED_LONGS_EQUAL(0, ns_to_compact(-1));
+    UNSIGNED_LONGS_EQUAL(0x10000, ns_to_compact(core::Second));
+    UNSIGNED_LONGS_EQUAL(0x8000, ns_to_compact(core::Second / 2));
+    UNSIGNED_LONGS_EQUAL(0xffffffff, ns_to_compact(100000 * core::Second));
+
+    LONGS_EQUAL((long)core::Second, (long)compact_to_ns(0x10000));
+    LONGS_EQUAL((long)(core::Second / 4), (long)compact_to_ns(0x4000));
+}
+
+} // namespace rtcp
+} // namespace roc
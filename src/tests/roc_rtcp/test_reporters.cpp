@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/queue.h"
+#include "roc_rtcp/receiver_reporter.h"
+#include "roc_rtcp/sender_reporter.h"
+
+namespace roc {
+namespace rtcp {
+
+namespace {
+
+enum { SampleRate = 1000, SamplesPerPacket = 10, PayloadSize = 40, Ssrc = 0xabcd };
+
+const core::nanoseconds_t PacketInterval = SamplesPerPacket * core::Millisecond;
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+packet::PacketPtr new_packet(packet::seqnum_t sn, core::nanoseconds_t delay) {
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    CHECK(pp);
+
+    pp->add_flags(packet::Packet::FlagUDP | packet::Packet::FlagRTP
+                  | packet::Packet::FlagAudio);
+
+    pp->udp()->receive_timestamp =
+        core::Second + (core::nanoseconds_t)sn * PacketInterval + delay;
+
+    core::Slice<uint8_t> payload = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(payload);
+
+    pp->rtp()->source = Ssrc;
+    pp->rtp()->seqnum = sn;
+    pp->rtp()->timestamp = packet::timestamp_t(sn * SamplesPerPacket);
+    pp->rtp()->duration = SamplesPerPacket;
+    pp->rtp()->payload = payload;
+
+    return pp;
+}
+
+} // namespace
+
+TEST_GROUP(reporters) {};
+
+TEST(reporters, sender_counters) {
+    packet::Queue queue;
+    SenderReporter reporter(queue, SampleRate);
+
+    CHECK(!reporter.has_report());
+
+    for (packet::seqnum_t sn = 0; sn < 10; sn++) {
+        reporter.write(new_packet(sn, 0));
+    }
+
+    UNSIGNED_LONGS_EQUAL(10, queue.size());
+    CHECK(reporter.has_report());
+
+    Report report;
+    reporter.generate(report);
+
+    UNSIGNED_LONGS_EQUAL(Ssrc, report.ssrc);
+    CHECK(report.has_sender_info);
+    CHECK(report.ntp_timestamp != 0);
+    UNSIGNED_LONGS_EQUAL(10, report.packet_count);
+    UNSIGNED_LONGS_EQUAL(10 * PayloadSize, report.byte_count);
+    CHECK(report.rtp_timestamp >= 10 * SamplesPerPacket);
+    UNSIGNED_LONGS_EQUAL(0, report.num_reports);
+}
+
+TEST(reporters, receiver_no_losses) {
+    ReceiverReporter reporter(SampleRate);
+
+    CHECK(!reporter.has_report());
+
+    for (packet::seqnum_t sn = 0; sn < 100; sn++) {
+        reporter.add_packet(*new_packet(sn, 0));
+    }
+
+    CHECK(reporter.has_report());
+
+    Report report;
+    reporter.generate(report, 1, core::timestamp());
+
+    UNSIGNED_LONGS_EQUAL(1, report.ssrc);
+    CHECK(!report.has_sender_info);
+    UNSIGNED_LONGS_EQUAL(1, report.num_reports);
+
+    UNSIGNED_LONGS_EQUAL(Ssrc, report.reports[0].ssrc);
+    UNSIGNED_LONGS_EQUAL(99, report.reports[0].last_seqnum);
+    LONGS_EQUAL(0, report.reports[0].cumulative_lost);
+    DOUBLES_EQUAL(0.0, (double)report.reports[0].fraction_lost, 0.0001);
+    UNSIGNED_LONGS_EQUAL(0, report.reports[0].jitter);
+    UNSIGNED_LONGS_EQUAL(0, report.reports[0].last_sr);
+}
+
+TEST(reporters, receiver_losses) {
+    ReceiverReporter reporter(SampleRate);
+
+    for (packet::seqnum_t sn = 0; sn < 100; sn++) {
+        if (sn % 4 != 3) {
+            reporter.add_packet(*new_packet(sn, 0));
+        }
+    }
+
+    Report report;
+    reporter.generate(report, 1, core::timestamp());
+
+    LONGS_EQUAL(24, report.reports[0].cumulative_lost);
+    // packet 99 is lost too, but it is not expected yet
+    DOUBLES_EQUAL(24.0 / 99, (double)report.reports[0].fraction_lost, 0.001);
+
+    // only packet 99 is lost since previous report
+    for (packet::seqnum_t sn = 100; sn < 200; sn++) {
+        reporter.add_packet(*new_packet(sn, 0));
+    }
+
+    reporter.generate(report, 1, core::timestamp());
+
+    LONGS_EQUAL(25, report.reports[0].cumulative_lost);
+    DOUBLES_EQUAL(1.0 / 101, (double)report.reports[0].fraction_lost, 0.0001);
+    DOUBLES_EQUAL(1.0 / 101, (double)reporter.stats().fraction_lost, 0.0001);
+    LONGS_EQUAL(25, reporter.stats().cumulative_lost);
+}
+
+TEST(reporters, receiver_seqnum_wrap) {
+    ReceiverReporter reporter(SampleRate);
+
+    for (packet::seqnum_t sn = 65500; sn != 100; sn++) {
+        reporter.add_packet(*new_packet(sn, 0));
+    }
+
+    Report report;
+    reporter.generate(report, 1, core::timestamp());
+
+    UNSIGNED_LONGS_EQUAL(0x10000 + 99, report.reports[0].last_seqnum);
+    LONGS_EQUAL(0, report.reports[0].cumulative_lost);
+}
+
+TEST(reporters, receiver_jitter) {
+    ReceiverReporter reporter(SampleRate);
+
+    for (packet::seqnum_t sn = 0; sn < 1000; sn++) {
+        reporter.add_packet(*new_packet(sn, sn % 2 == 0 ? 0 : 20 * core::Millisecond));
+    }
+
+    Report report;
+    reporter.generate(report, 1, core::timestamp());
+
+    // every packet is delayed by 20ms relative to the previous one
+    UNSIGNED_LONGS_EQUAL(19, report.reports[0].jitter);
+
+    const core::nanoseconds_t jitter = reporter.stats().jitter;
+    CHECK(jitter > 19 * core::Millisecond && jitter <= 20 * core::Millisecond);
+}
+
+TEST(reporters, round_trip) {
+    packet::Queue queue;
+    SenderReporter sender(queue, SampleRate);
+    ReceiverReporter receiver(SampleRate);
+
+    for (packet::seqnum_t sn = 0; sn < 10; sn++) {
+        packet::PacketPtr pp = new_packet(sn, 0);
+        sender.write(pp);
+        receiver.add_packet(*pp);
+    }
+
+    Report sr;
+    sender.generate(sr);
+    receiver.process(sr, core::timestamp());
+
+    CHECK(receiver.has_sender_clock());
+    UNSIGNED_LONGS_EQUAL(1, receiver.stats().num_reports);
+
+    // sample captured right before the report was sent
+    const core::nanoseconds_t e2e_latency = receiver.e2e_latency(sr.rtp_timestamp);
+    CHECK(e2e_latency >= -core::Millisecond && e2e_latency < core::Second);
+
+    Report rr;
+    receiver.generate(rr, 1, core::timestamp());
+
+    UNSIGNED_LONGS_EQUAL(ntp_compact(sr.ntp_timestamp), rr.reports[0].last_sr);
+
+    sender.process(rr);
+
+    UNSIGNED_LONGS_EQUAL(1, sender.stats().num_reports);
+    CHECK(sender.stats().rtt >= 0 && sender.stats().rtt < core::Second);
+    LONGS_EQUAL(0, sender.stats().cumulative_lost);
+}
+
+TEST(reporters, sender_ignores_other_ssrc) {
+    packet::Queue queue;
+    SenderReporter sender(queue, SampleRate);
+
+    sender.write(new_packet(0, 0));
+
+    Report rr;
+    rr.num_reports = 1;
+    rr.reports[0].ssrc = Ssrc + 1;
+    rr.reports[0].cumulative_lost = 10;
+
+    sender.process(rr);
+
+    UNSIGNED_LONGS_EQUAL(0, sender.stats().num_reports);
+    LONGS_EQUAL(0, sender.stats().cumulative_lost);
+}
+
+} // namespace rtcp
+} // namespace roc
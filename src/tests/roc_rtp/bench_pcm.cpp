@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// PCM conversion benchmark.
+//
+// Compares scalar and vectorized int16_t encoding and decoding for every
+// vector instruction set of the target architecture. Instruction sets that
+// the CPU doesn't support are reported as errors.
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/random.h"
+#include "roc_rtp/pcm_helpers.h"
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+enum { MaxSamples = 4096 };
+
+audio::sample_t float_buf[MaxSamples];
+int16_t int_buf[MaxSamples];
+
+void fill_buffers() {
+    for (size_t n = 0; n < MaxSamples; n++) {
+        float_buf[n] = (audio::sample_t)core::random(0, 0xffff) / 0x8000 - 1.0f;
+        int_buf[n] = (int16_t)core::random(0, 0xffff);
+    }
+}
+
+// Arguments: number of samples.
+void BM_PCM_Pack(benchmark::State& state, PCMIsa isa) {
+    if (!pcm_isa_supported(isa)) {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+
+    const size_t n_samples = (size_t)state.range(0);
+    fill_buffers();
+
+    for (auto _ : state) {
+        pcm_pack_n_isa(isa, int_buf, float_buf, n_samples);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_samples));
+    state.SetLabel(pcm_isa_to_str(isa));
+}
+
+// Arguments: number of samples.
+void BM_PCM_Unpack(benchmark::State& state, PCMIsa isa) {
+    if (!pcm_isa_supported(isa)) {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+
+    const size_t n_samples = (size_t)state.range(0);
+    fill_buffers();
+
+    for (auto _ : state) {
+        pcm_unpack_n_isa(isa, float_buf, int_buf, n_samples);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_samples));
+    state.SetLabel(pcm_isa_to_str(isa));
+}
+
+// 10ms of mono and stereo audio at 32kHz, and a large buffer.
+void pcm_args(benchmark::internal::Benchmark* b) {
+    b->Arg(320)->Arg(640)->Arg(MaxSamples);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(BM_PCM_Pack, scalar, PCMIsa_Scalar)->Apply(pcm_args);
+BENCHMARK_CAPTURE(BM_PCM_Unpack, scalar, PCMIsa_Scalar)->Apply(pcm_args);
+
+#if defined(__x86_64__) || defined(__i386__)
+
+BENCHMARK_CAPTURE(BM_PCM_Pack, sse2, PCMIsa_SSE2)->Apply(pcm_args);
+BENCHMARK_CAPTURE(BM_PCM_Unpack, sse2, PCMIsa_SSE2)->Apply(pcm_args);
+
+BENCHMARK_CAPTURE(BM_PCM_Pack, avx2, PCMIsa_AVX2)->Apply(pcm_args);
+BENCHMARK_CAPTURE(BM_PCM_Unpack, avx2, PCMIsa_AVX2)->Apply(pcm_args);
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+BENCHMARK_CAPTURE(BM_PCM_Pack, neon, PCMIsa_NEON)->Apply(pcm_args);
+BENCHMARK_CAPTURE(BM_PCM_Unpack, neon, PCMIsa_NEON)->Apply(pcm_args);
+
+#endif
+
+} // namespace rtp
+} // namespace roc
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// Opus codec benchmark.
+//
+// BM_OpusEncode and BM_OpusDecode measure CPU time per packet for every Opus
+// frame size (2.5 to 60 ms) and for mono and stereo streams. items_per_second
+// is the number of samples per channel, so it can be compared with
+// OpusSampleRate to see how many streams a single core can handle.
+
+#include <benchmark/benchmark.h>
+
+#include <math.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/unique_ptr.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/opus_decoder.h"
+#include "roc_rtp/opus_encoder.h"
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+enum { MaxBufSize = 4000, NumPackets = 16 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxBufSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+audio::sample_t input[OpusMaxFrameSamples * OpusMaxChannels];
+
+// Fills input with a two-tone signal, so that the encoder doesn't take
+// shortcuts for silence or a pure tone.
+void init_input(size_t n_channels) {
+    for (size_t n = 0; n < OpusMaxFrameSamples; n++) {
+        const double t = 2 * M_PI * double(n) / OpusSampleRate;
+        const audio::sample_t s = (audio::sample_t)(0.3 * sin(440 * t)
+                                                    + 0.2 * sin(3520 * t));
+        for (size_t ch = 0; ch < n_channels; ch++) {
+            input[n * n_channels + ch] = ch % 2 ? -s : s;
+        }
+    }
+}
+
+packet::PacketPtr new_packet(audio::IEncoder& encoder, size_t n_samples) {
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    roc_panic_if(!pp);
+
+    core::Slice<uint8_t> bp = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    roc_panic_if(!bp);
+
+    Composer composer(NULL);
+    if (!composer.prepare(*pp, bp, encoder.payload_size(n_samples))) {
+        roc_panic("bench opus: can't prepare packet");
+    }
+    pp->set_data(bp);
+
+    return pp;
+}
+
+void encode(audio::IEncoder& encoder,
+            packet::Packet& packet,
+            size_t n_samples,
+            packet::channel_mask_t channels) {
+    if (encoder.write_samples(packet, 0, input, n_samples, channels) != n_samples) {
+        roc_panic("bench opus: can't write samples");
+    }
+    if (!encoder.finish(packet, n_samples)) {
+        roc_panic("bench opus: can't encode packet");
+    }
+}
+
+// Arguments: number of channels, frame size in samples per channel.
+void BM_OpusEncode(benchmark::State& state) {
+    const size_t n_channels = (size_t)state.range(0);
+    const size_t n_samples = (size_t)state.range(1);
+    const packet::channel_mask_t channels =
+        packet::channel_mask_t((1 << n_channels) - 1);
+
+    core::UniquePtr<audio::IEncoder> encoder(OpusEncoder::create(n_channels, allocator),
+                                             allocator);
+    roc_panic_if(!encoder);
+
+    init_input(n_channels);
+
+    packet::PacketPtr pp = new_packet(*encoder, n_samples);
+
+    while (state.KeepRunning()) {
+        encode(*encoder, *pp, n_samples, channels);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_samples));
+}
+
+// Arguments: number of channels, frame size in samples per channel.
+// Packets are encoded in advance and decoded in a loop.
+void BM_OpusDecode(benchmark::State& state) {
+    const size_t n_channels = (size_t)state.range(0);
+    const size_t n_samples = (size_t)state.range(1);
+    const packet::channel_mask_t channels =
+        packet::channel_mask_t((1 << n_channels) - 1);
+
+    core::UniquePtr<audio::IEncoder> encoder(OpusEncoder::create(n_channels, allocator),
+                                             allocator);
+    roc_panic_if(!encoder);
+
+    core::UniquePtr<audio::IDecoder> decoder(OpusDecoder::create(n_channels, allocator),
+                                             allocator);
+    roc_panic_if(!decoder);
+
+    init_input(n_channels);
+
+    // decoder skips decoding when it reads the same packet twice, so every
+    // packet gets its own seqnum
+    packet::PacketPtr packets[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet(*encoder, n_samples);
+        packets[n]->rtp()->seqnum = packet::seqnum_t(n);
+        encode(*encoder, *packets[n], n_samples, channels);
+    }
+
+    audio::sample_t output[OpusMaxFrameSamples * OpusMaxChannels];
+
+    size_t n = 0;
+    while (state.KeepRunning()) {
+        if (decoder->read_samples(*packets[n], 0, output, n_samples, channels)
+            != n_samples) {
+            state.SkipWithError("decoder returned less samples than expected");
+            return;
+        }
+        n = (n + 1) % NumPackets;
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_samples));
+}
+
+void frame_args(benchmark::internal::Benchmark* bench) {
+    static const int frame_sizes[] = { 120, 240, 480, 960, 1920, 2880 };
+
+    bench->ArgNames({ "channels", "samples" });
+    for (int ch = 1; ch <= (int)OpusMaxChannels; ch++) {
+        for (size_t n = 0; n < ROC_ARRAY_SIZE(frame_sizes); n++) {
+            bench->Args({ ch, frame_sizes[n] });
+        }
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_OpusEncode)->Apply(frame_args)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_OpusDecode)->Apply(frame_args)->Unit(benchmark::kMicrosecond);
+
+} // namespace rtp
+} // namespace roc
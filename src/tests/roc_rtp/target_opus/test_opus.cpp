@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/unique_ptr.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/opus_decoder.h"
+#include "roc_rtp/opus_encoder.h"
+
+#include <math.h>
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+enum {
+    NumCh = 2,
+    ChMask = 0x3,
+    FrameSamples = 480,
+    NumPackets = 20,
+    MaxBufsz = 2000
+};
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxBufsz, true);
+packet::PacketPool packet_pool(allocator, true);
+
+} // namespace
+
+TEST_GROUP(opus) {
+    audio::sample_t input[FrameSamples * NumCh];
+    audio::sample_t output[FrameSamples * NumCh];
+
+    core::UniquePtr<audio::IEncoder> encoder;
+    core::UniquePtr<audio::IDecoder> decoder;
+
+    void setup() {
+        encoder.reset(new_opus_encoder<NumCh>(allocator), allocator);
+        CHECK(encoder);
+
+        decoder.reset(new_opus_decoder<NumCh>(allocator), allocator);
+        CHECK(decoder);
+
+        for (size_t n = 0; n < FrameSamples; n++) {
+            const audio::sample_t s =
+                (audio::sample_t)(0.5 * sin(2 * M_PI * 440 * n / OpusSampleRate));
+            input[n * NumCh] = s;
+            input[n * NumCh + 1] = -s;
+        }
+    }
+
+    packet::PacketPtr new_packet(size_t num_samples) {
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        CHECK(pp);
+
+        core::Slice<uint8_t> bp = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+        CHECK(bp);
+
+        Composer composer(NULL);
+        CHECK(composer.prepare(*pp, bp, encoder->payload_size(num_samples)));
+
+        pp->set_data(bp);
+        return pp;
+    }
+
+    packet::PacketPtr encode(size_t num_samples) {
+        packet::PacketPtr pp = new_packet(num_samples);
+
+        UNSIGNED_LONGS_EQUAL(num_samples,
+                             encoder->write_samples(*pp, 0, input, num_samples, ChMask));
+        CHECK(encoder->finish(*pp, num_samples));
+
+        return pp;
+    }
+};
+
+TEST(opus, payload_size) {
+    UNSIGNED_LONGS_EQUAL(40, encoder->payload_size(120));
+    UNSIGNED_LONGS_EQUAL(80, encoder->payload_size(240));
+    UNSIGNED_LONGS_EQUAL(160, encoder->payload_size(480));
+    UNSIGNED_LONGS_EQUAL(320, encoder->payload_size(960));
+
+    UNSIGNED_LONGS_EQUAL(160, encoder->payload_size(300));
+}
+
+TEST(opus, payload_samples) {
+    UNSIGNED_LONGS_EQUAL(0, encoder->payload_samples(39));
+    UNSIGNED_LONGS_EQUAL(120, encoder->payload_samples(40));
+    UNSIGNED_LONGS_EQUAL(120, encoder->payload_samples(79));
+    UNSIGNED_LONGS_EQUAL(480, encoder->payload_samples(160));
+    UNSIGNED_LONGS_EQUAL(960, encoder->payload_samples(500));
+    UNSIGNED_LONGS_EQUAL(2880, encoder->payload_samples(100000));
+}
+
+TEST(opus, constant_size) {
+    for (size_t n = 0; n < NumPackets; n++) {
+        packet::PacketPtr pp = encode(FrameSamples);
+
+        UNSIGNED_LONGS_EQUAL(encoder->payload_size(FrameSamples),
+                             pp->rtp()->payload.size());
+    }
+}
+
+TEST(opus, duration) {
+    packet::PacketPtr pp = encode(FrameSamples);
+
+    UNSIGNED_LONGS_EQUAL(FrameSamples, opus_duration_from_header(*pp->rtp()));
+}
+
+TEST(opus, encode_decode) {
+    double energy = 0;
+
+    // Let the decoder converge, the first frames contain codec delay.
+    for (size_t n = 0; n < NumPackets; n++) {
+        packet::PacketPtr pp = encode(FrameSamples);
+
+        UNSIGNED_LONGS_EQUAL(FrameSamples / 2,
+                             decoder->read_samples(*pp, 0, output, FrameSamples / 2,
+                                                   ChMask));
+        UNSIGNED_LONGS_EQUAL(FrameSamples / 2,
+                             decoder->read_samples(*pp, FrameSamples / 2,
+                                                   output + FrameSamples / 2 * NumCh,
+                                                   FrameSamples, ChMask));
+        UNSIGNED_LONGS_EQUAL(0, decoder->read_samples(*pp, FrameSamples, output,
+                                                      FrameSamples, ChMask));
+
+        energy = 0;
+        for (size_t i = 0; i < FrameSamples * NumCh; i++) {
+            energy += (double)(output[i] * output[i]);
+        }
+    }
+
+    CHECK(energy > 0);
+}
+
+TEST(opus, mono_output) {
+    packet::PacketPtr pp = encode(FrameSamples);
+
+    UNSIGNED_LONGS_EQUAL(FrameSamples,
+                         decoder->read_samples(*pp, 0, output, FrameSamples, 0x1));
+}
+
+TEST(opus, conceal) {
+    for (size_t n = 0; n < NumPackets; n++) {
+        packet::PacketPtr pp = encode(FrameSamples);
+
+        UNSIGNED_LONGS_EQUAL(FrameSamples, decoder->read_samples(*pp, 0, output,
+                                                                 FrameSamples, ChMask));
+    }
+
+    decoder->conceal_samples(output, FrameSamples, ChMask);
+
+    double energy = 0;
+    for (size_t i = 0; i < FrameSamples * NumCh; i++) {
+        energy += (double)(output[i] * output[i]);
+    }
+
+    // Concealment continues the signal instead of filling it with zeros.
+    CHECK(energy > 0);
+}
+
+TEST(opus, format_map) {
+    FormatMap fmt_map;
+
+    const Format* fmt = fmt_map.format(PayloadType_Opus_Stereo);
+    CHECK(fmt);
+
+    UNSIGNED_LONGS_EQUAL(OpusSampleRate, fmt->sample_rate);
+    UNSIGNED_LONGS_EQUAL(ChMask, fmt->channel_mask);
+
+    CHECK(fmt_map.format(PayloadType_Opus_Mono));
+}
+
+} // namespace rtp
+} // namespace roc
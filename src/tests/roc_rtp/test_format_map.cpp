@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2019 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/unique_ptr.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+core::HeapAllocator allocator;
+
+struct FormatInfo {
+    PayloadType payload_type;
+    size_t sample_rate;
+    packet::channel_mask_t channel_mask;
+    size_t sample_size;
+};
+
+const FormatInfo formats[] = {
+    { PayloadType_L16_Stereo, 44100, 0x3, 2 },
+    { PayloadType_L16_Mono, 44100, 0x1, 2 },
+    { PayloadType_L16_48k_Stereo, 48000, 0x3, 2 },
+    { PayloadType_L16_48k_Mono, 48000, 0x1, 2 },
+    { PayloadType_L16_96k_Stereo, 96000, 0x3, 2 },
+    { PayloadType_L16_96k_Mono, 96000, 0x1, 2 },
+    { PayloadType_L24_Stereo, 44100, 0x3, 3 },
+    { PayloadType_L24_Mono, 44100, 0x1, 3 },
+    { PayloadType_L24_48k_Stereo, 48000, 0x3, 3 },
+    { PayloadType_L24_48k_Mono, 48000, 0x1, 3 },
+    { PayloadType_L24_96k_Stereo, 96000, 0x3, 3 },
+    { PayloadType_L24_96k_Mono, 96000, 0x1, 3 },
+    { PayloadType_Float32_Stereo, 44100, 0x3, 4 },
+    { PayloadType_Float32_Mono, 44100, 0x1, 4 },
+    { PayloadType_Float32_48k_Stereo, 48000, 0x3, 4 },
+    { PayloadType_Float32_48k_Mono, 48000, 0x1, 4 },
+    { PayloadType_Float32_96k_Stereo, 96000, 0x3, 4 },
+    { PayloadType_Float32_96k_Mono, 96000, 0x1, 4 },
+};
+
+} // namespace
+
+TEST_GROUP(format_map) {};
+
+TEST(format_map, formats) {
+    FormatMap format_map;
+
+    for (size_t n = 0; n < sizeof(formats) / sizeof(formats[0]); n++) {
+        const Format* format = format_map.format(formats[n].payload_type);
+        CHECK(format);
+
+        LONGS_EQUAL(formats[n].payload_type, format->payload_type);
+        UNSIGNED_LONGS_EQUAL(formats[n].sample_rate, format->sample_rate);
+        UNSIGNED_LONGS_EQUAL(formats[n].channel_mask, format->channel_mask);
+
+        const size_t num_ch = packet::num_channels(format->channel_mask);
+
+        // 10ms packet
+        UNSIGNED_LONGS_EQUAL(sizeof(Header)
+                                 + formats[n].sample_rate / 100 * num_ch
+                                     * formats[n].sample_size,
+                             format->size(10 * core::Millisecond, format->sample_rate));
+
+        core::UniquePtr<audio::IEncoder> encoder(format->new_encoder(allocator),
+                                                 allocator);
+        CHECK(encoder);
+
+        core::UniquePtr<audio::IDecoder> decoder(format->new_decoder(allocator),
+                                                 allocator);
+        CHECK(decoder);
+
+        UNSIGNED_LONGS_EQUAL(100 * num_ch * formats[n].sample_size,
+                             encoder->payload_size(100));
+    }
+}
+
+TEST(format_map, unknown) {
+    FormatMap format_map;
+
+    CHECK(!format_map.format(0));
+    CHECK(!format_map.format(127));
+    CHECK(!format_map.format(128));
+    CHECK(!format_map.format(1000));
+}
+
+TEST(format_map, add_format) {
+    enum { DynamicPayloadType = 120, SampleRate = 16000 };
+
+    FormatMap format_map;
+
+    Format fmt = *FormatMap::builtin_format(PayloadType_L16_Mono);
+    fmt.payload_type = (PayloadType)DynamicPayloadType;
+    fmt.sample_rate = SampleRate;
+
+    CHECK(format_map.add_format(fmt));
+
+    const Format* format = format_map.format(DynamicPayloadType);
+    CHECK(format);
+
+    LONGS_EQUAL(DynamicPayloadType, format->payload_type);
+    UNSIGNED_LONGS_EQUAL(SampleRate, format->sample_rate);
+    UNSIGNED_LONGS_EQUAL(0x1, format->channel_mask);
+
+    // 10ms packet
+    UNSIGNED_LONGS_EQUAL(sizeof(Header) + SampleRate / 100 * 2,
+                         format->size(10 * core::Millisecond, format->sample_rate));
+}
+
+TEST(format_map, replace_format) {
+    FormatMap format_map;
+
+    Format fmt = *FormatMap::builtin_format(PayloadType_L24_Stereo);
+    fmt.payload_type = PayloadType_L16_Stereo;
+
+    CHECK(format_map.add_format(fmt));
+
+    const Format* format = format_map.format(PayloadType_L16_Stereo);
+    CHECK(format);
+    CHECK(format->duration == fmt.duration);
+
+    const Format* builtin = FormatMap::builtin_format(PayloadType_L16_Stereo);
+    CHECK(builtin);
+    CHECK(builtin->duration != fmt.duration);
+}
+
+TEST(format_map, add_invalid) {
+    FormatMap format_map;
+
+    Format fmt = *FormatMap::builtin_format(PayloadType_L16_Stereo);
+
+    Format bad_pt = fmt;
+    bad_pt.payload_type = (PayloadType)128;
+    CHECK(!format_map.add_format(bad_pt));
+
+    Format bad_rate = fmt;
+    bad_rate.sample_rate = 0;
+    CHECK(!format_map.add_format(bad_rate));
+
+    Format bad_decoder = fmt;
+    bad_decoder.new_decoder = NULL;
+    CHECK(!format_map.add_format(bad_decoder));
+}
+
+} // namespace rtp
+} // namespace roc
@@ -15,6 +15,7 @@
 #include "roc_packet/packet_pool.h"
 #include "roc_rtp/composer.h"
 #include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
 #include "roc_rtp/parser.h"
 
 #include "test_packets/rtp_l16_1ch_10s_12ext.h"
@@ -72,7 +73,8 @@ TEST_GROUP(packets) {
             UNSIGNED_LONGS_EQUAL(
                 pi.packet_size,
                 format.size(core::nanoseconds_t(pi.num_samples) * core::Second
-                            / core::nanoseconds_t(format.sample_rate)));
+                                / core::nanoseconds_t(format.sample_rate),
+                            format.sample_rate));
         }
     }
 
@@ -189,6 +191,8 @@ TEST_GROUP(packets) {
         check_format(*format, *packet, pi, false);
         check_headers(*packet, pi);
 
+        LONGS_EQUAL(0, packet->rtp()->capture_timestamp);
+
         decode_samples(*decoder, *packet, pi);
     }
 
@@ -242,5 +246,68 @@ TEST(packets, l16_1ch_10s_4pad_2csrc_12ext_marker) {
     check(rtp_l16_1ch_10s_4pad_2csrc_12ext_marker, false);
 }
 
+TEST(packets, overhead) {
+    Composer composer(NULL);
+    UNSIGNED_LONGS_EQUAL(sizeof(Header), composer.overhead());
+
+    Composer ext_composer(NULL, true);
+    UNSIGNED_LONGS_EQUAL(sizeof(Header) + sizeof(CaptureTimestampExtension),
+                         ext_composer.overhead());
+}
+
+TEST(packets, capture_timestamp) {
+    enum { NumSamples = 10 };
+
+    const core::nanoseconds_t capture_ts = 1500000000 * core::Second + 123456789;
+
+    FormatMap format_map;
+
+    const Format* format = format_map.format(PayloadType_L16_Stereo);
+    CHECK(format);
+
+    core::UniquePtr<audio::IEncoder> encoder(format->new_encoder(allocator), allocator);
+    CHECK(encoder);
+
+    core::Slice<uint8_t> buffer = new_buffer(NULL, 0);
+    CHECK(buffer);
+
+    packet::PacketPtr packet = new_packet();
+    CHECK(packet);
+
+    Composer composer(NULL, true);
+    CHECK(composer.prepare(*packet, buffer, encoder->payload_size(NumSamples)));
+    packet->set_data(buffer);
+
+    packet->rtp()->source = 1;
+    packet->rtp()->seqnum = 2;
+    packet->rtp()->timestamp = 3;
+    packet->rtp()->payload_type = PayloadType_L16_Stereo;
+    packet->rtp()->capture_timestamp = capture_ts;
+
+    CHECK(composer.compose(*packet));
+
+    UNSIGNED_LONGS_EQUAL(sizeof(Header) + sizeof(CaptureTimestampExtension)
+                             + encoder->payload_size(NumSamples),
+                         packet->data().size());
+
+    packet::PacketPtr parsed = new_packet();
+    CHECK(parsed);
+
+    parsed->set_data(new_buffer(packet->data().data(), packet->data().size()));
+
+    Parser parser(format_map, NULL);
+    CHECK(parser.parse(*parsed, parsed->data()));
+
+    UNSIGNED_LONGS_EQUAL(1, parsed->rtp()->source);
+    UNSIGNED_LONGS_EQUAL(2, parsed->rtp()->seqnum);
+    UNSIGNED_LONGS_EQUAL(3, parsed->rtp()->timestamp);
+    UNSIGNED_LONGS_EQUAL(NumSamples, parsed->rtp()->duration);
+    UNSIGNED_LONGS_EQUAL(encoder->payload_size(NumSamples),
+                         parsed->rtp()->payload.size());
+
+    CHECK(parsed->rtp()->capture_timestamp >= capture_ts - 1);
+    CHECK(parsed->rtp()->capture_timestamp <= capture_ts + 1);
+}
+
 } // namespace rtp
 } // namespace roc
@@ -103,6 +103,30 @@ TEST(pcm, payload_size) {
     PCMEncoder<int16_t, 2> encoder2ch;
     UNSIGNED_LONGS_EQUAL(NumSamples * 2 * sizeof(int16_t),
                          encoder2ch.payload_size(NumSamples));
+
+    PCMEncoder<PCMInt24, 2> encoder24;
+    UNSIGNED_LONGS_EQUAL(NumSamples * 2 * 3, encoder24.payload_size(NumSamples));
+
+    PCMEncoder<PCMFloat32, 2> encoder32;
+    UNSIGNED_LONGS_EQUAL(NumSamples * 2 * 4, encoder32.payload_size(NumSamples));
+}
+
+TEST(pcm, payload_samples) {
+    enum { NumSamples = 77 };
+
+    PCMEncoder<int16_t, 1> encoder1ch;
+    UNSIGNED_LONGS_EQUAL(NumSamples, encoder1ch.payload_samples(NumSamples * 2));
+    UNSIGNED_LONGS_EQUAL(NumSamples, encoder1ch.payload_samples(NumSamples * 2 + 1));
+
+    PCMEncoder<int16_t, 2> encoder2ch;
+    UNSIGNED_LONGS_EQUAL(NumSamples, encoder2ch.payload_samples(NumSamples * 4 + 3));
+    UNSIGNED_LONGS_EQUAL(0, encoder2ch.payload_samples(3));
+
+    PCMEncoder<PCMInt24, 2> encoder24;
+    UNSIGNED_LONGS_EQUAL(NumSamples, encoder24.payload_samples(NumSamples * 6 + 5));
+
+    PCMEncoder<PCMFloat32, 2> encoder32;
+    UNSIGNED_LONGS_EQUAL(NumSamples, encoder32.payload_samples(NumSamples * 8 + 7));
 }
 
 TEST(pcm, 1ch) {
@@ -143,6 +167,145 @@ TEST(pcm, 2ch) {
     check(samples, NumSamples, 0x3);
 }
 
+TEST(pcm, 24bit) {
+    enum { NumSamples = 5 };
+
+    packet::PacketPtr pp = new_packet<PCMInt24, 2>(NumSamples);
+
+    const audio::sample_t samples[NumSamples * 2] = {
+        -0.1f,       0.1f,        //
+        -0.2f,       0.2f,        //
+        -0.3f,       0.3f,        //
+        -0.4f,       0.4f,        //
+        -0.0000001f, 0.0000001f, //
+    };
+
+    encode<PCMInt24, 2>(pp, samples, 0, NumSamples, 0x3);
+    decode<PCMInt24, 2>(pp, 0, NumSamples, 0x3);
+
+    check(samples, NumSamples, 0x3);
+
+    const uint8_t* payload = pp->rtp()->payload.data();
+
+    // -0.1 * 2^23 = -838860.8, truncated to 0xf33334
+    UNSIGNED_LONGS_EQUAL(0xf3, payload[0]);
+    UNSIGNED_LONGS_EQUAL(0x33, payload[1]);
+    UNSIGNED_LONGS_EQUAL(0x34, payload[2]);
+
+    // 0.1 * 2^23 = 838860.8, truncated to 0x0ccccc
+    UNSIGNED_LONGS_EQUAL(0x0c, payload[3]);
+    UNSIGNED_LONGS_EQUAL(0xcc, payload[4]);
+    UNSIGNED_LONGS_EQUAL(0xcc, payload[5]);
+}
+
+TEST(pcm, float32) {
+    enum { NumSamples = 5 };
+
+    packet::PacketPtr pp = new_packet<PCMFloat32, 2>(NumSamples);
+
+    const audio::sample_t samples[NumSamples * 2] = {
+        -0.1f,       0.1f,       //
+        -0.2f,       0.2f,       //
+        -0.3f,       0.3f,       //
+        -0.4f,       0.4f,       //
+        -0.0000001f, 0.0000001f, //
+    };
+
+    encode<PCMFloat32, 2>(pp, samples, 0, NumSamples, 0x3);
+    decode<PCMFloat32, 2>(pp, 0, NumSamples, 0x3);
+
+    for (size_t n = 0; n < NumSamples * 2; n++) {
+        DOUBLES_EQUAL((double)samples[n], (double)output[n], 0.0);
+    }
+
+    const uint8_t* payload = pp->rtp()->payload.data();
+
+    // -0.1f is 0xbdcccccd
+    UNSIGNED_LONGS_EQUAL(0xbd, payload[0]);
+    UNSIGNED_LONGS_EQUAL(0xcc, payload[1]);
+    UNSIGNED_LONGS_EQUAL(0xcc, payload[2]);
+    UNSIGNED_LONGS_EQUAL(0xcd, payload[3]);
+}
+
+TEST(pcm, saturation) {
+    const audio::sample_t samples[] = { 1.0f, -1.0f, 2.0f, -2.0f };
+
+    const int32_t expected16[] = { 32767, -32768, 32767, -32768 };
+    const int32_t expected24[] = { 8388607, -8388608, 8388607, -8388608 };
+
+    for (size_t n = 0; n < sizeof(samples) / sizeof(samples[0]); n++) {
+        const int16_t s16 = pcm_pack<int16_t>(samples[n]);
+        LONGS_EQUAL(expected16[n], (int16_t)core::ntoh16((uint16_t)s16));
+
+        const PCMInt24 s24 = pcm_pack<PCMInt24>(samples[n]);
+        DOUBLES_EQUAL((double)expected24[n] / 8388608, (double)pcm_unpack(s24), 0.0);
+
+        const PCMFloat32 f32 = pcm_pack<PCMFloat32>(samples[n]);
+        DOUBLES_EQUAL((double)samples[n], (double)pcm_unpack(f32), 0.0);
+    }
+}
+
+TEST(pcm, pack_unpack_n) {
+    enum { NumSamples = 37, MaxOffset = 3 };
+
+    audio::sample_t samples[NumSamples + MaxOffset];
+    for (size_t n = 0; n < NumSamples + MaxOffset; n++) {
+        samples[n] = (float)n / NumSamples * 2.5f - 1.25f;
+    }
+    samples[5] = 1.0f;
+    samples[6] = -1.0f;
+    samples[7] = 0.99999f;
+
+    for (int isa = 0; isa < PCMIsa_Max; isa++) {
+        if (!pcm_isa_supported((PCMIsa)isa)) {
+            continue;
+        }
+
+        for (size_t off = 0; off < MaxOffset; off++) {
+            for (size_t ns = 0; ns <= NumSamples; ns++) {
+                int16_t packed[NumSamples + MaxOffset] = {};
+                pcm_pack_n_isa((PCMIsa)isa, packed + off, samples + off, ns);
+
+                audio::sample_t unpacked[NumSamples + MaxOffset] = {};
+                pcm_unpack_n_isa((PCMIsa)isa, unpacked + off, packed + off, ns);
+
+                for (size_t n = 0; n < NumSamples + MaxOffset; n++) {
+                    if (n < off || n >= off + ns) {
+                        LONGS_EQUAL(0, packed[n]);
+                        DOUBLES_EQUAL(0.0, (double)unpacked[n], 0.0);
+                        continue;
+                    }
+                    LONGS_EQUAL(pcm_pack<int16_t>(samples[n]), packed[n]);
+                    DOUBLES_EQUAL((double)pcm_unpack(packed[n]), (double)unpacked[n],
+                                  0.0);
+                }
+            }
+        }
+    }
+}
+
+TEST(pcm, pack_unpack_n_default_isa) {
+    enum { NumSamples = 37 };
+
+    audio::sample_t samples[NumSamples];
+    for (size_t n = 0; n < NumSamples; n++) {
+        samples[n] = (float)n / NumSamples * 2.5f - 1.25f;
+    }
+
+    CHECK(pcm_isa_supported(pcm_isa()));
+
+    int16_t packed[NumSamples] = {};
+    pcm_pack_n<int16_t>(packed, samples, NumSamples);
+
+    audio::sample_t unpacked[NumSamples] = {};
+    pcm_unpack_n<int16_t>(unpacked, packed, NumSamples);
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        LONGS_EQUAL(pcm_pack<int16_t>(samples[n]), packed[n]);
+        DOUBLES_EQUAL((double)pcm_unpack(packed[n]), (double)unpacked[n], 0.0);
+    }
+}
+
 TEST(pcm, encode_mask_subset) {
     enum { NumSamples = 5 };
 
@@ -105,6 +105,18 @@ int main(int argc, char** argv) {
         resampler_config = audio::resampler_profile(audio::ResamplerProfile_High);
         break;
 
+    case resampler_profile_arg_short:
+        resampler_config = audio::resampler_profile(audio::ResamplerProfile_Short);
+        break;
+
+    case resampler_profile_arg_cubic:
+        resampler_config = audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+
+    case resampler_profile_arg_linear:
+        resampler_config = audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
+
     default:
         break;
     }
@@ -126,6 +138,7 @@ int main(int argc, char** argv) {
             roc_log(LogError, "can't set resampler scaling");
             return 1;
         }
+        resampler.enable_profiling(reader.sample_rate());
         writer = &resampler;
     }
 
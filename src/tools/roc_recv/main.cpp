@@ -86,6 +86,25 @@ int main(int argc, char** argv) {
         repair_port.protocol = pipeline::Proto_LDPC_Repair;
         break;
 
+    case fec_arg_rlc:
+        config.default_session.fec.codec = fec::RLC8m;
+        source_port.protocol = pipeline::Proto_RTP_RLC_Source;
+        repair_port.protocol = pipeline::Proto_RLC_Repair;
+        break;
+
+    default:
+        break;
+    }
+
+    switch ((unsigned)args.fec_backend_arg) {
+    case fec_backend_arg_openfec:
+        config.default_session.fec.backend = fec::OpenFECBackend;
+        break;
+
+    case fec_backend_arg_builtin:
+        config.default_session.fec.backend = fec::BuiltinBackend;
+        break;
+
     default:
         break;
     }
@@ -144,6 +163,47 @@ int main(int argc, char** argv) {
             config.default_session.target_latency * pipeline::DefaultMaxLatencyFactor;
     }
 
+    config.default_session.adaptive_latency = args.adaptive_latency_flag;
+
+    if (args.min_target_latency_given) {
+        if (!config.default_session.adaptive_latency) {
+            roc_log(LogError, "--min-target-latency requires --adaptive-latency");
+            return 1;
+        }
+        if (!core::parse_duration(
+                args.min_target_latency_arg,
+                config.default_session.latency_tuner.min_target_latency)) {
+            roc_log(LogError, "invalid --min-target-latency");
+            return 1;
+        }
+    }
+
+    if (args.max_target_latency_given) {
+        if (!config.default_session.adaptive_latency) {
+            roc_log(LogError, "--max-target-latency requires --adaptive-latency");
+            return 1;
+        }
+        if (!core::parse_duration(
+                args.max_target_latency_arg,
+                config.default_session.latency_tuner.max_target_latency)) {
+            roc_log(LogError, "invalid --max-target-latency");
+            return 1;
+        }
+    }
+
+    if (config.default_session.adaptive_latency) {
+        const core::nanoseconds_t max_target =
+            config.default_session.latency_tuner.max_target_latency;
+        if (!args.min_latency_given) {
+            config.default_session.latency_monitor.min_latency =
+                max_target * pipeline::DefaultMinLatencyFactor;
+        }
+        if (!args.max_latency_given) {
+            config.default_session.latency_monitor.max_latency =
+                max_target * pipeline::DefaultMaxLatencyFactor;
+        }
+    }
+
     if (args.np_timeout_given) {
         if (!core::parse_duration(args.np_timeout_arg,
                                   config.default_session.watchdog.no_playback_timeout)) {
@@ -172,6 +232,11 @@ int main(int argc, char** argv) {
 
     config.output.resampling = !args.no_resampling_flag;
 
+    if (config.default_session.adaptive_latency && !config.output.resampling) {
+        roc_log(LogError, "--adaptive-latency can't be used with --no-resampling");
+        return 1;
+    }
+
     switch ((unsigned)args.resampler_profile_arg) {
     case resampler_profile_arg_low:
         config.default_session.resampler =
@@ -188,6 +253,21 @@ int main(int argc, char** argv) {
             audio::resampler_profile(audio::ResamplerProfile_High);
         break;
 
+    case resampler_profile_arg_short:
+        config.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Short);
+        break;
+
+    case resampler_profile_arg_cubic:
+        config.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+
+    case resampler_profile_arg_linear:
+        config.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
+
     default:
         break;
     }
@@ -11,6 +11,7 @@
 #include "roc_core/heap_allocator.h"
 #include "roc_core/log.h"
 #include "roc_core/scoped_destructor.h"
+#include "roc_fec/encoder_worker.h"
 #include "roc_netio/transceiver.h"
 #include "roc_packet/address_to_str.h"
 #include "roc_packet/parse_address.h"
@@ -50,6 +51,7 @@ int main(int argc, char** argv) {
 
     pipeline::PortConfig source_port;
     pipeline::PortConfig repair_port;
+    pipeline::PortConfig control_port;
 
     if (args.source_given) {
         if (!packet::parse_address(args.source_arg, source_port.address)) {
@@ -94,6 +96,25 @@ int main(int argc, char** argv) {
         repair_port.protocol = pipeline::Proto_LDPC_Repair;
         break;
 
+    case fec_arg_rlc:
+        config.fec.codec = fec::RLC8m;
+        source_port.protocol = pipeline::Proto_RTP_RLC_Source;
+        repair_port.protocol = pipeline::Proto_RLC_Repair;
+        break;
+
+    default:
+        break;
+    }
+
+    switch ((unsigned)args.fec_backend_arg) {
+    case fec_backend_arg_openfec:
+        config.fec.backend = fec::OpenFECBackend;
+        break;
+
+    case fec_backend_arg_builtin:
+        config.fec.backend = fec::BuiltinBackend;
+        break;
+
     default:
         break;
     }
@@ -137,6 +158,18 @@ int main(int argc, char** argv) {
         config.resampler = audio::resampler_profile(audio::ResamplerProfile_High);
         break;
 
+    case resampler_profile_arg_short:
+        config.resampler = audio::resampler_profile(audio::ResamplerProfile_Short);
+        break;
+
+    case resampler_profile_arg_cubic:
+        config.resampler = audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+
+    case resampler_profile_arg_linear:
+        config.resampler = audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
+
     default:
         break;
     }
@@ -172,6 +205,7 @@ int main(int argc, char** argv) {
 
     config.interleaving = args.interleaving_flag;
     config.poisoning = args.poisoning_flag;
+    config.profiling = args.profiling_flag;
 
     core::HeapAllocator allocator;
     core::BufferPool<uint8_t> byte_buffer_pool(allocator, MaxPacketSize,
@@ -206,9 +240,11 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    fec::EncoderWorker fec_worker;
+
     pipeline::Sender sender(config, source_port, *udp_sender, repair_port, *udp_sender,
-                            format_map, packet_pool, byte_buffer_pool, sample_buffer_pool,
-                            allocator);
+                            control_port, *udp_sender, &fec_worker, format_map,
+                            packet_pool, byte_buffer_pool, sample_buffer_pool, allocator);
     if (!sender.valid()) {
         roc_log(LogError, "can't create sender pipeline");
         return 1;
@@ -221,13 +257,18 @@ int main(int argc, char** argv) {
 
     int status = 1;
 
-    if (reader.start(sender)) {
+    if (!fec_worker.start()) {
+        roc_log(LogError, "can't start fec thread");
+    } else if (reader.start(sender)) {
         reader.join();
         status = 0;
     } else {
         roc_log(LogError, "can't start reader");
     }
 
+    fec_worker.stop();
+    fec_worker.join();
+
     trx.stop();
     trx.join();
 